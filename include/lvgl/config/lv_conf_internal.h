@@ -62,6 +62,7 @@
 #define LV_DRAW_SW_ASM_NEON      1
 #define LV_DRAW_SW_ASM_HELIUM    2
 #define LV_DRAW_SW_ASM_RISCV_V   3
+#define LV_DRAW_SW_ASM_X86       4
 #define LV_DRAW_SW_ASM_CUSTOM    255
 
 /* VG-Lite GPU (series and revision) */
@@ -417,6 +418,36 @@
     #endif
 #endif
 
+#ifndef LV_USE_DRAW_TASK_POOL
+    #ifdef CONFIG_LV_USE_DRAW_TASK_POOL
+        #define LV_USE_DRAW_TASK_POOL CONFIG_LV_USE_DRAW_TASK_POOL
+    #else
+        #define LV_USE_DRAW_TASK_POOL 0
+    #endif
+#endif
+
+#ifndef LV_USE_DRAW_GLYPH_ATLAS
+    #ifdef CONFIG_LV_USE_DRAW_GLYPH_ATLAS
+        #define LV_USE_DRAW_GLYPH_ATLAS CONFIG_LV_USE_DRAW_GLYPH_ATLAS
+    #else
+        #define LV_USE_DRAW_GLYPH_ATLAS 0
+    #endif
+#endif
+#ifndef LV_DRAW_GLYPH_ATLAS_PAGE_SIZE
+    #ifdef CONFIG_LV_DRAW_GLYPH_ATLAS_PAGE_SIZE
+        #define LV_DRAW_GLYPH_ATLAS_PAGE_SIZE CONFIG_LV_DRAW_GLYPH_ATLAS_PAGE_SIZE
+    #else
+        #define LV_DRAW_GLYPH_ATLAS_PAGE_SIZE 256
+    #endif
+#endif
+#ifndef LV_DRAW_GLYPH_ATLAS_PAGE_CNT
+    #ifdef CONFIG_LV_DRAW_GLYPH_ATLAS_PAGE_CNT
+        #define LV_DRAW_GLYPH_ATLAS_PAGE_CNT CONFIG_LV_DRAW_GLYPH_ATLAS_PAGE_CNT
+    #else
+        #define LV_DRAW_GLYPH_ATLAS_PAGE_CNT 4
+    #endif
+#endif
+
 #ifndef LV_DRAW_THREAD_STACK_SIZE
     #ifdef CONFIG_LV_DRAW_THREAD_STACK_SIZE
         #define LV_DRAW_THREAD_STACK_SIZE CONFIG_LV_DRAW_THREAD_STACK_SIZE
@@ -629,6 +660,14 @@
     #endif
 #endif
 
+#ifndef LV_DRAW_SW_SPLIT_MIN_SIZE
+    #ifdef CONFIG_LV_DRAW_SW_SPLIT_MIN_SIZE
+        #define LV_DRAW_SW_SPLIT_MIN_SIZE CONFIG_LV_DRAW_SW_SPLIT_MIN_SIZE
+    #else
+        #define LV_DRAW_SW_SPLIT_MIN_SIZE 16384
+    #endif
+#endif
+
 #ifndef LV_USE_DRAW_ARM2D_SYNC
     #ifdef CONFIG_LV_USE_DRAW_ARM2D_SYNC
         #define LV_USE_DRAW_ARM2D_SYNC CONFIG_LV_USE_DRAW_ARM2D_SYNC
@@ -681,6 +720,14 @@
     #endif
 #endif
 
+#ifndef LV_DRAW_SW_SHADOW_CACHE_CNT
+    #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_CNT
+        #define LV_DRAW_SW_SHADOW_CACHE_CNT CONFIG_LV_DRAW_SW_SHADOW_CACHE_CNT
+    #else
+        #define LV_DRAW_SW_SHADOW_CACHE_CNT 4
+    #endif
+#endif
+
 #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
     #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
@@ -689,6 +736,14 @@
     #endif
 #endif
 
+#ifndef LV_DRAW_SW_BLUR_CACHE_SIZE
+    #ifdef CONFIG_LV_DRAW_SW_BLUR_CACHE_SIZE
+        #define LV_DRAW_SW_BLUR_CACHE_SIZE CONFIG_LV_DRAW_SW_BLUR_CACHE_SIZE
+    #else
+        #define LV_DRAW_SW_BLUR_CACHE_SIZE 0
+    #endif
+#endif
+
 #ifndef LV_USE_DRAW_SW_ASM
     #ifdef CONFIG_LV_USE_DRAW_SW_ASM
         #define LV_USE_DRAW_SW_ASM CONFIG_LV_USE_DRAW_SW_ASM
@@ -705,6 +760,14 @@
     #endif
 #endif
 
+#ifndef LV_USE_DRAW_SW_SIMD
+    #ifdef CONFIG_LV_USE_DRAW_SW_SIMD
+        #define LV_USE_DRAW_SW_SIMD CONFIG_LV_USE_DRAW_SW_SIMD
+    #else
+        #define LV_USE_DRAW_SW_SIMD 0
+    #endif
+#endif
+
 #ifndef LV_USE_DRAW_VG_LITE
     #ifdef CONFIG_LV_USE_DRAW_VG_LITE
         #define LV_USE_DRAW_VG_LITE CONFIG_LV_USE_DRAW_VG_LITE
@@ -1325,6 +1388,30 @@
     #endif
 #endif
 
+#ifndef LV_STYLE_SORTED_PROPS
+    #ifdef CONFIG_LV_STYLE_SORTED_PROPS
+        #define LV_STYLE_SORTED_PROPS CONFIG_LV_STYLE_SORTED_PROPS
+    #else
+        #define LV_STYLE_SORTED_PROPS 0
+    #endif
+#endif
+
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE 0
+    #endif
+#endif
+
+#ifndef LV_USE_OBJ_RETAINED_DRAW
+    #ifdef CONFIG_LV_USE_OBJ_RETAINED_DRAW
+        #define LV_USE_OBJ_RETAINED_DRAW CONFIG_LV_USE_OBJ_RETAINED_DRAW
+    #else
+        #define LV_USE_OBJ_RETAINED_DRAW 0
+    #endif
+#endif
+
 #ifndef LV_USE_OBJ_NAME
     #ifdef CONFIG_LV_USE_OBJ_NAME
         #define LV_USE_OBJ_NAME CONFIG_LV_USE_OBJ_NAME
@@ -1713,6 +1800,96 @@
     #endif
 #endif
 
+#ifndef LV_IMAGE_CACHE_SHARD_CNT
+    #ifdef CONFIG_LV_IMAGE_CACHE_SHARD_CNT
+        #define LV_IMAGE_CACHE_SHARD_CNT CONFIG_LV_IMAGE_CACHE_SHARD_CNT
+    #else
+        #define LV_IMAGE_CACHE_SHARD_CNT 1
+    #endif
+#endif
+
+#ifndef LV_USE_IMAGE_CACHE_2Q
+    #ifdef CONFIG_LV_USE_IMAGE_CACHE_2Q
+        #define LV_USE_IMAGE_CACHE_2Q CONFIG_LV_USE_IMAGE_CACHE_2Q
+    #else
+        #define LV_USE_IMAGE_CACHE_2Q 0
+    #endif
+#endif
+
+#ifndef LV_USE_IMAGE_CACHE_CONVERT
+    #ifdef CONFIG_LV_USE_IMAGE_CACHE_CONVERT
+        #define LV_USE_IMAGE_CACHE_CONVERT CONFIG_LV_USE_IMAGE_CACHE_CONVERT
+    #else
+        #define LV_USE_IMAGE_CACHE_CONVERT 0
+    #endif
+#endif
+#ifndef LV_IMAGE_CACHE_CONVERT_DITHER
+    #ifdef CONFIG_LV_IMAGE_CACHE_CONVERT_DITHER
+        #define LV_IMAGE_CACHE_CONVERT_DITHER CONFIG_LV_IMAGE_CACHE_CONVERT_DITHER
+    #else
+        #define LV_IMAGE_CACHE_CONVERT_DITHER 0
+    #endif
+#endif
+
+#ifndef LV_USE_IMAGE_DECODER_ROI
+    #ifdef CONFIG_LV_USE_IMAGE_DECODER_ROI
+        #define LV_USE_IMAGE_DECODER_ROI CONFIG_LV_USE_IMAGE_DECODER_ROI
+    #else
+        #define LV_USE_IMAGE_DECODER_ROI 0
+    #endif
+#endif
+#ifndef LV_IMAGE_DECODER_ROI_MIN_SIZE
+    #ifdef CONFIG_LV_IMAGE_DECODER_ROI_MIN_SIZE
+        #define LV_IMAGE_DECODER_ROI_MIN_SIZE CONFIG_LV_IMAGE_DECODER_ROI_MIN_SIZE
+    #else
+        #define LV_IMAGE_DECODER_ROI_MIN_SIZE (1024 * 1024)
+    #endif
+#endif
+#ifndef LV_IMAGE_DECODER_ROI_TILE_SIZE
+    #ifdef CONFIG_LV_IMAGE_DECODER_ROI_TILE_SIZE
+        #define LV_IMAGE_DECODER_ROI_TILE_SIZE CONFIG_LV_IMAGE_DECODER_ROI_TILE_SIZE
+    #else
+        #define LV_IMAGE_DECODER_ROI_TILE_SIZE 64
+    #endif
+#endif
+#ifndef LV_IMAGE_DECODER_ROI_OPENED_CNT
+    #ifdef CONFIG_LV_IMAGE_DECODER_ROI_OPENED_CNT
+        #define LV_IMAGE_DECODER_ROI_OPENED_CNT CONFIG_LV_IMAGE_DECODER_ROI_OPENED_CNT
+    #else
+        #define LV_IMAGE_DECODER_ROI_OPENED_CNT 4
+    #endif
+#endif
+
+#ifndef LV_USE_IMAGE_DECODER_ASYNC
+    #ifdef CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+        #define LV_USE_IMAGE_DECODER_ASYNC CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+    #else
+        #define LV_USE_IMAGE_DECODER_ASYNC 0
+    #endif
+#endif
+
+#ifndef LV_USE_IMAGE_DISK_CACHE
+    #ifdef CONFIG_LV_USE_IMAGE_DISK_CACHE
+        #define LV_USE_IMAGE_DISK_CACHE CONFIG_LV_USE_IMAGE_DISK_CACHE
+    #else
+        #define LV_USE_IMAGE_DISK_CACHE 0
+    #endif
+#endif
+#ifndef LV_IMAGE_DISK_CACHE_MAX_SIZE
+    #ifdef CONFIG_LV_IMAGE_DISK_CACHE_MAX_SIZE
+        #define LV_IMAGE_DISK_CACHE_MAX_SIZE CONFIG_LV_IMAGE_DISK_CACHE_MAX_SIZE
+    #else
+        #define LV_IMAGE_DISK_CACHE_MAX_SIZE (8 * 1024 * 1024)
+    #endif
+#endif
+#ifndef LV_IMAGE_DISK_CACHE_MIN_TIME
+    #ifdef CONFIG_LV_IMAGE_DISK_CACHE_MIN_TIME
+        #define LV_IMAGE_DISK_CACHE_MIN_TIME CONFIG_LV_IMAGE_DISK_CACHE_MIN_TIME
+    #else
+        #define LV_IMAGE_DISK_CACHE_MIN_TIME 50
+    #endif
+#endif
+
 #ifndef LV_USE_RLE
     #ifdef CONFIG_LV_USE_RLE
         #define LV_USE_RLE CONFIG_LV_USE_RLE
@@ -2167,6 +2344,21 @@
     #endif
 #endif
 
+#ifndef LV_USE_FONT_FMT_TXT_CACHE
+    #ifdef CONFIG_LV_USE_FONT_FMT_TXT_CACHE
+        #define LV_USE_FONT_FMT_TXT_CACHE CONFIG_LV_USE_FONT_FMT_TXT_CACHE
+    #else
+        #define LV_USE_FONT_FMT_TXT_CACHE 0
+    #endif
+#endif
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_CACHE_SIZE 256
+    #endif
+#endif
+
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_FONT_PLACEHOLDER
@@ -5258,6 +5450,10 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
     #error "LV_USE_GRID must be enabled: Kconfig selects it from LV_USE_DEMO_RENDER && LV_BUILD_DEMOS"
 #endif
 
+#if LV_USE_FONT_FMT_TXT_CACHE && !(LV_USE_OS == LV_OS_NONE)
+    #error "LV_USE_FONT_FMT_TXT_CACHE requires LV_USE_OS == LV_OS_NONE (Kconfig depends on)"
+#endif
+
 #if (LV_USE_TEST_SCREENSHOT_COMPARE && LV_USE_TEST) && !LV_USE_LODEPNG
     #error "LV_USE_LODEPNG must be enabled: Kconfig selects it from LV_USE_TEST_SCREENSHOT_COMPARE && LV_USE_TEST"
 #endif
@@ -140,6 +140,28 @@ int32_t lv_obj_calculate_ext_draw_size(lv_obj_t * obj, lv_part_t part);
  */
 void lv_obj_refresh_ext_draw_size(lv_obj_t * obj);
 
+#if LV_USE_OBJ_RETAINED_DRAW
+/**
+ * Enable or disable retained drawing for a widget. If enabled the draw tasks created
+ * in the widget's `LV_EVENT_DRAW_MAIN_BEGIN/MAIN/MAIN_END` events are saved and reused in the
+ * next refreshes (even if the widget was scrolled) until the widget is invalidated or its styles change.
+ * The children and `LV_EVENT_DRAW_POST` are always drawn normally.
+ * @param obj       pointer to an object
+ * @param en        true: enable retained drawing; false: disable it and free the saved draw tasks
+ * @note            The draw events are not sent while the saved draw tasks are used, so the
+ *                  custom draw event handlers of the widget should draw only what depends on the
+ *                  widget's state and styles.
+ */
+void lv_obj_set_draw_retained(lv_obj_t * obj, bool en);
+
+/**
+ * Check if retained drawing is enabled for a widget
+ * @param obj       pointer to an object
+ * @return          true: retained drawing is enabled
+ */
+bool lv_obj_get_draw_retained(const lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -367,6 +367,11 @@ typedef struct {
     lv_style_value_t value;
 } lv_style_const_prop_t;
 
+#if LV_STYLE_SORTED_PROPS
+/** Number of 32 bit words to have a bit for each built-in property and one for all the custom properties*/
+#define LV_STYLE_PROP_BITMAP_SIZE ((LV_STYLE_NUM_BUILT_IN_PROPS + 32) / 32)
+#endif
+
 /**
  * Descriptor of a style (a collection of properties and values).
  */
@@ -379,6 +384,9 @@ typedef struct {
     void * values_and_props;
 
     uint32_t has_group;
+#if LV_STYLE_SORTED_PROPS
+    uint32_t has_prop[LV_STYLE_PROP_BITMAP_SIZE];   /**< A bit for each property which is set in the style*/
+#endif
     uint8_t prop_cnt;   /**< 255 means it's a constant style*/
 } lv_style_t;
 
@@ -543,6 +551,21 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     }
     else {
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+#if LV_STYLE_SORTED_PROPS
+        /*The properties are sorted so use binary search*/
+        uint32_t min = 0;
+        uint32_t max = style->prop_cnt;
+        while(min < max) {
+            uint32_t mid = (min + max) >> 1;
+            if(props[mid] < prop) min = mid + 1;
+            else max = mid;
+        }
+        if(min < style->prop_cnt && props[min] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            *value = values[min];
+            return LV_STYLE_RES_FOUND;
+        }
+#else
         uint32_t i;
         for(i = 0; i < style->prop_cnt; i++) {
             if(props[i] == prop) {
@@ -551,6 +574,7 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
                 return LV_STYLE_RES_FOUND;
             }
         }
+#endif
     }
     return LV_STYLE_RES_NOT_FOUND;
 }
@@ -576,6 +600,24 @@ static inline uint32_t lv_style_get_prop_group(lv_style_prop_t prop)
 
 }
 
+/**
+ * Quickly check if a style might have a property. If it returns `false` the style surely doesn't have it.
+ * With `LV_STYLE_SORTED_PROPS` each property has its own bit, else only the group of the property is checked.
+ * @param style pointer to a style
+ * @param prop  a style property
+ * @return      true: the style might have the property, false: the style doesn't have the property
+ */
+static inline bool lv_style_may_have_prop(const lv_style_t * style, lv_style_prop_t prop)
+{
+#if LV_STYLE_SORTED_PROPS
+    if(lv_style_is_const(style)) return true;
+    uint32_t bit = prop < LV_STYLE_PROP_BITMAP_SIZE * 32 ? prop : LV_STYLE_PROP_BITMAP_SIZE * 32 - 1;
+    return (style->has_prop[bit >> 5] & ((uint32_t)1 << (bit & 0x1F))) != 0;
+#else
+    return (style->has_group & ((uint32_t)1 << lv_style_get_prop_group(prop))) != 0;
+#endif
+}
+
 /**
  * Get the flags of a built-in or custom property.
  *
@@ -82,6 +82,15 @@ typedef void (*lv_display_flush_cb_t)(lv_display_t * disp, const lv_area_t * are
 typedef void (*lv_display_flush_wait_cb_t)(lv_display_t * disp);
 typedef void (*lv_display_sync_cb_t)(lv_display_t * disp, const lv_area_t * area);
 typedef void (*lv_display_sync_wait_cb_t)(lv_display_t * disp);
+typedef uint64_t (*lv_display_refr_cost_cb_t)(lv_display_t * disp, const lv_area_t * area);
+
+/** Counters of the decisions made by the adaptive frame pacing */
+typedef struct {
+    uint32_t frame_cnt;         /**< Number of rendered frames*/
+    uint32_t skip_cnt;          /**< Number of refreshes skipped because the previous frame missed its deadline*/
+    uint32_t coalesce_cnt;      /**< Number of frames after which the refresh period was increased*/
+    uint32_t split_cnt;         /**< Number of frames where some areas were postponed to the next frame*/
+} lv_display_frame_pacing_stats_t;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -349,6 +358,74 @@ void lv_display_set_sync_cb(lv_display_t * disp, lv_display_sync_cb_t sync_cb);
  */
 void lv_display_set_sync_wait_cb(lv_display_t * disp, lv_display_sync_wait_cb_t wait_cb);
 
+/**
+ * Set the parameters of the built-in cost model which is used to decide which invalidated areas
+ * to join before redrawing them. Redrawing an area is predicted to take
+ * `flush_cnt * flush_cost + pixel_cnt * (render_px_cost + transfer_px_cost)` nanoseconds.
+ * @param disp              pointer to a display
+ * @param flush_cost        fixed overhead of a flush in ns, e.g. `flush_cb` latency, SPI transaction setup
+ * @param render_px_cost    time of rendering a pixel in ns
+ * @param transfer_px_cost  time of sending a pixel to the display in ns
+ */
+void lv_display_set_refr_cost(lv_display_t * disp, uint32_t flush_cost, uint32_t render_px_cost,
+                              uint32_t transfer_px_cost);
+
+/**
+ * Set a custom cost model to decide which invalidated areas to join before redrawing them.
+ * @param disp      pointer to a display
+ * @param cost_cb   a callback which returns the predicted time of redrawing an area in ns.
+ *                  If NULL the built-in cost model is used (see `lv_display_set_refr_cost()`).
+ */
+void lv_display_set_refr_cost_cb(lv_display_t * disp, lv_display_refr_cost_cb_t cost_cb);
+
+/**
+ * Get the predicted time of redrawing an area with the cost model of the display
+ * @param disp      pointer to a display
+ * @param area      the area to redraw
+ * @return          the predicted time in ns
+ */
+uint64_t lv_display_get_refr_cost(lv_display_t * disp, const lv_area_t * area);
+
+/**
+ * Get the predicted time of redrawing the invalidated areas in the last refresh
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          the predicted time in ns
+ */
+uint64_t lv_display_get_refr_cost_predicted(lv_display_t * disp);
+
+/**
+ * Enable or disable adaptive frame pacing. The render and flush time of each frame is measured
+ * to predict the time of the next frame from the number of invalidated pixels.
+ * To keep the period of the refresh timer as the target frame time:
+ * - if a frame missed its deadline the next refresh is skipped to let the other timers run,
+ * - in partial render mode the areas which don't fit in the time budget are postponed to the next frame,
+ * - else the refresh period is increased to collect the changes of more periods into one frame.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param en        true: enable frame pacing; false: disable it and restore the refresh period
+ * @note            The period of the refresh timer should be set before enabling frame pacing
+ */
+void lv_display_set_frame_pacing(lv_display_t * disp, bool en);
+
+/**
+ * Check if adaptive frame pacing is enabled
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          true: frame pacing is enabled
+ */
+bool lv_display_get_frame_pacing(lv_display_t * disp);
+
+/**
+ * Get the counters of the decisions made by the adaptive frame pacing
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param stats     store the counters here
+ */
+void lv_display_get_frame_pacing_stats(lv_display_t * disp, lv_display_frame_pacing_stats_t * stats);
+
+/**
+ * Reset the counters of the adaptive frame pacing
+ * @param disp      pointer to a display (NULL to use the default display)
+ */
+void lv_display_reset_frame_pacing_stats(lv_display_t * disp);
+
 /**
  * Set the color format of the display.
  * @param disp              pointer to a display
@@ -102,6 +102,9 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** Spatial index of `draw_task_head` to speed up the dependency checks. Managed internally. */
+    lv_draw_task_index_t * task_index;
+
     /** Parent layer */
     lv_layer_t * parent;
 
@@ -146,6 +149,11 @@ struct _lv_layer_t  {
 
     /** Opacity of the layer */
     lv_opa_t opa;
+
+#if LV_USE_OBJ_RETAINED_DRAW
+    /** If set, the new draw tasks are recorded here too. Managed internally. */
+    lv_draw_recording_t * recording;
+#endif
 };
 
 typedef struct {
@@ -191,6 +199,17 @@ typedef struct {
     void * user_data;
 } lv_draw_dsc_base_t;
 
+typedef struct {
+    /**Number of draw tasks allocated from the heap*/
+    uint32_t alloc_cnt;
+
+    /**Number of draw tasks reused from the pool. Each saved an `lv_malloc` and an `lv_free` call.*/
+    uint32_t reuse_cnt;
+
+    /**Number of finished draw tasks currently kept in the pool*/
+    uint32_t cached_cnt;
+} lv_draw_task_pool_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -267,6 +286,24 @@ void lv_draw_dispatch_request(void);
   */
 uint32_t lv_draw_get_unit_count(void);
 
+/**
+ * Get the statistics of the draw task pool. All the counters are 0 if
+ * `LV_USE_DRAW_TASK_POOL` is disabled.
+ * @param stats     store the statistics here
+ */
+void lv_draw_task_pool_get_stats(lv_draw_task_pool_stats_t * stats);
+
+/**
+ * Reset the allocation and reuse counters of the draw task pool
+ */
+void lv_draw_task_pool_reset_stats(void);
+
+/**
+ * Free the finished draw tasks kept for reuse, e.g. when the memory is low. They are kept
+ * between the refreshes otherwise, and freed by `lv_deinit()`.
+ */
+void lv_draw_task_pool_flush(void);
+
 /**
  * If there is only one draw unit check the first draw task if it's available.
  * If there are multiple draw units call `lv_draw_get_next_available_task` to find a task.
@@ -237,6 +237,18 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 void lv_draw_unit_draw_letter(lv_draw_task_t * t, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                               const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb);
 
+#if LV_USE_DRAW_GLYPH_ATLAS
+
+/**
+ * Remove the glyphs of a font from the glyph atlas. Must be called before deleting a font
+ * whose glyphs might be in the atlas, as a new font could get the same address.
+ * The binary fonts are removed by `lv_binfont_destroy()`.
+ * @param font      pointer to a font, or NULL to remove all glyphs
+ */
+void lv_draw_glyph_atlas_drop(const lv_font_t * font);
+
+#endif /*LV_USE_DRAW_GLYPH_ATLAS*/
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
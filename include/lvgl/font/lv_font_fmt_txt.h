@@ -224,6 +224,17 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+
+/**
+ * Remove the cached glyph IDs and kerning values of a font.
+ * Needs to be called before freeing a font created at runtime.
+ * @param font      the font whose data is removed, or NULL to remove all
+ */
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font);
+
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
 /**********************
  *      MACROS
  **********************/
@@ -80,6 +80,11 @@ struct _lv_fs_drv_t {
     lv_fs_res_t (*write_cb)(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
     lv_fs_res_t (*seek_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+    lv_fs_res_t (*delete_cb)(lv_fs_drv_t * drv, const char * path); /*Optional*/
+
+    /*Optional. Return the address of the file's data at `offset` or NULL if it can't be mapped*/
+    const void * (*map_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t offset, uint32_t size);
+    void (*unmap_cb)(lv_fs_drv_t * drv, const void * data, uint32_t size); /*Optional*/
 
     void * (*dir_open_cb)(lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len);
@@ -101,6 +106,13 @@ typedef struct {
 } lv_fs_dir_t;
 
 
+/** A range of a file mapped to the memory by `lv_fs_map()` */
+typedef struct {
+    const void * data;  /**< Address of the first mapped byte*/
+    uint32_t size;      /**< Number of mapped bytes*/
+    lv_fs_drv_t * drv;
+} lv_fs_map_t;
+
 /** Extended path object to specify buffer for memory-mapped files */
 typedef struct {
     char path[64];   /**<  Store the driver letter address and size*/
@@ -267,6 +279,33 @@ lv_fs_res_t lv_fs_load_to_buf(void * buf, uint32_t buf_size, const char * path);
  */
 void * lv_fs_load_with_alloc(const char * path, uint32_t * size);
 
+/**
+ * Map a range of a file to the memory to read it in place, without copying.
+ * The mapping stays valid after the file is closed, until `lv_fs_unmap()` is called.
+ * The mapped data must not be written.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param offset    the first byte of the range
+ * @param size      the number of bytes to map
+ * @param map       pointer to a `lv_fs_map_t` variable to initialize
+ * @return          LV_FS_RES_OK, LV_FS_RES_NOT_IMP if the driver can't map files,
+ *                  or any error from `lv_fs_res_t`
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, uint32_t offset, uint32_t size, lv_fs_map_t * map);
+
+/**
+ * Release a range mapped by `lv_fs_map()`
+ * @param map       pointer to a mapped `lv_fs_map_t` variable
+ */
+void lv_fs_unmap(lv_fs_map_t * map);
+
+/**
+ * Delete a file
+ * @param path      path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @return          LV_FS_RES_OK, LV_FS_RES_NOT_IMP if the driver can't delete files,
+ *                  or any error from `lv_fs_res_t`
+ */
+lv_fs_res_t lv_fs_delete(const char * path);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
@@ -188,6 +188,69 @@ void lv_image_decoder_set_close_cb(lv_image_decoder_t * decoder, lv_image_decode
  */
 lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+/**
+ * Set how to draw the images which are not in the image cache yet.
+ * @param en        true: leave the image out and decode it in the background.
+ *                        The widget is invalidated when the image is decoded;
+ *                  false: wait for the image to be decoded while rendering (default)
+ */
+void lv_image_decoder_set_async(bool en);
+
+/**
+ * Get if the images which are not cached yet are decoded in the background
+ * @return          true: the images are decoded in the background
+ */
+bool lv_image_decoder_get_async(void);
+
+/**
+ * Set the rectangle drawn instead of the images which are decoded in the background
+ * @param color     color of the placeholder
+ * @param opa       opacity of the placeholder, `LV_OPA_TRANSP` to draw nothing.
+ *                  (default: light gray with `LV_OPA_30`)
+ */
+void lv_image_decoder_set_async_placeholder(lv_color_t color, lv_opa_t opa);
+
+/**
+ * Decode an image to the image cache in the background, e.g. before loading a screen
+ * which uses it. The image cache needs to be enabled and large enough to keep the image.
+ * @param src       the image source, a file path or an `lv_image_dsc_t` variable.
+ *                  A copy of the file path is stored.
+ * @return          LV_RESULT_OK: the image is queued or already cached;
+ *                  LV_RESULT_INVALID: the image cache is disabled or the image can't be opened
+ */
+lv_result_t lv_image_prefetch(const void * src);
+
+/**
+ * Check if an image is still waiting to be decoded in the background
+ * @param src       the image source
+ * @return          true: the image is queued or being decoded
+ */
+bool lv_image_prefetch_is_pending(const void * src);
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
+#if LV_USE_IMAGE_DISK_CACHE
+
+/**
+ * Set the directory where the decoded images are stored, e.g. "A:/var/cache/images".
+ * The images stored there in earlier runs are used if their source files didn't change.
+ * @param path      path to an existing directory. NULL to disable the disk cache.
+ * @return          LV_RESULT_OK: the disk cache is enabled or disabled;
+ *                  LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_image_decoder_set_disk_cache_path(const char * path);
+
+/**
+ * Delete a stored image from the disk cache, e.g. if its source file changed in a way
+ * which is not detected
+ * @param src       path of the source file, or NULL to delete all images
+ */
+void lv_image_decoder_disk_cache_drop(const char * src);
+
+#endif /*LV_USE_IMAGE_DISK_CACHE*/
+
 /**********************
  *      MACROS
  **********************/
@@ -175,6 +175,25 @@
  */
 #define LV_DRAW_LAYER_MAX_MEMORY 0
 
+/** Keep the finished draw tasks in lists by size and reuse them for the new draw tasks
+ *  instead of freeing and allocating them again. The lists are protected by a mutex as the
+ *  draw threads free the tasks too. They are kept between the refreshes and freed by
+ *  `lv_draw_task_pool_flush()`, when an allocation fails and by `lv_deinit()`. */
+#define LV_USE_DRAW_TASK_POOL 0
+
+/** Keep the A8 bitmaps of the glyphs of the LVGL format fonts (the built-in and the loaded
+ *  binary fonts) in atlas pages, so the compressed and the 1-4 bpp glyphs are not decompressed
+ *  again at every refresh. Used by the SW and NanoVG renderers. */
+#define LV_USE_DRAW_GLYPH_ATLAS 0
+#if LV_USE_DRAW_GLYPH_ATLAS
+    /** Width and height of an atlas page [px]. A page takes this value squared in RAM.
+     *  Larger glyphs are not stored. */
+    #define LV_DRAW_GLYPH_ATLAS_PAGE_SIZE 256
+
+    /** Number of atlas pages. When all are full, the least recently used page is cleared. */
+    #define LV_DRAW_GLYPH_ATLAS_PAGE_CNT 4
+#endif
+
 #if LV_USE_OS != LV_OS_NONE
 /** If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more. */
 #define LV_DRAW_THREAD_STACK_SIZE 8192
@@ -260,6 +279,11 @@
 /** Number of threads used to render a frame in parallel */
 #define LV_DRAW_SW_DRAW_UNIT_CNT 1
 
+/** If there are more draw units, draw tasks covering at least this many pixels are
+ *  split into horizontal bands which the idle render threads can steal.
+ *  0: never split the draw tasks */
+#define LV_DRAW_SW_SPLIT_MIN_SIZE 16384
+
 #endif /*LV_USE_OS != LV_OS_NONE*/
 
 /** Requires the Arm-2D library in your project and an include path for "arm_2d.h". */
@@ -281,10 +305,15 @@
 
 #if LV_DRAW_SW_COMPLEX
 /** Maximum shadow size to buffer, where shadow size is `shadow_width + radius`.
- *  Costs this value squared in RAM; 0 disables caching.
+ *  Each cached shadow costs its size squared in RAM; 0 disables caching.
  */
 #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
+/** The blurred corners of this many different shadows are kept. Shadows with
+ *  the same width, radius and spread share a corner on every draw thread.
+ */
+#define LV_DRAW_SW_SHADOW_CACHE_CNT 4
+
 /** The circumference of a 1/4 circle is cached for anti-aliasing, costing
  *  radius * 4 bytes per circle. Set to 0 to disable caching.
  */
@@ -292,12 +321,19 @@
 
 #endif /*LV_DRAW_SW_COMPLEX*/
 
+/** Keep the result of the recent blurs and reuse them when the same pixels are blurred again
+ *  with the same parameters, e.g. the backdrop of a blurred widget which doesn't change.
+ *  Size of the cache in bytes; 0 disables caching.
+ */
+#define LV_DRAW_SW_BLUR_CACHE_SIZE 0
+
 /** SW assembly optimization
  *  Possible values:
  *  - LV_DRAW_SW_ASM_NONE
  *  - LV_DRAW_SW_ASM_NEON
  *  - LV_DRAW_SW_ASM_HELIUM
  *  - LV_DRAW_SW_ASM_RISCV_V: RISC-V Vector
+ *  - LV_DRAW_SW_ASM_X86: x86 SSE4.1 and AVX2, selected at runtime (GCC or Clang)
  *  - LV_DRAW_SW_ASM_CUSTOM
  */
 #define LV_USE_DRAW_SW_ASM LV_DRAW_SW_ASM_NONE
@@ -307,6 +343,13 @@
 #define LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
 
 #endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM*/
+
+/** Blend with the vector extensions of GCC 9+ or Clang where `LV_USE_DRAW_SW_ASM` has no
+ *  accelerated function: color fills to ARGB8888, XRGB8888, RGB565, L8 and A8, and the normal
+ *  blending of ARGB8888 images to 32 bit and RGB565 layers and of RGB565 images to RGB565.
+ *  Sample the anti-aliased rotated and scaled images and blur the 32 bit layers with them too.
+ *  They are compiled to the SIMD instructions of any target. */
+#define LV_USE_DRAW_SW_SIMD 0
 #endif /*LV_USE_DRAW_SW*/
 
 /** Renders with a VG-Lite GPU. Requires a VG-Lite driver, or the VG-Lite simulator below.
@@ -680,6 +723,24 @@
 /** Speed up style property lookups by adding 2 x 32 bit variables to each lv_obj_t. */
 #define LV_OBJ_STYLE_CACHE 0
 
+/** Keep the properties of the styles sorted and add a bit for each property to lv_style_t
+ *  to tell if the style has it. It makes getting style properties faster, but
+ *  adds 24 bytes to each lv_style_t: a bit for each built-in property and one for the
+ *  custom properties, rounded up to 32 bit words. */
+#define LV_STYLE_SORTED_PROPS 0
+
+/** Remember the resolved values of the most often drawn style properties
+ *  for the last few parts and states of each widget. It makes redrawing
+ *  faster. Only the properties set in the styles take memory: each drawn widget allocates up
+ *  to 112 bytes, plus 8 bytes for each such property in each of the up to 4 cached parts and
+ *  states (72 + 4 bytes on 32-bit systems). */
+#define LV_OBJ_STYLE_RESOLVED_CACHE 0
+
+/** Allow recording the draw tasks of selected widgets with lv_obj_set_draw_retained()
+ *  and adding them again, translated if needed, instead of redrawing the widgets
+ *  until they are invalidated. */
+#define LV_USE_OBJ_RETAINED_DRAW 0
+
 /** Widget names (lv_obj_set_name) */
 #define LV_USE_OBJ_NAME 0
 
@@ -843,6 +904,63 @@
  */
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/** Split the image cache and the image header cache into independent shards, each with
+ *  its own lock, to reduce the lock contention of multiple draw threads.
+ *  The shards share `LV_CACHE_DEF_SIZE`, only adding an image locks all of them. */
+#define LV_IMAGE_CACHE_SHARD_CNT 1
+
+/** Use the scan resistant and cost aware 2Q cache class for the image cache instead of LRU.
+ *  Images used only once (e.g. scrolled past) are evicted before the repeatedly used ones,
+ *  and of the oldest images the cheaper ones to decode are evicted first. */
+#define LV_USE_IMAGE_CACHE_2Q 0
+
+/** Also cache a copy of the images converted to the color format of the layer they are
+ *  drawn to (RGB565, RGB888 or XRGB8888), so the software renderer can copy them
+ *  as they are instead of converting each pixel in each frame. Costs the RAM of the copies. */
+#define LV_USE_IMAGE_CACHE_CONVERT 0
+#if LV_USE_IMAGE_CACHE_CONVERT
+    /** Use ordered dithering when converting to RGB565 to hide the banding of gradients. */
+    #define LV_IMAGE_CACHE_CONVERT_DITHER 0
+#endif
+
+/** Decode the large images only in the areas being drawn and cache them in tiles, instead of
+ *  decoding and caching the whole image. Used by the libpng (for not interlaced images),
+ *  libjpeg-turbo and libwebp decoders. Such images are drawn in tiles only by the software
+ *  renderer; rotated or scaled ones are decoded fully. */
+#define LV_USE_IMAGE_DECODER_ROI 0
+#if LV_USE_IMAGE_DECODER_ROI
+    /** Decode only the drawn areas of the images at least this large when decoded [bytes] */
+    #define LV_IMAGE_DECODER_ROI_MIN_SIZE (1024 * 1024)
+
+    /** Width and height of the tiles stored in the image cache [px] */
+    #define LV_IMAGE_DECODER_ROI_TILE_SIZE 64
+
+    /** Number of images kept opened (e.g. with the file and the decoder's state) to decode
+     *  their missing tiles in the next draws. 0: open them again for each draw. */
+    #define LV_IMAGE_DECODER_ROI_OPENED_CNT 4
+#endif
+
+/** Decode images to the image cache in the background. Enables `lv_image_prefetch()`, and
+ *  `lv_image_decoder_set_async()` to leave out the images until they are decoded.
+ *  Requires the image cache.
+ *  - With an OS a worker thread decodes the images,
+ *  - without an OS a timer decodes one image at a time between the refreshes. */
+#define LV_USE_IMAGE_DECODER_ASYNC 0
+
+/** Store the images which are slow to decode in a directory set by
+ *  `lv_image_decoder_set_disk_cache_path()` and load them from there, even after a restart,
+ *  instead of decoding them again. The images are stored as decoded, so they are mapped from
+ *  the disk if the file system driver supports it. */
+#define LV_USE_IMAGE_DISK_CACHE 0
+#if LV_USE_IMAGE_DISK_CACHE
+    /** Delete the least recently used images to keep the stored images below this size [bytes] */
+    #define LV_IMAGE_DISK_CACHE_MAX_SIZE (8 * 1024 * 1024)
+
+    /** Store only the images which took at least this long to decode [ms].
+     *  Reading an image from the disk takes time too, so store only the images which are clearly slower to decode. */
+    #define LV_IMAGE_DISK_CACHE_MIN_TIME 50
+#endif
+
 /** Decoder for LVGL's run-length encoded binary image format. */
 #define LV_USE_RLE 0
 
@@ -1104,6 +1222,17 @@
 /** Compressed fonts */
 #define LV_USE_FONT_COMPRESSED 0
 
+/** Cache the glyph IDs of the sparse character maps and the kerning pairs of the
+ *  built-in fonts, so looking them up again (e.g. for CJK text) takes constant time.
+ *  Requires `LV_USE_OS == LV_OS_NONE`: the table is shared by all the threads, and
+ *  locking it on every lookup would cost about as much as the search itself. */
+#define LV_USE_FONT_FMT_TXT_CACHE 0
+
+#if LV_USE_FONT_FMT_TXT_CACHE
+    /** Number of cached glyph IDs and kerning values. Must be a power of 2. */
+    #define LV_FONT_FMT_TXT_CACHE_SIZE 256
+#endif
+
 /** Draw a placeholder rectangle instead of nothing when a glyph is missing
  *  from the font.
  */
@@ -495,32 +495,64 @@ class LVGLCompressData:
     def __init__(self,
                  cf: ColorFormat,
                  method: CompressMethod,
-                 raw_data: bytes = b''):
+                 raw_data: bytes = b'',
+                 stride: int = 0,
+                 block_rows: int = 0):
+        '''
+        block_rows: compress every `block_rows * stride` bytes independently so
+        that the areas of the image can be decompressed separately. 0 to
+        compress the whole image at once.
+        '''
+        if block_rows < 0 or block_rows > 0xFFFF:
+            raise ParameterError(f"Invalid block rows: {block_rows}")
+        if block_rows and stride == 0:
+            raise ParameterError("Stride is required to compress in blocks")
+
         self.blk_size = (cf.bpp + 7) // 8
         self.compress = method
+        self.block_rows = block_rows
+        self.block_len = block_rows * stride
         self.raw_data = raw_data
         self.raw_data_len = len(raw_data)
         self.compressed = self._compress(raw_data)
 
-    def _compress(self, raw_data: bytes) -> bytearray:
-        if self.compress == CompressMethod.NONE:
-            return raw_data
-
+    def _compress_block(self, raw_data: bytes) -> bytes:
         if self.compress == CompressMethod.RLE:
             # RLE compression performs on pixel unit, pad data to pixel unit
             pad = b'\x00' * 0
-            if self.raw_data_len % self.blk_size:
-                pad = b'\x00' * (self.blk_size - self.raw_data_len % self.blk_size)
-            compressed = RLEImage().rle_compress(raw_data + pad, self.blk_size)
+            if len(raw_data) % self.blk_size:
+                pad = b'\x00' * (self.blk_size - len(raw_data) % self.blk_size)
+            return RLEImage().rle_compress(raw_data + pad, self.blk_size)
         elif self.compress == CompressMethod.LZ4:
-            compressed = lz4.block.compress(raw_data, store_size=False)
+            return lz4.block.compress(raw_data, store_size=False)
         else:
             raise ParameterError(f"Invalid compress method: {self.compress}")
 
+    def _compress(self, raw_data: bytes) -> bytearray:
+        if self.compress == CompressMethod.NONE:
+            return raw_data
+
+        if self.block_rows == 0:
+            compressed = self._compress_block(raw_data)
+        else:
+            # The index of the blocks: the offset of each block and the end of
+            # the last block from the start of the index
+            blocks = [
+                self._compress_block(raw_data[i:i + self.block_len])
+                for i in range(0, self.raw_data_len, self.block_len)
+            ]
+            offset = (len(blocks) + 1) * 4
+            index = bytearray()
+            for block in blocks:
+                index += uint32_t(offset)
+                offset += len(block)
+            index += uint32_t(offset)
+            compressed = bytes(index) + b"".join(blocks)
+
         self.compressed_len = len(compressed)
 
         bin = bytearray()
-        bin += uint32_t(self.compress.value)
+        bin += uint32_t(self.compress.value | (self.block_rows << 4))
         bin += uint32_t(self.compressed_len)
         bin += uint32_t(self.raw_data_len)
         bin += compressed
@@ -786,7 +818,8 @@ class LVGLImage:
 
     def to_bin(self,
                filename: str,
-               compress: CompressMethod = CompressMethod.NONE):
+               compress: CompressMethod = CompressMethod.NONE,
+               compress_block_rows: int = 0):
         """
         Write this image to file, filename should be ended with '.bin'
         """
@@ -805,7 +838,8 @@ class LVGLImage:
                                      self.stride,
                                      flags=flags)
             bin += header.binary
-            compressed = LVGLCompressData(self.cf, compress, self.data)
+            compressed = LVGLCompressData(self.cf, compress, self.data,
+                                          self.stride, compress_block_rows)
             bin += compressed.compressed
 
             f.write(bin)
@@ -815,12 +849,14 @@ class LVGLImage:
     def to_c_array(self,
                    filename: str,
                    compress: CompressMethod = CompressMethod.NONE,
-                   outputname: str = None):
+                   outputname: str = None,
+                   compress_block_rows: int = 0):
         self._check_ext(filename, ".c")
         self._check_dir(filename)
 
         if compress != CompressMethod.NONE:
-            data = LVGLCompressData(self.cf, compress, self.data).compressed
+            data = LVGLCompressData(self.cf, compress, self.data, self.stride,
+                                    compress_block_rows).compressed
         else:
             data = self.data
         write_c_array_file(self.w, self.h, self.stride, self.cf, filename, outputname,
@@ -1362,6 +1398,7 @@ class PNGConverter:
                  align: int = 1,
                  premultiply: bool = False,
                  compress: CompressMethod = CompressMethod.NONE,
+                 compress_block_rows: int = 0,
                  keep_folder=True,
                  rgb565_dither=False,
                  nema_gfx=False) -> None:
@@ -1374,6 +1411,7 @@ class PNGConverter:
         self.align = align
         self.premultiply = premultiply
         self.compress = compress
+        self.compress_block_rows = compress_block_rows
         self.background = background
         self.rgb565_dither = rgb565_dither
         self.nema_gfx = nema_gfx
@@ -1411,11 +1449,13 @@ class PNGConverter:
                 output.append((f, img))
                 if self.ofmt == OutputFormat.BIN_FILE:
                     img.to_bin(self._replace_ext(f, ".bin"),
-                               compress=self.compress)
+                               compress=self.compress,
+                               compress_block_rows=self.compress_block_rows)
                 elif self.ofmt == OutputFormat.C_ARRAY:
                     img.to_c_array(self._replace_ext(f, ".c", outputname),
                                    compress=self.compress,
-                                   outputname=outputname)
+                                   outputname=outputname,
+                                   compress_block_rows=self.compress_block_rows)
                 elif self.ofmt == OutputFormat.PNG_FILE:
                     img.to_png(self._replace_ext(f, ".png"))
 
@@ -1450,6 +1490,14 @@ def main():
                         default="NONE",
                         choices=["NONE", "RLE", "LZ4"])
 
+    parser.add_argument('--compress-block-rows',
+                        help=("compress every N rows independently so that only the "
+                              "drawn areas need to be decompressed, default to 0 "
+                              "to compress the whole image at once"),
+                        default=0,
+                        type=int,
+                        metavar='rows')
+
     parser.add_argument('--align',
                         help="stride alignment in bytes for bin image",
                         default=1,
@@ -1509,6 +1557,7 @@ def main():
                              align=args.align,
                              premultiply=args.premultiply,
                              compress=compress,
+                             compress_block_rows=args.compress_block_rows,
                              keep_folder=False,
                              rgb565_dither=args.rgb565dither,
                              nema_gfx=args.nemagfx)
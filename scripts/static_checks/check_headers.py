@@ -177,6 +177,7 @@ ALLOWED_EXTERNAL_HEADERS: set[str] = {
     "hal/color_hal.h",
     "hal_data.h",
     "include/lv_mp_mem_custom_include.h",
+    "immintrin.h",
     "intrin.h",
     "jpeglib.h",
     "lfs.h",
@@ -30,12 +30,18 @@ extern "C" {
 #include "../tick/lv_tick_private.h"
 #include "../draw/lv_draw_buf_private.h"
 #include "../draw/lv_draw_private.h"
+#include "../draw/lv_draw_label_private.h"
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
 #include "../debugging/sysmon/lv_sysmon_private.h"
 #include "../debugging/test/lv_test_private.h"
 #include "../layouts/lv_layout_private.h"
+#include "../image/lv_image_decoder_private.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+#include "../draw/sw/blend/x86/lv_blend_x86.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -80,6 +86,9 @@ typedef struct _lv_global_t {
 
     lv_ll_t style_trans_ll;
     bool style_refresh;
+#if LV_USE_OBJ_RETAINED_DRAW
+    uint32_t obj_draw_retained_cnt;     /**< Number of widgets with retained drawing*/
+#endif
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
@@ -118,15 +127,33 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_cache_t * img_opened_cache;
+#endif
+#if LV_USE_IMAGE_DECODER_ASYNC
+    lv_image_decoder_async_t img_decoder_async;
+#endif
+#if LV_USE_IMAGE_DISK_CACHE
+    lv_image_disk_cache_t img_disk_cache;
+#endif
 
     lv_draw_global_info_t draw_info;
+#if LV_USE_DRAW_GLYPH_ATLAS
+    lv_draw_glyph_atlas_t glyph_atlas;
+#endif
     lv_ll_t draw_sw_blend_handler_ll;
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    lv_draw_sw_blend_x86_level_t draw_sw_blend_x86_level;
+#endif
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    lv_draw_sw_shadow_cache_t sw_shadow_cache;
+    lv_cache_t * sw_shadow_cache;
 #endif
 #if LV_DRAW_SW_COMPLEX
     lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
 #endif
+#if defined(LV_DRAW_SW_BLUR_CACHE_SIZE) && LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    lv_cache_t * sw_blur_cache;
+#endif
 
 #if LV_USE_LOG
     lv_log_print_g_cb_t custom_log_print_cb;
@@ -196,6 +223,10 @@ typedef struct _lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+    lv_font_fmt_txt_cache_t font_fmt_txt_cache;
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
@@ -1374,6 +1374,10 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         }
 #endif
 
+#if LV_USE_OBJ_RETAINED_DRAW
+        lv_obj_set_draw_retained(obj, false);
+#endif
+
 #if LV_DRAW_TRANSFORM_USE_MATRIX
         if(obj->spec_attr->matrix) {
             lv_free(obj->spec_attr->matrix);
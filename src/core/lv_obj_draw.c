@@ -9,11 +9,14 @@
 #include "lv_obj_draw_private.h"
 #include "../lvgl_public.h"
 #include "lv_obj_private.h"
+#include "lv_global.h"
+#include "../draw/lv_draw_private.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS (&lv_obj_class)
+#define obj_draw_retained_cnt LV_GLOBAL_DEFAULT()->obj_draw_retained_cnt
 
 /**********************
  *      TYPEDEFS
@@ -464,6 +467,57 @@ lv_layer_type_t lv_obj_get_layer_type(const lv_obj_t * obj)
     else return LV_LAYER_TYPE_NONE;
 }
 
+#if LV_USE_OBJ_RETAINED_DRAW
+
+void lv_obj_set_draw_retained(lv_obj_t * obj, bool en)
+{
+    LV_CHECK_OBJ(obj, MY_CLASS, return);
+
+    if(en == lv_obj_get_draw_retained(obj)) return;
+
+    if(en) {
+        if(!lv_obj_allocate_spec_attr(obj)) return;
+        lv_draw_recording_t * rec = lv_malloc(sizeof(lv_draw_recording_t));
+        LV_ASSERT_MALLOC(rec);
+        if(rec == NULL) return;
+
+        lv_draw_recording_init(rec);
+        obj->spec_attr->draw_recording = rec;
+        obj_draw_retained_cnt++;
+    }
+    else {
+        lv_draw_recording_deinit(obj->spec_attr->draw_recording);
+        lv_free(obj->spec_attr->draw_recording);
+        obj->spec_attr->draw_recording = NULL;
+        obj_draw_retained_cnt--;
+    }
+}
+
+bool lv_obj_get_draw_retained(const lv_obj_t * obj)
+{
+    LV_CHECK_OBJ(obj, MY_CLASS, return false);
+
+    return obj->spec_attr && obj->spec_attr->draw_recording;
+}
+
+void lv_obj_draw_retained_drop(lv_obj_t * obj, bool children)
+{
+    /*Most of the time no widgets are retained, so return quickly*/
+    if(obj_draw_retained_cnt == 0) return;
+    if(obj->spec_attr == NULL) return;
+
+    if(obj->spec_attr->draw_recording) lv_draw_recording_reset(obj->spec_attr->draw_recording);
+
+    if(children) {
+        uint32_t i;
+        for(i = 0; i < obj->spec_attr->child_cnt; i++) {
+            lv_obj_draw_retained_drop(obj->spec_attr->children[i], true);
+        }
+    }
+}
+
+#endif /*LV_USE_OBJ_RETAINED_DRAW*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -37,6 +37,16 @@ int32_t lv_obj_get_ext_draw_size(const lv_obj_t * obj);
 
 lv_layer_type_t lv_obj_get_layer_type(const lv_obj_t * obj);
 
+#if LV_USE_OBJ_RETAINED_DRAW
+/**
+ * Drop the saved draw tasks of a widget with retained drawing, so it will be drawn
+ * normally on the next refresh.
+ * @param obj       pointer to an object
+ * @param children  true: drop the saved draw tasks of all the descendants too
+ */
+void lv_obj_draw_retained_drop(lv_obj_t * obj, bool children);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -1069,6 +1069,11 @@ lv_result_t lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     LV_CHECK_ARG(area != NULL, return LV_RESULT_INVALID);
     LV_CHECK_OBJ(obj, MY_CLASS, return LV_RESULT_INVALID);
 
+#if LV_USE_OBJ_RETAINED_DRAW
+    /*The content of the widget has changed so its saved draw tasks can't be used anymore*/
+    lv_obj_draw_retained_drop((lv_obj_t *)obj, false);
+#endif
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return LV_RESULT_INVALID;
 
@@ -1083,6 +1088,10 @@ lv_result_t lv_obj_invalidate(const lv_obj_t * obj)
 {
     LV_CHECK_OBJ(obj, MY_CLASS, return LV_RESULT_INVALID);
 
+#if LV_USE_OBJ_RETAINED_DRAW
+    lv_obj_draw_retained_drop((lv_obj_t *)obj, false);
+#endif
+
     lv_display_t * disp = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return LV_RESULT_INVALID;
 
@@ -1640,8 +1649,6 @@ static lv_result_t invalidate_area_core(const lv_obj_t * obj, lv_area_t * area_t
 
 static bool has_blur(const lv_obj_t * obj)
 {
-    const uint32_t group_blur = (uint32_t)1 << lv_style_get_prop_group(LV_STYLE_BLUR_RADIUS);
-    const uint32_t group_dropshadow = (uint32_t)1 << lv_style_get_prop_group(LV_STYLE_DROP_SHADOW_OPA);
     const lv_state_t state = lv_obj_style_get_selector_state(lv_obj_get_state(obj));
     const lv_state_t state_inv = ~state;
     lv_style_value_t v;
@@ -1653,11 +1660,11 @@ static bool has_blur(const lv_obj_t * obj)
         lv_state_t state_style = lv_obj_style_get_selector_state(obj->styles[i].selector);
         if((state_style & state_inv)) continue;
 
-        if((obj_style->style->has_group & group_blur) &&
+        if(lv_style_may_have_prop(obj_style->style, LV_STYLE_BLUR_RADIUS) &&
            lv_style_get_prop(obj_style->style, LV_STYLE_BLUR_RADIUS, &v)) {
             if(v.num > 0) return true;
         }
-        if((obj_style->style->has_group & group_dropshadow) &&
+        if(lv_style_may_have_prop(obj_style->style, LV_STYLE_DROP_SHADOW_OPA) &&
            lv_style_get_prop(obj_style->style, LV_STYLE_DROP_SHADOW_OPA, &v)) {
             if(v.num > 0) return true;
         }
@@ -38,6 +38,9 @@ typedef struct _lv_obj_spec_attr_t {
     lv_event_list_t event_list;
 #if LV_USE_OBJ_NAME
     const char * name;              /**< Pointer to the name */
+#endif
+#if LV_USE_OBJ_RETAINED_DRAW
+    lv_draw_recording_t * draw_recording;   /**< The recorded draw tasks if retained drawing is enabled*/
 #endif
     lv_point_t scroll;              /**< The current X/Y scroll offset*/
 
@@ -66,6 +69,9 @@ struct _lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    struct _lv_obj_style_resolved_t * style_resolved;   /**< Allocated on the first style lookup */
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -11,6 +11,7 @@
 #include "../misc/lv_anim_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_draw_private.h"
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
 #include "lv_observer_private.h"
@@ -72,6 +73,13 @@ static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
 static void remove_style_core(lv_obj_t * obj, const lv_style_t * style, lv_style_selector_t selector, bool theme_only);
+static lv_style_res_t get_prop_resolved(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                        lv_style_value_t * v);
+static void resolved_cache_invalidate(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    static uint32_t resolved_value_index(uint32_t is_found, uint32_t bit);
+    static void resolved_entry_drop_values(lv_obj_style_resolved_entry_t * entry, uint32_t drop_mask);
+#endif
 #if LV_USE_OBSERVER
     static void bind_style_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
     static void bind_style_prop_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
@@ -80,6 +88,43 @@ static void remove_style_core(lv_obj_t * obj, const lv_style_t * style, lv_style
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/*Index + 1 of the properties in `lv_obj_style_resolved_entry_t::values`. 0: not cached*/
+static const uint8_t resolved_prop_slots[LV_STYLE_NUM_BUILT_IN_PROPS] = {
+    [LV_STYLE_RADIUS] = 1,
+    [LV_STYLE_OPA] = 2,
+    [LV_STYLE_RECOLOR_OPA] = 3,
+    [LV_STYLE_COLOR_FILTER_DSC] = 4,
+    [LV_STYLE_COLOR_FILTER_OPA] = 5,
+    [LV_STYLE_BLEND_MODE] = 6,
+    [LV_STYLE_BG_OPA] = 7,
+    [LV_STYLE_BG_COLOR] = 8,
+    [LV_STYLE_BG_GRAD_DIR] = 9,
+    [LV_STYLE_BG_GRAD] = 10,
+    [LV_STYLE_BG_IMAGE_SRC] = 11,
+    [LV_STYLE_BORDER_WIDTH] = 12,
+    [LV_STYLE_BORDER_OPA] = 13,
+    [LV_STYLE_BORDER_COLOR] = 14,
+    [LV_STYLE_BORDER_SIDE] = 15,
+    [LV_STYLE_OUTLINE_WIDTH] = 16,
+    [LV_STYLE_OUTLINE_OPA] = 17,
+    [LV_STYLE_SHADOW_WIDTH] = 18,
+    [LV_STYLE_SHADOW_OPA] = 19,
+    [LV_STYLE_TEXT_COLOR] = 20,
+    [LV_STYLE_TEXT_OPA] = 21,
+    [LV_STYLE_TEXT_FONT] = 22,
+    [LV_STYLE_TEXT_LETTER_SPACE] = 23,
+    [LV_STYLE_TEXT_LINE_SPACE] = 24,
+    [LV_STYLE_TEXT_ALIGN] = 25,
+    [LV_STYLE_TEXT_DECOR] = 26,
+    [LV_STYLE_PAD_TOP] = 27,
+    [LV_STYLE_PAD_BOTTOM] = 28,
+    [LV_STYLE_PAD_LEFT] = 29,
+    [LV_STYLE_PAD_RIGHT] = 30,
+    [LV_STYLE_TRANSFORM_WIDTH] = 31,
+    [LV_STYLE_TRANSFORM_HEIGHT] = 32,
+};
+#endif
 
 /**********************
  *      MACROS
@@ -249,6 +294,14 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
     LV_CHECK_OBJ(obj, MY_CLASS, return);
 
+    /*Drop the cached values even if the refresh is postponed*/
+    resolved_cache_invalidate(obj, lv_obj_style_get_selector_part(part), prop);
+
+#if LV_USE_OBJ_RETAINED_DRAW
+    /*Inherited properties and the layer's opacity and recolor of the main part affect the descendants too*/
+    lv_obj_draw_retained_drop(obj, part == LV_PART_ANY || part == LV_PART_MAIN);
+#endif
+
     if(!style_refr) return;
 
     LV_PROFILER_STYLE_BEGIN;
@@ -913,8 +966,6 @@ static lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t sel
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                     lv_style_value_t * v)
 {
-
-    const uint32_t group = (uint32_t)1 << lv_style_get_prop_group(prop);
     const lv_part_t part = lv_obj_style_get_selector_part(selector);
     const lv_state_t state = lv_obj_style_get_selector_state(selector);
     const lv_state_t state_inv = ~state;
@@ -931,7 +982,7 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t se
         lv_part_t part_act = lv_obj_style_get_selector_part(obj->styles[i].selector);
 
         if(part_act != part) continue;
-        if((obj_style->style->has_group & group) == 0) continue;
+        if(!lv_style_may_have_prop(obj_style->style, prop)) continue;
         found = lv_style_get_prop_inlined(obj_style->style, prop, v);
         if(found == LV_STYLE_RES_FOUND) {
             return LV_STYLE_RES_FOUND;
@@ -939,7 +990,7 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t se
     }
 
     for(; i < obj->style_cnt; i++) {
-        if((obj->styles[i].style->has_group & group) == 0) continue;
+        if(!lv_style_may_have_prop(obj->styles[i].style, prop)) continue;
         if(obj->styles[i].is_disabled) continue;
         lv_obj_style_t * obj_style = &obj->styles[i];
         lv_part_t part_act = lv_obj_style_get_selector_part(obj->styles[i].selector);
@@ -1037,6 +1088,7 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
                     lv_style_remove_prop((lv_style_t *)obj->styles[i].style, tr->prop);
                 }
             }
+            resolved_cache_invalidate(obj, part, tr->prop);
 
             /*Free the transition descriptor too*/
             lv_anim_delete(tr, NULL);
@@ -1165,6 +1217,7 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                resolved_cache_invalidate(obj, lv_obj_style_get_selector_part(obj_style->selector), prop);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1194,6 +1247,8 @@ static lv_layer_type_t calculate_layer_type(lv_obj_t * obj)
 
 static void full_cache_refresh(lv_obj_t * obj, lv_part_t part)
 {
+    resolved_cache_invalidate(obj, part, LV_STYLE_PROP_ANY);
+
 #if LV_OBJ_STYLE_CACHE
     uint32_t i;
     if(part == LV_PART_MAIN || part == LV_PART_ANY) {
@@ -1290,7 +1345,7 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
     if((part == LV_PART_MAIN ? obj->style_main_prop_is_set : obj->style_other_prop_is_set) & prop_shifted)
 #endif
     {
-        found = get_prop_core(obj, selector, prop, value_act);
+        found = get_prop_resolved(obj, selector, prop, value_act);
         if(found == LV_STYLE_RES_FOUND) return LV_STYLE_RES_FOUND;
     }
 
@@ -1317,7 +1372,7 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 #endif
             {
                 selector = part | obj->state;
-                found = get_prop_core(obj, selector, prop, value_act);
+                found = get_prop_resolved(obj, selector, prop, value_act);
                 if(found == LV_STYLE_RES_FOUND) return LV_STYLE_RES_FOUND;
             }
             /*Check the parent too.*/
@@ -1407,10 +1462,23 @@ static void remove_style_core(lv_obj_t * obj, const lv_style_t * style, lv_style
     obj->style_cnt = style_count;
     if(style_count > 0) {
         obj->styles = lv_realloc(obj->styles, style_count * sizeof(lv_obj_style_t));
+        resolved_cache_invalidate(obj, part, LV_STYLE_PROP_ANY);
     }
     else {
         lv_free(obj->styles);
         obj->styles = NULL;
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+        /*Nothing to cache without styles. It also frees the cache when the widget is deleted.*/
+        if(obj->style_resolved) {
+            uint32_t i;
+            for(i = 0; i < obj->style_resolved->entry_cnt; i++) {
+                lv_free(obj->style_resolved->entries[i].values);
+            }
+            lv_free(obj->style_resolved->entries);
+            lv_free(obj->style_resolved);
+            obj->style_resolved = NULL;
+        }
+#endif
     }
 
     if(prop != LV_STYLE_PROP_INV) {
@@ -1419,7 +1487,167 @@ static void remove_style_core(lv_obj_t * obj, const lv_style_t * style, lv_style
     }
 }
 
+/**
+ * Get a property from the styles of a widget like `get_prop_core` but use
+ * and update the resolved style cache of the widget
+ * @param obj       pointer to a widget
+ * @param selector  OR-ed part and state
+ * @param prop      the property to get
+ * @param v         store the value here if found
+ * @return          LV_STYLE_RES_FOUND: a style of the widget has the property
+ */
+static lv_style_res_t get_prop_resolved(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                        lv_style_value_t * v)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*The transitions are skipped only temporarily so don't cache the result*/
+    if(prop >= LV_STYLE_NUM_BUILT_IN_PROPS || resolved_prop_slots[prop] == 0 ||
+       obj->style_cnt == 0 || obj->skip_trans) {
+        return get_prop_core(obj, selector, prop, v);
+    }
+
+    lv_obj_t * obj_mut = (lv_obj_t *)obj;
+    lv_obj_style_resolved_t * cache = obj_mut->style_resolved;
+    if(cache == NULL) {
+        cache = lv_malloc_zeroed(sizeof(lv_obj_style_resolved_t));
+        if(cache == NULL) return get_prop_core(obj, selector, prop, v);
+        obj_mut->style_resolved = cache;
+    }
+
+    lv_obj_style_resolved_entry_t * entry = NULL;
+    uint32_t i;
+    for(i = 0; i < cache->entry_cnt; i++) {
+        if(cache->entries[i].selector == selector) {
+            entry = &cache->entries[i];
+            break;
+        }
+    }
+
+    if(entry == NULL) {
+        if(cache->entry_cnt < LV_OBJ_STYLE_RESOLVED_ENTRY_CNT) {
+            lv_obj_style_resolved_entry_t * entries = lv_realloc(cache->entries,
+                                                                 (cache->entry_cnt + 1) * sizeof(lv_obj_style_resolved_entry_t));
+            if(entries == NULL) return get_prop_core(obj, selector, prop, v);
+            cache->entries = entries;
+            entry = &cache->entries[cache->entry_cnt];
+            entry->values = NULL;
+            cache->entry_cnt++;
+        }
+        else {
+            entry = &cache->entries[cache->entry_next];
+            cache->entry_next = (cache->entry_next + 1) % LV_OBJ_STYLE_RESOLVED_ENTRY_CNT;
+            lv_free(entry->values);
+            entry->values = NULL;
+        }
+        entry->selector = selector;
+        entry->is_valid = 0;
+        entry->is_found = 0;
+    }
+
+    uint32_t bit = (uint32_t)1 << (resolved_prop_slots[prop] - 1);
+    uint32_t index = resolved_value_index(entry->is_found, bit);
+    if(entry->is_valid & bit) {
+        if((entry->is_found & bit) == 0) return LV_STYLE_RES_NOT_FOUND;
+        *v = entry->values[index];
+        return LV_STYLE_RES_FOUND;
+    }
+
+    lv_style_res_t found = get_prop_core(obj, selector, prop, v);
+    if(found == LV_STYLE_RES_FOUND) {
+        /*Only the found values are stored to keep the cache small*/
+        uint32_t value_cnt = resolved_value_index(entry->is_found, 0);
+        lv_style_value_t * values = lv_realloc(entry->values, (value_cnt + 1) * sizeof(lv_style_value_t));
+        if(values == NULL) return found;
+        lv_memmove(&values[index + 1], &values[index], (value_cnt - index) * sizeof(lv_style_value_t));
+        values[index] = *v;
+        entry->values = values;
+        entry->is_found |= bit;
+    }
+    entry->is_valid |= bit;
+    return found;
+#else
+    return get_prop_core(obj, selector, prop, v);
+#endif
+}
+
+/**
+ * Drop the cached values of a property or all properties of a part
+ * @param obj   pointer to a widget
+ * @param part  the part which has changed or `LV_PART_ANY`
+ * @param prop  the property which has changed or `LV_STYLE_PROP_ANY`
+ */
+static void resolved_cache_invalidate(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    lv_obj_style_resolved_t * cache = obj->style_resolved;
+    if(cache == NULL) return;
+
+    uint32_t keep_mask = 0;
+    if(prop != LV_STYLE_PROP_ANY) {
+        if(prop >= LV_STYLE_NUM_BUILT_IN_PROPS || resolved_prop_slots[prop] == 0) return;
+        keep_mask = ~((uint32_t)1 << (resolved_prop_slots[prop] - 1));
+    }
+
+    uint32_t i;
+    for(i = 0; i < cache->entry_cnt; i++) {
+        lv_obj_style_resolved_entry_t * entry = &cache->entries[i];
+        if(part != LV_PART_ANY && lv_obj_style_get_selector_part(entry->selector) != part) continue;
+        entry->is_valid &= keep_mask;
+        resolved_entry_drop_values(entry, entry->is_found & ~keep_mask);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(part);
+    LV_UNUSED(prop);
+#endif
+}
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/**
+ * Get the index of a property in `lv_obj_style_resolved_entry_t::values`
+ * @param is_found  the found properties of the entry
+ * @param bit       the bit of the property, or 0 to get the number of values
+ * @return          the number of found properties before the property
+ */
+static uint32_t resolved_value_index(uint32_t is_found, uint32_t bit)
+{
+    uint32_t before = bit ? is_found & (bit - 1) : is_found;
+    uint32_t cnt = 0;
+    while(before) {
+        before &= before - 1;
+        cnt++;
+    }
+    return cnt;
+}
+
+/**
+ * Remove the values of some found properties from an entry
+ * @param entry     pointer to an entry
+ * @param drop_mask the bits of the properties to remove
+ */
+static void resolved_entry_drop_values(lv_obj_style_resolved_entry_t * entry, uint32_t drop_mask)
+{
+    if(drop_mask == 0) return;
+
+    if(drop_mask == entry->is_found) {
+        lv_free(entry->values);
+        entry->values = NULL;
+        entry->is_found = 0;
+        return;
+    }
 
+    /*Keep the order of the remaining values. The allocation isn't shrunk, it will be reused.*/
+    uint32_t value_cnt = 0;
+    uint32_t index = 0;
+    uint32_t bit;
+    for(bit = 1; bit != 0 && bit <= entry->is_found; bit <<= 1) {
+        if((entry->is_found & bit) == 0) continue;
+        if((drop_mask & bit) == 0) entry->values[value_cnt++] = entry->values[index];
+        index++;
+    }
+    entry->is_found &= ~drop_mask;
+}
+#endif
 
 #if LV_USE_OBSERVER
 
@@ -20,6 +20,14 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/** Number of style properties with a bit in the masks of the resolved style cache */
+#define LV_OBJ_STYLE_RESOLVED_PROP_CNT      32
+
+/** Max. number of selectors (part and state pairs) cached for a widget */
+#define LV_OBJ_STYLE_RESOLVED_ENTRY_CNT     4
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -42,6 +50,25 @@ struct _lv_obj_style_transition_dsc_t {
     lv_style_prop_t prop;
 };
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/**
+ * The properties found in the styles of a widget for a selector.
+ * Inheritance and default values are not cached as they depend on the parents.
+ */
+typedef struct {
+    lv_style_selector_t selector;
+    uint32_t is_valid;      /**< A bit for each property: the property was looked up already */
+    uint32_t is_found;      /**< A bit for each property: a style has the property */
+    lv_style_value_t * values;  /**< Only the found properties, in the order of their bits in `is_found` */
+} lv_obj_style_resolved_entry_t;
+
+typedef struct _lv_obj_style_resolved_t {
+    lv_obj_style_resolved_entry_t * entries;    /**< Grows up to `LV_OBJ_STYLE_RESOLVED_ENTRY_CNT` entries */
+    uint8_t entry_cnt;
+    uint8_t entry_next;     /**< The entry to replace next if all are used */
+} lv_obj_style_resolved_t;
+#endif
+
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -26,6 +26,9 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+/*Increase the refresh period to at most this many times the target period to coalesce frames*/
+#define FRAME_PACING_MAX_COALESCE 4
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,9 +37,14 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static uint64_t inv_area_cost_cb(const lv_area_t * area, void * user_data);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p, int32_t y_offset);
+static bool frame_pacing_begin(void);
+static void frame_pacing_end(uint32_t start_time);
+static void frame_pacing_set_period(uint32_t period);
+static void draw_main(lv_layer_t * layer, lv_obj_t * obj, const lv_area_t * obj_coords_ext);
 static void refr_configured_layer(lv_layer_t * layer);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
@@ -124,9 +132,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     /*If the object is visible on the current clip area*/
     layer->_clip_area = clip_coords_for_obj;
 
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+    draw_main(layer, obj, &obj_coords_ext);
 #if LV_USE_REFR_DEBUG
     lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
     lv_draw_rect_dsc_t draw_dsc;
@@ -287,7 +293,7 @@ lv_result_t lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
 
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
-        disp->inv_p = 0;
+        lv_region_clear(&disp->inv_region);
         return LV_RESULT_OK;
     }
 
@@ -312,8 +318,8 @@ lv_result_t lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
 
     /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
     if(disp->render_mode == LV_DISPLAY_RENDER_MODE_FULL) {
-        disp->inv_areas[0] = scr_area;
-        disp->inv_p = 1;
+        lv_region_clear(&disp->inv_region);
+        lv_region_add(&disp->inv_region, &scr_area);
         lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
         return LV_RESULT_OK;
     }
@@ -321,20 +327,11 @@ lv_result_t lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     lv_result_t res = lv_display_send_event(disp, LV_EVENT_INVALIDATE_AREA, &com_area);
     if(res != LV_RESULT_OK) return LV_RESULT_INVALID;
 
-    /*Save only if this area is not in one of the saved areas*/
-    uint16_t i;
-    for(i = 0; i < disp->inv_p; i++) {
-        if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return LV_RESULT_OK;
-    }
-
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*Save the area if it's not in one of the saved areas. If there is no memory for it invalidate the whole screen*/
+    if(lv_region_add(&disp->inv_region, &com_area) != LV_RESULT_OK) {
+        lv_region_clear(&disp->inv_region);
+        lv_region_add(&disp->inv_region, &scr_area);
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
-    disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 
@@ -409,36 +406,49 @@ void lv_display_refr_timer(lv_timer_t * timer)
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
-        disp_refr->inv_p = 0;
+        lv_region_clear(&disp_refr->inv_region);
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
     lv_refr_join_area();
+
+    /*Skip the refresh or postpone some areas if required to keep the frame rate*/
+    uint32_t frame_start = lv_tick_get();
+    if(disp_refr->frame_period && !frame_pacing_begin()) goto refr_finish;
+
     refr_sync_areas();
     refr_invalid_areas();
 
-    if(disp_refr->inv_p == 0) goto refr_finish;
+    if(disp_refr->frame_period) frame_pacing_end(frame_start);
+
+    uint32_t inv_cnt = lv_region_get_area_count(&disp_refr->inv_region);
+    if(inv_cnt == 0) goto refr_finish;
     /*In double buffered direct mode or if sync callback is set, save the updated areas.
      *They will be used on the next call to synchronize the buffers.*/
     if((lv_display_is_double_buffered(disp_refr) && disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) ||
        disp_refr->sync_cb) {
         uint32_t i;
-        for(i = 0; i < disp_refr->inv_p; i++) {
-            if(disp_refr->inv_area_joined[i])
-                continue;
-
+        for(i = 0; i < inv_cnt; i++) {
             lv_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
-            *sync_area = disp_refr->inv_areas[i];
+            *sync_area = *lv_region_get_area(&disp_refr->inv_region, i);
         }
     }
 
-    lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
-    lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
-    disp_refr->inv_p = 0;
+    lv_region_clear(&disp_refr->inv_region);
 
 refr_finish:
 
+    /*Redraw the postponed areas in the next frame*/
+    if(disp_refr->frame_period && lv_region_get_area_count(&disp_refr->frame_postponed)) {
+        uint32_t i;
+        for(i = 0; i < lv_region_get_area_count(&disp_refr->frame_postponed); i++) {
+            lv_region_add(&disp_refr->inv_region, lv_region_get_area(&disp_refr->frame_postponed, i));
+        }
+        lv_region_clear(&disp_refr->frame_postponed);
+        if(disp_refr->refr_timer) lv_timer_resume(disp_refr->refr_timer);
+    }
+
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_cleanup();
 #endif
@@ -618,42 +628,30 @@ void lv_obj_refr(lv_layer_t * layer, lv_obj_t * obj)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the neighboring areas if redrawing their bounding box is predicted to be faster
  */
 static void lv_refr_join_area(void)
 {
-    LV_PROFILER_REFR_BEGIN;
-    uint32_t join_from;
-    uint32_t join_in;
-    lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
-
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
-
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
-
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    lv_region_merge(&disp_refr->inv_region, inv_area_cost_cb, disp_refr);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
-            }
-        }
+    /*Save the predicted time to compare it with the measured one*/
+    uint64_t cost = 0;
+    uint32_t i;
+    for(i = 0; i < lv_region_get_area_count(&disp_refr->inv_region); i++) {
+        cost += lv_display_get_refr_cost(disp_refr, lv_region_get_area(&disp_refr->inv_region, i));
     }
-    LV_PROFILER_REFR_END;
+    disp_refr->refr_cost_predicted = cost;
+}
+
+/**
+ * Get the cost of redrawing an invalidated area
+ * @param area      pointer to an invalidated area
+ * @param user_data pointer to the display
+ * @return          the predicted time of redrawing the area in ns
+ */
+static uint64_t inv_area_cost_cb(const lv_area_t * area, void * user_data)
+{
+    return lv_display_get_refr_cost(user_data, area);
 }
 
 /**
@@ -676,14 +674,14 @@ static void refr_sync_areas(void)
     wait_for_flushing(disp_refr);
 
     /*Iterate through invalidated areas to see if sync area should be copied*/
-    uint16_t i;
+    uint32_t i;
     int8_t j;
     lv_area_t res[4] = {0};
     int8_t res_c;
     lv_area_t * sync_area, * new_area, * next_area;
-    for(i = 0; i < disp_refr->inv_p; i++) {
-        /*Skip joined areas*/
-        if(disp_refr->inv_area_joined[i]) continue;
+    uint32_t inv_cnt = lv_region_get_area_count(&disp_refr->inv_region);
+    for(i = 0; i < inv_cnt; i++) {
+        const lv_area_t * inv_area = lv_region_get_area(&disp_refr->inv_region, i);
 
         /*Iterate over sync areas*/
         sync_area = lv_ll_get_head(&disp_refr->sync_areas);
@@ -692,7 +690,7 @@ static void refr_sync_areas(void)
             next_area = lv_ll_get_next(&disp_refr->sync_areas, sync_area);
 
             /*Remove intersect of redraw area from sync area and get remaining areas*/
-            res_c = lv_area_diff(res, sync_area, &disp_refr->inv_areas[i]);
+            res_c = lv_area_diff(res, sync_area, inv_area);
 
             /*New sub areas created after removing intersect*/
             if(res_c != -1) {
@@ -780,34 +778,23 @@ static void refr_sync_areas(void)
  */
 static void refr_invalid_areas(void)
 {
-    if(disp_refr->inv_p == 0) return;
+    uint32_t inv_cnt = lv_region_get_area_count(&disp_refr->inv_region);
+    if(inv_cnt == 0) return;
     LV_PROFILER_REFR_BEGIN;
 
     /*Notify the display driven rendering has started*/
     lv_display_send_event(disp_refr, LV_EVENT_RENDER_START, NULL);
 
-    /*Find the last area which will be drawn*/
-    int32_t i;
-    int32_t last_i = 0;
-    for(i = disp_refr->inv_p - 1; i >= 0; i--) {
-        if(disp_refr->inv_area_joined[i] == 0) {
-            last_i = i;
-            break;
-        }
-    }
-
     disp_refr->last_area = 0;
     disp_refr->last_part = 0;
     disp_refr->rendering_in_progress = true;
 
-    for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
-        /*Refresh the unjoined areas*/
-        if(disp_refr->inv_area_joined[i]) continue;
-
-        if(i == last_i) disp_refr->last_area = 1;
+    uint32_t i;
+    for(i = 0; i < inv_cnt; i++) {
+        if(i == inv_cnt - 1) disp_refr->last_area = 1;
         disp_refr->last_part = 0;
 
-        lv_area_t inv_a = disp_refr->inv_areas[i];
+        lv_area_t inv_a = *lv_region_get_area(&disp_refr->inv_region, i);
         if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
             /*Calculate the max row num*/
             int32_t w = lv_area_get_width(&inv_a);
@@ -847,7 +834,7 @@ static void refr_invalid_areas(void)
         else if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_FULL ||
                 disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
             disp_refr->last_part = 1;
-            refr_area(&disp_refr->inv_areas[i], 0);
+            refr_area(&inv_a, 0);
             draw_buf_flush(disp_refr);
         }
     }
@@ -988,6 +975,133 @@ static void refr_area(const lv_area_t * area_p, int32_t y_offset)
     LV_PROFILER_REFR_END;
 }
 
+/**
+ * Decide how to redraw the invalidated areas to keep the target frame time
+ * @return      true: redraw the invalidated areas (maybe only some of them); false: skip this refresh
+ */
+static bool frame_pacing_begin(void)
+{
+    uint32_t cnt = lv_region_get_area_count(&disp_refr->inv_region);
+    if(cnt == 0) return true;
+
+    /*The last frame missed its deadline. Let the other timers (e.g. animations and input devices) run
+     *and redraw everything which changes meanwhile in the next frame.*/
+    uint32_t period = disp_refr->refr_timer ? disp_refr->refr_timer->period : disp_refr->frame_period;
+    if(disp_refr->frame_time_last > period && !disp_refr->frame_skipped) {
+        disp_refr->frame_skipped = 1;
+        disp_refr->frame_pacing_stats.skip_cnt++;
+        frame_pacing_set_period(disp_refr->frame_period);
+        if(disp_refr->refr_timer) lv_timer_resume(disp_refr->refr_timer);
+        return false;
+    }
+    disp_refr->frame_skipped = 0;
+
+    /*Predict the time of the frame from the number of pixels and find the areas which fit in the budget*/
+    uint64_t budget = (uint64_t)disp_refr->frame_period * 1000000;
+    uint64_t predicted = 0;
+    uint32_t fit_cnt = cnt;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        predicted += (uint64_t)lv_area_get_size(lv_region_get_area(&disp_refr->inv_region, i)) * disp_refr->frame_px_time;
+        /*Draw at least one area*/
+        if(predicted > budget && fit_cnt == cnt) fit_cnt = LV_MAX(i, 1);
+    }
+
+    if(predicted <= budget) {
+        frame_pacing_set_period(disp_refr->frame_period);
+        return true;
+    }
+
+    /*In partial mode the areas are independent, so draw only the areas which fit in the budget now.
+     *The areas are sorted by y coordinate so the screen is updated from top to bottom.*/
+    if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL && fit_cnt < cnt) {
+        for(i = fit_cnt; i < cnt; i++) {
+            lv_region_add(&disp_refr->frame_postponed, lv_region_get_area(&disp_refr->inv_region, i));
+        }
+        for(i = 0; i < lv_region_get_area_count(&disp_refr->frame_postponed); i++) {
+            lv_region_subtract(&disp_refr->inv_region, lv_region_get_area(&disp_refr->frame_postponed, i));
+        }
+        disp_refr->frame_pacing_stats.split_cnt++;
+        frame_pacing_set_period(disp_refr->frame_period);
+        return true;
+    }
+
+    /*Draw everything now but draw less frequently to collect the changes of more periods into one frame*/
+    uint64_t mult = (predicted + budget - 1) / budget;
+    if(mult > FRAME_PACING_MAX_COALESCE) mult = FRAME_PACING_MAX_COALESCE;
+    frame_pacing_set_period(disp_refr->frame_period * (uint32_t)mult);
+    disp_refr->frame_pacing_stats.coalesce_cnt++;
+    return true;
+}
+
+/**
+ * Measure the time of the frame and update the average time of a pixel
+ * @param start_time    the tick when the rendering of the frame started
+ */
+static void frame_pacing_end(uint32_t start_time)
+{
+    uint32_t elaps = lv_tick_elaps(start_time);
+    disp_refr->frame_time_last = elaps;
+    disp_refr->frame_pacing_stats.frame_cnt++;
+
+    uint64_t px_cnt = 0;
+    uint32_t cnt = lv_region_get_area_count(&disp_refr->inv_region);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        px_cnt += lv_area_get_size(lv_region_get_area(&disp_refr->inv_region, i));
+    }
+    if(px_cnt == 0) return;
+
+    /*Moving average to be less sensitive to the frames with unusual content*/
+    uint32_t px_time = (uint32_t)((uint64_t)elaps * 1000000 / px_cnt);
+    if(disp_refr->frame_px_time == 0) disp_refr->frame_px_time = px_time;
+    else disp_refr->frame_px_time = (disp_refr->frame_px_time * 3 + px_time) / 4;
+}
+
+/**
+ * Set the period of the refresh timer of the display being refreshed
+ * @param period    the new period in ms
+ */
+static void frame_pacing_set_period(uint32_t period)
+{
+    lv_timer_t * timer = disp_refr->refr_timer;
+    if(timer && timer->period != period) lv_timer_set_period(timer, period);
+}
+
+/**
+ * Send the `LV_EVENT_DRAW_MAIN_BEGIN/MAIN/MAIN_END` events to draw a widget, or if retained
+ * drawing is enabled for the widget, add the draw tasks saved earlier instead.
+ * @param layer             pointer to a layer. Its clip area is already set for the widget.
+ * @param obj               the widget to draw
+ * @param obj_coords_ext    the coordinates of the widget increased by the ext. draw size
+ */
+static void draw_main(lv_layer_t * layer, lv_obj_t * obj, const lv_area_t * obj_coords_ext)
+{
+#if LV_USE_OBJ_RETAINED_DRAW
+    lv_draw_recording_t * rec = obj->spec_attr ? obj->spec_attr->draw_recording : NULL;
+    /*The draw task events need the real draw tasks of the widget*/
+    if(rec && layer->recording == NULL && !lv_obj_is_send_draw_task_events(obj)) {
+        if(lv_draw_recording_replay(layer, rec, &obj->coords) == LV_RESULT_OK) return;
+
+        /*Record only if nothing is clipped to be able to use it in any other area too*/
+        if(lv_area_is_in(obj_coords_ext, &layer->_clip_area, 0)) {
+            lv_draw_recording_start(layer, rec, &obj->coords);
+            lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+            lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
+            lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+            lv_draw_recording_stop(layer);
+            return;
+        }
+    }
+#else
+    LV_UNUSED(obj_coords_ext);
+#endif
+
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+}
+
 static void refr_configured_layer(lv_layer_t * layer)
 {
     LV_PROFILER_REFR_BEGIN;
@@ -53,6 +53,7 @@ extern uint32_t LV_SYSMON_GET_IDLE(void);
     static void perf_monitor_disp_event_cb(lv_event_t * e);
     static void perf_dump_info(lv_display_t * disp);
     static void perf_control(lv_display_t * disp, bool start);
+    static uint32_t frame_time_percentile(const lv_sysmon_perf_info_t * info, uint32_t percent);
 #endif
 
 #if LV_USE_MEM_MONITOR
@@ -228,12 +229,17 @@ static void perf_monitor_disp_event_cb(lv_event_t * e)
         case LV_EVENT_RENDER_START:
             info->measured.render_in_progress = 1;
             info->measured.render_start = lv_tick_get();
+            info->measured.refr_cost_predicted_sum += (uint32_t)(lv_display_get_refr_cost_predicted(disp) / 1000);
             break;
-        case LV_EVENT_RENDER_READY:
-            info->measured.render_in_progress = 0;
-            info->measured.render_elaps_sum += lv_tick_elaps(info->measured.render_start);
-            info->measured.render_cnt++;
-            break;
+        case LV_EVENT_RENDER_READY: {
+                info->measured.render_in_progress = 0;
+                uint32_t elaps = lv_tick_elaps(info->measured.render_start);
+                info->measured.render_elaps_sum += elaps;
+                info->measured.render_cnt++;
+                uint32_t bin = LV_MIN(elaps, LV_SYSMON_FRAME_TIME_BIN_CNT - 1);
+                if(info->measured.frame_time_bins[bin] < UINT16_MAX) info->measured.frame_time_bins[bin]++;
+                break;
+            }
         case LV_EVENT_FLUSH_START:
         case LV_EVENT_FLUSH_WAIT_START:
             if(info->measured.render_in_progress) {
@@ -289,6 +295,11 @@ static void perf_dump_info(lv_display_t * disp)
     info->calculated.render_avg_time = info->measured.render_cnt ? ((info->measured.render_elaps_sum -
                                                                      info->measured.flush_in_render_elaps_sum) /
                                                                     info->measured.render_cnt) : 0;
+    info->calculated.predicted_avg_time = info->measured.render_cnt ? (info->measured.refr_cost_predicted_sum /
+                                                                       info->measured.render_cnt / 1000) : 0;
+    info->calculated.frame_time_p50 = frame_time_percentile(info, 50);
+    info->calculated.frame_time_p95 = frame_time_percentile(info, 95);
+    info->calculated.frame_time_p99 = frame_time_percentile(info, 99);
 
     info->calculated.cpu_avg_total = ((info->calculated.cpu_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.cpu) / info->calculated.run_cnt;
@@ -310,6 +321,30 @@ static void perf_dump_info(lv_display_t * disp)
     info->measured.last_report_timestamp = lv_tick_get();
 }
 
+/**
+ * Get a percentile of the render and flush times from their histogram
+ * @param info      the performance info of a display
+ * @param percent   e.g. 95 to get the time in which 95% of the frames were rendered and flushed
+ * @return          the time in ms, the last bin is reported for the longer times too
+ */
+static uint32_t frame_time_percentile(const lv_sysmon_perf_info_t * info, uint32_t percent)
+{
+    uint32_t total = 0;
+    uint32_t i;
+    for(i = 0; i < LV_SYSMON_FRAME_TIME_BIN_CNT; i++) total += info->measured.frame_time_bins[i];
+    if(total == 0) return 0;
+
+    /*The smallest time where at least `percent` % of the frames are included*/
+    uint32_t limit = (total * percent + 99) / 100;
+    uint32_t sum = 0;
+    for(i = 0; i < LV_SYSMON_FRAME_TIME_BIN_CNT; i++) {
+        sum += info->measured.frame_time_bins[i];
+        if(sum >= limit) return i;
+    }
+
+    return LV_SYSMON_FRAME_TIME_BIN_CNT - 1;
+}
+
 static void perf_update_timer_cb(lv_timer_t * t)
 {
     lv_display_t * disp = lv_timer_get_user_data(t);
@@ -327,17 +362,25 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32"), "
            "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
+           "predicted %" LV_PRIu32 "ms, "
+           "frame p50/p95/p99 %" LV_PRIu32 "/%" LV_PRIu32 "/%" LV_PRIu32 "ms, "
            "CPU (total %" LV_PRIu32 "%% proc %" LV_PRIu32 "%%)\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
+           perf->calculated.predicted_avg_time,
+           perf->calculated.frame_time_p50, perf->calculated.frame_time_p95, perf->calculated.frame_time_p99,
            perf->calculated.cpu, perf->calculated.cpu_proc);
 #else
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32"), "
            "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
+           "predicted %" LV_PRIu32 "ms, "
+           "frame p50/p95/p99 %" LV_PRIu32 "/%" LV_PRIu32 "/%" LV_PRIu32 "ms, "
            "CPU %" LV_PRIu32 "%%\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
+           perf->calculated.predicted_avg_time,
+           perf->calculated.frame_time_p50, perf->calculated.frame_time_p95, perf->calculated.frame_time_p99,
            perf->calculated.cpu);
 #endif
 #else
@@ -346,19 +389,25 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     lv_label_set_text_fmt(
         label,
         "%" LV_PRIu32" FPS | CPU (%" LV_PRIu32 "%% | %" LV_PRIu32 "%%)\n"
-        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
+        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32"), pred. %" LV_PRIu32" ms\n"
+        "p50/95/99: %" LV_PRIu32"/%" LV_PRIu32"/%" LV_PRIu32" ms",
         perf->calculated.fps, perf->calculated.cpu, perf->calculated.cpu_proc,
         perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
-        perf->calculated.render_avg_time, perf->calculated.flush_avg_time
+        perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
+        perf->calculated.predicted_avg_time,
+        perf->calculated.frame_time_p50, perf->calculated.frame_time_p95, perf->calculated.frame_time_p99
     );
 #else
     lv_label_set_text_fmt(
         label,
         "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
-        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
+        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32"), pred. %" LV_PRIu32" ms\n"
+        "p50/95/99: %" LV_PRIu32"/%" LV_PRIu32"/%" LV_PRIu32" ms",
         perf->calculated.fps, perf->calculated.cpu,
         perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
-        perf->calculated.render_avg_time, perf->calculated.flush_avg_time
+        perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
+        perf->calculated.predicted_avg_time,
+        perf->calculated.frame_time_p50, perf->calculated.frame_time_p95, perf->calculated.frame_time_p99
     );
 #endif /*LV_SYSMON_PROC_IDLE_AVAILABLE*/
 #endif /*LV_USE_PERF_MONITOR_LOG_MODE*/
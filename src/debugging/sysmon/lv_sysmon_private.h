@@ -22,6 +22,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Number of 1 ms wide bins to collect the frame times for the percentiles. The last bin collects the longer frames too.*/
+#define LV_SYSMON_FRAME_TIME_BIN_CNT 64
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -46,6 +49,8 @@ struct _lv_sysmon_perf_info_t {
         uint32_t flush_in_render_elaps_sum;
         uint32_t flush_not_in_render_start;
         uint32_t flush_not_in_render_elaps_sum;
+        uint32_t refr_cost_predicted_sum;   /**< Predicted render and flush time in us*/
+        uint16_t frame_time_bins[LV_SYSMON_FRAME_TIME_BIN_CNT]; /**< Histogram of the render and flush times*/
         uint32_t last_report_timestamp;
         uint32_t render_in_progress : 1;
     } measured;
@@ -59,6 +64,10 @@ struct _lv_sysmon_perf_info_t {
         uint32_t refr_avg_time;
         uint32_t render_avg_time;       /**< Pure rendering time without flush time*/
         uint32_t flush_avg_time;        /**< Pure flushing time without rendering time*/
+        uint32_t predicted_avg_time;    /**< Render and flush time predicted by the display's cost model*/
+        uint32_t frame_time_p50;        /**< Median render and flush time of the frames*/
+        uint32_t frame_time_p95;        /**< 95% of the frames were rendered and flushed in this time*/
+        uint32_t frame_time_p99;        /**< 99% of the frames were rendered and flushed in this time*/
         uint32_t cpu_avg_total;
         uint32_t fps_avg_total;
         uint32_t run_cnt;
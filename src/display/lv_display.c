@@ -10,6 +10,7 @@
 #include "../display/lv_display_private.h"
 #include "../misc/lv_event_private.h"
 #include "../misc/lv_anim_private.h"
+#include "../misc/lv_timer_private.h"
 #include "../draw/lv_draw_private.h"
 #include "../core/lv_obj_private.h"
 #include "../core/lv_refr_private.h"
@@ -107,6 +108,10 @@ lv_display_t * lv_display_create(int32_t hor_res, int32_t ver_res)
     disp->last_activity_time = lv_tick_get();
 
     lv_ll_init(&disp->sync_areas, sizeof(lv_area_t));
+    lv_region_init(&disp->inv_region);
+    disp->flush_cost = LV_DISPLAY_DEF_FLUSH_COST;
+    disp->render_px_cost = LV_DISPLAY_DEF_RENDER_PX_COST;
+    disp->transfer_px_cost = LV_DISPLAY_DEF_TRANSFER_PX_COST;
 
     lv_display_t * disp_def_tmp = disp_def;
     disp_def                 = disp; /*Temporarily change the default screen to create the default screens on the
@@ -228,6 +233,8 @@ void lv_display_delete(lv_display_t * disp)
     }
 
     lv_ll_clear(&disp->sync_areas);
+    lv_region_deinit(&disp->inv_region);
+    if(disp->frame_period) lv_region_deinit(&disp->frame_postponed);
     lv_ll_remove(disp_ll_p, disp);
     if(disp->refr_timer) lv_timer_delete(disp->refr_timer);
 
@@ -596,6 +603,111 @@ void lv_display_set_sync_wait_cb(lv_display_t * disp, lv_display_sync_wait_cb_t
     disp->sync_wait_cb = wait_cb;
 }
 
+void lv_display_set_refr_cost(lv_display_t * disp, uint32_t flush_cost, uint32_t render_px_cost,
+                              uint32_t transfer_px_cost)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->flush_cost = flush_cost;
+    disp->render_px_cost = render_px_cost;
+    disp->transfer_px_cost = transfer_px_cost;
+}
+
+void lv_display_set_refr_cost_cb(lv_display_t * disp, lv_display_refr_cost_cb_t cost_cb)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->refr_cost_cb = cost_cb;
+}
+
+uint64_t lv_display_get_refr_cost(lv_display_t * disp, const lv_area_t * area)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return 0;
+
+    if(disp->refr_cost_cb) return disp->refr_cost_cb(disp, area);
+
+    /*In partial mode the area is rendered and flushed in as many chunks as the draw buffer requires*/
+    int32_t h = lv_area_get_height(area);
+    uint32_t flush_cnt = 1;
+    if(disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL && disp->buf_act) {
+        uint32_t stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), disp->color_format);
+        uint32_t max_row = stride ? disp->buf_act->data_size / stride : 0;
+        if(max_row > 0) flush_cnt = (h + max_row - 1) / max_row;
+    }
+
+    return (uint64_t)flush_cnt * disp->flush_cost +
+           (uint64_t)lv_area_get_size(area) * (disp->render_px_cost + disp->transfer_px_cost);
+}
+
+uint64_t lv_display_get_refr_cost_predicted(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return 0;
+
+    return disp->refr_cost_predicted;
+}
+
+void lv_display_set_frame_pacing(lv_display_t * disp, bool en)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    if(en == lv_display_get_frame_pacing(disp)) return;
+
+    if(en) {
+        uint32_t period = disp->refr_timer ? disp->refr_timer->period : LV_DEF_REFR_PERIOD;
+        disp->frame_period = LV_MAX(period, 1);
+        lv_region_init(&disp->frame_postponed);
+    }
+    else {
+        if(disp->refr_timer) lv_timer_set_period(disp->refr_timer, disp->frame_period);
+
+        /*Redraw the postponed areas normally*/
+        uint32_t cnt = lv_region_get_area_count(&disp->frame_postponed);
+        uint32_t i;
+        for(i = 0; i < cnt; i++) {
+            lv_inv_area(disp, lv_region_get_area(&disp->frame_postponed, i));
+        }
+        lv_region_deinit(&disp->frame_postponed);
+        disp->frame_period = 0;
+    }
+
+    disp->frame_px_time = 0;
+    disp->frame_time_last = 0;
+    disp->frame_skipped = 0;
+}
+
+bool lv_display_get_frame_pacing(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return false;
+
+    return disp->frame_period != 0;
+}
+
+void lv_display_get_frame_pacing_stats(lv_display_t * disp, lv_display_frame_pacing_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) {
+        lv_memzero(stats, sizeof(lv_display_frame_pacing_stats_t));
+        return;
+    }
+
+    *stats = disp->frame_pacing_stats;
+}
+
+void lv_display_reset_frame_pacing_stats(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_memzero(&disp->frame_pacing_stats, sizeof(lv_display_frame_pacing_stats_t));
+}
+
 void lv_display_set_color_format(lv_display_t * disp, lv_color_format_t color_format)
 {
     if(disp == NULL) disp = lv_display_get_default();
@@ -1443,9 +1555,7 @@ static void update_resolution(lv_display_t * disp)
     lv_area_set_height(&disp->bottom_layer->coords, ver_res);
     lv_obj_send_event(disp->bottom_layer, LV_EVENT_SIZE_CHANGED, &prev_coords);
 
-    lv_memzero(disp->inv_areas, sizeof(disp->inv_areas));
-    lv_memzero(disp->inv_area_joined, sizeof(disp->inv_area_joined));
-    disp->inv_p = 0;
+    lv_region_clear(&disp->inv_region);
     lv_obj_invalidate(disp->sys_layer);
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "../lvgl_public.h"
 #include "../misc/lv_event_private.h"
+#include "../misc/lv_region_private.h"
 
 #if LV_USE_SYSMON
 #include "../debugging/sysmon/lv_sysmon_private.h"
@@ -23,8 +24,16 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
-#ifndef LV_INV_BUF_SIZE
-#define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
+#ifndef LV_DISPLAY_DEF_FLUSH_COST
+#define LV_DISPLAY_DEF_FLUSH_COST 0 /**< Default fixed overhead of a flush in ns*/
+#endif
+
+#ifndef LV_DISPLAY_DEF_RENDER_PX_COST
+#define LV_DISPLAY_DEF_RENDER_PX_COST 20 /**< Default time of rendering a pixel in ns*/
+#endif
+
+#ifndef LV_DISPLAY_DEF_TRANSFER_PX_COST
+#define LV_DISPLAY_DEF_TRANSFER_PX_COST 10 /**< Default time of sending a pixel to the display in ns*/
 #endif
 
 /**********************
@@ -124,9 +133,22 @@ struct _lv_display_t {
     lv_color_format_t   color_format;
 
     /** Invalidated (marked to redraw) areas*/
-    lv_area_t inv_areas[LV_INV_BUF_SIZE];
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
-    uint32_t inv_p;
+    lv_region_t inv_region;
+
+    /** Cost model to decide which invalidated areas to join. The costs are in ns.*/
+    lv_display_refr_cost_cb_t refr_cost_cb;
+    uint32_t flush_cost;
+    uint32_t render_px_cost;
+    uint32_t transfer_px_cost;
+    uint64_t refr_cost_predicted;   /**< Predicted time of redrawing the areas in the last refresh*/
+
+    /** Adaptive frame pacing*/
+    uint32_t frame_period;          /**< Target frame time in ms. 0: frame pacing is disabled*/
+    uint32_t frame_px_time;         /**< Measured average render and flush time of a pixel in ns*/
+    uint32_t frame_time_last;       /**< Render and flush time of the last frame in ms*/
+    uint32_t frame_skipped : 1;     /**< 1: the last refresh was skipped*/
+    lv_region_t frame_postponed;    /**< Areas which didn't fit in the time budget of the last frame*/
+    lv_display_frame_pacing_stats_t frame_pacing_stats;
     int32_t inv_en_cnt;
 
     lv_draw_buf_t _static_buf1; /**< Used when user pass in a raw buffer as display draw buffer */
@@ -27,13 +27,36 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_OBJ_RETAINED_DRAW
+/*A recorded draw task. It's followed by the draw descriptor.*/
+typedef struct {
+    lv_draw_task_type_t type;
+    lv_area_t area;
+    lv_area_t real_area;
+    lv_area_t clip_area;
+} recorded_task_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check, uint8_t draw_unit_id);
 static inline size_t get_draw_dsc_size(lv_draw_task_type_t type);
+static lv_draw_task_t * task_alloc(size_t size);
+static void task_free(lv_draw_task_t * t);
+#if LV_USE_OBJ_RETAINED_DRAW
+    static void recording_add_task(lv_draw_recording_t * rec, const lv_draw_task_t * t);
+    static bool task_is_replayable(const lv_draw_task_t * t);
+    static void translate_draw_dsc(lv_draw_task_type_t type, void * draw_dsc, int32_t dx, int32_t dy);
+#endif
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer);
+static void task_index_add(lv_layer_t * layer, lv_draw_task_t * t);
+static void task_index_remove(lv_draw_task_t * t);
+static void task_index_free(lv_layer_t * layer);
+static bool bin_add(lv_draw_task_bin_t * bin, lv_draw_task_t * t);
+static void bin_remove(lv_draw_task_bin_t * bin, const lv_draw_task_t * t);
+static inline bool task_is_older(const lv_draw_task_t * t1, const lv_draw_task_t * t2);
+static inline bool task_blocks(const lv_draw_task_t * t, const lv_draw_task_t * t_check, uint8_t draw_unit_id);
 
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
@@ -59,10 +82,24 @@ void lv_draw_init(void)
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
 #endif
+
+#if LV_USE_DRAW_TASK_POOL
+    lv_mutex_init(&_draw_info.task_pool_mutex);
+#endif
+
+#if LV_USE_DRAW_GLYPH_ATLAS
+    lv_draw_glyph_atlas_init();
+#endif
 }
 
 void lv_draw_deinit(void)
 {
+    lv_draw_task_pool_flush();
+
+#if LV_USE_DRAW_TASK_POOL
+    lv_mutex_delete(&_draw_info.task_pool_mutex);
+#endif
+
 #if LV_USE_OS
     lv_thread_sync_delete(&_draw_info.sync);
 #endif
@@ -76,6 +113,10 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+#if LV_USE_DRAW_GLYPH_ATLAS
+    lv_draw_glyph_atlas_deinit();
+#endif
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -97,7 +138,7 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     LV_PROFILER_DRAW_BEGIN;
     size_t dsc_size = get_draw_dsc_size(type);
     LV_ASSERT_FORMAT_MSG(dsc_size > 0, "Draw task size is 0 for type %d", type);
-    lv_draw_task_t * new_task = lv_malloc_zeroed(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size);
+    lv_draw_task_t * new_task = task_alloc(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size);
     LV_ASSERT_MALLOC(new_task);
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -110,6 +151,7 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     new_task->type = type;
     new_task->draw_dsc = (uint8_t *)new_task + LV_ALIGN_UP(sizeof(lv_draw_task_t), 8);
     new_task->state = LV_DRAW_TASK_STATE_WAITING;
+    new_task->id = _draw_info.task_id_cnt++;
 
     /*Find the tail*/
     if(layer->draw_task_head == NULL) {
@@ -132,6 +174,14 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
     lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
     base_dsc->layer = layer;
 
+#if LV_USE_OBJ_RETAINED_DRAW
+    if(layer->recording) recording_add_task(layer->recording, t);
+#endif
+
+    /*`_real_area` is final now, so the task can be added to the index.
+     *Do it before sending the event as the event might add newer draw tasks*/
+    task_index_add(layer, t);
+
     lv_draw_global_info_t * info = &_draw_info;
 
     /*Send LV_EVENT_DRAW_TASK_ADDED and dispatch only on the "main" draw_task
@@ -592,20 +642,38 @@ void lv_draw_layer_finish_drop_shadow(lv_layer_t * drop_shadow_layer, const lv_d
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check, uint8_t draw_unit_id)
 {
     LV_PROFILER_DRAW_BEGIN;
-    lv_draw_task_t * t = layer->draw_task_head;
+    lv_draw_task_index_t * index = layer->task_index;
+
+    /*Only the older tasks in the bins of `t_check` can overlap with it*/
+    if(index && !index->incomplete && t_check->indexed) {
+        int32_t bx, by;
+        for(by = t_check->bin_y1; by <= t_check->bin_y2; by++) {
+            for(bx = t_check->bin_x1; bx <= t_check->bin_x2; bx++) {
+                const lv_draw_task_bin_t * bin = &index->bins[by * LV_DRAW_TASK_INDEX_BINS + bx];
+                uint32_t i;
+                for(i = bin->start; i < bin->cnt; i++) {
+                    const lv_draw_task_t * t = bin->tasks[i];
+                    if(t == NULL || !task_is_older(t, t_check)) continue;
+
+                    /*Check the tasks spanning more bins only in their first bin shared with `t_check`*/
+                    if(LV_MAX(t->bin_x1, t_check->bin_x1) != bx || LV_MAX(t->bin_y1, t_check->bin_y1) != by) continue;
+
+                    if(task_blocks(t, t_check, draw_unit_id)) {
+                        LV_PROFILER_DRAW_END;
+                        return false;
+                    }
+                }
+            }
+        }
+
+        LV_PROFILER_DRAW_END;
+        return true;
+    }
 
     /*If t_check is outside of the older tasks then it's independent*/
+    lv_draw_task_t * t = layer->draw_task_head;
     while(t && t != t_check) {
-        /*It's independent of finished draw tasks, and queued draw tasks of the same draw unit,
-         *so no need to check it*/
-        if(t->state == LV_DRAW_TASK_STATE_FINISHED ||
-           (t->state == LV_DRAW_TASK_STATE_QUEUED && t->preferred_draw_unit_id == draw_unit_id)) {
-            t = t->next;
-            continue;
-        }
-
-        lv_area_t a;
-        if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
+        if(task_blocks(t, t_check, draw_unit_id)) {
             LV_PROFILER_DRAW_END;
             return false;
         }
@@ -678,6 +746,8 @@ static inline size_t get_draw_dsc_size(lv_draw_task_type_t type)
 void lv_draw_cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
 {
     LV_PROFILER_DRAW_BEGIN;
+    task_index_remove(t);
+
     if(t->type == LV_DRAW_TASK_TYPE_LINE) {
         lv_draw_line_dsc_t * draw_line_dsc = t->draw_dsc;
         if(draw_line_dsc->points) {
@@ -732,10 +802,302 @@ void lv_draw_cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
         draw_label_dsc->text = NULL;
     }
 
-    lv_free(t);
+    task_free(t);
+    LV_PROFILER_DRAW_END;
+}
+
+void lv_draw_task_pool_flush(void)
+{
+#if LV_USE_DRAW_TASK_POOL
+    /*Take the lists and free the tasks without holding the lock*/
+    lv_draw_task_t * lists[LV_DRAW_TASK_POOL_CLASS_CNT];
+    lv_mutex_lock(&_draw_info.task_pool_mutex);
+    lv_memcpy(lists, _draw_info.task_pool, sizeof(lists));
+    lv_memzero(_draw_info.task_pool, sizeof(_draw_info.task_pool));
+    _draw_info.task_pool_stats.cached_cnt = 0;
+    lv_mutex_unlock(&_draw_info.task_pool_mutex);
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_POOL_CLASS_CNT; i++) {
+        lv_draw_task_t * t = lists[i];
+        while(t) {
+            lv_draw_task_t * t_next = t->next;
+            lv_free(t);
+            t = t_next;
+        }
+    }
+#endif
+}
+
+#if LV_USE_OBJ_RETAINED_DRAW
+
+void lv_draw_recording_init(lv_draw_recording_t * rec)
+{
+    lv_array_init(&rec->tasks, LV_ARRAY_DEFAULT_CAPACITY, sizeof(recorded_task_t *));
+    lv_area_set(&rec->coords, 0, 0, -1, -1);
+    rec->valid = false;
+}
+
+void lv_draw_recording_deinit(lv_draw_recording_t * rec)
+{
+    lv_draw_recording_reset(rec);
+    lv_array_deinit(&rec->tasks);
+}
+
+void lv_draw_recording_reset(lv_draw_recording_t * rec)
+{
+    uint32_t cnt = lv_array_size(&rec->tasks);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        recorded_task_t ** r = lv_array_at(&rec->tasks, i);
+        lv_free(*r);
+    }
+    lv_array_clear(&rec->tasks);
+    rec->valid = false;
+}
+
+void lv_draw_recording_start(lv_layer_t * layer, lv_draw_recording_t * rec, const lv_area_t * coords)
+{
+    lv_draw_recording_reset(rec);
+    rec->coords = *coords;
+    rec->recolor = layer->recolor;
+    rec->opa = layer->opa;
+    rec->valid = true;
+    layer->recording = rec;
+}
+
+bool lv_draw_recording_stop(lv_layer_t * layer)
+{
+    lv_draw_recording_t * rec = layer->recording;
+    if(rec == NULL) return false;
+
+    layer->recording = NULL;
+    if(!rec->valid) lv_draw_recording_reset(rec);
+
+    return rec->valid;
+}
+
+lv_result_t lv_draw_recording_replay(lv_layer_t * layer, const lv_draw_recording_t * rec, const lv_area_t * coords)
+{
+    if(!rec->valid) return LV_RESULT_INVALID;
+    if(lv_area_get_width(coords) != lv_area_get_width(&rec->coords) ||
+       lv_area_get_height(coords) != lv_area_get_height(&rec->coords)) {
+        return LV_RESULT_INVALID;
+    }
+    if(layer->opa != rec->opa || !lv_color32_eq(layer->recolor, rec->recolor)) {
+        return LV_RESULT_INVALID;
+    }
+
+    LV_PROFILER_DRAW_BEGIN;
+    int32_t dx = coords->x1 - rec->coords.x1;
+    int32_t dy = coords->y1 - rec->coords.y1;
+    const lv_area_t clip_area_ori = layer->_clip_area;
+
+    uint32_t cnt = lv_array_size(&rec->tasks);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        const recorded_task_t * r = *(recorded_task_t **)lv_array_at(&rec->tasks, i);
+
+        lv_area_t clip_area = r->clip_area;
+        lv_area_move(&clip_area, dx, dy);
+        if(!lv_area_intersect(&layer->_clip_area, &clip_area, &clip_area_ori)) continue;
+
+        lv_area_t area = r->area;
+        lv_area_move(&area, dx, dy);
+        lv_draw_task_t * t = lv_draw_add_task(layer, &area, r->type);
+        if(t == NULL) break;
+
+        lv_memcpy(t->draw_dsc, (uint8_t *)r + LV_ALIGN_UP(sizeof(recorded_task_t), 8), get_draw_dsc_size(r->type));
+        translate_draw_dsc(r->type, t->draw_dsc, dx, dy);
+        t->_real_area = r->real_area;
+        lv_area_move(&t->_real_area, dx, dy);
+
+        lv_draw_finalize_task_creation(layer, t);
+    }
+
+    layer->_clip_area = clip_area_ori;
     LV_PROFILER_DRAW_END;
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_USE_OBJ_RETAINED_DRAW*/
+
+void lv_draw_task_pool_get_stats(lv_draw_task_pool_stats_t * stats)
+{
+#if LV_USE_DRAW_TASK_POOL
+    lv_mutex_lock(&_draw_info.task_pool_mutex);
+    *stats = _draw_info.task_pool_stats;
+    lv_mutex_unlock(&_draw_info.task_pool_mutex);
+#else
+    lv_memzero(stats, sizeof(lv_draw_task_pool_stats_t));
+#endif
+}
+
+void lv_draw_task_pool_reset_stats(void)
+{
+#if LV_USE_DRAW_TASK_POOL
+    lv_mutex_lock(&_draw_info.task_pool_mutex);
+    _draw_info.task_pool_stats.alloc_cnt = 0;
+    _draw_info.task_pool_stats.reuse_cnt = 0;
+    lv_mutex_unlock(&_draw_info.task_pool_mutex);
+#endif
+}
+
+/**
+ * Allocate a zeroed draw task, reuse a finished draw task of the same size class if possible
+ * @param size      size of the draw task and its draw descriptor
+ * @return          the allocated draw task or NULL on error
+ */
+static lv_draw_task_t * task_alloc(size_t size)
+{
+#if LV_USE_DRAW_TASK_POOL
+    uint32_t cls = (size - 1) / LV_DRAW_TASK_POOL_CLASS_SIZE;
+    lv_mutex_lock(&_draw_info.task_pool_mutex);
+    if(cls < LV_DRAW_TASK_POOL_CLASS_CNT) {
+        lv_draw_task_t * t = _draw_info.task_pool[cls];
+        if(t) {
+            _draw_info.task_pool[cls] = t->next;
+            _draw_info.task_pool_stats.cached_cnt--;
+            _draw_info.task_pool_stats.reuse_cnt++;
+            lv_mutex_unlock(&_draw_info.task_pool_mutex);
+            lv_memzero(t, size);
+            return t;
+        }
+
+        /*Allocate the whole class size to fit any draw task of the class when reused*/
+        size = (cls + 1) * LV_DRAW_TASK_POOL_CLASS_SIZE;
+    }
+    _draw_info.task_pool_stats.alloc_cnt++;
+    lv_mutex_unlock(&_draw_info.task_pool_mutex);
+
+    lv_draw_task_t * t = lv_malloc_zeroed(size);
+    if(t == NULL) {
+        /*Give the memory of the pooled draw tasks back and try again*/
+        lv_draw_task_pool_flush();
+        t = lv_malloc_zeroed(size);
+    }
+
+    return t;
+#else
+    return lv_malloc_zeroed(size);
+#endif
+}
+
+/**
+ * Put a finished draw task to the pool or free it if it's too large to be pooled
+ * @param t         pointer to a draw task
+ */
+static void task_free(lv_draw_task_t * t)
+{
+#if LV_USE_DRAW_TASK_POOL
+    size_t size = LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + get_draw_dsc_size(t->type);
+    uint32_t cls = (size - 1) / LV_DRAW_TASK_POOL_CLASS_SIZE;
+    if(cls < LV_DRAW_TASK_POOL_CLASS_CNT) {
+        lv_mutex_lock(&_draw_info.task_pool_mutex);
+        t->next = _draw_info.task_pool[cls];
+        _draw_info.task_pool[cls] = t;
+        _draw_info.task_pool_stats.cached_cnt++;
+        lv_mutex_unlock(&_draw_info.task_pool_mutex);
+        return;
+    }
+#endif
+
+    lv_free(t);
+}
+
+#if LV_USE_OBJ_RETAINED_DRAW
+
+/**
+ * Save a copy of a draw task and its draw descriptor in a recording
+ * @param rec       pointer to a draw recording
+ * @param t         the draw task to save
+ */
+static void recording_add_task(lv_draw_recording_t * rec, const lv_draw_task_t * t)
+{
+    if(!rec->valid) return;
+
+    if(!task_is_replayable(t)) {
+        rec->valid = false;
+        return;
+    }
+
+    size_t dsc_size = get_draw_dsc_size(t->type);
+    recorded_task_t * r = lv_malloc(LV_ALIGN_UP(sizeof(recorded_task_t), 8) + dsc_size);
+    if(r == NULL) {
+        rec->valid = false;
+        return;
+    }
+
+    r->type = t->type;
+    r->area = t->area;
+    r->real_area = t->_real_area;
+    r->clip_area = t->clip_area;
+    lv_memcpy((uint8_t *)r + LV_ALIGN_UP(sizeof(recorded_task_t), 8), t->draw_dsc, dsc_size);
+
+    if(lv_array_push_back(&rec->tasks, &r) != LV_RESULT_OK) {
+        lv_free(r);
+        rec->valid = false;
+    }
+}
+
+/**
+ * Check if a draw task can be added again later from a copy of its draw descriptor.
+ * Draw tasks owning memory or referring to other layers can't be replayed.
+ * @param t         pointer to a draw task
+ * @return          true: the draw task can be recorded
+ */
+static bool task_is_replayable(const lv_draw_task_t * t)
+{
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+        case LV_DRAW_TASK_TYPE_BORDER:
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+        case LV_DRAW_TASK_TYPE_ARC:
+        case LV_DRAW_TASK_TYPE_TRIANGLE:
+            return true;
+        case LV_DRAW_TASK_TYPE_LABEL: {
+                const lv_draw_label_dsc_t * dsc = t->draw_dsc;
+                return dsc->text_local == 0 && dsc->hint == NULL;
+            }
+        case LV_DRAW_TASK_TYPE_IMAGE: {
+                const lv_draw_image_dsc_t * dsc = t->draw_dsc;
+                return dsc->sup == NULL;
+            }
+        default:
+            return false;
+    }
+}
+
+/**
+ * Move the absolute coordinates stored in a draw descriptor
+ * @param type      type of the draw task
+ * @param draw_dsc  pointer to the draw descriptor
+ * @param dx        horizontal translation
+ * @param dy        vertical translation
+ */
+static void translate_draw_dsc(lv_draw_task_type_t type, void * draw_dsc, int32_t dx, int32_t dy)
+{
+    if(type == LV_DRAW_TASK_TYPE_IMAGE) {
+        lv_draw_image_dsc_t * dsc = draw_dsc;
+        lv_area_move(&dsc->image_area, dx, dy);
+    }
+    else if(type == LV_DRAW_TASK_TYPE_ARC) {
+        lv_draw_arc_dsc_t * dsc = draw_dsc;
+        dsc->center.x += dx;
+        dsc->center.y += dy;
+    }
+    else if(type == LV_DRAW_TASK_TYPE_TRIANGLE) {
+        lv_draw_triangle_dsc_t * dsc = draw_dsc;
+        uint32_t i;
+        for(i = 0; i < 3; i++) {
+            dsc->p[i].x += dx;
+            dsc->p[i].y += dy;
+        }
+    }
 }
 
+#endif /*LV_USE_OBJ_RETAINED_DRAW*/
+
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
 {
     LV_PROFILER_DRAW_BEGIN;
@@ -764,3 +1126,198 @@ static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
     LV_PROFILER_DRAW_END;
     return t;
 }
+
+/**
+ * Add a draw task to the spatial index of its layer. The index is created
+ * when the first draw task is added.
+ * @param layer     the layer of the draw task
+ * @param t         the draw task whose `_real_area` is already set
+ */
+static void task_index_add(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    LV_PROFILER_DRAW_BEGIN;
+    lv_draw_task_index_t * index = layer->task_index;
+    if(index == NULL) {
+        /*All the older tasks need to be in the index, so it can be created only
+         *if this is the first task. Else the dependencies are checked without index.*/
+        if(layer->draw_task_head != t) {
+            LV_PROFILER_DRAW_END;
+            return;
+        }
+
+        index = lv_malloc_zeroed(sizeof(lv_draw_task_index_t));
+        if(index == NULL) {
+            LV_PROFILER_DRAW_END;
+            return;
+        }
+
+        index->area = layer->buf_area;
+        int32_t w = lv_area_get_width(&index->area);
+        int32_t h = lv_area_get_height(&index->area);
+        index->bin_w = LV_MAX(1, (w + LV_DRAW_TASK_INDEX_BINS - 1) / LV_DRAW_TASK_INDEX_BINS);
+        index->bin_h = LV_MAX(1, (h + LV_DRAW_TASK_INDEX_BINS - 1) / LV_DRAW_TASK_INDEX_BINS);
+        layer->task_index = index;
+    }
+    else if(index->incomplete) {
+        LV_PROFILER_DRAW_END;
+        return;
+    }
+
+    /*Areas outside of the index are mapped to the edge bins*/
+    int32_t x1 = (t->_real_area.x1 - index->area.x1) / index->bin_w;
+    int32_t y1 = (t->_real_area.y1 - index->area.y1) / index->bin_h;
+    int32_t x2 = (t->_real_area.x2 - index->area.x1) / index->bin_w;
+    int32_t y2 = (t->_real_area.y2 - index->area.y1) / index->bin_h;
+    t->bin_x1 = (uint8_t)LV_CLAMP(0, x1, LV_DRAW_TASK_INDEX_BINS - 1);
+    t->bin_y1 = (uint8_t)LV_CLAMP(0, y1, LV_DRAW_TASK_INDEX_BINS - 1);
+    t->bin_x2 = (uint8_t)LV_CLAMP(0, x2, LV_DRAW_TASK_INDEX_BINS - 1);
+    t->bin_y2 = (uint8_t)LV_CLAMP(0, y2, LV_DRAW_TASK_INDEX_BINS - 1);
+
+    int32_t bx, by;
+    for(by = t->bin_y1; by <= t->bin_y2; by++) {
+        for(bx = t->bin_x1; bx <= t->bin_x2; bx++) {
+            if(bin_add(&index->bins[by * LV_DRAW_TASK_INDEX_BINS + bx], t)) continue;
+
+            /*Undo the bins added already and stop using the index*/
+            int32_t bx_undo, by_undo;
+            for(by_undo = t->bin_y1; by_undo <= by; by_undo++) {
+                for(bx_undo = t->bin_x1; bx_undo <= t->bin_x2; bx_undo++) {
+                    if(by_undo == by && bx_undo == bx) break;
+                    bin_remove(&index->bins[by_undo * LV_DRAW_TASK_INDEX_BINS + bx_undo], t);
+                }
+            }
+
+            index->incomplete = true;
+            if(index->task_cnt == 0) task_index_free(layer);
+            LV_PROFILER_DRAW_END;
+            return;
+        }
+    }
+
+    t->indexed = 1;
+    index->task_cnt++;
+    LV_PROFILER_DRAW_END;
+}
+
+/**
+ * Remove a draw task from the spatial index of its layer.
+ * The index is freed when its last task is removed.
+ * @param t         the draw task to remove
+ */
+static void task_index_remove(lv_draw_task_t * t)
+{
+    if(!t->indexed) return;
+
+    lv_layer_t * layer = t->target_layer;
+    lv_draw_task_index_t * index = layer->task_index;
+    t->indexed = 0;
+    if(index == NULL) return;
+
+    index->task_cnt--;
+    if(index->task_cnt == 0) {
+        task_index_free(layer);
+        return;
+    }
+
+    int32_t bx, by;
+    for(by = t->bin_y1; by <= t->bin_y2; by++) {
+        for(bx = t->bin_x1; bx <= t->bin_x2; bx++) {
+            bin_remove(&index->bins[by * LV_DRAW_TASK_INDEX_BINS + bx], t);
+        }
+    }
+}
+
+/**
+ * Free the spatial index of a layer
+ * @param layer     the layer whose `task_index` is set
+ */
+static void task_index_free(lv_layer_t * layer)
+{
+    lv_draw_task_index_t * index = layer->task_index;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_INDEX_BINS * LV_DRAW_TASK_INDEX_BINS; i++) {
+        lv_free(index->bins[i].tasks);
+    }
+
+    lv_free(index);
+    layer->task_index = NULL;
+}
+
+/**
+ * Add a draw task to the end of a bin
+ * @param bin       pointer to a bin
+ * @param t         the draw task to add
+ * @return          true: added; false: out of memory
+ */
+static bool bin_add(lv_draw_task_bin_t * bin, lv_draw_task_t * t)
+{
+    if(bin->cnt == bin->capacity) {
+        /*Drop the removed tasks first*/
+        uint32_t cnt = 0;
+        uint32_t i;
+        for(i = bin->start; i < bin->cnt; i++) {
+            if(bin->tasks[i]) bin->tasks[cnt++] = bin->tasks[i];
+        }
+        bin->start = 0;
+        bin->cnt = cnt;
+    }
+
+    if(bin->cnt == bin->capacity) {
+        uint32_t capacity = bin->capacity ? bin->capacity * 2 : 8;
+        lv_draw_task_t ** tasks = lv_realloc(bin->tasks, capacity * sizeof(lv_draw_task_t *));
+        if(tasks == NULL) return false;
+        bin->tasks = tasks;
+        bin->capacity = capacity;
+    }
+
+    bin->tasks[bin->cnt++] = t;
+    return true;
+}
+
+/**
+ * Remove a draw task from a bin
+ * @param bin       pointer to a bin
+ * @param t         the draw task to remove
+ */
+static void bin_remove(lv_draw_task_bin_t * bin, const lv_draw_task_t * t)
+{
+    /*Usually the oldest tasks are removed, so it's found at the beginning*/
+    uint32_t i;
+    for(i = bin->start; i < bin->cnt; i++) {
+        if(bin->tasks[i] == t) {
+            bin->tasks[i] = NULL;
+            break;
+        }
+    }
+
+    while(bin->start < bin->cnt && bin->tasks[bin->start] == NULL) bin->start++;
+    if(bin->start == bin->cnt) {
+        bin->start = 0;
+        bin->cnt = 0;
+    }
+}
+
+static inline bool task_is_older(const lv_draw_task_t * t1, const lv_draw_task_t * t2)
+{
+    /*Handle the overflow of the ID counter too*/
+    return (int32_t)(t1->id - t2->id) < 0;
+}
+
+/**
+ * Check if an older draw task needs to be finished before `t_check` can be drawn
+ * @param t             an older draw task
+ * @param t_check       the draw task to check
+ * @param draw_unit_id  draw unit ID for which the independence check is called
+ * @return              true: `t` overlaps with `t_check` and it's not done yet
+ */
+static inline bool task_blocks(const lv_draw_task_t * t, const lv_draw_task_t * t_check, uint8_t draw_unit_id)
+{
+    /*It's independent of finished draw tasks, and queued draw tasks of the same draw unit*/
+    if(t->state == LV_DRAW_TASK_STATE_FINISHED ||
+       (t->state == LV_DRAW_TASK_STATE_QUEUED && t->preferred_draw_unit_id == draw_unit_id)) {
+        return false;
+    }
+
+    lv_area_t a;
+    return lv_area_intersect(&a, &t->_real_area, &t_check->_real_area);
+}
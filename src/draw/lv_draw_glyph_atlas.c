@@ -0,0 +1,389 @@
+/**
+ * @file lv_draw_glyph_atlas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_label_private.h"
+
+#if LV_USE_DRAW_GLYPH_ATLAS
+
+#include "../core/lv_global.h"
+#include "../font/fmt_txt/lv_font_fmt_txt_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define atlas_p (&(LV_GLOBAL_DEFAULT()->glyph_atlas))
+
+#define PAGE_SIZE   LV_DRAW_GLYPH_ATLAS_PAGE_SIZE
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A row of glyphs on a page*/
+typedef struct {
+    int32_t y;
+    int32_t h;
+    int32_t free_x;     /*Start of the unused part of the row*/
+} shelf_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_draw_glyph_atlas_entry_t * find_glyph(const void * font_dsc, uint32_t gid);
+static const lv_draw_buf_t * render_glyph(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
+static bool add_glyph(lv_draw_glyph_atlas_entry_t * entry, const lv_font_glyph_dsc_t * g_dsc,
+                      const lv_draw_buf_t * bitmap);
+static bool reserve(lv_draw_glyph_atlas_page_t * page, int32_t w, int32_t h, int32_t * x, int32_t * y);
+static void clear_page(lv_draw_glyph_atlas_page_t * page);
+static void remove_from_bucket(lv_draw_glyph_atlas_entry_t * entry);
+static uint32_t get_bucket(const void * font_dsc, uint32_t gid);
+static bool is_supported(const lv_font_glyph_dsc_t * g_dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_glyph_atlas_init(void)
+{
+    lv_draw_glyph_atlas_t * atlas = atlas_p;
+    lv_memzero(atlas, sizeof(lv_draw_glyph_atlas_t));
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_GLYPH_ATLAS_PAGE_CNT; i++) {
+        lv_array_init(&atlas->pages[i].shelves, 0, sizeof(shelf_t));
+    }
+
+    lv_mutex_init(&atlas->lock);
+}
+
+void lv_draw_glyph_atlas_deinit(void)
+{
+    lv_draw_glyph_atlas_t * atlas = atlas_p;
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_GLYPH_ATLAS_PAGE_CNT; i++) {
+        lv_draw_glyph_atlas_page_t * page = &atlas->pages[i];
+        clear_page(page);
+        lv_array_deinit(&page->shelves);
+        lv_free(page->data);
+        page->data = NULL;
+    }
+
+    lv_mutex_delete(&atlas->lock);
+}
+
+bool lv_draw_glyph_atlas_acquire(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf,
+                                 lv_draw_glyph_atlas_glyph_t * glyph)
+{
+    if(!is_supported(g_dsc)) return false;
+
+    LV_PROFILER_FONT_BEGIN;
+    lv_draw_glyph_atlas_t * atlas = atlas_p;
+    lv_mutex_lock(&atlas->lock);
+
+    lv_draw_glyph_atlas_entry_t * entry = find_glyph(g_dsc->resolved_font->dsc, g_dsc->gid.index);
+    if(entry) {
+        atlas->hit_cnt++;
+    }
+    else {
+        atlas->miss_cnt++;
+
+        /*Don't block the other threads while the glyph is decompressed*/
+        lv_mutex_unlock(&atlas->lock);
+        const lv_draw_buf_t * bitmap = render_glyph(g_dsc, draw_buf);
+        lv_draw_glyph_atlas_entry_t * new_entry = bitmap ? lv_malloc(sizeof(lv_draw_glyph_atlas_entry_t)) : NULL;
+        if(new_entry == NULL) {
+            LV_PROFILER_FONT_END;
+            return false;
+        }
+
+        lv_mutex_lock(&atlas->lock);
+
+        /*An other thread might have added it meanwhile*/
+        entry = find_glyph(g_dsc->resolved_font->dsc, g_dsc->gid.index);
+        if(entry) {
+            lv_free(new_entry);
+        }
+        else if(add_glyph(new_entry, g_dsc, bitmap)) {
+            entry = new_entry;
+        }
+        else {
+            lv_free(new_entry);
+            lv_mutex_unlock(&atlas->lock);
+            LV_PROFILER_FONT_END;
+            return false;
+        }
+    }
+
+    lv_draw_glyph_atlas_page_t * page = &atlas->pages[entry->page];
+    page->ref_cnt++;
+    page->last_use = ++atlas->clock;
+
+    glyph->data = page->data + entry->y * PAGE_SIZE + entry->x;
+    glyph->stride = PAGE_SIZE;
+    glyph->page = entry->page;
+
+    lv_mutex_unlock(&atlas->lock);
+    LV_PROFILER_FONT_END;
+    return true;
+}
+
+void lv_draw_glyph_atlas_release(const lv_draw_glyph_atlas_glyph_t * glyph)
+{
+    lv_draw_glyph_atlas_t * atlas = atlas_p;
+    lv_mutex_lock(&atlas->lock);
+    LV_ASSERT(atlas->pages[glyph->page].ref_cnt > 0);
+    atlas->pages[glyph->page].ref_cnt--;
+    lv_mutex_unlock(&atlas->lock);
+}
+
+const void * lv_draw_glyph_atlas_get_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    lv_draw_glyph_atlas_glyph_t glyph;
+    if(draw_buf == NULL || !lv_draw_glyph_atlas_acquire(g_dsc, draw_buf, &glyph)) {
+        return lv_font_get_glyph_bitmap(g_dsc, draw_buf);
+    }
+
+    int32_t y;
+    for(y = 0; y < g_dsc->box_h; y++) {
+        lv_memcpy(lv_draw_buf_goto_xy(draw_buf, 0, y), glyph.data + y * glyph.stride, g_dsc->box_w);
+    }
+
+    lv_draw_glyph_atlas_release(&glyph);
+    return draw_buf;
+}
+
+void lv_draw_glyph_atlas_drop(const lv_font_t * font)
+{
+    lv_draw_glyph_atlas_t * atlas = atlas_p;
+    lv_mutex_lock(&atlas->lock);
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_GLYPH_ATLAS_PAGE_CNT; i++) {
+        lv_draw_glyph_atlas_page_t * page = &atlas->pages[i];
+        if(font == NULL) {
+            clear_page(page);
+            continue;
+        }
+
+        /*The space of the dropped glyphs is reused only when the page is cleared*/
+        lv_draw_glyph_atlas_entry_t ** next_p = &page->glyphs;
+        while(*next_p) {
+            lv_draw_glyph_atlas_entry_t * entry = *next_p;
+            if(entry->font_dsc == font->dsc) {
+                *next_p = entry->page_next;
+                remove_from_bucket(entry);
+                lv_free(entry);
+            }
+            else {
+                next_p = &entry->page_next;
+            }
+        }
+    }
+
+    lv_mutex_unlock(&atlas->lock);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_draw_glyph_atlas_entry_t * find_glyph(const void * font_dsc, uint32_t gid)
+{
+    lv_draw_glyph_atlas_entry_t * entry = atlas_p->buckets[get_bucket(font_dsc, gid)];
+    while(entry) {
+        if(entry->font_dsc == font_dsc && entry->gid == gid) return entry;
+        entry = entry->hash_next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the A8 bitmap of a glyph from the font if it can be stored in the atlas
+ * @param g_dsc     the glyph descriptor
+ * @param draw_buf  an A8 draw buffer to render the glyph to
+ * @return          the bitmap with the stride of the glyph's width or NULL on error
+ */
+static const lv_draw_buf_t * render_glyph(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    int32_t w = g_dsc->box_w;
+    int32_t h = g_dsc->box_h;
+    if(w > PAGE_SIZE || h > PAGE_SIZE) return NULL;
+    if(draw_buf == NULL || draw_buf->header.cf != LV_COLOR_FORMAT_A8 ||
+       draw_buf->header.w < w || draw_buf->header.h < h) return NULL;
+
+    g_dsc->req_raw_bitmap = 0;
+    return lv_font_get_glyph_bitmap(g_dsc, draw_buf);
+}
+
+/**
+ * Copy a rendered glyph into the atlas. Use an unused area of the pages, or clear the
+ * least recently used page if there is none. The atlas' lock needs to be held.
+ * @param entry     an allocated entry to fill and add to the atlas
+ * @param g_dsc     the glyph descriptor
+ * @param bitmap    the bitmap returned by `render_glyph`
+ * @return          true: the glyph was added; false: there is no space for it, `entry` is not used
+ */
+static bool add_glyph(lv_draw_glyph_atlas_entry_t * entry, const lv_font_glyph_dsc_t * g_dsc,
+                      const lv_draw_buf_t * bitmap)
+{
+    lv_draw_glyph_atlas_t * atlas = atlas_p;
+    int32_t w = g_dsc->box_w;
+    int32_t h = g_dsc->box_h;
+
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t page_id = -1;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_GLYPH_ATLAS_PAGE_CNT && page_id < 0; i++) {
+        lv_draw_glyph_atlas_page_t * page = &atlas->pages[i];
+        if(page->data == NULL) {
+            page->data = lv_malloc(PAGE_SIZE * PAGE_SIZE);
+            if(page->data == NULL) break;
+        }
+        if(reserve(page, w, h, &x, &y)) page_id = i;
+    }
+
+    if(page_id < 0) {
+        /*Pages with acquired glyphs are being drawn from, so they can't be cleared*/
+        lv_draw_glyph_atlas_page_t * lru = NULL;
+        for(i = 0; i < LV_DRAW_GLYPH_ATLAS_PAGE_CNT; i++) {
+            lv_draw_glyph_atlas_page_t * page = &atlas->pages[i];
+            if(page->data == NULL || page->ref_cnt > 0) continue;
+            if(lru == NULL || page->last_use < lru->last_use) {
+                lru = page;
+                page_id = i;
+            }
+        }
+
+        if(lru == NULL) return false;
+        LV_LOG_TRACE("clear page %" LV_PRId32, page_id);
+        clear_page(lru);
+        reserve(lru, w, h, &x, &y);
+    }
+
+    /*The fonts write the bitmaps with the stride of their width*/
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_A8);
+    lv_draw_glyph_atlas_page_t * page = &atlas->pages[page_id];
+    int32_t row;
+    for(row = 0; row < h; row++) {
+        lv_memcpy(page->data + (y + row) * PAGE_SIZE + x, bitmap->data + row * stride, w);
+    }
+
+    entry->font_dsc = g_dsc->resolved_font->dsc;
+    entry->gid = g_dsc->gid.index;
+    entry->x = x;
+    entry->y = y;
+    entry->page = page_id;
+
+    uint32_t bucket = get_bucket(entry->font_dsc, entry->gid);
+    entry->hash_next = atlas->buckets[bucket];
+    atlas->buckets[bucket] = entry;
+    entry->page_next = page->glyphs;
+    page->glyphs = entry;
+
+    return true;
+}
+
+/**
+ * Find an unused area on a page. The glyphs are put next to each other in rows
+ * which are not much higher than the glyphs.
+ */
+static bool reserve(lv_draw_glyph_atlas_page_t * page, int32_t w, int32_t h, int32_t * x, int32_t * y)
+{
+    shelf_t * fallback = NULL;
+    uint32_t shelf_cnt = lv_array_size(&page->shelves);
+    uint32_t i;
+    for(i = 0; i < shelf_cnt; i++) {
+        shelf_t * shelf = lv_array_at(&page->shelves, i);
+        if(shelf->h < h || shelf->free_x + w > PAGE_SIZE) continue;
+
+        if(shelf->h <= h + h / 4) {
+            fallback = shelf;
+            break;
+        }
+
+        if(fallback == NULL || shelf->h < fallback->h) fallback = shelf;
+    }
+
+    /*Start a new row for the glyphs of this height if there is space for it*/
+    if((fallback == NULL || fallback->h > h + h / 4) && page->free_y + h <= PAGE_SIZE) {
+        shelf_t shelf = {page->free_y, h, 0};
+        if(lv_array_push_back(&page->shelves, &shelf) == LV_RESULT_OK) {
+            page->free_y += h;
+            fallback = lv_array_at(&page->shelves, shelf_cnt);
+        }
+    }
+
+    if(fallback == NULL) return false;
+
+    *x = fallback->free_x;
+    *y = fallback->y;
+    fallback->free_x += w;
+    return true;
+}
+
+static void clear_page(lv_draw_glyph_atlas_page_t * page)
+{
+    lv_draw_glyph_atlas_entry_t * entry = page->glyphs;
+    while(entry) {
+        lv_draw_glyph_atlas_entry_t * next = entry->page_next;
+        remove_from_bucket(entry);
+        lv_free(entry);
+        entry = next;
+    }
+
+    page->glyphs = NULL;
+    page->free_y = 0;
+    lv_array_clear(&page->shelves);
+}
+
+static void remove_from_bucket(lv_draw_glyph_atlas_entry_t * entry)
+{
+    lv_draw_glyph_atlas_entry_t ** next_p = &atlas_p->buckets[get_bucket(entry->font_dsc, entry->gid)];
+    while(*next_p) {
+        if(*next_p == entry) {
+            *next_p = entry->hash_next;
+            return;
+        }
+        next_p = &(*next_p)->hash_next;
+    }
+}
+
+static uint32_t get_bucket(const void * font_dsc, uint32_t gid)
+{
+    uint32_t hash = (uint32_t)((lv_uintptr_t)font_dsc >> 4);
+    hash ^= gid * 2654435761u;
+    hash ^= hash >> 16;
+    return hash & (LV_DRAW_GLYPH_ATLAS_BUCKET_CNT - 1);
+}
+
+/**
+ * Only the glyphs of the LVGL format fonts are stored, as the other fonts have
+ * their own caches (e.g. FreeType) or return images.
+ */
+static bool is_supported(const lv_font_glyph_dsc_t * g_dsc)
+{
+    const lv_font_t * font = g_dsc->resolved_font;
+    if(font == NULL || font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return false;
+    if(g_dsc->format < LV_FONT_GLYPH_FORMAT_A1 || g_dsc->format > LV_FONT_GLYPH_FORMAT_A8) return false;
+    return g_dsc->gid.index != 0 && g_dsc->box_w > 0 && g_dsc->box_h > 0;
+}
+
+#endif /*LV_USE_DRAW_GLYPH_ATLAS*/
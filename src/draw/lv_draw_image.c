@@ -12,6 +12,7 @@
 #include "../image/lv_image_decoder_private.h"
 #include "lv_draw_private.h"
 #include "../core/lv_obj_private.h"
+#include "../core/lv_global.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +30,10 @@ static void img_decode_and_draw(lv_draw_task_t * t, const lv_draw_image_dsc_t *
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
                                 lv_draw_image_core_cb draw_core_cb);
+static void get_draw_area(lv_area_t * draw_area, const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * coords);
+#if LV_USE_IMAGE_DECODER_ASYNC
+    static void draw_async_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -105,15 +110,6 @@ void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
 
     LV_PROFILER_DRAW_BEGIN;
 
-    if(dsc->base.drop_shadow_opa) {
-        lv_layer_t * ds_layer = lv_draw_layer_create_drop_shadow(layer, &dsc->base, coords);
-        LV_ASSERT_NULL(ds_layer);
-        lv_draw_image_dsc_t ds_dsc = *dsc;
-        ds_dsc.base.drop_shadow_opa = 0; /*Disable drop shadow so rendering below will render plain image*/
-        lv_draw_image(ds_layer, &ds_dsc, coords);
-        lv_draw_layer_finish_drop_shadow(ds_layer, &dsc->base);
-    }
-
     lv_draw_image_dsc_t new_image_dsc;
     lv_memcpy(&new_image_dsc, dsc, sizeof(*dsc));
     lv_result_t res = lv_image_decoder_get_info(new_image_dsc.src, &new_image_dsc.header);
@@ -123,6 +119,25 @@ void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
         return;
     }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Leave the image out until it's decoded in the background. The widget will be redrawn then.*/
+    if(!(new_image_dsc.header.flags & LV_IMAGE_FLAGS_CUSTOM_DRAW) &&
+       lv_image_decoder_async_defer(new_image_dsc.src, &new_image_dsc.header, dsc->base.obj)) {
+        draw_async_placeholder(layer, dsc, coords);
+        LV_PROFILER_DRAW_END;
+        return;
+    }
+#endif
+
+    if(dsc->base.drop_shadow_opa) {
+        lv_layer_t * ds_layer = lv_draw_layer_create_drop_shadow(layer, &dsc->base, coords);
+        LV_ASSERT_NULL(ds_layer);
+        lv_draw_image_dsc_t ds_dsc = *dsc;
+        ds_dsc.base.drop_shadow_opa = 0; /*Disable drop shadow so rendering below will render plain image*/
+        lv_draw_image(ds_layer, &ds_dsc, coords);
+        lv_draw_layer_finish_drop_shadow(ds_layer, &dsc->base);
+    }
+
     /*If the image_area is not set assume that it's the same as the rendering area */
     if(new_image_dsc.image_area.x2 == LV_COORD_MIN) {
         new_image_dsc.image_area = *coords;
@@ -230,25 +245,16 @@ void lv_draw_image_normal_helper(lv_draw_task_t * t, const lv_draw_image_dsc_t *
     }
 
     lv_area_t draw_area;
-    lv_area_copy(&draw_area, coords);
-    if(draw_dsc->rotation || draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE) {
-        int32_t w = lv_area_get_width(coords);
-        int32_t h = lv_area_get_height(coords);
-
-        lv_image_buf_get_transformed_area(&draw_area, w, h, draw_dsc->rotation, draw_dsc->scale_x, draw_dsc->scale_y,
-                                          &draw_dsc->pivot);
-
-        draw_area.x1 += coords->x1;
-        draw_area.y1 += coords->y1;
-        draw_area.x2 += coords->x1;
-        draw_area.y2 += coords->y1;
-    }
+    get_draw_area(&draw_area, draw_dsc, coords);
 
     lv_area_t clipped_img_area;
     if(!lv_area_intersect(&clipped_img_area, &draw_area, &t->clip_area)) {
         return;
     }
 
+    lv_image_decoder_args_t args_buf;
+    decoder_args = lv_draw_image_get_decoder_args(draw_dsc, decoder_args, &args_buf);
+
     lv_image_decoder_dsc_t decoder_dsc;
     lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, decoder_args);
     if(res != LV_RESULT_OK) {
@@ -261,6 +267,40 @@ void lv_draw_image_normal_helper(lv_draw_task_t * t, const lv_draw_image_dsc_t *
     lv_image_decoder_close(&decoder_dsc);
 }
 
+const lv_image_decoder_args_t * lv_draw_image_get_decoder_args(const lv_draw_image_dsc_t * draw_dsc,
+                                                               const lv_image_decoder_args_t * decoder_args,
+                                                               lv_image_decoder_args_t * buf)
+{
+    if(draw_dsc->rotation == 0 && draw_dsc->scale_x == LV_SCALE_NONE && draw_dsc->scale_y == LV_SCALE_NONE) {
+        return decoder_args;
+    }
+
+    if(decoder_args) *buf = *decoder_args;
+    else lv_image_decoder_args_init(buf);
+    buf->no_roi = true;
+    return buf;
+}
+
+void lv_draw_image_opened_helper(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                                 const lv_area_t * coords, lv_image_decoder_dsc_t * decoder_dsc,
+                                 lv_draw_image_core_cb draw_core_cb)
+{
+    if(draw_core_cb == NULL) {
+        LV_LOG_WARN("draw_core_cb is NULL");
+        return;
+    }
+
+    lv_area_t draw_area;
+    get_draw_area(&draw_area, draw_dsc, coords);
+
+    lv_area_t clipped_img_area;
+    if(!lv_area_intersect(&clipped_img_area, &draw_area, &t->clip_area)) {
+        return;
+    }
+
+    img_decode_and_draw(t, draw_dsc, decoder_dsc, NULL, coords, &clipped_img_area, draw_core_cb);
+}
+
 void lv_draw_image_tiled_helper(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
                                 const lv_area_t * coords, lv_draw_image_core_cb draw_core_cb,
                                 const lv_image_decoder_args_t * decoder_args)
@@ -270,6 +310,9 @@ void lv_draw_image_tiled_helper(lv_draw_task_t * t, const lv_draw_image_dsc_t *
         return;
     }
 
+    lv_image_decoder_args_t args_buf;
+    decoder_args = lv_draw_image_get_decoder_args(draw_dsc, decoder_args, &args_buf);
+
     lv_image_decoder_dsc_t decoder_dsc;
     lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, decoder_args);
     if(res != LV_RESULT_OK) {
@@ -352,6 +395,29 @@ void lv_image_buf_get_transformed_area(lv_area_t * res, int32_t w, int32_t h, in
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the area of an image after rotation and scaling
+ * @param draw_area     store the absolute coordinates of the transformed image here
+ * @param draw_dsc      the draw descriptor of the image
+ * @param coords        the absolute coordinates of the image
+ */
+static void get_draw_area(lv_area_t * draw_area, const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * coords)
+{
+    lv_area_copy(draw_area, coords);
+    if(draw_dsc->rotation || draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE) {
+        int32_t w = lv_area_get_width(coords);
+        int32_t h = lv_area_get_height(coords);
+
+        lv_image_buf_get_transformed_area(draw_area, w, h, draw_dsc->rotation, draw_dsc->scale_x, draw_dsc->scale_y,
+                                          &draw_dsc->pivot);
+
+        draw_area->x1 += coords->x1;
+        draw_area->y1 += coords->y1;
+        draw_area->x2 += coords->x1;
+        draw_area->y2 += coords->y1;
+    }
+}
+
 static void img_decode_and_draw(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
@@ -394,3 +460,24 @@ static void img_decode_and_draw(lv_draw_task_t * t, const lv_draw_image_dsc_t *
         }
     }
 }
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Fill the area of an image which is being decoded in the background
+ */
+static void draw_async_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    const lv_image_decoder_async_t * async = &LV_GLOBAL_DEFAULT()->img_decoder_async;
+    lv_opa_t opa = LV_OPA_MIX2(async->placeholder_opa, dsc->opa);
+    if(opa <= LV_OPA_MIN) return;
+
+    lv_draw_fill_dsc_t fill_dsc;
+    lv_draw_fill_dsc_init(&fill_dsc);
+    fill_dsc.base = dsc->base;
+    fill_dsc.base.drop_shadow_opa = 0;
+    fill_dsc.color = async->placeholder_color;
+    fill_dsc.opa = opa;
+    fill_dsc.radius = dsc->clip_radius;
+    lv_draw_fill(layer, &fill_dsc, coords);
+}
+#endif
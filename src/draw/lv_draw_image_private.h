@@ -52,6 +52,32 @@ void lv_draw_image_normal_helper(lv_draw_task_t * t, const lv_draw_image_dsc_t *
                                  const lv_area_t * coords, lv_draw_image_core_cb draw_core_cb,
                                  const lv_image_decoder_args_t * decoder_args);
 
+/**
+ * Get the arguments to open an image with for drawing. The images decoded in tiles with
+ * `LV_USE_IMAGE_DECODER_ROI` can be drawn only without rotation and scaling, so the
+ * transformed images are decoded fully.
+ * @param draw_dsc      the draw descriptor of the image
+ * @param decoder_args  the args of the draw unit, or NULL for defaults
+ * @param buf           storage for the modified args
+ * @return              `decoder_args` or `buf`
+ */
+const lv_image_decoder_args_t * lv_draw_image_get_decoder_args(const lv_draw_image_dsc_t * draw_dsc,
+                                                               const lv_image_decoder_args_t * decoder_args,
+                                                               lv_image_decoder_args_t * buf);
+
+/**
+ * Same as `lv_draw_image_normal_helper` but draws an image which is already opened.
+ * Useful to open an image only once if it's drawn in more parts.
+ * @param t             pointer to a draw task
+ * @param draw_dsc      the draw descriptor of the image
+ * @param coords        the absolute coordinates of the image
+ * @param decoder_dsc   the image opened with `lv_image_decoder_open`. It's not closed.
+ * @param draw_core_cb  a callback to perform the actual rendering
+ */
+void lv_draw_image_opened_helper(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                                 const lv_area_t * coords, lv_image_decoder_dsc_t * decoder_dsc,
+                                 lv_draw_image_core_cb draw_core_cb);
+
 /**
  * Can be used by draw units for TILED images to handle the decoding and
  * prepare everything for the actual image rendering
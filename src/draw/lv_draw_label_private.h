@@ -15,11 +15,16 @@ extern "C" {
  *********************/
 
 #include "../lvgl_public.h"
+#include "../misc/lv_array.h"
+#include "../osal/lv_os_private.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/** Number of the hash buckets of the glyph atlas*/
+#define LV_DRAW_GLYPH_ATLAS_BUCKET_CNT  256
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -58,11 +63,92 @@ struct _lv_draw_glyph_dsc_t {
     lv_draw_buf_t * _draw_buf; /**< a shared draw buf for get_bitmap, do not use it directly, use glyph_data instead */
 };
 
+#if LV_USE_DRAW_GLYPH_ATLAS
+
+/** A glyph stored in the glyph atlas*/
+typedef struct _lv_draw_glyph_atlas_entry_t {
+    const void * font_dsc;      /**< `dsc` of the font, as copies of a font share its glyphs*/
+    uint32_t gid;
+    uint16_t x;
+    uint16_t y;
+    uint16_t page;
+    struct _lv_draw_glyph_atlas_entry_t * hash_next;    /**< Next glyph in the same hash bucket*/
+    struct _lv_draw_glyph_atlas_entry_t * page_next;    /**< Next glyph on the same page*/
+} lv_draw_glyph_atlas_entry_t;
+
+/** An A8 page of the glyph atlas. The glyphs are packed in rows ("shelves") of similar height.*/
+typedef struct {
+    uint8_t * data;                         /**< LV_DRAW_GLYPH_ATLAS_PAGE_SIZE squared pixels, NULL until used*/
+    lv_array_t shelves;                     /**< The rows of glyphs*/
+    int32_t free_y;                         /**< Start of the unused area below the shelves*/
+    lv_draw_glyph_atlas_entry_t * glyphs;   /**< The glyphs on this page*/
+    uint32_t last_use;
+    uint32_t ref_cnt;                       /**< Number of the acquired glyphs, which can't be evicted*/
+} lv_draw_glyph_atlas_page_t;
+
+typedef struct {
+    lv_draw_glyph_atlas_page_t pages[LV_DRAW_GLYPH_ATLAS_PAGE_CNT];
+    lv_draw_glyph_atlas_entry_t * buckets[LV_DRAW_GLYPH_ATLAS_BUCKET_CNT];
+    uint32_t clock;
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+    lv_mutex_t lock;
+} lv_draw_glyph_atlas_t;
+
+/** An acquired glyph of the glyph atlas*/
+typedef struct {
+    const uint8_t * data;   /**< The top left pixel of the glyph*/
+    uint32_t stride;        /**< Stride of the page*/
+    uint32_t page;
+} lv_draw_glyph_atlas_glyph_t;
+
+#endif /*LV_USE_DRAW_GLYPH_ATLAS*/
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_DRAW_GLYPH_ATLAS
+
+/**
+ * Initialize the glyph atlas
+ */
+void lv_draw_glyph_atlas_init(void);
+
+/**
+ * Free the pages and the glyphs of the glyph atlas
+ */
+void lv_draw_glyph_atlas_deinit(void);
+
+/**
+ * Get the A8 bitmap of a glyph from the glyph atlas, rendering it there first if needed.
+ * The glyph stays valid until `lv_draw_glyph_atlas_release` is called.
+ * @param g_dsc     the glyph descriptor of the glyph
+ * @param draw_buf  an A8 draw buffer of at least the size of the glyph to render the glyph into
+ * @param glyph     store the location of the glyph here
+ * @return          true: the glyph was acquired; false: the glyph can't be stored in the atlas,
+ *                  e.g. its font is not a `fmt_txt` font or all pages are in use
+ */
+bool lv_draw_glyph_atlas_acquire(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf,
+                                 lv_draw_glyph_atlas_glyph_t * glyph);
+
+/**
+ * Release a glyph acquired with `lv_draw_glyph_atlas_acquire`
+ * @param glyph     the acquired glyph
+ */
+void lv_draw_glyph_atlas_release(const lv_draw_glyph_atlas_glyph_t * glyph);
+
+/**
+ * Get the bitmap of a glyph like `lv_font_get_glyph_bitmap`, copying it from the glyph atlas
+ * if it can be stored there
+ * @param g_dsc     the glyph descriptor of the glyph
+ * @param draw_buf  an A8 draw buffer of the size of the glyph
+ * @return          `draw_buf` or what `lv_font_get_glyph_bitmap` returns
+ */
+const void * lv_draw_glyph_atlas_get_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
+
+#endif /*LV_USE_DRAW_GLYPH_ATLAS*/
+
 /**********************
  *      MACROS
  **********************/
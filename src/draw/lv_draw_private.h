@@ -22,11 +22,21 @@ extern "C" {
 #include "../osal/lv_os_private.h"
 #include "../misc/cache/lv_cache.h"
 #include "../misc/cache/lv_cache_entry.h"
+#include "../misc/lv_array.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/** The layer is divided into a grid of LV_DRAW_TASK_INDEX_BINS x LV_DRAW_TASK_INDEX_BINS bins
+ *  to find the draw tasks which might overlap a given area quickly*/
+#define LV_DRAW_TASK_INDEX_BINS  8
+
+/** The draw tasks are kept in the pool in lists by their size rounded up to
+ *  LV_DRAW_TASK_POOL_CLASS_SIZE. Larger draw tasks are not pooled.*/
+#define LV_DRAW_TASK_POOL_CLASS_SIZE    64
+#define LV_DRAW_TASK_POOL_CLASS_CNT     16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -85,6 +95,67 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /** Set when the task is added to the `task_index` of its layer */
+    uint8_t indexed : 1;
+
+    /** The range of the bins in the layer's `task_index` touched by `_real_area` */
+    uint8_t bin_x1;
+    uint8_t bin_y1;
+    uint8_t bin_x2;
+    uint8_t bin_y2;
+
+    /** Increasing counter to tell which of two draw tasks of a layer was created earlier */
+    uint32_t id;
+};
+
+#if LV_USE_OBJ_RETAINED_DRAW
+/**
+ * Copies of draw tasks created on a layer to add them again later, possibly in an other position
+ */
+struct _lv_draw_recording_t {
+    lv_array_t tasks;       /**< Pointers to the recorded draw tasks and their draw descriptors*/
+    lv_area_t coords;       /**< Reference area, the tasks are translated by the change of its position*/
+    lv_color32_t recolor;   /**< Recolor of the layer while recording. It's already applied on the colors*/
+    lv_opa_t opa;           /**< Opacity of the layer while recording. It's already applied on the colors*/
+    bool valid;             /**< false: nothing was recorded or a draw task couldn't be recorded*/
+};
+#endif
+
+/**
+ * The draw tasks touching a bin of a `lv_draw_task_index_t`
+ */
+typedef struct {
+    /** The tasks in the order they were added. The removed ones are NULL until compacted*/
+    lv_draw_task_t ** tasks;
+
+    /** The entries before it are all removed*/
+    uint32_t start;
+
+    /** Number of used entries, including the removed ones*/
+    uint32_t cnt;
+
+    uint32_t capacity;
+} lv_draw_task_bin_t;
+
+/**
+ * Spatial index of the draw tasks of a layer.
+ * Each bin lists the draw tasks which touch it, therefore a draw task needs to be
+ * checked only against the older draw tasks in its bins.
+ */
+struct _lv_draw_task_index_t {
+    /** The area covered by the bins. Tasks outside of it are mapped to the edge bins*/
+    lv_area_t area;
+    int32_t bin_w;
+    int32_t bin_h;
+
+    lv_draw_task_bin_t bins[LV_DRAW_TASK_INDEX_BINS * LV_DRAW_TASK_INDEX_BINS];
+
+    /** Number of indexed draw tasks. The index is freed when it becomes 0*/
+    uint32_t task_cnt;
+
+    /** Set if a draw task couldn't be added to the bins. No more tasks are added then,
+     *  and all the tasks are checked without the index until it's freed*/
+    bool incomplete;
 };
 
 struct _lv_draw_mask_t {
@@ -193,7 +264,16 @@ typedef struct {
     volatile int dispatch_req;
 #endif
     lv_mutex_t circle_cache_mutex;
+    uint32_t task_id_cnt;
     bool task_running;
+#if LV_USE_DRAW_TASK_POOL
+    /** Lists of finished draw tasks by size class, linked by their `next` field*/
+    lv_draw_task_t * task_pool[LV_DRAW_TASK_POOL_CLASS_CNT];
+    lv_draw_task_pool_stats_t task_pool_stats;
+
+    /** Protects the lists and the statistics as the draw tasks are freed by the draw units' threads too*/
+    lv_mutex_t task_pool_mutex;
+#endif
 } lv_draw_global_info_t;
 
 /**********************
@@ -212,6 +292,55 @@ typedef struct {
  */
 void lv_draw_cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
 
+#if LV_USE_OBJ_RETAINED_DRAW
+
+/**
+ * Initialize an empty draw recording
+ * @param rec       pointer to a draw recording
+ */
+void lv_draw_recording_init(lv_draw_recording_t * rec);
+
+/**
+ * Free all the memory used by a draw recording
+ * @param rec       pointer to a draw recording
+ */
+void lv_draw_recording_deinit(lv_draw_recording_t * rec);
+
+/**
+ * Free the recorded draw tasks and mark the recording as invalid
+ * @param rec       pointer to a draw recording
+ */
+void lv_draw_recording_reset(lv_draw_recording_t * rec);
+
+/**
+ * Start recording the draw tasks added to a layer. The previously recorded tasks are freed.
+ * @param layer     pointer to a layer
+ * @param rec       pointer to a draw recording
+ * @param coords    reference area. The tasks will be translated by the change of its position
+ */
+void lv_draw_recording_start(lv_layer_t * layer, lv_draw_recording_t * rec, const lv_area_t * coords);
+
+/**
+ * Stop recording the draw tasks of a layer
+ * @param layer     pointer to a layer
+ * @return          true: all the draw tasks were recorded; false: some draw tasks can't be
+ *                  recorded (e.g. layers or masks), so the recording was reset
+ */
+bool lv_draw_recording_stop(lv_layer_t * layer);
+
+/**
+ * Add the recorded draw tasks to a layer again
+ * @param layer     pointer to a layer. Its current clip area is applied on the draw tasks.
+ * @param rec       pointer to a draw recording
+ * @param coords    the current position of the reference area
+ * @return          LV_RESULT_OK: the draw tasks were added;
+ *                  LV_RESULT_INVALID: nothing was added as the recording is not valid, the size of
+ *                  the reference area or the opacity or recolor of the layer has changed
+ */
+lv_result_t lv_draw_recording_replay(lv_layer_t * layer, const lv_draw_recording_t * rec, const lv_area_t * coords);
+
+#endif /*LV_USE_OBJ_RETAINED_DRAW*/
+
 /**********************
  *      MACROS
  **********************/
@@ -255,7 +255,12 @@ static bool letter_create_cb(letter_item_t * item, void * user_data)
         return false;
     }
 
+#if LV_USE_DRAW_GLYPH_ATLAS
+    /*Don't decompress the glyph again if its texture was evicted*/
+    const lv_draw_buf_t * bitmap_draw_buf = (const lv_draw_buf_t *)lv_draw_glyph_atlas_get_bitmap(g_dsc, image_buf);
+#else
     const lv_draw_buf_t * bitmap_draw_buf = (const lv_draw_buf_t *)lv_font_get_glyph_bitmap(g_dsc, image_buf);
+#endif
     if(!bitmap_draw_buf) {
         LV_PROFILER_DRAW_END;
         return false;
@@ -169,6 +169,64 @@ void lv_draw_sw_blend(lv_draw_task_t * t, const lv_draw_sw_blend_dsc_t * dsc)
     LV_PROFILER_DRAW_END;
 }
 
+#if LV_DRAW_SW_BLEND_USE_ROWS
+void lv_draw_sw_blend_rows(lv_draw_sw_blend_row_cb_t row_cb, uint32_t px_cnt,
+                           uint32_t dest_px_size, void * dest_buf, int32_t dest_stride,
+                           uint32_t src_px_size, const void * src_buf, int32_t src_stride,
+                           const lv_opa_t * mask_buf, int32_t mask_stride,
+                           uint32_t color, lv_opa_t opa, int32_t w, int32_t h)
+{
+    LV_ASSERT(px_cnt <= LV_DRAW_SW_BLEND_ROW_PX_CNT_MAX);
+
+    int32_t body_w = w & ~(int32_t)(px_cnt - 1);
+    int32_t tail_w = w - body_w;
+
+    /*The buffers of the last pixels of the rows*/
+    uint32_t dest_tail[LV_DRAW_SW_BLEND_ROW_PX_CNT_MAX] = {0};
+    uint32_t src_tail[LV_DRAW_SW_BLEND_ROW_PX_CNT_MAX] = {0};
+    lv_opa_t mask_tail[LV_DRAW_SW_BLEND_ROW_PX_CNT_MAX] = {0};
+
+    lv_draw_sw_blend_row_t row;
+    row.color = color;
+    row.opa = opa;
+
+    uint8_t * dest = dest_buf;
+    const uint8_t * src = src_buf;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(body_w > 0) {
+            row.dest = dest;
+            row.src = src;
+            row.mask = mask_buf;
+            row.w = body_w;
+            row_cb(&row);
+        }
+
+        if(tail_w > 0) {
+            lv_memcpy(dest_tail, dest + body_w * dest_px_size, tail_w * dest_px_size);
+            row.dest = dest_tail;
+            row.src = NULL;
+            if(src) {
+                lv_memcpy(src_tail, src + body_w * src_px_size, tail_w * src_px_size);
+                row.src = src_tail;
+            }
+            row.mask = NULL;
+            if(mask_buf) {
+                lv_memcpy(mask_tail, mask_buf + body_w, tail_w);
+                row.mask = mask_tail;
+            }
+            row.w = px_cnt;
+            row_cb(&row);
+            lv_memcpy(dest + body_w * dest_px_size, dest_tail, tail_w * dest_px_size);
+        }
+
+        dest += dest_stride;
+        if(src) src += src_stride;
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+#endif /*LV_DRAW_SW_BLEND_USE_ROWS*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
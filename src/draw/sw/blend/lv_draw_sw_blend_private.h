@@ -22,14 +22,32 @@ extern "C" {
  *      DEFINES
  *********************/
 
-/**********************
- *      TYPEDEFS
- **********************/
+/** Blend the rows of an area with kernels processing more pixels at once, see `lv_draw_sw_blend_rows`*/
+#define LV_DRAW_SW_BLEND_USE_ROWS   (LV_USE_DRAW_SW_SIMD || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86)
+
+#if LV_DRAW_SW_BLEND_USE_ROWS
+/** The row kernels can process at most this many pixels at once*/
+#define LV_DRAW_SW_BLEND_ROW_PX_CNT_MAX     16
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_BLEND_USE_ROWS
+/** A row of pixels to blend with a row kernel*/
+typedef struct {
+    void * dest;
+    const void * src;           /**< Pixels to blend, or NULL to blend `color`*/
+    const lv_opa_t * mask;      /**< NULL if there is no mask*/
+    uint32_t color;             /**< The color as `lv_color_to_u32` or `lv_color_to_u16` returns it*/
+    int32_t w;                  /**< Multiple of the number of pixels the kernel processes at once*/
+    lv_opa_t opa;
+} lv_draw_sw_blend_row_t;
+
+typedef void (*lv_draw_sw_blend_row_cb_t)(const lv_draw_sw_blend_row_t * row);
+#endif
+
 struct _lv_draw_sw_blend_dsc_t {
     const lv_area_t * blend_area;   /**< The area with absolute coordinates to draw on `layer->buf`
                                      *   will be clipped to `layer->clip_area` */
@@ -79,6 +97,34 @@ struct _lv_draw_sw_blend_image_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_DRAW_SW_BLEND_USE_ROWS
+/**
+ * Blend the rows of an area with a kernel processing `px_cnt` pixels at once.
+ * The last pixels of the rows are blended in temporary buffers with the same kernel,
+ * so the results are the same everywhere.
+ * @param row_cb        the kernel
+ * @param px_cnt        the kernel processes this many pixels at once.
+ *                      Power of 2, at most `LV_DRAW_SW_BLEND_ROW_PX_CNT_MAX`
+ * @param dest_px_size  the size of the destination pixels in bytes
+ * @param dest_buf      the first pixel to blend to
+ * @param dest_stride   the stride of `dest_buf` in bytes
+ * @param src_px_size   the size of the source pixels in bytes
+ * @param src_buf       the image to blend or NULL to blend `color`
+ * @param src_stride    the stride of `src_buf` in bytes
+ * @param mask_buf      mask to apply or NULL
+ * @param mask_stride   the stride of `mask_buf` in bytes
+ * @param color         the color to blend as `lv_color_to_u32` or `lv_color_to_u16` returns it
+ * @param opa           the overall opacity
+ * @param w             the width of the area
+ * @param h             the height of the area
+ */
+void lv_draw_sw_blend_rows(lv_draw_sw_blend_row_cb_t row_cb, uint32_t px_cnt,
+                           uint32_t dest_px_size, void * dest_buf, int32_t dest_stride,
+                           uint32_t src_px_size, const void * src_buf, int32_t src_stride,
+                           const lv_opa_t * mask_buf, int32_t mask_stride,
+                           uint32_t color, lv_opa_t opa, int32_t w, int32_t h);
+#endif
+
 /**********************
  *      MACROS
  **********************/
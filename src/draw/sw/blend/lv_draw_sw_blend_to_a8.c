@@ -21,6 +21,10 @@
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
 
+#if LV_USE_DRAW_SW_SIMD
+    #include "simd/lv_blend_simd.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
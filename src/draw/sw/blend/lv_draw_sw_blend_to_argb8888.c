@@ -17,10 +17,16 @@
     #include "neon/lv_blend_neon.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "helium/lv_blend_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    #include "x86/lv_blend_x86.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
 
+#if LV_USE_DRAW_SW_SIMD
+    #include "simd/lv_blend_simd.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -0,0 +1,472 @@
+/**
+ * @file lv_blend_simd.c
+ * Blend functions written with the vector extensions of GCC and Clang
+ *
+ * The pixels are processed in 32 bit lanes, `PX_CNT` pixels at once.
+ * The last pixels of the rows are blended in temporary buffers with the same kernels.
+ * The results are the same as the results of the C implementation, bit by bit.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_simd.h"
+#if LV_USE_DRAW_SW_SIMD
+
+#if !defined(__GNUC__)
+    #error "LV_USE_DRAW_SW_SIMD requires GCC or Clang"
+#endif
+
+#include "../lv_draw_sw_blend_private.h"
+
+#if !defined(__clang__)
+    /*The vectors are passed only to static functions so the ABI they are passed with doesn't matter*/
+    #pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** The kernels process this many pixels at once*/
+#define PX_CNT      8
+
+/*Functions returning vectors are never called to keep the vectors in registers*/
+#define INLINE      inline __attribute__((always_inline))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef uint32_t vec_u32_t __attribute__((vector_size(PX_CNT * 4)));
+typedef uint16_t vec_u16_t __attribute__((vector_size(PX_CNT * 2)));
+typedef uint8_t vec_u8_t __attribute__((vector_size(PX_CNT)));
+typedef float vec_f32_t __attribute__((vector_size(PX_CNT * 4)));
+
+/** `PX_CNT` pixels to mix, in 32 bit lanes. They are passed by pointers as the ABI of vectors depends on the CPU.*/
+typedef struct {
+    vec_u32_t fg;
+    vec_u32_t bg;
+    vec_u32_t opa;
+    vec_u32_t res;
+} px_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void row_to_argb8888(const lv_draw_sw_blend_row_t * row);
+static void row_to_xrgb8888(const lv_draw_sw_blend_row_t * row);
+static void row_to_rgb565(const lv_draw_sw_blend_row_t * row);
+static void row_rgb565_to_rgb565(const lv_draw_sw_blend_row_t * row);
+static void row_to_l8(const lv_draw_sw_blend_row_t * row);
+static void row_to_a8(const lv_draw_sw_blend_row_t * row);
+static lv_result_t blend_rows(lv_draw_sw_blend_row_cb_t row_cb, uint32_t dest_px_size,
+                              void * dest_buf, int32_t dest_stride,
+                              uint32_t src_px_size, const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              uint32_t color, lv_opa_t opa, int32_t w, int32_t h);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define SPLAT(v)            ((vec_u32_t){0} + (uint32_t)(v))
+
+/*Lanes of `a` where `m` is all ones, and lanes of `b` elsewhere*/
+#define SELECT(m, a, b)     ((((vec_u32_t)(m)) & (a)) | (~((vec_u32_t)(m)) & (b)))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_draw_sw_blend_simd_color_to_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    /*A plain fill is a simple store in C too*/
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    return blend_rows(row_to_argb8888, 4, dsc->dest_buf, dsc->dest_stride, 0, NULL, 0,
+                      dsc->mask_buf, dsc->mask_stride, lv_color_to_u32(dsc->color), dsc->opa,
+                      dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_argb8888_to_argb8888(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return blend_rows(row_to_argb8888, 4, dsc->dest_buf, dsc->dest_stride, 4, dsc->src_buf, dsc->src_stride,
+                      dsc->mask_buf, dsc->mask_stride, 0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    return blend_rows(row_to_rgb565, 2, dsc->dest_buf, dsc->dest_stride, 0, NULL, 0,
+                      dsc->mask_buf, dsc->mask_stride, lv_color_to_u16(dsc->color), dsc->opa,
+                      dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_rgb565_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return blend_rows(row_rgb565_to_rgb565, 2, dsc->dest_buf, dsc->dest_stride, 2, dsc->src_buf, dsc->src_stride,
+                      dsc->mask_buf, dsc->mask_stride, 0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_argb8888_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return blend_rows(row_to_rgb565, 2, dsc->dest_buf, dsc->dest_stride, 4, dsc->src_buf, dsc->src_stride,
+                      dsc->mask_buf, dsc->mask_stride, 0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_color_to_rgb888(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    /*RGB888 pixels don't fit into the 32 bit lanes*/
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    return blend_rows(row_to_xrgb8888, 4, dsc->dest_buf, dsc->dest_stride, 0, NULL, 0,
+                      dsc->mask_buf, dsc->mask_stride, lv_color_to_u32(dsc->color), dsc->opa,
+                      dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_argb8888_to_rgb888(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    return blend_rows(row_to_xrgb8888, 4, dsc->dest_buf, dsc->dest_stride, 4, dsc->src_buf, dsc->src_stride,
+                      dsc->mask_buf, dsc->mask_stride, 0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_color_to_l8(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    return blend_rows(row_to_l8, 1, dsc->dest_buf, dsc->dest_stride, 0, NULL, 0,
+                      dsc->mask_buf, dsc->mask_stride, lv_color_luminance(dsc->color), dsc->opa,
+                      dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_simd_color_to_a8(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    /*A plain fill is a memset in C*/
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    return blend_rows(row_to_a8, 1, dsc->dest_buf, dsc->dest_stride, 0, NULL, 0,
+                      dsc->mask_buf, dsc->mask_stride, 0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static INLINE vec_u32_t load_u32(const void * p)
+{
+    vec_u32_t v;
+    __builtin_memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static INLINE vec_u32_t load_u16(const void * p)
+{
+    vec_u16_t v;
+    __builtin_memcpy(&v, p, sizeof(v));
+    return __builtin_convertvector(v, vec_u32_t);
+}
+
+static INLINE vec_u32_t load_u8(const void * p)
+{
+    vec_u8_t v;
+    __builtin_memcpy(&v, p, sizeof(v));
+    return __builtin_convertvector(v, vec_u32_t);
+}
+
+static INLINE void store_u32(void * p, const vec_u32_t * v)
+{
+    __builtin_memcpy(p, v, sizeof(*v));
+}
+
+static INLINE void store_u16(void * p, const vec_u32_t * v)
+{
+    vec_u16_t v16 = __builtin_convertvector(*v, vec_u16_t);
+    __builtin_memcpy(p, &v16, sizeof(v16));
+}
+
+static INLINE void store_u8(void * p, const vec_u32_t * v)
+{
+    vec_u8_t v8 = __builtin_convertvector(*v, vec_u8_t);
+    __builtin_memcpy(p, &v8, sizeof(v8));
+}
+
+/**
+ * Get the opacity of ARGB8888 pixels as the C implementation calculates them
+ * @param row       the row to blend
+ * @param px        the pixels with `fg` set
+ * @param x         the index of the first pixel
+ * @return          the opacity of the pixels
+ */
+static INLINE vec_u32_t get_opa(const lv_draw_sw_blend_row_t * row, const px_t * px, int32_t x)
+{
+    vec_u32_t fg_opa = px->fg >> 24;
+    if(row->mask == NULL) {
+        if(row->opa >= LV_OPA_MAX) return fg_opa;
+        /*LV_OPA_MIX2*/
+        return (fg_opa * (uint32_t)row->opa) >> 8;
+    }
+
+    vec_u32_t mask = load_u8(&row->mask[x]);
+    if(row->opa >= LV_OPA_MAX) return (fg_opa * mask) >> 8;
+    /*LV_OPA_MIX3*/
+    return (fg_opa * mask * (uint32_t)row->opa) >> 16;
+}
+
+/**
+ * Get the opacity of a color or of pixels without alpha channel as the C implementation calculates it
+ */
+static INLINE vec_u32_t get_color_opa(const lv_draw_sw_blend_row_t * row, int32_t x)
+{
+    if(row->mask == NULL) return SPLAT(row->opa);
+
+    vec_u32_t mask = load_u8(&row->mask[x]);
+    if(row->opa >= LV_OPA_MAX) return mask;
+    return (mask * (uint32_t)row->opa) >> 8;
+}
+
+/**
+ * Mix ARGB8888 pixels like `lv_color_32_32_mix` in lv_draw_sw_blend_to_argb8888.c
+ */
+static INLINE vec_u32_t mix_to_argb8888(const px_t * px)
+{
+    vec_u32_t fg = px->fg;
+    vec_u32_t bg = px->bg;
+    vec_u32_t fg_opa = px->opa;
+    vec_u32_t bg_opa = bg >> 24;
+
+    /*The alpha of the result and the ratio of the foreground.
+     *The quotient is below 256 so the float division truncates to the exact integer quotient.*/
+    vec_u32_t res_opa = 255 - (((255 - fg_opa) * (255 - bg_opa)) >> 8);
+    vec_f32_t ratio_f = __builtin_convertvector(fg_opa * 255, vec_f32_t) / __builtin_convertvector(res_opa, vec_f32_t);
+    vec_u32_t ratio = __builtin_convertvector(ratio_f, vec_u32_t);
+
+    /*`lv_color_mix32` takes the foreground above LV_OPA_MAX and the background below LV_OPA_MIN*/
+    ratio = SELECT(ratio >= LV_OPA_MAX, SPLAT(255), ratio);
+    ratio = SELECT(ratio <= LV_OPA_MIN, SPLAT(0), ratio);
+    vec_u32_t ratio_inv = 255 - ratio;
+
+    /*LV_UDIV255(fg * ratio + bg * (255 - ratio))*/
+    vec_u32_t b = (((fg & 0xFF) * ratio + (bg & 0xFF) * ratio_inv) * 0x8081) >> 23;
+    vec_u32_t g = ((((fg >> 8) & 0xFF) * ratio + ((bg >> 8) & 0xFF) * ratio_inv) * 0x8081) >> 23;
+    vec_u32_t r = ((((fg >> 16) & 0xFF) * ratio + ((bg >> 16) & 0xFF) * ratio_inv) * 0x8081) >> 23;
+    vec_u32_t res = b | (g << 8) | (r << 16) | (res_opa << 24);
+
+    /*Pick the foreground if it's opaque or the background is transparent,
+     *and the background if the foreground is transparent*/
+    vec_u32_t fg_res = (fg & 0x00FFFFFF) | (fg_opa << 24);
+    res = SELECT(fg_opa <= LV_OPA_MIN, bg, res);
+    return SELECT((fg_opa >= LV_OPA_MAX) | (bg_opa <= LV_OPA_MIN), fg_res, res);
+}
+
+/**
+ * Mix XRGB8888 pixels like `lv_color_24_24_mix` in lv_draw_sw_blend_to_rgb888.c, keeping the X channel
+ */
+static INLINE vec_u32_t mix_to_xrgb8888(const px_t * px)
+{
+    vec_u32_t fg = px->fg;
+    vec_u32_t bg = px->bg;
+    vec_u32_t mix = px->opa;
+    vec_u32_t mix_inv = 255 - mix;
+
+    /*(fg * mix + bg * (255 - mix)) >> 8*/
+    vec_u32_t b = ((fg & 0xFF) * mix + (bg & 0xFF) * mix_inv) >> 8;
+    vec_u32_t g = (((fg >> 8) & 0xFF) * mix + ((bg >> 8) & 0xFF) * mix_inv) >> 8;
+    vec_u32_t r = (((fg >> 16) & 0xFF) * mix + ((bg >> 16) & 0xFF) * mix_inv) >> 8;
+
+    vec_u32_t bg_x = bg & 0xFF000000;
+    vec_u32_t res = b | (g << 8) | (r << 16) | bg_x;
+    res = SELECT(mix >= LV_OPA_MAX, (fg & 0x00FFFFFF) | bg_x, res);
+    return SELECT(mix == 0, bg, res);
+}
+
+/**
+ * Mix RGB565 pixels like `lv_color_16_16_mix`. Its special cases give the same results.
+ */
+static INLINE vec_u32_t mix_rgb565(const px_t * px)
+{
+    vec_u32_t mix = (px->opa + 4) >> 3;
+    vec_u32_t fg = (px->fg | (px->fg << 16)) & 0x7E0F81F;
+    vec_u32_t bg = (px->bg | (px->bg << 16)) & 0x7E0F81F;
+    vec_u32_t res = ((((fg - bg) * mix) >> 5) + bg) & 0x7E0F81F;
+    return ((res >> 16) | res) & 0xFFFF;
+}
+
+/**
+ * Mix ARGB8888 pixels to RGB565 pixels like `lv_color_24_16_mix` in lv_draw_sw_blend_to_rgb565.c
+ */
+static INLINE vec_u32_t mix_argb8888_to_rgb565(const px_t * px)
+{
+    vec_u32_t bg = px->bg;
+    vec_u32_t mix = px->opa;
+    vec_u32_t mix_inv = 255 - mix;
+    vec_u32_t fg_r = (px->fg >> 16) & 0xFF;
+    vec_u32_t fg_g = (px->fg >> 8) & 0xFF;
+    vec_u32_t fg_b = px->fg & 0xFF;
+
+    vec_u32_t res = ((((fg_r >> 3) * mix + ((bg >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+                    ((((fg_g >> 2) * mix + ((bg >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+                    (((fg_b >> 3) * mix + (bg & 0x1F) * mix_inv) >> 8);
+    vec_u32_t fg_res = ((fg_r & 0xF8) << 8) + ((fg_g & 0xFC) << 3) + ((fg_b & 0xF8) >> 3);
+    res = SELECT(mix == 255, fg_res, res);
+    return SELECT(mix == 0, bg, res);
+}
+
+/**
+ * Mix L8 pixels like `lv_color_8_8_mix` in lv_draw_sw_blend_to_l8.c
+ */
+static INLINE vec_u32_t mix_l8(const px_t * px)
+{
+    vec_u32_t mix = px->opa;
+    vec_u32_t res = (px->fg * mix + px->bg * (255 - mix)) >> 8;
+    res = SELECT(mix >= LV_OPA_MAX, px->fg, res);
+    return SELECT(mix == 0, px->bg, res);
+}
+
+static void row_to_argb8888(const lv_draw_sw_blend_row_t * row)
+{
+    uint32_t * dest = row->dest;
+    const uint32_t * src = row->src;
+    px_t px;
+    px.fg = SPLAT(row->color);
+    int32_t x;
+    for(x = 0; x < row->w; x += PX_CNT) {
+        px.bg = load_u32(&dest[x]);
+        if(src) {
+            px.fg = load_u32(&src[x]);
+            px.opa = get_opa(row, &px, x);
+        }
+        else {
+            px.opa = get_color_opa(row, x);
+        }
+        px.res = mix_to_argb8888(&px);
+        store_u32(&dest[x], &px.res);
+    }
+}
+
+static void row_to_xrgb8888(const lv_draw_sw_blend_row_t * row)
+{
+    uint32_t * dest = row->dest;
+    const uint32_t * src = row->src;
+    px_t px;
+    px.fg = SPLAT(row->color);
+    int32_t x;
+    for(x = 0; x < row->w; x += PX_CNT) {
+        px.bg = load_u32(&dest[x]);
+        if(src) {
+            px.fg = load_u32(&src[x]);
+            px.opa = get_opa(row, &px, x);
+        }
+        else {
+            px.opa = get_color_opa(row, x);
+        }
+        px.res = mix_to_xrgb8888(&px);
+        store_u32(&dest[x], &px.res);
+    }
+}
+
+static void row_to_rgb565(const lv_draw_sw_blend_row_t * row)
+{
+    uint16_t * dest = row->dest;
+    const uint32_t * src = row->src;
+    px_t px;
+    px.fg = SPLAT(row->color);
+    int32_t x;
+    for(x = 0; x < row->w; x += PX_CNT) {
+        px.bg = load_u16(&dest[x]);
+        if(src) {
+            px.fg = load_u32(&src[x]);
+            px.opa = get_opa(row, &px, x);
+            px.res = mix_argb8888_to_rgb565(&px);
+            store_u16(&dest[x], &px.res);
+        }
+        else {
+            px.opa = get_color_opa(row, x);
+            px.res = mix_rgb565(&px);
+            store_u16(&dest[x], &px.res);
+        }
+    }
+}
+
+static void row_rgb565_to_rgb565(const lv_draw_sw_blend_row_t * row)
+{
+    uint16_t * dest = row->dest;
+    const uint16_t * src = row->src;
+    px_t px;
+    int32_t x;
+    for(x = 0; x < row->w; x += PX_CNT) {
+        px.fg = load_u16(&src[x]);
+        px.bg = load_u16(&dest[x]);
+        px.opa = get_color_opa(row, x);
+        px.res = mix_rgb565(&px);
+        store_u16(&dest[x], &px.res);
+    }
+}
+
+static void row_to_l8(const lv_draw_sw_blend_row_t * row)
+{
+    uint8_t * dest = row->dest;
+    px_t px;
+    px.fg = SPLAT(row->color);
+    int32_t x;
+    for(x = 0; x < row->w; x += PX_CNT) {
+        px.bg = load_u8(&dest[x]);
+        px.opa = get_color_opa(row, x);
+        px.res = mix_l8(&px);
+        store_u8(&dest[x], &px.res);
+    }
+}
+
+/**
+ * Keep the larger opacity like `BLEND_A8` in lv_draw_sw_blend_to_a8.c
+ */
+static void row_to_a8(const lv_draw_sw_blend_row_t * row)
+{
+    uint8_t * dest = row->dest;
+    int32_t x;
+    for(x = 0; x < row->w; x += PX_CNT) {
+        vec_u32_t bg = load_u8(&dest[x]);
+        vec_u32_t opa = get_color_opa(row, x);
+        vec_u32_t res = SELECT(bg < opa, opa, bg);
+        store_u8(&dest[x], &res);
+    }
+}
+
+/**
+ * Blend the rows of an area with a kernel processing `PX_CNT` pixels at once
+ * @param row_cb        the kernel to use
+ * @param dest_px_size  the size of the destination pixels in bytes
+ * @param dest_buf      the first pixel to blend to
+ * @param dest_stride   the stride of `dest_buf` in bytes
+ * @param src_px_size   the size of the source pixels in bytes
+ * @param src_buf       the image to blend or NULL to blend `color`
+ * @param src_stride    the stride of `src_buf` in bytes
+ * @param mask_buf      mask to apply or NULL
+ * @param mask_stride   the stride of `mask_buf` in bytes
+ * @param color         the color to blend as `lv_color_to_u32`, `lv_color_to_u16` or `lv_color_luminance` returns it
+ * @param opa           the overall opacity
+ * @param w             the width of the area
+ * @param h             the height of the area
+ * @return              LV_RESULT_OK
+ */
+static lv_result_t blend_rows(lv_draw_sw_blend_row_cb_t row_cb, uint32_t dest_px_size,
+                              void * dest_buf, int32_t dest_stride,
+                              uint32_t src_px_size, const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              uint32_t color, lv_opa_t opa, int32_t w, int32_t h)
+{
+    lv_draw_sw_blend_rows(row_cb, PX_CNT, dest_px_size, dest_buf, dest_stride, src_px_size, src_buf, src_stride,
+                          mask_buf, mask_stride, color, opa, w, h);
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_USE_DRAW_SW_SIMD*/
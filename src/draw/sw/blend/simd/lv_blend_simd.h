@@ -0,0 +1,54 @@
+/**
+ * @file lv_blend_simd.h
+ * Blend functions written with the vector extensions of GCC and Clang.
+ *
+ * They are compiled to the SIMD instructions of any target (SSE, AVX, Neon, RISC-V Vector, etc)
+ * and set only the blend hooks which are not set by `LV_USE_DRAW_SW_ASM`.
+ * Only the color fills and the normal blending of ARGB8888 and RGB565 images are covered,
+ * as the C implementation has no hooks for the other blend modes.
+ */
+
+#ifndef LV_BLEND_SIMD_H
+#define LV_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lvgl_public.h"
+
+#if LV_USE_DRAW_SW_SIMD
+
+#include "lv_draw_sw_blend_simd_to_argb8888.h"
+#include "lv_draw_sw_blend_simd_to_rgb565.h"
+#include "lv_draw_sw_blend_simd_to_rgb888.h"
+#include "lv_draw_sw_blend_simd_to_l8.h"
+#include "lv_draw_sw_blend_simd_to_a8.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW_SIMD*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_SIMD_H*/
@@ -0,0 +1,64 @@
+/**
+ * @file lv_draw_sw_blend_simd_to_a8.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_BLEND_SIMD_TO_A8_H
+#define LV_DRAW_SW_BLEND_SIMD_TO_A8_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lvgl_public.h"
+#if LV_USE_DRAW_SW_SIMD
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_A8
+#define LV_DRAW_SW_COLOR_BLEND_TO_A8(dsc) \
+    lv_draw_sw_blend_simd_color_to_a8(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_A8_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_A8_WITH_OPA(dsc) \
+    lv_draw_sw_blend_simd_color_to_a8(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_A8_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_A8_WITH_MASK(dsc) \
+    lv_draw_sw_blend_simd_color_to_a8(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_A8_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_A8_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_simd_color_to_a8(dsc)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+lv_result_t lv_draw_sw_blend_simd_color_to_a8(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW_SIMD*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_SIMD_TO_A8_H*/
@@ -0,0 +1,182 @@
+/**
+ * @file lv_blend_x86.c
+ * Run the x86 row kernels on the blend descriptors with the best instruction set of the CPU
+ *
+ * The kernels process `LV_DRAW_SW_BLEND_X86_PX_CNT` pixels at once.
+ * The remaining pixels at the end of the rows are blended in temporary buffers with the same kernels
+ * so that the results are the same everywhere.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_x86_private.h"
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+
+#if !defined(__GNUC__) || !(defined(__x86_64__) || defined(__i386__))
+    #error "LV_DRAW_SW_ASM_X86 requires GCC or Clang on x86"
+#endif
+
+#include "../lv_draw_sw_blend_private.h"
+#include "../../../../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define blend_x86_level LV_GLOBAL_DEFAULT()->draw_sw_blend_x86_level
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_draw_sw_blend_x86_level_t get_supported_level(void);
+static lv_result_t blend_rows(lv_draw_sw_blend_x86_op_t op, void * dest_buf, int32_t dest_stride,
+                              const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              uint32_t color, lv_opa_t opa, int32_t w, int32_t h);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const lv_draw_sw_blend_row_cb_t row_cbs[][LV_DRAW_SW_BLEND_X86_OP_CNT] = {
+    [LV_DRAW_SW_BLEND_X86_SSE41 - 1] = {
+        [LV_DRAW_SW_BLEND_X86_FILL_32] = lv_draw_sw_blend_x86_fill_32_sse41,
+        [LV_DRAW_SW_BLEND_X86_FILL_16] = lv_draw_sw_blend_x86_fill_16_sse41,
+        [LV_DRAW_SW_BLEND_X86_TO_ARGB8888] = lv_draw_sw_blend_x86_to_argb8888_sse41,
+        [LV_DRAW_SW_BLEND_X86_TO_XRGB8888] = lv_draw_sw_blend_x86_to_xrgb8888_sse41,
+        [LV_DRAW_SW_BLEND_X86_TO_RGB565] = lv_draw_sw_blend_x86_to_rgb565_sse41,
+    },
+    [LV_DRAW_SW_BLEND_X86_AVX2 - 1] = {
+        [LV_DRAW_SW_BLEND_X86_FILL_32] = lv_draw_sw_blend_x86_fill_32_avx2,
+        [LV_DRAW_SW_BLEND_X86_FILL_16] = lv_draw_sw_blend_x86_fill_16_avx2,
+        [LV_DRAW_SW_BLEND_X86_TO_ARGB8888] = lv_draw_sw_blend_x86_to_argb8888_avx2,
+        [LV_DRAW_SW_BLEND_X86_TO_XRGB8888] = lv_draw_sw_blend_x86_to_xrgb8888_avx2,
+        [LV_DRAW_SW_BLEND_X86_TO_RGB565] = lv_draw_sw_blend_x86_to_rgb565_avx2,
+    },
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_blend_x86_init(void)
+{
+    blend_x86_level = get_supported_level();
+}
+
+lv_draw_sw_blend_x86_level_t lv_draw_sw_blend_x86_set_level(lv_draw_sw_blend_x86_level_t level)
+{
+    lv_draw_sw_blend_x86_level_t supported = get_supported_level();
+    blend_x86_level = level < supported ? level : supported;
+    return blend_x86_level;
+}
+
+lv_draw_sw_blend_x86_level_t lv_draw_sw_blend_x86_get_level(void)
+{
+    return blend_x86_level;
+}
+
+lv_result_t lv_draw_sw_blend_x86_color_to_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    bool fill = dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX;
+    return blend_rows(fill ? LV_DRAW_SW_BLEND_X86_FILL_32 : LV_DRAW_SW_BLEND_X86_TO_ARGB8888,
+                      dsc->dest_buf, dsc->dest_stride, NULL, 0, dsc->mask_buf, dsc->mask_stride,
+                      lv_color_to_u32(dsc->color), dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_x86_argb8888_to_argb8888(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return blend_rows(LV_DRAW_SW_BLEND_X86_TO_ARGB8888, dsc->dest_buf, dsc->dest_stride,
+                      dsc->src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+                      0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_x86_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    bool fill = dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX;
+    return blend_rows(fill ? LV_DRAW_SW_BLEND_X86_FILL_16 : LV_DRAW_SW_BLEND_X86_TO_RGB565,
+                      dsc->dest_buf, dsc->dest_stride, NULL, 0, dsc->mask_buf, dsc->mask_stride,
+                      lv_color_to_u16(dsc->color), dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_x86_argb8888_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return blend_rows(LV_DRAW_SW_BLEND_X86_TO_RGB565, dsc->dest_buf, dsc->dest_stride,
+                      dsc->src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+                      0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_x86_color_to_rgb888(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    /*RGB888 pixels don't fit into the 32 bit lanes*/
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    bool fill = dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX;
+    return blend_rows(fill ? LV_DRAW_SW_BLEND_X86_FILL_32 : LV_DRAW_SW_BLEND_X86_TO_XRGB8888,
+                      dsc->dest_buf, dsc->dest_stride, NULL, 0, dsc->mask_buf, dsc->mask_stride,
+                      lv_color_to_u32(dsc->color), dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+lv_result_t lv_draw_sw_blend_x86_argb8888_to_rgb888(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    return blend_rows(LV_DRAW_SW_BLEND_X86_TO_XRGB8888, dsc->dest_buf, dsc->dest_stride,
+                      dsc->src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+                      0, dsc->opa, dsc->dest_w, dsc->dest_h);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_draw_sw_blend_x86_level_t get_supported_level(void)
+{
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return LV_DRAW_SW_BLEND_X86_AVX2;
+    if(__builtin_cpu_supports("sse4.1")) return LV_DRAW_SW_BLEND_X86_SSE41;
+    return LV_DRAW_SW_BLEND_X86_NONE;
+}
+
+/**
+ * Blend the rows of an area with a kernel
+ * @param op            the kernel to use
+ * @param dest_buf      the first pixel to blend to
+ * @param dest_stride   the stride of `dest_buf` in bytes
+ * @param src_buf       ARGB8888 image to blend or NULL to blend `color`
+ * @param src_stride    the stride of `src_buf` in bytes
+ * @param mask_buf      mask to apply or NULL
+ * @param mask_stride   the stride of `mask_buf` in bytes
+ * @param color         the color to blend as `lv_color_to_u32` or `lv_color_to_u16` returns it
+ * @param opa           the overall opacity
+ * @param w             the width of the area
+ * @param h             the height of the area
+ * @return              LV_RESULT_INVALID if the C implementation should be used instead
+ */
+static lv_result_t blend_rows(lv_draw_sw_blend_x86_op_t op, void * dest_buf, int32_t dest_stride,
+                              const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              uint32_t color, lv_opa_t opa, int32_t w, int32_t h)
+{
+    lv_draw_sw_blend_x86_level_t level = blend_x86_level;
+    if(level == LV_DRAW_SW_BLEND_X86_NONE) return LV_RESULT_INVALID;
+
+    lv_draw_sw_blend_row_cb_t row_cb = row_cbs[level - 1][op];
+    uint32_t dest_px_size = (op == LV_DRAW_SW_BLEND_X86_FILL_16 || op == LV_DRAW_SW_BLEND_X86_TO_RGB565) ? 2 : 4;
+    lv_draw_sw_blend_rows(row_cb, LV_DRAW_SW_BLEND_X86_PX_CNT, dest_px_size, dest_buf, dest_stride,
+                          sizeof(lv_color32_t), src_buf, src_stride, mask_buf, mask_stride, color, opa, w, h);
+
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86*/
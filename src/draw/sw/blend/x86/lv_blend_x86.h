@@ -0,0 +1,72 @@
+/**
+ * @file lv_blend_x86.h
+ *
+ */
+
+#ifndef LV_BLEND_X86_H
+#define LV_BLEND_X86_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lvgl_public.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+
+#include "lv_draw_sw_blend_x86_to_argb8888.h"
+#include "lv_draw_sw_blend_x86_to_rgb565.h"
+#include "lv_draw_sw_blend_x86_to_rgb888.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The instruction sets the x86 blend functions can use*/
+typedef enum {
+    LV_DRAW_SW_BLEND_X86_NONE,      /**< Use the C implementation*/
+    LV_DRAW_SW_BLEND_X86_SSE41,
+    LV_DRAW_SW_BLEND_X86_AVX2,
+} lv_draw_sw_blend_x86_level_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Select the best instruction set supported by the CPU
+ */
+void lv_draw_sw_blend_x86_init(void);
+
+/**
+ * Limit the instruction set used for blending, e.g. to compare the results with the C implementation
+ * @param level     the instruction set to use, the best supported one is used if it's not supported
+ * @return          the instruction set which will be used
+ */
+lv_draw_sw_blend_x86_level_t lv_draw_sw_blend_x86_set_level(lv_draw_sw_blend_x86_level_t level);
+
+/**
+ * Get the instruction set used for blending
+ * @return          the instruction set which is used
+ */
+lv_draw_sw_blend_x86_level_t lv_draw_sw_blend_x86_get_level(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_X86_H*/
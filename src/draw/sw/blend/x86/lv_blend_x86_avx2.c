@@ -0,0 +1,276 @@
+/**
+ * @file lv_blend_x86_avx2.c
+ * AVX2 row kernels of the x86 blend functions, processing 8 pixels at once
+ *
+ * The color channels are mixed in 16 bit lanes: blue and red in one vector, green and alpha in another one.
+ * lv_blend_x86_sse41.c has the same kernels with SSE4.1.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_x86_private.h"
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+
+#include "../lv_draw_sw_blend_private.h"
+#include <immintrin.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define TARGET  __attribute__((target("avx2")))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline __m256i TARGET load_mask(const lv_opa_t * mask);
+static inline __m256i TARGET get_opa(const lv_draw_sw_blend_row_t * row, __m256i fg, int32_t x);
+static inline __m256i TARGET mix_to_argb8888(__m256i fg, __m256i bg, __m256i fg_opa);
+static inline __m256i TARGET mix_to_xrgb8888(__m256i fg, __m256i bg, __m256i mix);
+static inline __m256i TARGET mix_rgb565(__m256i fg, __m256i bg, __m256i mix);
+static inline __m256i TARGET mix_argb8888_to_rgb565(__m256i fg, __m256i bg, __m256i mix);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void TARGET lv_draw_sw_blend_x86_fill_32_avx2(const lv_draw_sw_blend_row_t * row)
+{
+    __m256i * dest = row->dest;
+    __m256i color = _mm256_set1_epi32((int32_t)row->color);
+    int32_t x;
+    for(x = 0; x < row->w; x += 8) {
+        _mm256_storeu_si256(dest, color);
+        dest++;
+    }
+}
+
+void TARGET lv_draw_sw_blend_x86_fill_16_avx2(const lv_draw_sw_blend_row_t * row)
+{
+    uint16_t * dest = row->dest;
+    __m256i color = _mm256_set1_epi16((int16_t)row->color);
+    int32_t x;
+    for(x = 0; x + 16 <= row->w; x += 16) {
+        _mm256_storeu_si256((__m256i *)&dest[x], color);
+    }
+    if(x < row->w) _mm_storeu_si128((__m128i *)&dest[x], _mm256_castsi256_si128(color));
+}
+
+void TARGET lv_draw_sw_blend_x86_to_argb8888_avx2(const lv_draw_sw_blend_row_t * row)
+{
+    uint32_t * dest = row->dest;
+    __m256i fg = _mm256_set1_epi32((int32_t)row->color);
+    int32_t x;
+    for(x = 0; x < row->w; x += 8) {
+        if(row->src) fg = _mm256_loadu_si256((const __m256i *)((const lv_color32_t *)row->src + x));
+        __m256i bg = _mm256_loadu_si256((const __m256i *)&dest[x]);
+        _mm256_storeu_si256((__m256i *)&dest[x], mix_to_argb8888(fg, bg, get_opa(row, fg, x)));
+    }
+}
+
+void TARGET lv_draw_sw_blend_x86_to_xrgb8888_avx2(const lv_draw_sw_blend_row_t * row)
+{
+    uint32_t * dest = row->dest;
+    __m256i fg = _mm256_set1_epi32((int32_t)row->color);
+    int32_t x;
+    for(x = 0; x < row->w; x += 8) {
+        if(row->src) fg = _mm256_loadu_si256((const __m256i *)((const lv_color32_t *)row->src + x));
+        __m256i bg = _mm256_loadu_si256((const __m256i *)&dest[x]);
+        _mm256_storeu_si256((__m256i *)&dest[x], mix_to_xrgb8888(fg, bg, get_opa(row, fg, x)));
+    }
+}
+
+void TARGET lv_draw_sw_blend_x86_to_rgb565_avx2(const lv_draw_sw_blend_row_t * row)
+{
+    uint16_t * dest = row->dest;
+    /*The color with its channels spread out as `lv_color_16_16_mix` needs it*/
+    __m256i color = _mm256_set1_epi32((int32_t)((row->color | (row->color << 16)) & 0x7E0F81F));
+    int32_t x;
+    for(x = 0; x < row->w; x += 8) {
+        __m256i bg = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)&dest[x]));
+        __m256i res;
+        if(row->src) {
+            __m256i fg = _mm256_loadu_si256((const __m256i *)((const lv_color32_t *)row->src + x));
+            res = mix_argb8888_to_rgb565(fg, bg, get_opa(row, fg, x));
+        }
+        else {
+            res = mix_rgb565(color, bg, get_opa(row, color, x));
+        }
+        /*The packing works in 128 bit lanes so move the results of the upper lane next to the lower one*/
+        res = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), 0x08);
+        _mm_storeu_si128((__m128i *)&dest[x], _mm256_castsi256_si128(res));
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Load 8 mask values to 32 bit lanes
+ */
+static inline __m256i TARGET load_mask(const lv_opa_t * mask)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)mask));
+}
+
+/**
+ * Get the opacity of the foreground pixels in 32 bit lanes as the C implementation calculates them
+ */
+static inline __m256i TARGET get_opa(const lv_draw_sw_blend_row_t * row, __m256i fg, int32_t x)
+{
+    __m256i opa = _mm256_set1_epi32(row->opa);
+    if(row->src) {
+        __m256i fg_opa = _mm256_srli_epi32(fg, 24);
+        if(row->mask == NULL) {
+            if(row->opa >= LV_OPA_MAX) return fg_opa;
+            /*LV_OPA_MIX2*/
+            return _mm256_srli_epi32(_mm256_mullo_epi16(fg_opa, opa), 8);
+        }
+
+        __m256i mask = load_mask(&row->mask[x]);
+        if(row->opa >= LV_OPA_MAX) return _mm256_srli_epi32(_mm256_mullo_epi16(fg_opa, mask), 8);
+        /*LV_OPA_MIX3*/
+        return _mm256_mulhi_epu16(_mm256_mullo_epi16(fg_opa, mask), opa);
+    }
+    else {
+        if(row->mask == NULL) return opa;
+
+        __m256i mask = load_mask(&row->mask[x]);
+        if(row->opa >= LV_OPA_MAX) return mask;
+        return _mm256_srli_epi32(_mm256_mullo_epi16(mask, opa), 8);
+    }
+}
+
+/**
+ * Mix ARGB8888 pixels like `lv_color_32_32_mix` in lv_draw_sw_blend_to_argb8888.c
+ */
+static inline __m256i TARGET mix_to_argb8888(__m256i fg, __m256i bg, __m256i fg_opa)
+{
+    const __m256i v255 = _mm256_set1_epi32(255);
+    const __m256i ch_mask = _mm256_set1_epi32(0x00FF00FF);
+    __m256i bg_opa = _mm256_srli_epi32(bg, 24);
+
+    /*The alpha of the result and the ratio of the foreground.
+     *The quotient is below 256 so the float division truncates to the exact integer quotient.*/
+    __m256i res_opa = _mm256_sub_epi32(v255, _mm256_srli_epi32(_mm256_mullo_epi16(_mm256_sub_epi32(v255, fg_opa),
+                                                                                  _mm256_sub_epi32(v255, bg_opa)), 8));
+    __m256i ratio = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_mullo_epi16(fg_opa, v255)),
+                                                      _mm256_cvtepi32_ps(res_opa)));
+
+    /*`lv_color_mix32` takes the foreground above LV_OPA_MAX and the background below LV_OPA_MIN*/
+    __m256i max_opa = _mm256_set1_epi32(LV_OPA_MAX - 1);
+    ratio = _mm256_or_si256(ratio, _mm256_and_si256(_mm256_cmpgt_epi32(ratio, max_opa), v255));
+    ratio = _mm256_andnot_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(LV_OPA_MIN + 1), ratio), ratio);
+
+    __m256i mix = _mm256_or_si256(ratio, _mm256_slli_epi32(ratio, 16));
+    __m256i mix_inv = _mm256_sub_epi16(ch_mask, mix);
+    __m256i div255 = _mm256_set1_epi16((int16_t)0x8081);
+
+    /*LV_UDIV255(fg * mix + bg * (255 - mix))*/
+    __m256i rb = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(fg, ch_mask), mix),
+                                  _mm256_mullo_epi16(_mm256_and_si256(bg, ch_mask), mix_inv));
+    __m256i ga = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(fg, 8), ch_mask), mix),
+                                  _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(bg, 8), ch_mask), mix_inv));
+    rb = _mm256_srli_epi16(_mm256_mulhi_epu16(rb, div255), 7);
+    ga = _mm256_srli_epi16(_mm256_mulhi_epu16(ga, div255), 7);
+    __m256i res = _mm256_or_si256(_mm256_or_si256(rb, _mm256_slli_epi32(_mm256_and_si256(ga, v255), 8)),
+                                  _mm256_slli_epi32(res_opa, 24));
+
+    /*Pick the foreground if it's opaque or the background is transparent,
+     *and the background if the foreground is transparent*/
+    __m256i fg_res = _mm256_or_si256(_mm256_and_si256(fg, _mm256_set1_epi32(0x00FFFFFF)),
+                                     _mm256_slli_epi32(fg_opa, 24));
+    __m256i min_opa = _mm256_set1_epi32(LV_OPA_MIN + 1);
+    __m256i use_fg = _mm256_or_si256(_mm256_cmpgt_epi32(fg_opa, max_opa),
+                                     _mm256_cmpgt_epi32(min_opa, bg_opa));
+    res = _mm256_blendv_epi8(res, bg, _mm256_cmpgt_epi32(min_opa, fg_opa));
+    return _mm256_blendv_epi8(res, fg_res, use_fg);
+}
+
+/**
+ * Mix XRGB8888 pixels like `lv_color_24_24_mix` in lv_draw_sw_blend_to_rgb888.c, keeping the X channel
+ */
+static inline __m256i TARGET mix_to_xrgb8888(__m256i fg, __m256i bg, __m256i mix)
+{
+    const __m256i ch_mask = _mm256_set1_epi32(0x00FF00FF);
+    const __m256i x_mask = _mm256_set1_epi32((int32_t)0xFF000000);
+    __m256i mix16 = _mm256_or_si256(mix, _mm256_slli_epi32(mix, 16));
+    __m256i mix_inv = _mm256_sub_epi16(ch_mask, mix16);
+
+    /*(fg * mix + bg * (255 - mix)) >> 8*/
+    __m256i rb = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(fg, ch_mask), mix16),
+                                  _mm256_mullo_epi16(_mm256_and_si256(bg, ch_mask), mix_inv));
+    __m256i g = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(fg, 8), ch_mask), mix16),
+                                 _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(bg, 8), ch_mask), mix_inv));
+    rb = _mm256_srli_epi16(rb, 8);
+    g = _mm256_and_si256(g, _mm256_set1_epi32(0xFF00));
+
+    __m256i bg_x = _mm256_and_si256(bg, x_mask);
+    __m256i res = _mm256_or_si256(_mm256_or_si256(rb, g), bg_x);
+    __m256i fg_res = _mm256_or_si256(_mm256_andnot_si256(x_mask, fg), bg_x);
+    res = _mm256_blendv_epi8(res, fg_res, _mm256_cmpgt_epi32(mix, _mm256_set1_epi32(LV_OPA_MAX - 1)));
+    return _mm256_blendv_epi8(res, bg, _mm256_cmpeq_epi32(mix, _mm256_setzero_si256()));
+}
+
+/**
+ * Mix RGB565 pixels in 32 bit lanes like `lv_color_16_16_mix`.
+ * The color of `fg` is already spread out in the lanes.
+ */
+static inline __m256i TARGET mix_rgb565(__m256i fg, __m256i bg, __m256i mix)
+{
+    const __m256i spread_mask = _mm256_set1_epi32(0x7E0F81F);
+    bg = _mm256_and_si256(_mm256_or_si256(bg, _mm256_slli_epi32(bg, 16)), spread_mask);
+    mix = _mm256_srli_epi32(_mm256_add_epi32(mix, _mm256_set1_epi32(4)), 3);
+
+    __m256i res = _mm256_mullo_epi32(_mm256_sub_epi32(fg, bg), mix);
+    res = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(res, 5), bg), spread_mask);
+    return _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi32(res, 16), res), _mm256_set1_epi32(0xFFFF));
+}
+
+/**
+ * Mix ARGB8888 pixels to RGB565 pixels in 32 bit lanes like `lv_color_24_16_mix` in lv_draw_sw_blend_to_rgb565.c
+ */
+static inline __m256i TARGET mix_argb8888_to_rgb565(__m256i fg, __m256i bg, __m256i mix)
+{
+    const __m256i rb_mask = _mm256_set1_epi32(0x001F001F);
+    const __m256i b_mask = _mm256_set1_epi32(0x1F);
+    const __m256i g_mask = _mm256_set1_epi32(0x3F);
+
+    /*Blue and red in the 16 bit lanes*/
+    __m256i fg_rb = _mm256_and_si256(_mm256_srli_epi32(fg, 3), rb_mask);
+    __m256i fg_g = _mm256_and_si256(_mm256_srli_epi32(fg, 10), g_mask);
+    __m256i bg_rb = _mm256_and_si256(_mm256_or_si256(bg, _mm256_slli_epi32(bg, 5)), rb_mask);
+    __m256i bg_g = _mm256_and_si256(_mm256_srli_epi32(bg, 5), g_mask);
+
+    __m256i mix16 = _mm256_or_si256(mix, _mm256_slli_epi32(mix, 16));
+    __m256i mix_inv = _mm256_sub_epi16(_mm256_set1_epi32(0x00FF00FF), mix16);
+    __m256i rb = _mm256_add_epi16(_mm256_mullo_epi16(fg_rb, mix16), _mm256_mullo_epi16(bg_rb, mix_inv));
+    __m256i g = _mm256_add_epi16(_mm256_mullo_epi16(fg_g, mix16), _mm256_mullo_epi16(bg_g, mix_inv));
+    rb = _mm256_srli_epi16(rb, 8);
+    g = _mm256_srli_epi32(g, 8);
+
+    __m256i res = _mm256_or_si256(_mm256_and_si256(rb, b_mask), _mm256_slli_epi32(_mm256_srli_epi32(rb, 16), 11));
+    res = _mm256_or_si256(res, _mm256_slli_epi32(g, 5));
+    __m256i fg_res = _mm256_or_si256(_mm256_and_si256(fg_rb, b_mask),
+                                     _mm256_slli_epi32(_mm256_srli_epi32(fg_rb, 16), 11));
+    fg_res = _mm256_or_si256(fg_res, _mm256_slli_epi32(fg_g, 5));
+    res = _mm256_blendv_epi8(res, fg_res, _mm256_cmpeq_epi32(mix, _mm256_set1_epi32(255)));
+    return _mm256_blendv_epi8(res, bg, _mm256_cmpeq_epi32(mix, _mm256_setzero_si256()));
+}
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86*/
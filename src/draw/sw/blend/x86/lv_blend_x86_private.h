@@ -0,0 +1,74 @@
+/**
+ * @file lv_blend_x86_private.h
+ * Row kernels of the x86 blend functions
+ *
+ * Every kernel exists for each supported instruction set (e.g. `_sse41` and `_avx2`)
+ * and processes `LV_DRAW_SW_BLEND_X86_PX_CNT` pixels at once,
+ * so the width of the rows has to be a multiple of it. The source pixels are ARGB8888.
+ * The results are the same as the results of the C implementation, bit by bit.
+ */
+
+#ifndef LV_BLEND_X86_PRIVATE_H
+#define LV_BLEND_X86_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_x86.h"
+#include "../lv_draw_sw_blend_private.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** The kernels process this many pixels at once*/
+#define LV_DRAW_SW_BLEND_X86_PX_CNT     8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** What to do with the row*/
+typedef enum {
+    LV_DRAW_SW_BLEND_X86_FILL_32,           /**< Set the 32 bit pixels to `color`*/
+    LV_DRAW_SW_BLEND_X86_FILL_16,           /**< Set the 16 bit pixels to `color`*/
+    LV_DRAW_SW_BLEND_X86_TO_ARGB8888,
+    LV_DRAW_SW_BLEND_X86_TO_XRGB8888,
+    LV_DRAW_SW_BLEND_X86_TO_RGB565,
+    LV_DRAW_SW_BLEND_X86_OP_CNT,
+} lv_draw_sw_blend_x86_op_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+void lv_draw_sw_blend_x86_fill_32_sse41(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_fill_16_sse41(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_to_argb8888_sse41(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_to_xrgb8888_sse41(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_to_rgb565_sse41(const lv_draw_sw_blend_row_t * row);
+
+void lv_draw_sw_blend_x86_fill_32_avx2(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_fill_16_avx2(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_to_argb8888_avx2(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_to_xrgb8888_avx2(const lv_draw_sw_blend_row_t * row);
+void lv_draw_sw_blend_x86_to_rgb565_avx2(const lv_draw_sw_blend_row_t * row);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_X86_PRIVATE_H*/
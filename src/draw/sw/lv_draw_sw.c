@@ -13,6 +13,8 @@
 #include "../../display/lv_display_private.h"
 #include "../../core/lv_global.h"
 #include "../../misc/lv_area_private.h"
+#include "../../image/lv_image_decoder_private.h"
+#include "../lv_draw_image_private.h"
 
 #if LV_USE_THORVG
     #if LV_USE_THORVG_INTERNAL
@@ -37,6 +39,9 @@
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+/*Don't make the bands thinner than this to keep the overhead of a band low*/
+#define BAND_MIN_SIZE       16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -50,6 +55,18 @@
 
 static void execute_drawing(lv_draw_task_t * t);
 
+#if LV_DRAW_SW_USE_BANDS
+    static bool execute_in_bands(lv_draw_sw_thread_dsc_t * thread_dsc);
+    static bool is_splittable(const lv_draw_task_t * t);
+    static void push_bands(lv_draw_sw_thread_dsc_t * thread_dsc, const lv_area_t * area, bool vertical,
+                           lv_draw_sw_band_type_t type);
+    static void execute_bands(lv_draw_sw_thread_dsc_t * thread_dsc);
+    static lv_draw_sw_thread_dsc_t * take_band(lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_band_t * band);
+    static bool pop_band(lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_band_t * band, bool from_head);
+    static void execute_band(lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_thread_dsc_t * owner,
+                             const lv_draw_sw_band_t * band);
+#endif
+
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit);
@@ -93,6 +110,9 @@ void lv_draw_sw_init(void)
         lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
         thread_dsc->idx = i;
         thread_dsc->draw_unit = (void *) draw_sw_unit;
+#if LV_DRAW_SW_USE_BANDS
+        lv_mutex_init(&thread_dsc->band_lock);
+#endif
         lv_thread_init(&thread_dsc->thread, "swdraw", LV_DRAW_THREAD_PRIO, render_thread_cb,
                        LV_DRAW_THREAD_STACK_SIZE, thread_dsc);
     }
@@ -108,6 +128,18 @@ void lv_draw_sw_init(void)
 #endif
 
     lv_ll_init(&LV_GLOBAL_DEFAULT()->draw_sw_blend_handler_ll, sizeof(lv_draw_sw_custom_blend_handler_t));
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    lv_draw_sw_blend_x86_init();
+#endif
+
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    lv_draw_sw_box_shadow_cache_init();
+#endif
+
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    lv_draw_sw_blur_cache_init();
+#endif
 }
 
 void lv_draw_sw_deinit(void)
@@ -119,6 +151,14 @@ void lv_draw_sw_deinit(void)
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
+
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    lv_draw_sw_box_shadow_cache_deinit();
+#endif
+
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    lv_draw_sw_blur_cache_deinit();
+#endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
@@ -137,6 +177,9 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
             lv_thread_sync_signal(&thread_dsc->sync);
         }
         lv_thread_delete(&thread_dsc->thread);
+#if LV_DRAW_SW_USE_BANDS
+        lv_mutex_delete(&thread_dsc->band_lock);
+#endif
     }
 
     return 0;
@@ -353,10 +396,19 @@ static void render_thread_cb(void * ptr)
     thread_dsc->inited = true;
 
     while(1) {
+#if LV_DRAW_SW_USE_BANDS
+        lv_draw_sw_thread_dsc_t * band_owner = NULL;
+        lv_draw_sw_band_t band;
+#endif
         while(thread_dsc->task_act == NULL) {
             if(thread_dsc->exit_status) {
                 break;
             }
+#if LV_DRAW_SW_USE_BANDS
+            /*Help the other threads while there is no own task*/
+            band_owner = take_band(thread_dsc, &band);
+            if(band_owner) break;
+#endif
             lv_thread_sync_wait(&thread_dsc->sync);
         }
 
@@ -365,10 +417,22 @@ static void render_thread_cb(void * ptr)
             break;
         }
 
-        execute_drawing(thread_dsc->task_act);
+        bool rendered = false;
+#if LV_DRAW_SW_USE_BANDS
+        if(band_owner) {
+            execute_band(thread_dsc, band_owner, &band);
+            continue;
+        }
+
+        rendered = execute_in_bands(thread_dsc);
+#endif
+        if(!rendered) {
+            execute_drawing(thread_dsc->task_act);
 #if LV_USE_PARALLEL_DRAW_DEBUG
-        parallel_debug_draw(thread_dsc->task_act, thread_dsc->idx);
+            parallel_debug_draw(thread_dsc->task_act, thread_dsc->idx);
 #endif
+        }
+
         thread_dsc->task_act->state = LV_DRAW_TASK_STATE_FINISHED;
         thread_dsc->task_act = NULL;
 
@@ -437,6 +501,274 @@ static void execute_drawing(lv_draw_task_t * t)
     LV_PROFILER_DRAW_END;
 }
 
+#if LV_DRAW_SW_USE_BANDS
+
+/**
+ * Split the task of a thread into bands and render them together with the other threads
+ * @param thread_dsc    the thread whose `task_act` should be rendered
+ * @return              true: the task was rendered in bands; false: the task is not worth splitting
+ */
+static bool execute_in_bands(lv_draw_sw_thread_dsc_t * thread_dsc)
+{
+    lv_draw_task_t * t = thread_dsc->task_act;
+    if(!is_splittable(t)) return false;
+
+    lv_area_t draw_area;
+    if(!lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) return false;
+    if(lv_area_get_size(&draw_area) < LV_DRAW_SW_SPLIT_MIN_SIZE) return false;
+    if(lv_area_get_height(&draw_area) < 2 * BAND_MIN_SIZE) return false;
+
+    LV_PROFILER_DRAW_BEGIN;
+
+    if(t->type == LV_DRAW_TASK_TYPE_BLUR) {
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+        uint64_t hash;
+        if(lv_draw_sw_blur_cache_restore(t, t->draw_dsc, &t->area, &hash)) {
+            LV_PROFILER_DRAW_END;
+            return true;
+        }
+#endif
+
+        /*Each column is blurred along its whole height and then each row along its whole width,
+         *so split the columns first and the rows only when all the columns are ready*/
+        push_bands(thread_dsc, &draw_area, true, LV_DRAW_SW_BAND_TYPE_BLUR_COLUMNS);
+        execute_bands(thread_dsc);
+        push_bands(thread_dsc, &draw_area, false, LV_DRAW_SW_BAND_TYPE_BLUR_ROWS);
+        execute_bands(thread_dsc);
+
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+        lv_draw_sw_blur_cache_add(t, t->draw_dsc, &t->area, hash);
+#endif
+    }
+    else if(t->type == LV_DRAW_TASK_TYPE_IMAGE && !((lv_draw_image_dsc_t *)t->draw_dsc)->tile) {
+        /*Open the image only once instead of in each band. The bands can share it only
+         *if it's fully decoded, as reading the image in parts changes the decoder's state.*/
+        const lv_draw_image_dsc_t * draw_dsc = t->draw_dsc;
+        lv_image_decoder_args_t args_buf;
+        const lv_image_decoder_args_t * args = lv_draw_image_get_decoder_args(draw_dsc, NULL, &args_buf);
+        lv_image_decoder_dsc_t decoder_dsc;
+        bool opened = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, args) == LV_RESULT_OK;
+        if(opened && decoder_dsc.decoded) thread_dsc->band_decoder_dsc = &decoder_dsc;
+
+        push_bands(thread_dsc, &draw_area, false, LV_DRAW_SW_BAND_TYPE_CLIP);
+        execute_bands(thread_dsc);
+
+        thread_dsc->band_decoder_dsc = NULL;
+        if(opened) lv_image_decoder_close(&decoder_dsc);
+    }
+    else {
+        /*Nothing is drawn outside of `_real_area` so it's enough to clip to `draw_area`*/
+        push_bands(thread_dsc, &draw_area, false, LV_DRAW_SW_BAND_TYPE_CLIP);
+        execute_bands(thread_dsc);
+    }
+
+    LV_PROFILER_DRAW_END;
+    return true;
+}
+
+/**
+ * Check if the parts of a task can be rendered independently of each other
+ * @param t     pointer to a draw task
+ * @return      true: the task can be split into bands
+ */
+static bool is_splittable(const lv_draw_task_t * t)
+{
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                /*The complex gradients store their state in the draw descriptor while rendering*/
+                const lv_draw_fill_dsc_t * draw_dsc = t->draw_dsc;
+                return draw_dsc->grad.dir < LV_GRAD_DIR_LINEAR;
+            }
+        case LV_DRAW_TASK_TYPE_BLUR:
+            return true;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+        case LV_DRAW_TASK_TYPE_LAYER: {
+                /*The bitmap mask is applied on the whole source layer in place*/
+                const lv_draw_image_dsc_t * draw_dsc = t->draw_dsc;
+                if(draw_dsc->bitmap_mask_src) return false;
+
+                /*Without rotation the scaling steps are interpolated over the rendered area,
+                 *so the rounding would be different in each band*/
+                bool scaled = draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE;
+                if(draw_dsc->rotation == 0 && scaled) return false;
+
+                return true;
+            }
+        default:
+            return false;
+    }
+}
+
+/**
+ * Split an area into bands and add them to the deque of a thread
+ * @param thread_dsc    the thread whose `task_act` the bands belong to
+ * @param area          the area to split
+ * @param vertical      true: split into columns; false: split into rows
+ * @param type          the type of the bands
+ */
+static void push_bands(lv_draw_sw_thread_dsc_t * thread_dsc, const lv_area_t * area, bool vertical,
+                       lv_draw_sw_band_type_t type)
+{
+    int32_t start = vertical ? area->x1 : area->y1;
+    int32_t len = vertical ? lv_area_get_width(area) : lv_area_get_height(area);
+    int32_t band_cnt = LV_CLAMP(1, len / BAND_MIN_SIZE, LV_DRAW_SW_BAND_CNT_MAX);
+
+    lv_mutex_lock(&thread_dsc->band_lock);
+    int32_t i;
+    int32_t band_start = start;
+    for(i = 0; i < band_cnt; i++) {
+        lv_draw_sw_band_t * band = &thread_dsc->bands[i];
+        int32_t band_end = start + (len * (i + 1)) / band_cnt - 1;
+        band->area = *area;
+        band->type = type;
+        if(vertical) {
+            band->area.x1 = band_start;
+            band->area.x2 = band_end;
+        }
+        else {
+            band->area.y1 = band_start;
+            band->area.y2 = band_end;
+        }
+        band_start = band_end + 1;
+    }
+    thread_dsc->band_head = 0;
+    thread_dsc->band_tail = band_cnt;
+    thread_dsc->band_pending = band_cnt;
+    lv_mutex_unlock(&thread_dsc->band_lock);
+
+    /*Wake up the other threads to steal bands*/
+    lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *)thread_dsc->draw_unit;
+    for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+        lv_draw_sw_thread_dsc_t * other = &draw_sw_unit->thread_dscs[i];
+        if(other != thread_dsc && other->inited) lv_thread_sync_signal(&other->sync);
+    }
+}
+
+/**
+ * Render the own bands and help the others until the stolen bands of the own task are finished too
+ * @param thread_dsc    the thread whose bands were pushed
+ */
+static void execute_bands(lv_draw_sw_thread_dsc_t * thread_dsc)
+{
+    while(1) {
+        lv_draw_sw_band_t band;
+        lv_draw_sw_thread_dsc_t * band_owner = take_band(thread_dsc, &band);
+        if(band_owner) {
+            execute_band(thread_dsc, band_owner, &band);
+        }
+        else if(thread_dsc->band_pending == 0) {
+            break;
+        }
+        else {
+            /*The thread which finishes the last band will signal*/
+            lv_thread_sync_wait(&thread_dsc->sync);
+        }
+    }
+}
+
+/**
+ * Take a band of the thread's own task or steal one from an other thread
+ * @param thread_dsc    the thread which wants to render a band
+ * @param band          store the band here
+ * @return              the thread owning the task of the band, or NULL if there are no bands
+ */
+static lv_draw_sw_thread_dsc_t * take_band(lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_band_t * band)
+{
+    if(pop_band(thread_dsc, band, true)) return thread_dsc;
+
+    /*Start from the next thread so that the threads don't steal from the same one*/
+    lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *)thread_dsc->draw_unit;
+    uint32_t i;
+    for(i = 1; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+        uint32_t victim_idx = (thread_dsc->idx + i) % LV_DRAW_SW_DRAW_UNIT_CNT;
+        lv_draw_sw_thread_dsc_t * victim = &draw_sw_unit->thread_dscs[victim_idx];
+        if(pop_band(victim, band, false)) return victim;
+    }
+
+    return NULL;
+}
+
+/**
+ * Remove a band from the deque of a thread
+ * @param thread_dsc    the thread owning the deque
+ * @param band          store the band here
+ * @param from_head     true: take the next band in the rendering order (the owner does this);
+ *                      false: take the last band (stealers do this)
+ * @return              true: a band was taken; false: the deque was empty
+ */
+static bool pop_band(lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_band_t * band, bool from_head)
+{
+    /*Quick check without locking. The deque is checked again under the lock.*/
+    if(thread_dsc->band_head == thread_dsc->band_tail) return false;
+
+    bool taken = false;
+    lv_mutex_lock(&thread_dsc->band_lock);
+    if(thread_dsc->band_head != thread_dsc->band_tail) {
+        if(from_head) {
+            *band = thread_dsc->bands[thread_dsc->band_head];
+            thread_dsc->band_head++;
+        }
+        else {
+            thread_dsc->band_tail--;
+            *band = thread_dsc->bands[thread_dsc->band_tail];
+        }
+        taken = true;
+    }
+    lv_mutex_unlock(&thread_dsc->band_lock);
+
+    return taken;
+}
+
+/**
+ * Render a band of a task
+ * @param thread_dsc    the thread rendering the band
+ * @param owner         the thread whose `task_act` is split into bands
+ * @param band          the band to render
+ */
+static void execute_band(lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_thread_dsc_t * owner,
+                         const lv_draw_sw_band_t * band)
+{
+    LV_PROFILER_DRAW_BEGIN;
+
+    /*`task_act` of the owner stays valid until all of its bands are finished*/
+    lv_draw_task_t * t = owner->task_act;
+    switch(band->type) {
+        case LV_DRAW_SW_BAND_TYPE_CLIP: {
+                /*Render on a copy to not modify the clip area of the original task*/
+                lv_draw_task_t band_task = *t;
+                band_task.clip_area = band->area;
+                if(owner->band_decoder_dsc) {
+                    lv_draw_sw_image_opened(&band_task, t->draw_dsc, &t->area, owner->band_decoder_dsc);
+                }
+                else {
+                    execute_drawing(&band_task);
+                }
+#if LV_USE_PARALLEL_DRAW_DEBUG
+                parallel_debug_draw(&band_task, thread_dsc->idx);
+#endif
+            }
+            break;
+        case LV_DRAW_SW_BAND_TYPE_BLUR_COLUMNS:
+            lv_draw_sw_blur_part(t, t->draw_dsc, &t->area, &band->area, true);
+            break;
+        case LV_DRAW_SW_BAND_TYPE_BLUR_ROWS:
+            lv_draw_sw_blur_part(t, t->draw_dsc, &t->area, &band->area, false);
+            break;
+    }
+
+    lv_mutex_lock(&owner->band_lock);
+    owner->band_pending--;
+    bool last = owner->band_pending == 0;
+    lv_mutex_unlock(&owner->band_lock);
+
+    /*Let the owner continue*/
+    if(last && owner != thread_dsc) lv_thread_sync_signal(&owner->sync);
+
+    LV_PROFILER_DRAW_END;
+}
+
+#endif /*LV_DRAW_SW_USE_BANDS*/
+
 #if LV_USE_PARALLEL_DRAW_DEBUG
 static void parallel_debug_draw(lv_draw_task_t * t, uint32_t idx)
 {
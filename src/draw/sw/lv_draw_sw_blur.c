@@ -9,12 +9,18 @@
 #include "../../misc/lv_area_private.h"
 #include "lv_draw_sw_mask_private.h"
 #include "../lv_draw_private.h"
-#include "lv_draw_sw.h"
+#include "lv_draw_sw_private.h"
 
 #if LV_USE_DRAW_SW
 
 #include "../../core/lv_refr_private.h"
 
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    #include "../../core/lv_global.h"
+    #include "../../misc/cache/lv_cache.h"
+    #include "../../misc/cache/class/lv_cache_lru_rb.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -22,25 +28,62 @@
 #define BLUR_INTENSITY_MAX (1 << 12)
 #define BLUR_INTENSITY_HALF ((1 << 12) / 2)
 
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    #define blur_cache LV_GLOBAL_DEFAULT()->sw_blur_cache
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+typedef struct {
+    /*The size of `data` for the cache*/
+    lv_cache_slot_size_t slot;
+
+    /*Key*/
+    uint64_t hash;          /*Hash of the pixels of `area` before blurring*/
+    lv_area_t area;         /*The blurred area relative to the layer's buffer*/
+    lv_area_t coords;       /*The coordinates of the full blurred area relative to the layer's buffer*/
+    int32_t blur_radius;
+    int32_t corner_radius;
+    lv_blur_quality_t quality;
+    lv_color_format_t cf;
+
+    /*Value*/
+    uint8_t * data;         /*The pixels of `area` after blurring*/
+} blur_cache_item_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 static void blur_1_bytes_init(uint32_t * sum, uint8_t * buf, uint32_t sample_len, int32_t stride);
-static inline uint8_t blur_1_bytes(uint32_t * sum, uint8_t px, uint32_t intensity);
+static inline uint8_t blur_1_bytes(uint32_t * sum, uint8_t px, uint32_t intensity, const uint32_t * px_inv);
 
 static void blur_2_bytes_init(uint32_t * sum, lv_color16_t * buf, uint32_t sample_len, int32_t stride, bool swapped);
-static inline uint16_t blur_2_bytes(uint32_t * sum, uint16_t px, uint32_t intensity, bool swapped);
+static inline uint16_t blur_2_bytes(uint32_t * sum, uint16_t px, uint32_t intensity, const uint32_t * px_inv,
+                                    bool swapped);
+
+static void blur_3_bytes_init(uint32_t * sum, uint8_t * buf, uint32_t sample_len, int32_t stride);
+static inline void blur_3_bytes(uint32_t * sum, uint8_t * buf, uint32_t intensity, const uint32_t * px_inv);
 
-static void blur_3_bytes_init(uint32_t * sum, volatile uint8_t * buf, uint32_t sample_len, int32_t stride);
-static inline void blur_3_bytes(uint32_t * sum, volatile uint8_t * buf, uint32_t intensity);
+static void blur_core(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                      const lv_area_t * part, bool vertical);
 
 static int32_t get_rounded_edge_point(int32_t p_start, int32_t p_end, int32_t p, int32_t r);
 
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    static bool blur_cache_item_init(blur_cache_item_t * item, lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc,
+                                     const lv_area_t * coords);
+    static uint64_t blur_cache_hash(const lv_draw_buf_t * draw_buf, const lv_area_t * area);
+    static void blur_cache_copy(lv_draw_buf_t * draw_buf, const lv_area_t * area, uint8_t * data, bool to_buf);
+    static lv_cache_compare_res_t blur_cache_compare_cb(const blur_cache_item_t * lhs, const blur_cache_item_t * rhs);
+    static bool blur_cache_create_cb(blur_cache_item_t * item, lv_draw_task_t * t);
+    static void blur_cache_free_cb(blur_cache_item_t * item, void * user_data);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -58,6 +101,115 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
     if(dsc->blur_radius == 0) return;
     LV_PROFILER_DRAW_BEGIN;
 
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    uint64_t hash;
+    if(lv_draw_sw_blur_cache_restore(t, dsc, coords, &hash)) {
+        LV_PROFILER_DRAW_END;
+        return;
+    }
+#endif
+
+    blur_core(t, dsc, coords, NULL, false);
+
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+    lv_draw_sw_blur_cache_add(t, dsc, coords, hash);
+#endif
+
+    LV_PROFILER_DRAW_END;
+}
+
+void lv_draw_sw_blur_part(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                          const lv_area_t * part, bool vertical)
+{
+    if(dsc->blur_radius == 0) return;
+    LV_PROFILER_DRAW_BEGIN;
+    blur_core(t, dsc, coords, part, vertical);
+    LV_PROFILER_DRAW_END;
+}
+
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+
+void lv_draw_sw_blur_cache_init(void)
+{
+    const lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)blur_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)blur_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)blur_cache_free_cb,
+    };
+
+    blur_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(blur_cache_item_t),
+                                 LV_DRAW_SW_BLUR_CACHE_SIZE, ops);
+    lv_cache_set_name(blur_cache, "SW_BLUR");
+}
+
+void lv_draw_sw_blur_cache_deinit(void)
+{
+    lv_cache_destroy(blur_cache, NULL);
+    blur_cache = NULL;
+}
+
+bool lv_draw_sw_blur_cache_restore(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                                   uint64_t * hash)
+{
+    blur_cache_item_t search_key;
+    if(!blur_cache_item_init(&search_key, t, dsc, coords)) {
+        *hash = 0;
+        return false;
+    }
+
+    LV_PROFILER_DRAW_BEGIN;
+    search_key.hash = blur_cache_hash(t->target_layer->draw_buf, &search_key.area);
+    *hash = search_key.hash;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(blur_cache, &search_key, NULL);
+    if(entry == NULL) {
+        LV_PROFILER_DRAW_END;
+        return false;
+    }
+
+    blur_cache_item_t * item = lv_cache_entry_get_data(entry);
+    blur_cache_copy(t->target_layer->draw_buf, &item->area, item->data, true);
+    lv_cache_release(blur_cache, entry, NULL);
+
+    LV_PROFILER_DRAW_END;
+    return true;
+}
+
+void lv_draw_sw_blur_cache_add(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                               uint64_t hash)
+{
+    blur_cache_item_t search_key;
+    if(!blur_cache_item_init(&search_key, t, dsc, coords)) return;
+    if(search_key.slot.size > LV_DRAW_SW_BLUR_CACHE_SIZE) return;
+
+    LV_PROFILER_DRAW_BEGIN;
+    search_key.hash = hash;
+
+    /*Copy the pixels in `create_cb` as another thread might have added the same item in the meantime*/
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(blur_cache, &search_key, t);
+    if(entry) lv_cache_release(blur_cache, entry, NULL);
+
+    LV_PROFILER_DRAW_END;
+}
+
+#endif /*LV_DRAW_SW_BLUR_CACHE_SIZE > 0*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Blur an area with IIR filters
+ * @param t         the blur draw task. Its whole clip area is considered even if only a part is blurred.
+ * @param dsc       the blur descriptor
+ * @param coords    the area to blur
+ * @param part      NULL: blur in both directions;
+ *                  else blur only the columns (`vertical == true`) or rows (`vertical == false`) of this area
+ * @param vertical  select the pass if `part` is not NULL
+ */
+static void blur_core(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                      const lv_area_t * part, bool vertical)
+{
     int32_t layer_x_ofs = t->target_layer->buf_area.x1;
     int32_t layer_y_ofs = t->target_layer->buf_area.y1;
     lv_area_t clipped_coords;
@@ -112,12 +264,36 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
     int32_t next_px_ofs_byte = px_size * skip_cnt;
     bool swapped = t->target_layer->draw_buf->header.cf == LV_COLOR_FORMAT_RGB565_SWAPPED;
 
+    /*Select the columns of the vertical and the rows of the horizontal pass.
+     *Start from a multiple of skip_cnt to blur the same pixels as if the whole area were blurred at once.*/
+    int32_t col_x1 = clipped_coords.x1;
+    int32_t col_x2 = clipped_coords.x2;
+    int32_t row_y1 = clipped_coords.y1;
+    int32_t row_y2 = clipped_coords.y2;
+    if(part) {
+        if(vertical) {
+            col_x1 = LV_MAX(col_x1, ((part->x1 - layer_x_ofs + (skip_cnt - 1)) / skip_cnt) * skip_cnt);
+            col_x2 = LV_MIN(col_x2, part->x2 - layer_x_ofs);
+            row_y2 = row_y1 - 1;
+        }
+        else {
+            row_y1 = LV_MAX(row_y1, ((part->y1 - layer_y_ofs + (skip_cnt - 1)) / skip_cnt) * skip_cnt);
+            row_y2 = LV_MIN(row_y2, part->y2 - layer_y_ofs);
+            col_x2 = col_x1 - 1;
+        }
+    }
+
+    /*The new pixels are multiplied by the same value in each step, so look up the products*/
+    uint32_t px_inv[256];
+    uint32_t i;
+    for(i = 0; i < 256; i++) px_inv[i] = i * (BLUR_INTENSITY_MAX - intensity);
+
     uint32_t sum[3];
     int32_t y;
     int32_t x;
 
     /*Blur each column top to bottom and bottom to top.*/
-    for(x = clipped_coords.x1; x <= clipped_coords.x2; x += skip_cnt) {
+    for(x = col_x1; x <= col_x2; x += skip_cnt) {
         int32_t cir_y = get_rounded_edge_point(coords->x1, coords->x2, layer_x_ofs + x, radius);
         int32_t y_start = LV_CLAMP(clipped_coords.y1, coords->y1 - layer_y_ofs + cir_y, clipped_coords.y2);
         int32_t y_end = LV_CLAMP(clipped_coords.y1, coords->y2  - layer_y_ofs - cir_y, clipped_coords.y2);
@@ -130,15 +306,32 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
         uint32_t sample_len_limited = LV_MIN((y_end - y_start) / skip_cnt + 1, sample_len);
 
+#if LV_USE_DRAW_SW_SIMD
+        /*Blur the next columns of 32 bit layers together if they have the same height*/
+        int32_t group_x_last = x + (LV_DRAW_SW_BLUR_SIMD_COL_CNT - 1) * skip_cnt;
+        bool group = px_size == 4 && group_x_last <= col_x2;
+        int32_t group_x;
+        for(group_x = x + skip_cnt; group && group_x <= group_x_last; group_x += skip_cnt) {
+            group = get_rounded_edge_point(coords->x1, coords->x2, layer_x_ofs + group_x, radius) == cir_y;
+        }
+
+        if(group) {
+            uint8_t * buf_column_start = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x, y_start);
+            lv_draw_sw_blur_simd_columns(buf_column_start, next_px_ofs_byte, stride_byte * skip_cnt,
+                                         (y_end - y_start) / skip_cnt + 1, sample_len_limited, intensity);
+            x = group_x_last;
+            continue;
+        }
+#endif
+
         if(px_size == 1) {
-            /*Compiler optimization might mishandle it, so add volatile*/
             uint8_t * buf_column_start = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x, y_start);
             blur_1_bytes_init(sum, buf_column_start, sample_len_limited, stride_byte * skip_cnt);
 
             uint8_t buf_prev = buf_column_start[0] + 1; /*Make sure that it's not equal in the first round*/
             for(y = y_start; y <= y_end; y += skip_cnt) {
                 if(buf_prev != *buf_column_start) {
-                    *buf_column_start = blur_1_bytes(sum, *buf_column_start, intensity);
+                    *buf_column_start = blur_1_bytes(sum, *buf_column_start, intensity, px_inv);
                     buf_prev = *buf_column_start;
                 }
                 buf_column_start += stride_byte * skip_cnt;
@@ -149,7 +342,7 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
             buf_prev = buf_column_end[0] + 1; /*Make sure that it's not equal in the first round*/
             for(y = y_start; y <= y_end; y += skip_cnt) {
                 if(buf_prev != *buf_column_end) {
-                    *buf_column_end = blur_1_bytes(sum, *buf_column_end, intensity);
+                    *buf_column_end = blur_1_bytes(sum, *buf_column_end, intensity, px_inv);
                     buf_prev = *buf_column_end;
                 }
                 buf_column_end -= stride_byte * skip_cnt;
@@ -162,7 +355,7 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
             for(y = y_start; y <= y_end; y += skip_cnt) {
                 if(buf16_prev != *buf16_column_start) {
-                    *buf16_column_start = blur_2_bytes(sum, *buf16_column_start, intensity, swapped);
+                    *buf16_column_start = blur_2_bytes(sum, *buf16_column_start, intensity, px_inv, swapped);
                     buf16_prev = *buf16_column_start;
                 }
                 buf16_column_start += stride_px * skip_cnt;
@@ -174,26 +367,25 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
             for(y = y_start; y <= y_end; y += skip_cnt) {
                 if(buf16_prev != *buf16_column_end) {
-                    *buf16_column_end = blur_2_bytes(sum, *buf16_column_end, intensity, swapped);
+                    *buf16_column_end = blur_2_bytes(sum, *buf16_column_end, intensity, px_inv, swapped);
                     buf16_prev = *buf16_column_end;
                 }
                 buf16_column_end -= stride_px * skip_cnt;
             }
         }
         else if(px_size >= 3) {
-            /*Compiler optimization might mishandle it, so add volatile*/
-            volatile uint8_t * buf_column_start = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x, y_start);
+            uint8_t * buf_column_start = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x, y_start);
             blur_3_bytes_init(sum, buf_column_start, sample_len_limited, stride_byte * skip_cnt);
 
             for(y = y_start; y <= y_end; y += skip_cnt) {
-                blur_3_bytes(sum, buf_column_start, intensity);
+                blur_3_bytes(sum, buf_column_start, intensity, px_inv);
                 buf_column_start += stride_byte * skip_cnt;
             }
 
-            volatile uint8_t * buf_column_end = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x, y_end);
+            uint8_t * buf_column_end = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x, y_end);
             blur_3_bytes_init(sum, buf_column_end, sample_len_limited, -stride_byte * skip_cnt);
             for(y = y_start; y <= y_end; y += skip_cnt) {
-                blur_3_bytes(sum, buf_column_end, intensity);
+                blur_3_bytes(sum, buf_column_end, intensity, px_inv);
                 buf_column_end -= stride_byte * skip_cnt;
             }
         }
@@ -201,7 +393,7 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
     /*Blur each line from left to right and right to left.
      *Also fill the gap in each line because of skipped pixels*/
-    for(y = clipped_coords.y1; y <= clipped_coords.y2; y += skip_cnt) {
+    for(y = row_y1; y <= row_y2; y += skip_cnt) {
         int32_t cir_x = get_rounded_edge_point(coords->y1, coords->y2, layer_y_ofs + y, radius);
         int32_t x_start = LV_CLAMP(clipped_coords.x1, coords->x1  - layer_x_ofs + cir_x, clipped_coords.x2);
         int32_t x_end = LV_CLAMP(clipped_coords.x1, coords->x2  - layer_x_ofs - cir_x, clipped_coords.x2);
@@ -217,7 +409,6 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
 
         if(px_size == 1) {
-            /*Compiler optimization might mishandle it, so add volatile*/
             uint8_t * buf_line_start = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x_start, y);
 
             blur_1_bytes_init(sum, buf_line_start, sample_len_limited, px_size * skip_cnt);
@@ -225,7 +416,7 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
             uint8_t buf_prev = buf_line_start[0] + 1; /*Make sure that it's not equal in the first round*/
             for(x = x_start + skip_cnt; x <= x_end; x += skip_cnt) {
                 if(buf_prev != *buf_line_start) {
-                    *buf_line_start = blur_1_bytes(sum, *buf_line_start, intensity);
+                    *buf_line_start = blur_1_bytes(sum, *buf_line_start, intensity, px_inv);
                     buf_prev = *buf_line_start;
                 }
                 buf_line_start += next_px_ofs_byte;
@@ -237,7 +428,7 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
             for(x = x_start; x <= x_end; x += skip_cnt) {
                 if(buf_prev != *buf_line_end) {
-                    *buf_line_end = blur_1_bytes(sum, *buf_line_end, intensity);
+                    *buf_line_end = blur_1_bytes(sum, *buf_line_end, intensity, px_inv);
                     buf_prev = *buf_line_end;
                 }
 
@@ -271,7 +462,7 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
             for(x = x_start; x <= x_end; x += skip_cnt) {
 
                 if(buf16_prev != *buf16_line_start) {
-                    *buf16_line_start = blur_2_bytes(sum, *buf16_line_start, intensity, swapped);
+                    *buf16_line_start = blur_2_bytes(sum, *buf16_line_start, intensity, px_inv, swapped);
                     buf16_prev = *buf16_line_start;
                 }
                 buf16_line_start += skip_cnt;
@@ -283,7 +474,7 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
             for(x = x_start; x <= x_end; x += skip_cnt) {
                 if(buf16_prev != *buf16_line_end) {
-                    *buf16_line_end = blur_2_bytes(sum, *buf16_line_end, intensity, swapped);
+                    *buf16_line_end = blur_2_bytes(sum, *buf16_line_end, intensity, px_inv, swapped);
                     buf16_prev = *buf16_line_end;
                 }
 
@@ -311,20 +502,19 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
             }
         }
         else if(px_size >= 3) {
-            /*Compiler optimization might mishandle it, so add volatile*/
-            volatile uint8_t * buf_line_start = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x_start, y);
+            uint8_t * buf_line_start = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x_start, y);
 
             blur_3_bytes_init(sum, buf_line_start, sample_len_limited, px_size * skip_cnt);
             for(x = x_start + skip_cnt; x <= x_end; x += skip_cnt) {
-                blur_3_bytes(sum, buf_line_start, intensity);
+                blur_3_bytes(sum, buf_line_start, intensity, px_inv);
                 buf_line_start += next_px_ofs_byte;
             }
 
-            volatile uint8_t * buf_line_end = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x_end, y);
+            uint8_t * buf_line_end = lv_draw_buf_goto_xy(t->target_layer->draw_buf, x_end, y);
             blur_3_bytes_init(sum, buf_line_end, sample_len_limited, -(int32_t)px_size * skip_cnt);
 
             for(x = x_start; x <= x_end; x += skip_cnt) {
-                blur_3_bytes(sum, buf_line_end, intensity);
+                blur_3_bytes(sum, buf_line_end, intensity, px_inv);
 
                 /*This is the final pixel, fill the gaps in the line by just repeating the pixel (simple upscale)*/
                 if(skip_cnt == 2) {
@@ -355,14 +545,8 @@ void lv_draw_sw_blur(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const l
 
         }
     }
-
-    LV_PROFILER_DRAW_END;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 static void blur_1_bytes_init(uint32_t * sum, uint8_t * buf, uint32_t sample_len, int32_t stride)
 {
     uint32_t s;
@@ -376,7 +560,7 @@ static void blur_1_bytes_init(uint32_t * sum, uint8_t * buf, uint32_t sample_len
     sum[0] = (sum[0] << BLUR_INTENSITY_BITS) / sample_len;
 }
 
-static void blur_3_bytes_init(uint32_t * sum, volatile uint8_t * buf, uint32_t sample_len, int32_t stride)
+static void blur_3_bytes_init(uint32_t * sum, uint8_t * buf, uint32_t sample_len, int32_t stride)
 {
     uint32_t s;
 
@@ -418,17 +602,15 @@ static void blur_2_bytes_init(uint32_t * sum, lv_color16_t * buf, uint32_t sampl
 }
 
 
-static inline uint8_t blur_1_bytes(uint32_t * sum, uint8_t px, uint32_t intensity)
+static inline uint8_t blur_1_bytes(uint32_t * sum, uint8_t px, uint32_t intensity, const uint32_t * px_inv)
 {
-    uint32_t intensity_inv = BLUR_INTENSITY_MAX - intensity;
-
-    *sum = (((*sum) * intensity) >> BLUR_INTENSITY_BITS) + ((px * intensity_inv));
+    *sum = (((*sum) * intensity) >> BLUR_INTENSITY_BITS) + px_inv[px];
     return (*sum) >> BLUR_INTENSITY_BITS;
 }
 
-static inline uint16_t blur_2_bytes(uint32_t * sum, uint16_t px, uint32_t intensity, bool swapped)
+static inline uint16_t blur_2_bytes(uint32_t * sum, uint16_t px, uint32_t intensity, const uint32_t * px_inv,
+                                    bool swapped)
 {
-    const uint32_t inv = BLUR_INTENSITY_MAX - intensity;
     const uint32_t half = BLUR_INTENSITY_MAX >> 1;
     const uint32_t shift = BLUR_INTENSITY_BITS;
 
@@ -444,9 +626,9 @@ static inline uint16_t blur_2_bytes(uint32_t * sum, uint16_t px, uint32_t intens
     uint32_t s2 = sum[2];
 
     /* fused multiply-accumulate pattern */
-    s0 = (s0 * intensity >> shift) + (r * inv);
-    s1 = (s1 * intensity >> shift) + (g * inv);
-    s2 = (s2 * intensity >> shift) + (b * inv);
+    s0 = (s0 * intensity >> shift) + px_inv[r];
+    s1 = (s1 * intensity >> shift) + px_inv[g];
+    s2 = (s2 * intensity >> shift) + px_inv[b];
 
     sum[0] = s0;
     sum[1] = s1;
@@ -464,17 +646,15 @@ static inline uint16_t blur_2_bytes(uint32_t * sum, uint16_t px, uint32_t intens
 
 
 
-static inline void blur_3_bytes(uint32_t * sum, volatile uint8_t * buf, uint32_t intensity)
+static inline void blur_3_bytes(uint32_t * sum, uint8_t * buf, uint32_t intensity, const uint32_t * px_inv)
 {
-    uint32_t intensity_inv = BLUR_INTENSITY_MAX - intensity;
-
-    sum[0] = ((sum[0] * intensity) >> BLUR_INTENSITY_BITS) + ((buf[0] * intensity_inv));
+    sum[0] = ((sum[0] * intensity) >> BLUR_INTENSITY_BITS) + px_inv[buf[0]];
     buf[0] = sum[0] >> BLUR_INTENSITY_BITS;
 
-    sum[1] = ((sum[1] * intensity) >> BLUR_INTENSITY_BITS) + ((buf[1] * intensity_inv));
+    sum[1] = ((sum[1] * intensity) >> BLUR_INTENSITY_BITS) + px_inv[buf[1]];
     buf[1] = sum[1] >> BLUR_INTENSITY_BITS;
 
-    sum[2] = ((sum[2] * intensity) >> BLUR_INTENSITY_BITS) + ((buf[2] * intensity_inv));
+    sum[2] = ((sum[2] * intensity) >> BLUR_INTENSITY_BITS) + px_inv[buf[2]];
     buf[2] = sum[2] >> BLUR_INTENSITY_BITS;
 }
 
@@ -498,5 +678,139 @@ static int32_t get_rounded_edge_point(int32_t p_start, int32_t p_end, int32_t p,
     return r - res;
 }
 
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+
+/**
+ * Initialize the key of a cache item of a blur draw task
+ * @param item      the item to initialize. The hash is not calculated here.
+ * @param t         pointer to a blur draw task
+ * @param dsc       the blur descriptor
+ * @param coords    the coordinates of the full blurred area
+ * @return          true: there is something to blur; false: the blurred area is empty or not blurred at all
+ */
+static bool blur_cache_item_init(blur_cache_item_t * item, lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc,
+                                 const lv_area_t * coords)
+{
+    lv_memzero(item, sizeof(blur_cache_item_t));
+    if(dsc->blur_radius == 0) return false;
+
+    /*The blur reads and writes only the pixels inside the clip area, so these are enough to compare and store.
+     *The coordinates are relative to the layer as the pixels are skipped and the corners are rounded
+     *relative to the layer's buffer.*/
+    if(!lv_area_intersect(&item->area, coords, &t->clip_area)) return false;
+
+    int32_t layer_x_ofs = t->target_layer->buf_area.x1;
+    int32_t layer_y_ofs = t->target_layer->buf_area.y1;
+    lv_area_move(&item->area, -layer_x_ofs, -layer_y_ofs);
+    item->coords = *coords;
+    lv_area_move(&item->coords, -layer_x_ofs, -layer_y_ofs);
+
+    item->blur_radius = dsc->blur_radius;
+    item->corner_radius = dsc->corner_radius;
+    item->quality = dsc->quality;
+    item->cf = t->target_layer->draw_buf->header.cf;
+    item->slot.size = lv_area_get_size(&item->area) * lv_color_format_get_size(item->cf);
+
+    return true;
+}
+
+/**
+ * Calculate a 64 bit hash of the pixels of an area
+ * @param draw_buf  the buffer of the layer
+ * @param area      the area relative to the buffer
+ * @return          the hash
+ */
+static uint64_t blur_cache_hash(const lv_draw_buf_t * draw_buf, const lv_area_t * area)
+{
+    const uint64_t prime = 0x9E3779B97F4A7C15ULL;
+    uint32_t line_len = lv_area_get_width(area) * lv_color_format_get_size(draw_buf->header.cf);
+    uint64_t h = line_len;
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        const uint8_t * buf = lv_draw_buf_goto_xy(draw_buf, area->x1, y);
+        const uint8_t * buf_end = buf + line_len;
+
+        /*Mix 8 bytes at once and the remaining bytes one by one*/
+        for(; buf + 8 <= buf_end; buf += 8) {
+            uint64_t v;
+            lv_memcpy(&v, buf, sizeof(v));
+            h = ((h << 31) | (h >> 33)) ^ v;
+            h *= prime;
+        }
+
+        for(; buf < buf_end; buf++) {
+            h = ((h << 31) | (h >> 33)) ^ *buf;
+            h *= prime;
+        }
+    }
+
+    h ^= h >> 32;
+    h *= prime;
+    h ^= h >> 29;
+    return h;
+}
+
+/**
+ * Copy the pixels of an area between a layer and a continuous buffer
+ * @param draw_buf  the buffer of the layer
+ * @param area      the area relative to the buffer
+ * @param data      the continuous buffer
+ * @param to_buf    true: copy `data` to the layer; false: copy the layer to `data`
+ */
+static void blur_cache_copy(lv_draw_buf_t * draw_buf, const lv_area_t * area, uint8_t * data, bool to_buf)
+{
+    uint32_t line_len = lv_area_get_width(area) * lv_color_format_get_size(draw_buf->header.cf);
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        uint8_t * buf = lv_draw_buf_goto_xy(draw_buf, area->x1, y);
+        if(to_buf) lv_memcpy(buf, data, line_len);
+        else lv_memcpy(data, buf, line_len);
+        data += line_len;
+    }
+}
+
+static lv_cache_compare_res_t blur_cache_compare_cb(const blur_cache_item_t * lhs, const blur_cache_item_t * rhs)
+{
+    if(lhs->hash != rhs->hash) return lhs->hash > rhs->hash ? 1 : -1;
+    if(lhs->blur_radius != rhs->blur_radius) return lhs->blur_radius > rhs->blur_radius ? 1 : -1;
+    if(lhs->corner_radius != rhs->corner_radius) return lhs->corner_radius > rhs->corner_radius ? 1 : -1;
+    if(lhs->quality != rhs->quality) return lhs->quality > rhs->quality ? 1 : -1;
+    if(lhs->cf != rhs->cf) return lhs->cf > rhs->cf ? 1 : -1;
+
+    const lv_area_t * lhs_areas[2] = {&lhs->area, &lhs->coords};
+    const lv_area_t * rhs_areas[2] = {&rhs->area, &rhs->coords};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        const lv_area_t * a = lhs_areas[i];
+        const lv_area_t * b = rhs_areas[i];
+        if(a->x1 != b->x1) return a->x1 > b->x1 ? 1 : -1;
+        if(a->y1 != b->y1) return a->y1 > b->y1 ? 1 : -1;
+        if(a->x2 != b->x2) return a->x2 > b->x2 ? 1 : -1;
+        if(a->y2 != b->y2) return a->y2 > b->y2 ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static bool blur_cache_create_cb(blur_cache_item_t * item, lv_draw_task_t * t)
+{
+    item->data = lv_malloc(item->slot.size);
+    if(item->data == NULL) {
+        LV_LOG_WARN("Couldn't allocate %d bytes for the blur cache", (int)item->slot.size);
+        return false;
+    }
+
+    blur_cache_copy(t->target_layer->draw_buf, &item->area, item->data, false);
+    return true;
+}
+
+static void blur_cache_free_cb(blur_cache_item_t * item, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(item->data);
+    item->data = NULL;
+}
+
+#endif /*LV_DRAW_SW_BLUR_CACHE_SIZE > 0*/
 
 #endif /*LV_USE_DRAW_SW*/
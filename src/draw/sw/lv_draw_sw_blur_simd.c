@@ -0,0 +1,158 @@
+/**
+ * @file lv_draw_sw_blur_simd.c
+ * Blur the columns of 4 bytes per pixel layers with the vector extensions of GCC and Clang
+ *
+ * `LV_DRAW_SW_BLUR_SIMD_COL_CNT` neighboring columns are blurred at once, each in a lane of the vectors.
+ * So the filters of the columns run in parallel and the pixels are read row by row.
+ * The results are the same as the results of the C implementation in lv_draw_sw_blur.c, bit by bit.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_private.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD
+
+#if !defined(__GNUC__)
+    #error "LV_USE_DRAW_SW_SIMD requires GCC or Clang"
+#endif
+
+#if !defined(__clang__)
+    /*The vectors are passed only to static functions so the ABI they are passed with doesn't matter*/
+    #pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define COL_CNT     LV_DRAW_SW_BLUR_SIMD_COL_CNT
+
+/*The same as in lv_draw_sw_blur.c*/
+#define BLUR_INTENSITY_BITS 12
+#define BLUR_INTENSITY_MAX (1 << 12)
+
+/*Functions returning vectors are never called to keep the vectors in registers*/
+#define INLINE      inline __attribute__((always_inline))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef uint32_t vec_u32_t __attribute__((vector_size(COL_CNT * 4)));
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The static functions are defined first as they are inlined into the global functions*/
+
+/**
+ * Read a pixel from each column
+ * @param buf       the pixel of the first column
+ * @param col_ofs   the distance of the columns in bytes
+ * @return          the pixels in the lanes
+ */
+static INLINE vec_u32_t load_row(const uint8_t * buf, int32_t col_ofs)
+{
+    vec_u32_t px;
+    if(col_ofs == 4) {
+        __builtin_memcpy(&px, buf, sizeof(px));
+        return px;
+    }
+
+    uint32_t px_buf[COL_CNT];
+    uint32_t i;
+    for(i = 0; i < COL_CNT; i++) {
+        __builtin_memcpy(&px_buf[i], buf + i * col_ofs, 4);
+    }
+
+    __builtin_memcpy(&px, px_buf, sizeof(px));
+    return px;
+}
+
+/**
+ * Write a pixel to each column
+ * @param buf       the pixel of the first column
+ * @param col_ofs   the distance of the columns in bytes
+ * @param px        the pixels in the lanes
+ */
+static INLINE void store_row(uint8_t * buf, int32_t col_ofs, const vec_u32_t * px)
+{
+    if(col_ofs == 4) {
+        __builtin_memcpy(buf, px, sizeof(*px));
+        return;
+    }
+
+    uint32_t px_buf[COL_CNT];
+    __builtin_memcpy(px_buf, px, sizeof(*px));
+    uint32_t i;
+    for(i = 0; i < COL_CNT; i++) {
+        __builtin_memcpy(buf + i * col_ofs, &px_buf[i], 4);
+    }
+}
+
+/**
+ * Blur the columns in one direction as `blur_3_bytes_init` and `blur_3_bytes` do
+ * @param buf           the first pixel of the first column
+ * @param col_ofs       the distance of the columns in bytes
+ * @param stride        the distance of the pixels of a column in bytes, negative to blur upwards
+ * @param len           number of pixels in a column
+ * @param sample_len    number of pixels to initialize the filters from
+ * @param intensity     the coefficient of the filter
+ */
+static INLINE void blur_pass(uint8_t * buf, int32_t col_ofs, int32_t stride, int32_t len,
+                             uint32_t sample_len, uint32_t intensity)
+{
+    vec_u32_t sum[3] = {{0}, {0}, {0}};
+    uint32_t c;
+    uint32_t s;
+    const uint8_t * sample = buf;
+    for(s = 0; s < sample_len; s++) {
+        vec_u32_t px = load_row(sample, col_ofs);
+        for(c = 0; c < 3; c++) sum[c] += (px >> (c * 8)) & 0xFF;
+        sample += stride;
+    }
+
+    for(c = 0; c < 3; c++) sum[c] = (sum[c] << BLUR_INTENSITY_BITS) / sample_len;
+
+    uint32_t intensity_inv = BLUR_INTENSITY_MAX - intensity;
+    int32_t y;
+    for(y = 0; y < len; y++) {
+        vec_u32_t px = load_row(buf, col_ofs);
+        /*Keep the alpha channel*/
+        vec_u32_t res = px & 0xFF000000;
+        for(c = 0; c < 3; c++) {
+            sum[c] = ((sum[c] * intensity) >> BLUR_INTENSITY_BITS) + ((px >> (c * 8)) & 0xFF) * intensity_inv;
+            res |= (sum[c] >> BLUR_INTENSITY_BITS) << (c * 8);
+        }
+
+        store_row(buf, col_ofs, &res);
+        buf += stride;
+    }
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_blur_simd_columns(uint8_t * buf, int32_t col_ofs, int32_t stride, int32_t len,
+                                  uint32_t sample_len, uint32_t intensity)
+{
+    blur_pass(buf, col_ofs, stride, len, sample_len, intensity);
+    blur_pass(buf + (len - 1) * stride, col_ofs, -stride, len, sample_len, intensity);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD*/
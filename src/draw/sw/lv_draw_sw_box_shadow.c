@@ -15,7 +15,10 @@
 #if LV_DRAW_SW_COMPLEX
 
 #include "blend/lv_draw_sw_blend_private.h"
+#include "lv_draw_sw_private.h"
 #include "../../core/lv_global.h"
+#include "../../misc/cache/lv_cache.h"
+#include "../../misc/cache/class/lv_cache_lru_rb.h"
 
 /*********************
  *      DEFINES
@@ -31,12 +34,39 @@
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+typedef struct {
+    /*Key*/
+    int32_t sw;         /*Shadow width*/
+    int32_t r;          /*Clamped radius*/
+    int32_t w;          /*Width of the blurred rectangle, limited to the sizes which still change the corner*/
+    int32_t h;          /*Height of the blurred rectangle, limited to the sizes which still change the corner*/
+
+    /*Value*/
+    lv_opa_t * buf;     /*The blurred corner*/
+} shadow_cache_item_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_opa_t * shadow_get_corner(const lv_area_t * core_area, int32_t sw, int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t sw,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_mask_rows(lv_draw_sw_mask_radius_param_t * mask_param, int32_t size,
+                                                         int32_t y1, int32_t row_cnt, int32_t sw, uint16_t * sh_ups_buf);
+static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_rows(int32_t size, int32_t row_cnt, int32_t sw, uint16_t * sh_ups_buf);
+static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_rect_corner(lv_draw_sw_mask_radius_param_t * mask_param,
+                                                                int32_t size, int32_t y1, int32_t sw,
+                                                                uint16_t * sh_ups_buf);
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    static bool shadow_cache_create_cb(shadow_cache_item_t * item, void * user_data);
+    static void shadow_cache_free_cb(shadow_cache_item_t * item, void * user_data);
+    static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_item_t * lhs,
+                                                          const shadow_cache_item_t * rhs);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -92,34 +122,7 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->width  + r_sh;
 
-    lv_opa_t * sh_buf;
-
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        LV_ASSERT_MALLOC(sh_buf);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        LV_ASSERT_MALLOC(sh_buf);
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
-    }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    LV_ASSERT_MALLOC(sh_buf);
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    lv_opa_t * sh_buf = shadow_get_corner(&core_area, dsc->width, r_sh);
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -554,10 +557,75 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     lv_free(mask_buf);
 }
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+
+void lv_draw_sw_box_shadow_cache_init(void)
+{
+    const lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)shadow_cache_free_cb,
+    };
+
+    shadow_cache = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(shadow_cache_item_t),
+                                   LV_DRAW_SW_SHADOW_CACHE_CNT, ops);
+    lv_cache_set_name(shadow_cache, "SW_SHADOW");
+}
+
+void lv_draw_sw_box_shadow_cache_deinit(void)
+{
+    lv_cache_destroy(shadow_cache, NULL);
+    shadow_cache = NULL;
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE > 0*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the blurred top right corner of a shadow from the cache or calculate it
+ * @param core_area     the rectangle which is blurred
+ * @param sw            shadow width
+ * @param r             the clamped radius
+ * @return              the corner in a new buffer of `(sw + r)^2` bytes which can be modified and should be freed
+ */
+static lv_opa_t * shadow_get_corner(const lv_area_t * core_area, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    if(size <= LV_DRAW_SW_SHADOW_CACHE_SIZE) {
+        /*Only the size of the rectangle matters and only until its other corners are far enough
+         *to not change the blurred corner. This way the same corner is used for many rectangles.*/
+        shadow_cache_item_t search_key;
+        lv_memzero(&search_key, sizeof(search_key));
+        search_key.sw = sw;
+        search_key.r = r;
+        search_key.w = LV_MIN(lv_area_get_width(core_area), 2 * size + 1);
+        search_key.h = LV_MIN(lv_area_get_height(core_area), 2 * size + 1);
+
+        /*The draw threads share the cache, so copy the corner as it will be mirrored while drawing*/
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(shadow_cache, &search_key, NULL);
+        if(entry) {
+            shadow_cache_item_t * item = lv_cache_entry_get_data(entry);
+            lv_opa_t * sh_buf = lv_malloc(size * size);
+            LV_ASSERT_MALLOC(sh_buf);
+            lv_memcpy(sh_buf, item->buf, size * size);
+            lv_cache_release(shadow_cache, entry, NULL);
+            return sh_buf;
+        }
+    }
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE > 0*/
+
+    /*A larger buffer is required for calculation*/
+    lv_opa_t * sh_buf = lv_malloc(size * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_buf);
+    shadow_draw_corner_buf(core_area, (uint16_t *)sh_buf, sw, r);
+    return sh_buf;
+}
+
 /**
  * Calculate a blurred corner
  * @param coords Coordinates of the shadow
@@ -588,41 +656,28 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_draw_corner_buf(const lv_area_t * coord
     else sw = sw_ori >> 1;
 #endif /*SHADOW_ENHANCE*/
 
-    int32_t y;
-    lv_opa_t * mask_line = lv_malloc(size);
-    uint16_t * sh_ups_tmp_buf = (uint16_t *)sh_buf;
-    for(y = 0; y < size; y++) {
-        lv_memset(mask_line, 0xff, size);
-        lv_draw_sw_mask_res_t mask_res = mask_param.dsc.cb(mask_line, 0, y, size, &mask_param);
-        if(mask_res == LV_DRAW_SW_MASK_RES_TRANSP) {
-            lv_memzero(sh_ups_tmp_buf, size * sizeof(sh_ups_tmp_buf[0]));
-        }
-        else {
+    if(r == 0 && sw > 1 && sh_area.y2 >= size - 1) {
+        /*The rows of a rectangle are the same below `sh_area.y1`, so the blurred corner can be calculated from
+         *a blurred row and a blurred column*/
+        shadow_blur_rect_corner(&mask_param, size, sh_area.y1, sw, sh_buf);
+        lv_draw_sw_mask_free_param(&mask_param);
+    }
+    else {
+        shadow_mask_rows(&mask_param, size, 0, size, sw, sh_buf);
+        lv_draw_sw_mask_free_param(&mask_param);
+
+        if(sw == 1) {
             int32_t i;
-            sh_ups_tmp_buf[0] = (mask_line[0] << SHADOW_UPSCALE_SHIFT) / sw;
-            for(i = 1; i < size; i++) {
-                if(mask_line[i] == mask_line[i - 1]) sh_ups_tmp_buf[i] = sh_ups_tmp_buf[i - 1];
-                else  sh_ups_tmp_buf[i] = (mask_line[i] << SHADOW_UPSCALE_SHIFT) / sw;
+            lv_opa_t * res_buf = (lv_opa_t *)sh_buf;
+            for(i = 0; i < size * size; i++) {
+                res_buf[i] = (sh_buf[i] >> SHADOW_UPSCALE_SHIFT);
             }
+            return;
         }
 
-        sh_ups_tmp_buf += size;
-    }
-    lv_free(mask_line);
-
-    lv_draw_sw_mask_free_param(&mask_param);
-
-    if(sw == 1) {
-        int32_t i;
-        lv_opa_t * res_buf = (lv_opa_t *)sh_buf;
-        for(i = 0; i < size * size; i++) {
-            res_buf[i] = (sh_buf[i] >> SHADOW_UPSCALE_SHIFT);
-        }
-        return;
+        shadow_blur_corner(size, sw, sh_buf);
     }
 
-    shadow_blur_corner(size, sw, sh_buf);
-
 #if SHADOW_ENHANCE == 0
     /*The result is required in lv_opa_t not uint16_t*/
     uint32_t x;
@@ -652,13 +707,54 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_draw_corner_buf(const lv_area_t * coord
 
 }
 
-static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf)
+/**
+ * Initialize the rows of a corner from a radius mask
+ * @param mask_param    the radius mask of the shadow's rectangle
+ * @param size          the width and height of the corner
+ * @param y1            the first row to initialize
+ * @param row_cnt       number of rows to initialize
+ * @param sw            the shadow width of the blur
+ * @param sh_ups_buf    store the upscaled opacities of the rows here
+ */
+static void LV_ATTRIBUTE_FAST_MEM shadow_mask_rows(lv_draw_sw_mask_radius_param_t * mask_param, int32_t size,
+                                                   int32_t y1, int32_t row_cnt, int32_t sw, uint16_t * sh_ups_buf)
+{
+    int32_t y;
+    lv_opa_t * mask_line = lv_malloc(size);
+    uint16_t * sh_ups_tmp_buf = sh_ups_buf;
+    for(y = y1; y < y1 + row_cnt; y++) {
+        lv_memset(mask_line, 0xff, size);
+        lv_draw_sw_mask_res_t mask_res = mask_param->dsc.cb(mask_line, 0, y, size, mask_param);
+        if(mask_res == LV_DRAW_SW_MASK_RES_TRANSP) {
+            lv_memzero(sh_ups_tmp_buf, size * sizeof(sh_ups_tmp_buf[0]));
+        }
+        else {
+            int32_t i;
+            sh_ups_tmp_buf[0] = (mask_line[0] << SHADOW_UPSCALE_SHIFT) / sw;
+            for(i = 1; i < size; i++) {
+                if(mask_line[i] == mask_line[i - 1]) sh_ups_tmp_buf[i] = sh_ups_tmp_buf[i - 1];
+                else  sh_ups_tmp_buf[i] = (mask_line[i] << SHADOW_UPSCALE_SHIFT) / sw;
+            }
+        }
+
+        sh_ups_tmp_buf += size;
+    }
+    lv_free(mask_line);
+}
+
+/**
+ * Blur the rows of a corner horizontally
+ * @param size          the width and height of the corner
+ * @param row_cnt       number of rows to blur
+ * @param sw            the shadow width of the blur
+ * @param sh_ups_buf    the upscaled opacities of the rows
+ */
+static void LV_ATTRIBUTE_FAST_MEM shadow_blur_rows(int32_t size, int32_t row_cnt, int32_t sw, uint16_t * sh_ups_buf)
 {
     int32_t s_left = sw >> 1;
     int32_t s_right = (sw >> 1);
     if((sw & 1) == 0) s_left--;
 
-    /*Horizontal blur*/
     uint16_t * sh_ups_blur_buf = lv_malloc(size * sizeof(uint16_t));
 
     int32_t x;
@@ -666,7 +762,7 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
 
     uint16_t * sh_ups_tmp_buf = sh_ups_buf;
 
-    for(y = 0; y < size; y++) {
+    for(y = 0; y < row_cnt; y++) {
         int32_t v = sh_ups_tmp_buf[size - 1] * sw;
         for(x = size - 1; x >= 0; x--) {
             sh_ups_blur_buf[x] = v;
@@ -686,6 +782,23 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
         sh_ups_tmp_buf += size;
     }
 
+    lv_free(sh_ups_blur_buf);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf)
+{
+    int32_t s_left = sw >> 1;
+    int32_t s_right = (sw >> 1);
+    if((sw & 1) == 0) s_left--;
+
+    /*Horizontal blur*/
+    shadow_blur_rows(size, size, sw, sh_ups_buf);
+
+    int32_t x;
+    int32_t y;
+    uint16_t * sh_ups_tmp_buf;
+    uint16_t * sh_ups_blur_buf = lv_malloc(size * sizeof(uint16_t));
+
     /*Vertical blur*/
     uint32_t i;
     uint32_t max_v = LV_OPA_COVER << SHADOW_UPSCALE_SHIFT;
@@ -725,6 +838,107 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     lv_free(sh_ups_blur_buf);
 }
 
+/**
+ * Blur the corner of a rectangle without radius the same way as `shadow_blur_corner` does but faster.
+ * The corner is empty above `y1` and the rows below it are the same. So each column of the horizontally
+ * blurred corner is a step scaled by a value of the blurred row. As the vertical blur is linear,
+ * the result is the product of the blurred row and a vertically blurred step.
+ * @param mask_param    the radius mask of the shadow's rectangle
+ * @param size          the width and height of the corner
+ * @param y1            the first not empty row
+ * @param sw            the shadow width of the blur
+ * @param sh_ups_buf    store the blurred corner here
+ */
+static void LV_ATTRIBUTE_FAST_MEM shadow_blur_rect_corner(lv_draw_sw_mask_radius_param_t * mask_param,
+                                                          int32_t size, int32_t y1, int32_t sw, uint16_t * sh_ups_buf)
+{
+    int32_t s_left = sw >> 1;
+    int32_t s_right = (sw >> 1);
+    if((sw & 1) == 0) s_left--;
+
+    /*Blur a row horizontally*/
+    uint16_t * row = lv_malloc(size * sizeof(uint16_t));
+    shadow_mask_rows(mask_param, size, y1, 1, sw, row);
+    shadow_blur_rows(size, 1, sw, row);
+
+    int32_t x;
+    int32_t y;
+    uint32_t max_v = LV_OPA_COVER << SHADOW_UPSCALE_SHIFT;
+    uint32_t max_v_div = max_v / sw;
+    for(x = 0; x < size; x++) {
+        if(row[x] == 0) continue;
+        else if(row[x] == max_v) row[x] = max_v_div;
+        else row[x] = row[x] / sw;
+    }
+
+    /*Blur a step from 0 to 1 at `y1` vertically. The sum of the window is kept without downscaling.*/
+    int32_t * col = lv_malloc(size * sizeof(int32_t));
+    int32_t v = y1 <= 0 ? sw : 0;
+    for(y = 0; y < size; y++) {
+        col[y] = v;
+
+        /*Forget the top pixel*/
+        if(y - s_right <= 0) v -= y >= y1;
+        else v -= y - s_right >= y1;
+
+        /*Add the bottom pixel*/
+        if(y + s_left + 1 < size) v += y + s_left + 1 >= y1;
+        else v += size - 1 >= y1;
+    }
+
+    uint16_t * sh_ups_tmp_buf = sh_ups_buf;
+    for(y = 0; y < size; y++) {
+        for(x = 0; x < size; x++) {
+            int32_t px = row[x] * col[y];
+            sh_ups_tmp_buf[x] = px < 0 ? 0 : (px >> SHADOW_UPSCALE_SHIFT);
+        }
+        sh_ups_tmp_buf += size;
+    }
+
+    lv_free(col);
+    lv_free(row);
+}
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+
+static bool shadow_cache_create_cb(shadow_cache_item_t * item, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    int32_t size = item->sw + item->r;
+    uint16_t * sh_ups_buf = lv_malloc(size * size * sizeof(uint16_t));
+    if(sh_ups_buf == NULL) return false;
+
+    lv_area_t core_area = {0, 0, item->w - 1, item->h - 1};
+    shadow_draw_corner_buf(&core_area, sh_ups_buf, item->sw, item->r);
+
+    /*Keep only the opacities*/
+    item->buf = lv_realloc(sh_ups_buf, size * size);
+    if(item->buf == NULL) item->buf = (lv_opa_t *)sh_ups_buf;
+
+    return true;
+}
+
+static void shadow_cache_free_cb(shadow_cache_item_t * item, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(item->buf);
+    item->buf = NULL;
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_item_t * lhs,
+                                                      const shadow_cache_item_t * rhs)
+{
+    if(lhs->sw != rhs->sw) return lhs->sw > rhs->sw ? 1 : -1;
+    if(lhs->r != rhs->r) return lhs->r > rhs->r ? 1 : -1;
+    if(lhs->w != rhs->w) return lhs->w > rhs->w ? 1 : -1;
+    if(lhs->h != rhs->h) return lhs->h > rhs->h ? 1 : -1;
+
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE > 0*/
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
@@ -62,6 +62,10 @@ static void img_draw_core(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_d
                           const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
                           const lv_area_t * img_coords, const lv_area_t * clipped_img_area);
 
+static void img_draw_decoded(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                             const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                             const lv_area_t * img_coords, const lv_area_t * clipped_img_area);
+
 
 #if LV_DRAW_SW_COMPLEX
 static void radius_only(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
@@ -206,6 +210,12 @@ void lv_draw_sw_image(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
     }
 }
 
+void lv_draw_sw_image_opened(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                             const lv_area_t * coords, lv_image_decoder_dsc_t * decoder_dsc)
+{
+    lv_draw_image_opened_helper(t, draw_dsc, coords, decoder_dsc, img_draw_core);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -213,6 +223,32 @@ void lv_draw_sw_image(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
 static void img_draw_core(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
                           const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
                           const lv_area_t * img_coords, const lv_area_t * clipped_img_area)
+{
+#if LV_USE_IMAGE_CACHE_CONVERT
+    bool transformed = draw_dsc->rotation != 0 || draw_dsc->scale_x != LV_SCALE_NONE ||
+                       draw_dsc->scale_y != LV_SCALE_NONE;
+
+    /*Use the copy converted to the layer's color format so that the image can be simply copied*/
+    if(!transformed && draw_dsc->clip_radius == 0 && draw_dsc->recolor_opa <= LV_OPA_MIN &&
+       draw_dsc->colorkey == NULL) {
+        lv_cache_entry_t * entry = lv_image_decoder_acquire_converted(decoder_dsc, t->target_layer->color_format);
+        if(entry) {
+            lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+            lv_image_decoder_dsc_t converted_dsc = *decoder_dsc;
+            converted_dsc.decoded = cached_data->decoded;
+            img_draw_decoded(t, draw_dsc, &converted_dsc, sup, img_coords, clipped_img_area);
+            lv_cache_release(LV_GLOBAL_DEFAULT()->img_cache, entry, NULL);
+            return;
+        }
+    }
+#endif
+
+    img_draw_decoded(t, draw_dsc, decoder_dsc, sup, img_coords, clipped_img_area);
+}
+
+static void img_draw_decoded(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                             const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                             const lv_area_t * img_coords, const lv_area_t * clipped_img_area)
 {
     bool transformed = draw_dsc->rotation != 0 || draw_dsc->scale_x != LV_SCALE_NONE ||
                        draw_dsc->scale_y != LV_SCALE_NONE ? true : false;
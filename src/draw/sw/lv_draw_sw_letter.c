@@ -156,6 +156,24 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_cb(lv_draw_task_t * t, lv_draw_gly
                             lv_draw_sw_blend(t, &blend_dsc);
                         }
                         else {
+#if LV_USE_DRAW_GLYPH_ATLAS
+                            /*Blend directly from the atlas page*/
+                            lv_draw_glyph_atlas_glyph_t atlas_glyph;
+                            if(lv_draw_glyph_atlas_acquire(glyph_draw_dsc->g, glyph_draw_dsc->_draw_buf, &atlas_glyph)) {
+                                lv_draw_sw_blend_dsc_t blend_dsc;
+                                lv_memzero(&blend_dsc, sizeof(blend_dsc));
+                                blend_dsc.color = glyph_draw_dsc->color;
+                                blend_dsc.opa = glyph_draw_dsc->opa;
+                                blend_dsc.mask_buf = atlas_glyph.data;
+                                blend_dsc.mask_area = &mask_area;
+                                blend_dsc.mask_stride = atlas_glyph.stride;
+                                blend_dsc.blend_area = glyph_draw_dsc->letter_coords;
+                                blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+                                lv_draw_sw_blend(t, &blend_dsc);
+                                lv_draw_glyph_atlas_release(&atlas_glyph);
+                                break;
+                            }
+#endif
                             glyph_draw_dsc->glyph_data = lv_font_get_glyph_bitmap(glyph_draw_dsc->g, glyph_draw_dsc->_draw_buf);
                             if(glyph_draw_dsc->glyph_data == NULL) {
                                 LV_LOG_WARN("Couldn't get the bitmap of a glyph");
@@ -177,7 +195,11 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_cb(lv_draw_task_t * t, lv_draw_gly
                         }
                     }
                     else {
+#if LV_USE_DRAW_GLYPH_ATLAS
+                        glyph_draw_dsc->glyph_data = lv_draw_glyph_atlas_get_bitmap(glyph_draw_dsc->g, glyph_draw_dsc->_draw_buf);
+#else
                         glyph_draw_dsc->glyph_data = lv_font_get_glyph_bitmap(glyph_draw_dsc->g, glyph_draw_dsc->_draw_buf);
+#endif
                         lv_draw_image_dsc_t img_dsc;
                         lv_draw_image_dsc_init(&img_dsc);
                         img_dsc.rotation = glyph_draw_dsc->rotation;
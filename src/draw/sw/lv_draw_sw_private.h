@@ -23,14 +23,44 @@ extern "C" {
  *      DEFINES
  *********************/
 
-/**********************
- *      TYPEDEFS
- **********************/
+/** Draw tasks can be split into horizontal bands rendered by more threads */
+#define LV_DRAW_SW_USE_BANDS (LV_USE_OS && LV_DRAW_SW_DRAW_UNIT_CNT > 1 && LV_DRAW_SW_SPLIT_MIN_SIZE > 0)
+
+#if LV_DRAW_SW_USE_BANDS
+/** Maximum number of bands a draw task can be split into */
+#define LV_DRAW_SW_BAND_CNT_MAX (LV_DRAW_SW_DRAW_UNIT_CNT * 4)
+#endif
+
+#if LV_USE_DRAW_SW_SIMD
+/** The SIMD transform functions process this many pixels at once */
+#define LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT 4
+
+/** The SIMD blur functions process this many columns at once */
+#define LV_DRAW_SW_BLUR_SIMD_COL_CNT 8
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_USE_BANDS
+typedef enum {
+    /** Render the draw task clipped to the area of the band */
+    LV_DRAW_SW_BAND_TYPE_CLIP,
+
+    /** Blur the columns of the band vertically */
+    LV_DRAW_SW_BAND_TYPE_BLUR_COLUMNS,
+
+    /** Blur the rows of the band horizontally */
+    LV_DRAW_SW_BAND_TYPE_BLUR_ROWS,
+} lv_draw_sw_band_type_t;
+
+typedef struct {
+    lv_area_t area;
+    lv_draw_sw_band_type_t type;
+} lv_draw_sw_band_t;
+#endif
+
 typedef struct {
     lv_draw_task_t * task_act;
     lv_thread_t thread;
@@ -39,6 +69,25 @@ typedef struct {
     uint32_t idx;
     volatile bool inited;
     volatile bool exit_status;
+#if LV_DRAW_SW_USE_BANDS
+    /** Protects the bands and `band_pending` */
+    lv_mutex_t band_lock;
+
+    /** Deque of the not started bands of `task_act` */
+    lv_draw_sw_band_t bands[LV_DRAW_SW_BAND_CNT_MAX];
+
+    /** The thread takes its own bands from the head */
+    volatile uint32_t band_head;
+
+    /** Other threads steal the bands from the tail */
+    volatile uint32_t band_tail;
+
+    /** Number of bands of `task_act` which are not finished yet */
+    volatile uint32_t band_pending;
+
+    /** The fully decoded image of `task_act` shared by its bands, or NULL to open it in each band */
+    lv_image_decoder_dsc_t * band_decoder_dsc;
+#endif
 } lv_draw_sw_thread_dsc_t;
 
 struct _lv_draw_sw_unit_t {
@@ -50,18 +99,139 @@ struct _lv_draw_sw_unit_t {
 #endif
 };
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
-} lv_draw_sw_shadow_cache_t;
-#endif
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Draw a not tiled image which is already opened. Used to open an image only once if it's drawn in bands.
+ * @param t             pointer to a draw task
+ * @param draw_dsc      the draw descriptor
+ * @param coords        the coordinates of the image
+ * @param decoder_dsc   the opened image. It must be fully decoded if more threads use it at the same time.
+ */
+void lv_draw_sw_image_opened(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                             const lv_area_t * coords, lv_image_decoder_dsc_t * decoder_dsc);
+
+/**
+ * Blur only the columns or only the rows of a part of a blur draw task.
+ * Used to blur a large area on more threads. All the columns must be blurred before the rows.
+ * @param t         pointer to a draw task
+ * @param dsc       the blur descriptor
+ * @param coords    the coordinates of the full blurred area
+ * @param part      blur only the columns or rows of this area
+ * @param vertical  true: blur the columns of `part`; false: blur the rows of `part`
+ */
+void lv_draw_sw_blur_part(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                          const lv_area_t * part, bool vertical);
+
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+
+/**
+ * Create the cache of the blurred shadow corners
+ */
+void lv_draw_sw_box_shadow_cache_init(void);
+
+/**
+ * Delete the cache of the blurred shadow corners
+ */
+void lv_draw_sw_box_shadow_cache_deinit(void);
+
+#endif /*LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0*/
+
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+
+/**
+ * Create the cache of the blurred areas
+ */
+void lv_draw_sw_blur_cache_init(void);
+
+/**
+ * Delete the cache of the blurred areas
+ */
+void lv_draw_sw_blur_cache_deinit(void);
+
+/**
+ * Restore the result of an earlier blur if the same pixels were blurred with the same parameters.
+ * @param t         pointer to a blur draw task
+ * @param dsc       the blur descriptor
+ * @param coords    the coordinates of the full blurred area
+ * @param hash      store the hash of the not blurred pixels here to pass it to `lv_draw_sw_blur_cache_add`
+ * @return          true: the blurred pixels were restored; false: the area needs to be blurred
+ */
+bool lv_draw_sw_blur_cache_restore(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                                   uint64_t * hash);
+
+/**
+ * Save the blurred pixels of an area to restore them next time
+ * @param t         pointer to a blur draw task
+ * @param dsc       the blur descriptor
+ * @param coords    the coordinates of the full blurred area
+ * @param hash      the hash returned by `lv_draw_sw_blur_cache_restore` before blurring
+ */
+void lv_draw_sw_blur_cache_add(lv_draw_task_t * t, const lv_draw_blur_dsc_t * dsc, const lv_area_t * coords,
+                               uint64_t hash);
+
+#endif /*LV_DRAW_SW_BLUR_CACHE_SIZE > 0*/
+
+#if LV_USE_DRAW_SW_SIMD
+
+/**
+ * Transform the pixels of a row of an RGB888 or XRGB8888 image with SIMD instructions and anti-aliasing.
+ * Stops at the first `LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT` pixels which are not fully inside the image.
+ * The other parameters are the same as in `lv_draw_sw_transform`'s row functions.
+ * @param x         the index of the first pixel to transform
+ * @param x_end     the width of the row
+ * @param px_size   3 for RGB888, 4 for XRGB8888
+ * @return          the index of the first pixel which was not transformed
+ */
+int32_t lv_draw_sw_transform_simd_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                         int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                         int32_t x, int32_t x_end, uint8_t * dest_buf, uint32_t px_size);
+
+/**
+ * Transform the pixels of a row of an ARGB8888 image with SIMD instructions and anti-aliasing.
+ * See `lv_draw_sw_transform_simd_rgb888`.
+ * @return          the index of the first pixel which was not transformed
+ */
+int32_t lv_draw_sw_transform_simd_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                           int32_t x, int32_t x_end, uint8_t * dest_buf);
+
+/**
+ * Transform the pixels of a row of an RGB565 image with SIMD instructions and anti-aliasing.
+ * See `lv_draw_sw_transform_simd_rgb888`.
+ * @return          the index of the first pixel which was not transformed
+ */
+int32_t lv_draw_sw_transform_simd_rgb565(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                         int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                         int32_t x, int32_t x_end, uint16_t * cbuf, uint8_t * abuf);
+
+/**
+ * Transform the pixels of a row of an RGB565_SWAPPED image with SIMD instructions and anti-aliasing.
+ * See `lv_draw_sw_transform_simd_rgb888`.
+ * @return          the index of the first pixel which was not transformed
+ */
+int32_t lv_draw_sw_transform_simd_rgb565_swapped(const uint8_t * src, int32_t src_w, int32_t src_h,
+                                                 int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                                 int32_t xs_step, int32_t ys_step, int32_t x, int32_t x_end,
+                                                 uint16_t * cbuf, uint8_t * abuf);
+
+/**
+ * Blur `LV_DRAW_SW_BLUR_SIMD_COL_CNT` columns of a 4 bytes per pixel layer top to bottom and
+ * bottom to top with SIMD instructions. The columns should have the same height.
+ * @param buf           the top pixel of the first column
+ * @param col_ofs       the distance of the columns in bytes
+ * @param stride        the distance of the pixels of a column in bytes
+ * @param len           number of pixels in a column
+ * @param sample_len    number of pixels to initialize the filters from
+ * @param intensity     the coefficient of the filter. The alpha channel is not modified.
+ */
+void lv_draw_sw_blur_simd_columns(uint8_t * buf, int32_t col_ofs, int32_t stride, int32_t len,
+                                  uint32_t sample_len, uint32_t intensity);
+
+#endif /*LV_USE_DRAW_SW_SIMD*/
+
 /**********************
  *      MACROS
  **********************/
@@ -6,7 +6,7 @@
 /*********************
  *      INCLUDES
  *********************/
-#include "lv_draw_sw.h"
+#include "lv_draw_sw_private.h"
 #if LV_USE_DRAW_SW
 
 /*********************
@@ -330,8 +330,23 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
+#if LV_USE_DRAW_SW_SIMD
+    /*Only the mixing of the neighbors is vectorized, the copies are as fast in C*/
+    int32_t simd_x = aa ? 0 : x_end;
+#endif
+
     int32_t x;
     for(x = 0; x < x_end; x++) {
+#if LV_USE_DRAW_SW_SIMD
+        if(x >= simd_x) {
+            x = lv_draw_sw_transform_simd_rgb888(src, src_w, src_h, src_stride, xs_ups_start, ys_ups_start,
+                                                 xs_step, ys_step, x, x_end, dest_buf, px_size);
+            if(x >= x_end) break;
+            /*The next pixels are near the edges of the image or at the end of the row*/
+            simd_x = x + LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT;
+        }
+#endif
+
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -430,8 +445,23 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
+#if LV_USE_DRAW_SW_SIMD
+    /*Only the mixing of the neighbors is vectorized, the copies are as fast in C*/
+    int32_t simd_x = aa ? 0 : x_end;
+#endif
+
     int32_t x;
     for(x = 0; x < x_end; x++) {
+#if LV_USE_DRAW_SW_SIMD
+        if(x >= simd_x) {
+            x = lv_draw_sw_transform_simd_argb8888(src, src_w, src_h, src_stride, xs_ups_start, ys_ups_start,
+                                                   xs_step, ys_step, x, x_end, dest_buf);
+            if(x >= x_end) break;
+            /*The next pixels are near the edges of the image or at the end of the row*/
+            simd_x = x + LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT;
+        }
+#endif
+
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -659,8 +689,23 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     /*Must be signed type, because we would use negative array index calculated from stride*/
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
+#if LV_USE_DRAW_SW_SIMD
+    /*Only the mixing of the neighbors is vectorized, the copies are as fast in C*/
+    int32_t simd_x = aa && !src_has_a8 ? 0 : x_end;
+#endif
+
     int32_t x;
     for(x = 0; x < x_end; x++) {
+#if LV_USE_DRAW_SW_SIMD
+        if(x >= simd_x) {
+            x = lv_draw_sw_transform_simd_rgb565(src, src_w, src_h, src_stride, xs_ups_start, ys_ups_start,
+                                                 xs_step, ys_step, x, x_end, cbuf, abuf);
+            if(x >= x_end) break;
+            /*The next pixels are near the edges of the image or at the end of the row*/
+            simd_x = x + LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT;
+        }
+#endif
+
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -774,8 +819,23 @@ static void transform_rgb565a8_swapped(const uint8_t * src, int32_t src_w, int32
     /*Must be signed type, because we would use negative array index calculated from stride*/
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
+#if LV_USE_DRAW_SW_SIMD
+    /*Only the mixing of the neighbors is vectorized, the copies are as fast in C*/
+    int32_t simd_x = aa && !src_has_a8 ? 0 : x_end;
+#endif
+
     int32_t x;
     for(x = 0; x < x_end; x++) {
+#if LV_USE_DRAW_SW_SIMD
+        if(x >= simd_x) {
+            x = lv_draw_sw_transform_simd_rgb565_swapped(src, src_w, src_h, src_stride, xs_ups_start, ys_ups_start,
+                                                         xs_step, ys_step, x, x_end, cbuf, abuf);
+            if(x >= x_end) break;
+            /*The next pixels are near the edges of the image or at the end of the row*/
+            simd_x = x + LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT;
+        }
+#endif
+
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -0,0 +1,429 @@
+/**
+ * @file lv_draw_sw_transform_simd.c
+ * Sample the pixels of transformed images with the vector extensions of GCC and Clang
+ *
+ * The coordinates and the mixing of `LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT` pixels are calculated at once
+ * in 32 bit lanes. Only the pixels whose neighbors are all in the image are processed here,
+ * the pixels on the edges of the image are left to the C implementation.
+ * The results are the same as the results of the C implementation in lv_draw_sw_transform.c, bit by bit.
+ *
+ * Only the anti-aliased (bilinear) sampling of the formats with 16 and 32 bit colors is vectorized.
+ * Without anti-aliasing the pixels are only copied, and the 8 bit formats have so little to mix that
+ * reading the pixels one by one dominates. The C implementation is as fast or faster for them.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_private.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD
+
+#if !defined(__GNUC__)
+    #error "LV_USE_DRAW_SW_SIMD requires GCC or Clang"
+#endif
+
+#if !defined(__clang__)
+    /*The vectors are passed only to static functions so the ABI they are passed with doesn't matter*/
+    #pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define PX_CNT      LV_DRAW_SW_TRANSFORM_SIMD_PX_CNT
+
+/*Functions returning vectors are never called to keep the vectors in registers*/
+#define INLINE      inline __attribute__((always_inline))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef uint32_t vec_u32_t __attribute__((vector_size(PX_CNT * 4)));
+typedef int32_t vec_i32_t __attribute__((vector_size(PX_CNT * 4)));
+typedef uint16_t vec_u16_t __attribute__((vector_size(PX_CNT * 2)));
+
+/** A row of the source image and the position of its first pixel, as `lv_draw_sw_transform` calculates them*/
+typedef struct {
+    const uint8_t * src;
+    int32_t src_w;
+    int32_t src_h;
+    int32_t src_stride;
+    int32_t xs_ups;
+    int32_t ys_ups;
+    vec_u32_t xs_steps;     /**< `xs_step` times the index of the lanes*/
+    vec_u32_t ys_steps;     /**< `ys_step` times the index of the lanes*/
+} row_t;
+
+/** The position of `PX_CNT` consecutive pixels in the source image*/
+typedef struct {
+    vec_u32_t xs_fract;     /**< 0x00..0x7F: the weight of the horizontal neighbors*/
+    vec_u32_t ys_fract;     /**< 0x00..0x7F: the weight of the vertical neighbors*/
+    int32_t xs_int[PX_CNT];
+    int32_t ys_int[PX_CNT];
+    int32_t x_next[PX_CNT]; /**< -1 or 1: the direction of the horizontal neighbors*/
+    int32_t y_next[PX_CNT]; /**< -1 or 1: the direction of the vertical neighbors*/
+} chunk_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define SPLAT(v)            ((vec_u32_t){0} + (uint32_t)(v))
+
+/*Lanes of `a` where `m` is all ones, and lanes of `b` elsewhere*/
+#define SELECT(m, a, b)     ((((vec_u32_t)(m)) & (a)) | (~((vec_u32_t)(m)) & (b)))
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The static functions are defined first as they are inlined into the global functions*/
+
+static INLINE void row_init(row_t * row, const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step)
+{
+    row->src = src;
+    row->src_w = src_w;
+    row->src_h = src_h;
+    row->src_stride = src_stride;
+    row->xs_ups = xs_ups;
+    row->ys_ups = ys_ups;
+
+    uint32_t i;
+    for(i = 0; i < PX_CNT; i++) {
+        row->xs_steps[i] = (uint32_t)xs_step * i;
+        row->ys_steps[i] = (uint32_t)ys_step * i;
+    }
+}
+
+/**
+ * Get the position of the pixels from `x` in the source image
+ * @param row       the row to transform
+ * @param x         the index of the first pixel
+ * @param chunk     store the position here
+ * @return          true if all the pixels and their neighbors are in the image
+ */
+static INLINE bool get_chunk(const row_t * row, int32_t x, chunk_t * chunk)
+{
+    /*The same as `xs_ups_start + ((xs_step * x) >> 8)` in C*/
+    vec_i32_t xs_ups = (vec_i32_t)(row->xs_steps + (uint32_t)x * row->xs_steps[1]) >> 8;
+    vec_i32_t ys_ups = (vec_i32_t)(row->ys_steps + (uint32_t)x * row->ys_steps[1]) >> 8;
+    xs_ups += row->xs_ups;
+    ys_ups += row->ys_ups;
+
+    vec_i32_t xs_int = xs_ups >> 8;
+    vec_i32_t ys_int = ys_ups >> 8;
+    vec_i32_t xs_fract = xs_ups & 0xFF;
+    vec_i32_t ys_fract = ys_ups & 0xFF;
+    vec_i32_t x_prev = xs_fract < 0x80;
+    vec_i32_t y_prev = ys_fract < 0x80;
+    vec_i32_t x_next = x_prev | 1;
+    vec_i32_t y_next = y_prev | 1;
+
+    vec_i32_t xs_int_next = xs_int + x_next;
+    vec_i32_t ys_int_next = ys_int + y_next;
+    vec_i32_t in = (xs_int >= 0) & (xs_int < row->src_w) & (xs_int_next >= 0) & (xs_int_next < row->src_w) &
+                   (ys_int >= 0) & (ys_int < row->src_h) & (ys_int_next >= 0) & (ys_int_next < row->src_h);
+
+    uint64_t in_u64[PX_CNT / 2];
+    __builtin_memcpy(in_u64, &in, sizeof(in));
+    uint64_t in_all = UINT64_MAX;
+    uint32_t i;
+    for(i = 0; i < PX_CNT / 2; i++) in_all &= in_u64[i];
+    if(in_all != UINT64_MAX) return false;
+
+    chunk->xs_fract = SELECT(x_prev, (vec_u32_t)(0x7F - xs_fract), (vec_u32_t)(xs_fract - 0x80));
+    chunk->ys_fract = SELECT(y_prev, (vec_u32_t)(0x7F - ys_fract), (vec_u32_t)(ys_fract - 0x80));
+    __builtin_memcpy(chunk->xs_int, &xs_int, sizeof(xs_int));
+    __builtin_memcpy(chunk->ys_int, &ys_int, sizeof(ys_int));
+    __builtin_memcpy(chunk->x_next, &x_next, sizeof(x_next));
+    __builtin_memcpy(chunk->y_next, &y_next, sizeof(y_next));
+    return true;
+}
+
+/**
+ * Read the pixels and their neighbors from the source image.
+ * There is no portable gather instruction, so they are read one by one.
+ * @param src       the first pixel of the image, or of its alpha map
+ * @param stride    the stride of `src` in bytes
+ * @param px_size   size of a pixel in bytes: 1, 2, 3 or 4
+ * @param chunk     the position of the pixels
+ * @param px        store the pixels here in the lower bytes of the lanes
+ * @param hor       store the horizontal neighbors here
+ * @param ver       store the vertical neighbors here
+ */
+static INLINE void gather(const uint8_t * src, int32_t stride, uint32_t px_size, const chunk_t * chunk,
+                          vec_u32_t * px, vec_u32_t * hor, vec_u32_t * ver)
+{
+    uint32_t px_buf[PX_CNT];
+    uint32_t hor_buf[PX_CNT];
+    uint32_t ver_buf[PX_CNT];
+    uint32_t i;
+    for(i = 0; i < PX_CNT; i++) {
+        const uint8_t * p = src + chunk->ys_int[i] * stride + chunk->xs_int[i] * (int32_t)px_size;
+        px_buf[i] = 0;
+        hor_buf[i] = 0;
+        ver_buf[i] = 0;
+        __builtin_memcpy(&px_buf[i], p, px_size);
+        __builtin_memcpy(&hor_buf[i], p + chunk->x_next[i] * (int32_t)px_size, px_size);
+        __builtin_memcpy(&ver_buf[i], p + chunk->y_next[i] * stride, px_size);
+    }
+
+    __builtin_memcpy(px, px_buf, sizeof(*px));
+    __builtin_memcpy(hor, hor_buf, sizeof(*hor));
+    __builtin_memcpy(ver, ver_buf, sizeof(*ver));
+}
+
+static INLINE void store_u32(void * p, const vec_u32_t * v)
+{
+    __builtin_memcpy(p, v, sizeof(*v));
+}
+
+static INLINE void store_u16(void * p, const vec_u32_t * v)
+{
+    vec_u16_t v16 = __builtin_convertvector(*v, vec_u16_t);
+    __builtin_memcpy(p, &v16, sizeof(v16));
+}
+
+/**
+ * Mix the color channels of 32 bit pixels as `lv_color_mix32` does.
+ * @param fg        the neighbor pixels
+ * @param bg        the pixels to mix to. Their alpha is kept.
+ * @param mix       0x00..0x7F: the weight of `fg`
+ * @return          the mixed pixels
+ */
+static INLINE vec_u32_t mix_color32(const vec_u32_t * fg, const vec_u32_t * bg, const vec_u32_t * mix)
+{
+    vec_u32_t mix_inv = 255 - *mix;
+    vec_u32_t res = *bg & 0xFF000000;
+    uint32_t shift;
+    for(shift = 0; shift < 24; shift += 8) {
+        vec_u32_t c = ((*fg >> shift) & 0xFF) * *mix + ((*bg >> shift) & 0xFF) * mix_inv;
+        res |= ((c * 0x8081U) >> 23) << shift;   /*LV_UDIV255*/
+    }
+
+    /*`lv_color_mix32` keeps `bg` if the opacity of `fg` is <= LV_OPA_MIN*/
+    return SELECT(*mix <= LV_OPA_MIN, *bg, res);
+}
+
+/**
+ * Mix the neighbor pixels to ARGB8888 pixels as `transform_argb8888` does
+ * @param px        the pixels
+ * @param next      the neighbor pixels
+ * @param fract     0x00..0x7F: the weight of the neighbors
+ * @return          the mixed pixels
+ */
+static INLINE vec_u32_t mix_argb8888(const vec_u32_t * px, const vec_u32_t * next, const vec_u32_t * fract)
+{
+    vec_u32_t a = *px >> 24;
+    vec_u32_t next_a = *next >> 24;
+    vec_u32_t fract_inv = 0xFF - *fract;
+
+    /*Transparent neighbors make the pixels more transparent*/
+    vec_u32_t res_transp = (*px & 0x00FFFFFF) | (((a * fract_inv) >> 8) << 24);
+
+    vec_u32_t mix_a = SELECT(a != 0, (next_a * *fract + a * fract_inv) >> 8, a);
+    vec_u32_t res_mix = (*px & 0x00FFFFFF) | (mix_a << 24);
+    res_mix = mix_color32(next, &res_mix, fract);
+
+    vec_u32_t res = SELECT(*px == *next, *px, res_mix);
+    return SELECT(next_a == 0, res_transp, res);
+}
+
+/**
+ * Mix the neighbor pixels to RGB888 pixels as `transform_rgb888` does
+ * @param px        the pixels with 0xFF alpha
+ * @param next      the neighbor pixels with 0xFF alpha
+ * @param fract     0x00..0x7F: the weight of the neighbors
+ * @return          the mixed pixels
+ */
+static INLINE vec_u32_t mix_rgb888(const vec_u32_t * px, const vec_u32_t * next, const vec_u32_t * fract)
+{
+    vec_u32_t res = mix_color32(next, px, fract);
+    return SELECT(*px == *next, *px, res);
+}
+
+/**
+ * Mix RGB565 pixels as `lv_color_16_16_mix` does
+ * @param c1        the first pixels
+ * @param c2        the second pixels
+ * @param mix       0x00..0xFE: the weight of `c1`
+ * @return          the mixed pixels
+ */
+static INLINE vec_u32_t mix_rgb565(const vec_u32_t * c1, const vec_u32_t * c2, const vec_u32_t * mix)
+{
+    /*`mix` is never 255 here, and 0 and `c1 == c2` are calculated to `c2` by the formula too*/
+    vec_u32_t m = (*mix + 4) >> 3;
+    vec_u32_t bg = (*c2 | (*c2 << 16)) & 0x7E0F81F;
+    vec_u32_t fg = (*c1 | (*c1 << 16)) & 0x7E0F81F;
+    vec_u32_t res = ((((fg - bg) * m) >> 5) + bg) & 0x7E0F81F;
+    return ((res >> 16) | res) & 0xFFFF;
+}
+
+static INLINE vec_u32_t swap_16(const vec_u32_t * c)
+{
+    return ((*c >> 8) | (*c << 8)) & 0xFFFF;
+}
+
+/**
+ * Transform RGB888 or XRGB8888 pixels as `transform_rgb888` does
+ * @param row       the row to transform
+ * @param x         the index of the first pixel
+ * @param x_end     the width of the row
+ * @param dest_buf  the ARGB8888 buffer of the row
+ * @param px_size   3 for RGB888, 4 for XRGB8888
+ * @return          the first pixel which was not transformed
+ */
+static INLINE int32_t transform_rgb888_chunks(const row_t * row, int32_t x, int32_t x_end, uint8_t * dest_buf,
+                                              uint32_t px_size)
+{
+    for(; x + PX_CNT <= x_end; x += PX_CNT) {
+        chunk_t chunk;
+        if(!get_chunk(row, x, &chunk)) break;
+
+        vec_u32_t px;
+        vec_u32_t hor;
+        vec_u32_t ver;
+        gather(row->src, row->src_stride, px_size, &chunk, &px, &hor, &ver);
+        px |= 0xFF000000;
+        hor |= 0xFF000000;
+        ver |= 0xFF000000;
+        px = mix_rgb888(&px, &ver, &chunk.ys_fract);
+        px = mix_rgb888(&px, &hor, &chunk.xs_fract);
+
+        store_u32(dest_buf + x * 4, &px);
+    }
+
+    return x;
+}
+
+/**
+ * Transform RGB565 pixels as `transform_rgb565a8` does without an alpha map
+ * @param row       the row to transform
+ * @param x         the index of the first pixel
+ * @param x_end     the width of the row
+ * @param cbuf      the color buffer of the row
+ * @param abuf      the alpha buffer of the row
+ * @param swapped   true: the bytes of the source pixels are swapped
+ * @return          the first pixel which was not transformed
+ */
+static INLINE int32_t transform_rgb565_chunks(const row_t * row, int32_t x, int32_t x_end,
+                                              uint16_t * cbuf, uint8_t * abuf, bool swapped)
+{
+    for(; x + PX_CNT <= x_end; x += PX_CNT) {
+        chunk_t chunk;
+        if(!get_chunk(row, x, &chunk)) break;
+
+        vec_u32_t c;
+        vec_u32_t c_hor;
+        vec_u32_t c_ver;
+        gather(row->src, row->src_stride, 2, &chunk, &c, &c_hor, &c_ver);
+        if(swapped) {
+            c = swap_16(&c);
+            c_hor = swap_16(&c_hor);
+            c_ver = swap_16(&c_ver);
+        }
+
+        /*The weights are in 0x00..0xFE range here*/
+        vec_u32_t xs_fract = chunk.xs_fract * 2;
+        vec_u32_t ys_fract = chunk.ys_fract * 2;
+
+        vec_u32_t v = mix_rgb565(&c_ver, &c, &ys_fract);
+        vec_u32_t h = mix_rgb565(&c_hor, &c, &xs_fract);
+        vec_u32_t half = SPLAT(LV_OPA_50);
+        vec_u32_t c_mix = mix_rgb565(&h, &v, &half);
+        c = SELECT((c != c_ver) | (c != c_hor), c_mix, c);
+
+        store_u16(&cbuf[x], &c);
+        lv_memset(&abuf[x], 0xFF, PX_CNT);
+    }
+
+    return x;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888
+
+int32_t lv_draw_sw_transform_simd_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                         int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                         int32_t x, int32_t x_end, uint8_t * dest_buf, uint32_t px_size)
+{
+    row_t row;
+    row_init(&row, src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step);
+
+    /*Inline the reads with a constant size*/
+    if(px_size == 3) return transform_rgb888_chunks(&row, x, x_end, dest_buf, 3);
+    else return transform_rgb888_chunks(&row, x, x_end, dest_buf, 4);
+}
+
+#endif
+
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+
+int32_t lv_draw_sw_transform_simd_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                           int32_t x, int32_t x_end, uint8_t * dest_buf)
+{
+    row_t row;
+    row_init(&row, src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step);
+
+    for(; x + PX_CNT <= x_end; x += PX_CNT) {
+        chunk_t chunk;
+        if(!get_chunk(&row, x, &chunk)) break;
+
+        vec_u32_t px;
+        vec_u32_t hor;
+        vec_u32_t ver;
+        gather(src, src_stride, 4, &chunk, &px, &hor, &ver);
+        px = mix_argb8888(&px, &ver, &chunk.ys_fract);
+        px = mix_argb8888(&px, &hor, &chunk.xs_fract);
+
+        store_u32(dest_buf + x * 4, &px);
+    }
+
+    return x;
+}
+
+#endif
+
+#if LV_DRAW_SW_SUPPORT_RGB565A8
+
+int32_t lv_draw_sw_transform_simd_rgb565(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                         int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                         int32_t x, int32_t x_end, uint16_t * cbuf, uint8_t * abuf)
+{
+    row_t row;
+    row_init(&row, src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step);
+    return transform_rgb565_chunks(&row, x, x_end, cbuf, abuf, false);
+}
+
+#endif
+
+#if LV_DRAW_SW_SUPPORT_RGB565_SWAPPED
+
+int32_t lv_draw_sw_transform_simd_rgb565_swapped(const uint8_t * src, int32_t src_w, int32_t src_h,
+                                                 int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                                 int32_t xs_step, int32_t ys_step, int32_t x, int32_t x_end,
+                                                 uint16_t * cbuf, uint8_t * abuf)
+{
+    row_t row;
+    row_init(&row, src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step);
+    return transform_rgb565_chunks(&row, x, x_end, cbuf, abuf, true);
+}
+
+#endif
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD*/
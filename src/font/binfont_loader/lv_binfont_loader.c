@@ -47,6 +47,12 @@ typedef struct font_header_bin {
     uint16_t underline_thickness;
 } font_header_bin_t;
 
+/*The glyph bitmaps might be used in place from the mapped file*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_fs_map_t glyph_bitmap_map;
+} binfont_dsc_t;
+
 typedef struct cmap_table_bin {
     uint32_t data_offset;
     uint32_t range_start;
@@ -62,6 +68,8 @@ typedef struct cmap_table_bin {
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
 static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool map_glyph_bitmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint32_t start,
+                              const uint32_t * glyph_offset, uint32_t loca_count, uint32_t glyph_length, uint32_t header_size);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -135,6 +143,14 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+#if LV_USE_DRAW_GLYPH_ATLAS
+    lv_draw_glyph_atlas_drop(font);
+#endif
+
+#if LV_USE_FONT_FMT_TXT_CACHE
+    lv_font_fmt_txt_cache_drop(font);
+#endif
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -162,7 +178,9 @@ void lv_binfont_destroy(lv_font_t * font)
         lv_free((void *)cmaps);
     }
 
-    lv_free((void *)dsc->glyph_bitmap);
+    binfont_dsc_t * binfont_dsc = (binfont_dsc_t *)dsc;
+    if(binfont_dsc->glyph_bitmap_map.data) lv_fs_unmap(&binfont_dsc->glyph_bitmap_map);
+    else lv_free((void *)dsc->glyph_bitmap);
     lv_free((void *)dsc->glyph_dsc);
     lv_free((void *)dsc);
     lv_free(font);
@@ -404,6 +422,12 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
     }
 
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    if(nbits % 8 == 0 &&
+       map_glyph_bitmaps(fp, font_dsc, start, glyph_offset, loca_count, glyph_length, nbits / 8)) {
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *)lv_malloc(sizeof(uint8_t) * cur_bmp_size);
     LV_ASSERT_MALLOC(glyph_bmp);
 
@@ -418,8 +442,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
         bit_iterator_t bit_it = init_bit_iterator(fp);
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-
         read_bits(&bit_it, nbits, &res);
         if(res != LV_FS_RES_OK) {
             return -1;
@@ -459,6 +481,38 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     return glyph_length;
 }
 
+/**
+ * Use the glyph bitmaps in place from the mapped glyph table.
+ * It's possible only if the bitmaps start on byte boundary after the glyph headers.
+ * @param fp            the font file
+ * @param font_dsc      the font descriptor with loaded glyph descriptors
+ * @param start         start of the glyph table in the file
+ * @param glyph_offset  offset of each glyph in the glyph table
+ * @param loca_count    number of glyphs
+ * @param glyph_length  size of the glyph table
+ * @param header_size   size of the header of each glyph in bytes
+ * @return              true: the bitmaps are mapped; false: they need to be read
+ */
+static bool map_glyph_bitmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint32_t start,
+                              const uint32_t * glyph_offset, uint32_t loca_count, uint32_t glyph_length, uint32_t header_size)
+{
+#if LV_FONT_FMT_TXT_LARGE == 0
+    /*The bitmap index has only 20 bits*/
+    if(glyph_length >= (1 << 20)) return false;
+#endif
+
+    binfont_dsc_t * binfont_dsc = (binfont_dsc_t *)font_dsc;
+    if(lv_fs_map(fp, start, glyph_length, &binfont_dsc->glyph_bitmap_map) != LV_FS_RES_OK) return false;
+
+    lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)font_dsc->glyph_dsc;
+    for(uint32_t i = 1; i < loca_count; ++i) {
+        glyph_dsc[i].bitmap_index = glyph_offset[i] + header_size;
+    }
+
+    font_dsc->glyph_bitmap = binfont_dsc->glyph_bitmap_map.data;
+    return true;
+}
+
 static void release_glyph_cb(const lv_font_t * font, lv_font_glyph_dsc_t * glyph_dsc)
 {
     LV_UNUSED(font);
@@ -481,9 +535,9 @@ static void release_glyph_cb(const lv_font_t * font, lv_font_glyph_dsc_t * glyph
 static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 {
     lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_malloc(sizeof(lv_font_fmt_txt_dsc_t));
+                                       lv_malloc(sizeof(binfont_dsc_t));
 
-    lv_memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    lv_memset(font_dsc, 0, sizeof(binfont_dsc_t));
 
     font->dsc = font_dsc;
 
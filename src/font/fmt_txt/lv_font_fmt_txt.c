@@ -18,6 +18,14 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+    #define fmt_txt_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_cache
+
+    #if (LV_FONT_FMT_TXT_CACHE_SIZE & (LV_FONT_FMT_TXT_CACHE_SIZE - 1)) != 0
+        #error "LV_FONT_FMT_TXT_CACHE_SIZE must be a power of 2"
+    #endif
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,11 +38,19 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_sparse_cmap(const lv_font_fmt_txt_cmap_t * cmap, uint32_t rcp);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
-static int unicode_list_compare(const void * ref, const void * element);
+static int8_t search_kern_pair(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t gid_left, uint32_t gid_right);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+    static uint32_t cached_search_sparse_cmap(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_cmap_t * cmap,
+                                              uint32_t letter, uint32_t rcp);
+    static int8_t cached_search_kern_pair(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t gid_right);
+    static inline uint32_t get_cache_index(const void * font_dsc, uint32_t key1, uint32_t key2);
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, int32_t w);
@@ -272,6 +288,31 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+
+void lv_font_fmt_txt_cache_init(void)
+{
+    lv_font_fmt_txt_cache_t * cache = &fmt_txt_cache;
+    lv_memzero(cache->glyphs, sizeof(cache->glyphs));
+    lv_memzero(cache->kerns, sizeof(cache->kerns));
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+}
+
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font)
+{
+    lv_font_fmt_txt_cache_t * cache = &fmt_txt_cache;
+    const void * font_dsc = font ? font->dsc : NULL;
+
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_CACHE_SIZE; i++) {
+        if(font_dsc == NULL || cache->glyphs[i].font_dsc == font_dsc) cache->glyphs[i].font_dsc = NULL;
+        if(font_dsc == NULL || cache->kerns[i].font_dsc == font_dsc) cache->kerns[i].font_dsc = NULL;
+    }
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -300,26 +341,13 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             if(gid_ofs_8[rcp] == 0 && letter != fdsc->cmaps[i].range_start) continue;
             glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
         }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
-            uint16_t key = rcp;
-            uint16_t * p = lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
-                glyph_id = fdsc->cmaps[i].glyph_id_start + (uint32_t) ofs;
-            }
-        }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
-            uint16_t key = rcp;
-            uint16_t * p = lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
-                const uint16_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
-                glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_16[ofs];
-            }
+        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY ||
+                fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+#if LV_USE_FONT_FMT_TXT_CACHE
+            glyph_id = cached_search_sparse_cmap(fdsc, &fdsc->cmaps[i], letter, rcp);
+#else
+            glyph_id = search_sparse_cmap(&fdsc->cmaps[i], rcp);
+#endif
         }
 
         return glyph_id;
@@ -329,6 +357,36 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
+/**
+ * Find a relative code point in a sparse character map with binary search
+ * @param cmap      a `LV_FONT_FMT_TXT_CMAP_SPARSE_...` character map
+ * @param rcp       the code point relative to the start of `cmap`
+ * @return          the glyph ID or 0 if the code point is not in `cmap`
+ */
+static uint32_t search_sparse_cmap(const lv_font_fmt_txt_cmap_t * cmap, uint32_t rcp)
+{
+    /*The same as `lv_utils_bsearch` but without calling a compare function for each step*/
+    const uint16_t * list = cmap->unicode_list;
+    uint32_t first = 0;
+    uint32_t last = cmap->list_length;
+    while(first < last) {
+        uint32_t middle = (first + last) >> 1;
+        if(list[middle] < rcp) first = middle + 1;
+        else last = middle;
+    }
+
+    if(first == cmap->list_length || list[first] != rcp) return 0;
+
+    lv_uintptr_t ofs = first;
+    if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+        return cmap->glyph_id_start + (uint32_t) ofs;
+    }
+    else {
+        const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+        return cmap->glyph_id_start + gid_ofs_16[ofs];
+    }
+}
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
@@ -337,37 +395,11 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
-        const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
-        if(kdsc->glyph_ids_size == 0) {
-            /*Use binary search to find the kern value.
-             *The pairs are ordered left_id first, then right_id secondly.*/
-            const uint16_t * g_ids = kdsc->glyph_ids;
-            kern_pair_ref_t g_id_both = {gid_left, gid_right};
-            uint16_t * kid_p = lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
-
-            /*If the `g_id_both` were found get its index from the pointer*/
-            if(kid_p) {
-                lv_uintptr_t ofs = kid_p - g_ids;
-                value = kdsc->values[ofs];
-            }
-        }
-        else if(kdsc->glyph_ids_size == 1) {
-            /*Use binary search to find the kern value.
-             *The pairs are ordered left_id first, then right_id secondly.*/
-            const uint32_t * g_ids = kdsc->glyph_ids;
-            kern_pair_ref_t g_id_both = {gid_left, gid_right};
-            uint32_t * kid_p = lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
-
-            /*If the `g_id_both` were found get its index from the pointer*/
-            if(kid_p) {
-                lv_uintptr_t ofs = kid_p - g_ids;
-                value = kdsc->values[ofs];
-            }
-
-        }
-        else {
-            /*Invalid value*/
-        }
+#if LV_USE_FONT_FMT_TXT_CACHE
+        value = cached_search_kern_pair(fdsc, gid_left, gid_right);
+#else
+        value = search_kern_pair(fdsc->kern_dsc, gid_left, gid_right);
+#endif
     }
     else {
         /*Kern classes*/
@@ -385,6 +417,51 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     return value;
 }
 
+/**
+ * Find the kerning value of a glyph pair with binary search
+ * @param kdsc          the kerning pairs of a font
+ * @param gid_left      the glyph ID of the left glyph
+ * @param gid_right     the glyph ID of the right glyph
+ * @return              the kerning value or 0 if the pair is not found
+ */
+static int8_t search_kern_pair(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t gid_left, uint32_t gid_right)
+{
+    int8_t value = 0;
+
+    if(kdsc->glyph_ids_size == 0) {
+        /*Use binary search to find the kern value.
+         *The pairs are ordered left_id first, then right_id secondly.*/
+        const uint16_t * g_ids = kdsc->glyph_ids;
+        kern_pair_ref_t g_id_both = {gid_left, gid_right};
+        uint16_t * kid_p = lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
+
+        /*If the `g_id_both` were found get its index from the pointer*/
+        if(kid_p) {
+            lv_uintptr_t ofs = kid_p - g_ids;
+            value = kdsc->values[ofs];
+        }
+    }
+    else if(kdsc->glyph_ids_size == 1) {
+        /*Use binary search to find the kern value.
+         *The pairs are ordered left_id first, then right_id secondly.*/
+        const uint32_t * g_ids = kdsc->glyph_ids;
+        kern_pair_ref_t g_id_both = {gid_left, gid_right};
+        uint32_t * kid_p = lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
+
+        /*If the `g_id_both` were found get its index from the pointer*/
+        if(kid_p) {
+            lv_uintptr_t ofs = kid_p - g_ids;
+            value = kdsc->values[ofs];
+        }
+
+    }
+    else {
+        /*Invalid value*/
+    }
+
+    return value;
+}
+
 static int kern_pair_8_compare(const void * ref, const void * element)
 {
     const kern_pair_ref_t * ref8_p = ref;
@@ -405,6 +482,67 @@ static int kern_pair_16_compare(const void * ref, const void * element)
     else return ref16_p->gid_right - element16_p[1];
 }
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+
+/**
+ * Look up a letter of a sparse character map in the cache and search it only if it's not there.
+ * The letters missing from the map are cached too.
+ */
+static uint32_t cached_search_sparse_cmap(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_cmap_t * cmap,
+                                          uint32_t letter, uint32_t rcp)
+{
+    lv_font_fmt_txt_cache_t * cache = &fmt_txt_cache;
+    lv_font_fmt_txt_cache_glyph_t * entry = &cache->glyphs[get_cache_index(fdsc, letter, 0)];
+
+    if(entry->font_dsc == fdsc && entry->letter == letter) {
+        cache->hit_cnt++;
+    }
+    else {
+        cache->miss_cnt++;
+        entry->font_dsc = fdsc;
+        entry->letter = letter;
+        entry->gid = search_sparse_cmap(cmap, rcp);
+    }
+
+    return entry->gid;
+}
+
+/**
+ * Look up a pair of glyphs in the cache and search its kerning value only if it's not there.
+ */
+static int8_t cached_search_kern_pair(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t gid_right)
+{
+    lv_font_fmt_txt_cache_t * cache = &fmt_txt_cache;
+    lv_font_fmt_txt_cache_kern_t * entry = &cache->kerns[get_cache_index(fdsc, gid_left, gid_right)];
+
+    if(entry->font_dsc == fdsc && entry->gid_left == gid_left && entry->gid_right == gid_right) {
+        cache->hit_cnt++;
+    }
+    else {
+        cache->miss_cnt++;
+        entry->font_dsc = fdsc;
+        entry->gid_left = gid_left;
+        entry->gid_right = gid_right;
+        entry->value = search_kern_pair(fdsc->kern_dsc, gid_left, gid_right);
+    }
+
+    return entry->value;
+}
+
+/**
+ * Get the index of a cache entry. The low bits of the keys are only multiplied by odd numbers,
+ * so the consecutive letters of a font never get the same entry.
+ */
+static inline uint32_t get_cache_index(const void * font_dsc, uint32_t key1, uint32_t key2)
+{
+    uint32_t hash = (uint32_t)((lv_uintptr_t)font_dsc >> 4);
+    hash ^= key1 * 2654435761u;
+    hash ^= key2 * 2246822519u;
+    return hash & (LV_FONT_FMT_TXT_CACHE_SIZE - 1);
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
 #if LV_USE_FONT_COMPRESSED
 
 /**
@@ -603,24 +741,6 @@ static inline uint8_t rle_next(void)
 }
 #endif /*LV_USE_FONT_COMPRESSED*/
 
-/** Code Comparator.
- *
- *  Compares the value of both input arguments.
- *
- *  @param[in]  ref         Pointer to the reference.
- *  @param[in]  element     Pointer to the element to compare.
- *
- *  @return Result of comparison.
- *  @retval < 0   Reference is less than element.
- *  @retval = 0   Reference is equal to element.
- *  @retval > 0   Reference is greater than element.
- *
- */
-static int unicode_list_compare(const void * ref, const void * element)
-{
-    return (*(uint16_t *)ref) - (*(uint16_t *)element);
-}
-
 static lv_font_t * builtin_font_create_cb(const lv_font_info_t * info, const void * src)
 {
     const lv_builtin_font_src_t * font_src = src;
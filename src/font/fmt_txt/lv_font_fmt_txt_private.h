@@ -15,8 +15,9 @@ extern "C" {
  *********************/
 
 #include "../../lvgl_public.h"
-
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_FMT_TXT_CACHE
+#include "../../osal/lv_os_private.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -26,6 +27,8 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_FONT_COMPRESSED
+
 typedef enum {
     RLE_STATE_SINGLE = 0,
     RLE_STATE_REPEATED,
@@ -41,15 +44,56 @@ typedef struct {
     lv_font_fmt_rle_state_t state;
 } lv_font_fmt_rle_t;
 
+#endif /*LV_USE_FONT_COMPRESSED*/
+
+#if LV_USE_FONT_FMT_TXT_CACHE
+
+/** A glyph ID found in a sparse character map*/
+typedef struct {
+    const void * font_dsc;      /**< `dsc` of the font, NULL if the entry is unused*/
+    uint32_t letter;
+    uint32_t gid;               /**< 0 if the letter is not in the font*/
+} lv_font_fmt_txt_cache_glyph_t;
+
+/** A kerning value found in the kerning pairs*/
+typedef struct {
+    const void * font_dsc;      /**< `dsc` of the font, NULL if the entry is unused*/
+    uint32_t gid_left;
+    uint32_t gid_right;
+    int8_t value;
+} lv_font_fmt_txt_cache_kern_t;
+
+/**
+ * Direct-mapped caches of the binary searches of the `fmt_txt` fonts.
+ * As the built-in fonts are constant, they are shared by all fonts.
+ * Used only without an OS, so they are not locked.
+ */
+typedef struct {
+    lv_font_fmt_txt_cache_glyph_t glyphs[LV_FONT_FMT_TXT_CACHE_SIZE];
+    lv_font_fmt_txt_cache_kern_t kerns[LV_FONT_FMT_TXT_CACHE_SIZE];
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+} lv_font_fmt_txt_cache_t;
+
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+
+/**
+ * Initialize the glyph ID and kerning cache of the `fmt_txt` fonts
+ */
+void lv_font_fmt_txt_cache_init(void);
+
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
 /**********************
  *      MACROS
  **********************/
 
-#endif
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
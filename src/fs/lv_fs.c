@@ -445,6 +445,67 @@ fail:
     return data;
 }
 
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, uint32_t offset, uint32_t size, lv_fs_map_t * map)
+{
+    LV_ASSERT_NULL(map);
+    lv_memzero(map, sizeof(lv_fs_map_t));
+
+    if(file_p->drv == NULL) return LV_FS_RES_INV_PARAM;
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+    if(size == 0) return LV_FS_RES_INV_PARAM;
+
+    LV_PROFILER_FS_BEGIN;
+
+    const void * data = file_p->drv->map_cb(file_p->drv, file_p->file_d, offset, size);
+
+    LV_PROFILER_FS_END;
+
+    if(data == NULL) return LV_FS_RES_UNKNOWN;
+
+    map->data = data;
+    map->size = size;
+    map->drv = file_p->drv;
+    return LV_FS_RES_OK;
+}
+
+void lv_fs_unmap(lv_fs_map_t * map)
+{
+    LV_ASSERT_NULL(map);
+    if(map->data == NULL) return;
+
+    if(map->drv->unmap_cb) map->drv->unmap_cb(map->drv, map->data, map->size);
+    lv_memzero(map, sizeof(lv_fs_map_t));
+}
+
+lv_fs_res_t lv_fs_delete(const char * path)
+{
+    if(path == NULL) return LV_FS_RES_INV_PARAM;
+
+    resolved_path_t resolved_path = lv_fs_resolve_path(path);
+
+    lv_fs_drv_t * drv = lv_fs_get_drv(resolved_path.driver_letter);
+
+    if(drv == NULL) {
+        return LV_FS_RES_NOT_EX;
+    }
+
+    if(drv->ready_cb) {
+        if(drv->ready_cb(drv) == false) {
+            return LV_FS_RES_HW_ERR;
+        }
+    }
+
+    if(drv->delete_cb == NULL) {
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    LV_PROFILER_FS_BEGIN;
+    lv_fs_res_t res = drv->delete_cb(drv, resolved_path.real_path);
+    LV_PROFILER_FS_END;
+
+    return res;
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
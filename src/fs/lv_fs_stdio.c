@@ -17,6 +17,13 @@
 #else
     #include <windows.h>
 #endif
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define FS_STDIO_MAP 1
+#else
+    #define FS_STDIO_MAP 0
+#endif
 
 /*********************
  *      DEFINES
@@ -47,6 +54,11 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_delete(lv_fs_drv_t * drv, const char * path);
+#if FS_STDIO_MAP
+    static const void * fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t offset, uint32_t size);
+    static void fs_unmap(lv_fs_drv_t * drv, const void * data, uint32_t size);
+#endif
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -85,6 +97,11 @@ void lv_fs_stdio_init(void)
     fs_drv_p->write_cb = fs_write;
     fs_drv_p->seek_cb = fs_seek;
     fs_drv_p->tell_cb = fs_tell;
+    fs_drv_p->delete_cb = fs_delete;
+#if FS_STDIO_MAP
+    fs_drv_p->map_cb = fs_map;
+    fs_drv_p->unmap_cb = fs_unmap;
+#endif
 
     fs_drv_p->dir_close_cb = fs_dir_close;
     fs_drv_p->dir_open_cb = fs_dir_open;
@@ -214,6 +231,65 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return LV_FS_RES_OK;
 }
 
+/**
+ * Delete a file
+ * @param drv       pointer to a driver where this function belongs
+ * @param path      path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @return          LV_FS_RES_OK: no error or any error from @lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_delete(lv_fs_drv_t * drv, const char * path)
+{
+    LV_UNUSED(drv);
+
+    char buf[LV_FS_MAX_PATH_LEN];
+    lv_snprintf(buf, sizeof(buf), LV_FS_STDIO_PATH "%s", path);
+
+    return remove(buf) == 0 ? LV_FS_RES_OK : LV_FS_RES_UNKNOWN;
+}
+
+#if FS_STDIO_MAP
+
+/**
+ * Map a range of a file to the memory
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    pointer to a FILE variable
+ * @param offset    the first byte to map
+ * @param size      the number of bytes to map
+ * @return the address of the byte at `offset` or NULL if the range can't be mapped
+ */
+static const void * fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t offset, uint32_t size)
+{
+    LV_UNUSED(drv);
+
+    /*Pages beyond the end of the file can't be read*/
+    int fd = fileno(file_p);
+    struct stat st;
+    if(fd < 0 || fstat(fd, &st) < 0 || (uint64_t)offset + size > (uint64_t)st.st_size) return NULL;
+
+    /*The mapping has to start on a page boundary*/
+    uint32_t page_ofs = offset % (uint32_t)sysconf(_SC_PAGESIZE);
+    uint8_t * map = mmap(NULL, size + page_ofs, PROT_READ, MAP_SHARED, fd, offset - page_ofs);
+    if(map == MAP_FAILED) return NULL;
+
+    return map + page_ofs;
+}
+
+/**
+ * Unmap a range mapped by `fs_map`
+ * @param drv       pointer to a driver where this function belongs
+ * @param data      the address returned by `fs_map`
+ * @param size      the size passed to `fs_map`
+ */
+static void fs_unmap(lv_fs_drv_t * drv, const void * data, uint32_t size)
+{
+    LV_UNUSED(drv);
+
+    uint32_t page_ofs = (lv_uintptr_t)data % (uint32_t)sysconf(_SC_PAGESIZE);
+    munmap((uint8_t *)data - page_ofs, size + page_ofs);
+}
+
+#endif /*FS_STDIO_MAP*/
+
 /**
  * Initialize a 'DIR' or 'HANDLE' variable for directory reading
  * @param drv   pointer to a driver where this function belongs
@@ -44,6 +44,7 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_delete(lv_fs_drv_t * drv, const char * path);
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -83,6 +84,7 @@ void lv_fs_win32_init(void)
     fs_drv_p->write_cb = fs_write;
     fs_drv_p->seek_cb = fs_seek;
     fs_drv_p->tell_cb = fs_tell;
+    fs_drv_p->delete_cb = fs_delete;
 
     fs_drv_p->dir_close_cb = fs_dir_close;
     fs_drv_p->dir_open_cb = fs_dir_open;
@@ -355,6 +357,22 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     }
 }
 
+/**
+ * Delete a file
+ * @param drv       pointer to a driver where this function belongs
+ * @param path      path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @return          LV_FS_RES_OK: no error or any error from @lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_delete(lv_fs_drv_t * drv, const char * path)
+{
+    LV_UNUSED(drv);
+
+    char buf[MAX_PATH];
+    lv_snprintf(buf, sizeof(buf), LV_FS_WIN32_PATH "%s", path);
+
+    return DeleteFileA(buf) ? LV_FS_RES_OK : fs_error_from_win32(GetLastError());
+}
+
 /**
  * Initialize a 'DIR' or 'HANDLE' variable for directory reading
  * @param drv   pointer to a driver where this function belongs
@@ -37,12 +37,17 @@
 
 typedef struct _lv_image_compressed_t {
     uint32_t method: 4; /*Compression method, see `lv_image_compress_t`*/
-    uint32_t reserved : 28;  /*Reserved to be used later*/
-    uint32_t compressed_size;  /*Compressed data size in byte*/
+    uint32_t block_rows: 16; /*Rows compressed independently in each block. 0: the whole data is one block*/
+    uint32_t reserved : 12;  /*Reserved to be used later*/
+    uint32_t compressed_size;  /*Compressed data size in byte, including the index of the blocks*/
     uint32_t decompressed_size;  /*Decompressed data size in byte*/
     const uint8_t * data; /*Compressed data*/
 } lv_image_compressed_t;
 
+/* With `block_rows` the decompressed data is split to blocks of `block_rows * stride` bytes.
+ * The compressed data starts with `block count + 1` uint32_t offsets from the start of the
+ * compressed data: the start of each block and the end of the last one. */
+
 typedef struct {
     lv_fs_file_t * f;
     lv_color32_t * palette;
@@ -52,6 +57,8 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+    uint8_t * compressed_buf;           /*Compressed data loaded from a file*/
+    lv_fs_map_t compressed_map;         /*Compressed data mapped from a file*/
 } decoder_data_t;
 
 /**********************
@@ -63,6 +70,8 @@ static lv_result_t decode_indexed(lv_image_decoder_t * decoder, lv_image_decoder
 static lv_result_t load_indexed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 #if LV_BIN_DECODER_RAM_LOAD
     static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+    static lv_draw_buf_t * map_file(lv_fs_file_t * f, const lv_image_header_t * header, uint32_t len);
+    static void mapped_draw_buf_free(void * buf);
 #endif
 static lv_result_t decode_alpha_only(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_result_t decode_indexed_line(lv_color_format_t color_format, const lv_color32_t * palette, int32_t x,
@@ -72,11 +81,30 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
 static lv_fs_res_t fs_read_file_at(lv_fs_file_t * f, uint32_t pos, void * buff, uint32_t btr, uint32_t * br);
 
 static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+static lv_result_t decompress_area(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                   lv_area_t * decoded_area);
+static uint32_t decompress_block(const lv_image_compressed_t * compressed, lv_color_format_t cf, const uint8_t * input,
+                                 uint32_t input_len, uint8_t * output, uint32_t output_len);
+#if LV_BIN_DECODER_RAM_LOAD
+static bool check_blocks(const lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+#endif
+#if LV_BIN_DECODER_RAM_LOAD || LV_USE_LZ4 || LV_USE_RLE
+static uint32_t get_block_cnt(const lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+#endif
+static void get_block(const lv_image_compressed_t * compressed, uint32_t block, const uint8_t ** input,
+                      uint32_t * input_len);
+static void release_compressed_data(decoder_data_t * decoder_data);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+#if LV_BIN_DECODER_RAM_LOAD
+static lv_draw_buf_handlers_t mapped_draw_buf_handlers = {
+    .buf_free_cb = mapped_draw_buf_free,
+};
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -367,6 +395,8 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     lv_image_cache_data_t search_key;
     search_key.src_type = dsc->src_type;
     search_key.src = dsc->src;
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+    search_key.tile = 0;
     search_key.slot.size = dsc->decoded->data_size;
 
     lv_cache_entry_t * cache_entry = lv_image_decoder_add_to_cache(decoder, &search_key, dsc->decoded, dsc->user_data);
@@ -413,6 +443,9 @@ lv_result_t lv_bin_decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
                  full_area->y2 < (int32_t)dsc->header.h, return LV_RESULT_INVALID, "Area outside image bounds");
     LV_CHECK_ARG(dsc->user_data, return LV_RESULT_INVALID, "decoder data unavailable")
 
+    /*The compressed images are decompressed by blocks*/
+    if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) return decompress_area(dsc, full_area, decoded_area);
+
     lv_fs_res_t res = LV_FS_RES_UNKNOWN;
     decoder_data_t * decoder_data = dsc->user_data;
     lv_fs_file_t * f = decoder_data->f;
@@ -559,6 +592,7 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
 
     if(decoder_data->decoded) lv_draw_buf_destroy(decoder_data->decoded);
     if(decoder_data->decompressed) lv_draw_buf_destroy(decoder_data->decompressed);
+    release_compressed_data(decoder_data);
     lv_free(decoder_data->palette);
     lv_free(decoder_data);
     dsc->user_data = NULL;
@@ -796,8 +830,16 @@ static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc
         len += (dsc->header.stride / 2) * dsc->header.h; /*A8 mask*/
     }
 
-    lv_draw_buf_t * decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, dsc->header.h, cf,
-                                                    dsc->header.stride);
+    /*Use the data of the file in place if it can be mapped to the memory*/
+    lv_draw_buf_t * decoded = map_file(f, &dsc->header, len);
+    if(decoded) {
+        dsc->decoded = decoded;
+        decoder_data->decoded = decoded; /*Free when decoder closes*/
+        return LV_RESULT_OK;
+    }
+
+    decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, dsc->header.h, cf,
+                                    dsc->header.stride);
     if(decoded == NULL) {
         LV_LOG_ERROR("No memory for rgb file read");
         return LV_RESULT_INVALID;
@@ -817,6 +859,48 @@ static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc
     decoder_data->decoded = decoded; /*Free when decoder closes*/
     return LV_RESULT_OK;
 }
+
+/**
+ * Create a draw buffer which uses the mapped image data of the file.
+ * @param f         the opened image file
+ * @param header    the header of the image
+ * @param len       size of the image data in bytes
+ * @return          a read-only draw buffer or NULL if the file can't be mapped
+ */
+static lv_draw_buf_t * map_file(lv_fs_file_t * f, const lv_image_header_t * header, uint32_t len)
+{
+    lv_fs_map_t map;
+    if(lv_fs_map(f, sizeof(lv_image_header_t), len, &map) != LV_FS_RES_OK) return NULL;
+
+    /*The draw units might need aligned data*/
+    if(lv_draw_buf_align((void *)map.data, header->cf) != map.data) {
+        lv_fs_unmap(&map);
+        return NULL;
+    }
+
+    lv_fs_map_t * map_p = lv_malloc(sizeof(lv_fs_map_t));
+    lv_draw_buf_t * decoded = lv_malloc(sizeof(lv_draw_buf_t));
+    if(map_p == NULL || decoded == NULL) {
+        lv_free(map_p);
+        lv_free(decoded);
+        lv_fs_unmap(&map);
+        return NULL;
+    }
+
+    *map_p = map;
+    lv_draw_buf_init(decoded, header->w, header->h, header->cf, header->stride, (void *)map.data, len);
+    decoded->header.flags = LV_IMAGE_FLAGS_ALLOCATED; /*Not modifiable*/
+    decoded->unaligned_data = map_p;
+    decoded->handlers = &mapped_draw_buf_handlers;
+    return decoded;
+}
+
+static void mapped_draw_buf_free(void * buf)
+{
+    lv_fs_map_t * map = buf;
+    lv_fs_unmap(map);
+    lv_free(map);
+}
 #endif
 
 /**
@@ -952,24 +1036,30 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
             return LV_RESULT_INVALID;
         }
 
-        file_buf = lv_malloc(compressed_len);
-        if(file_buf == NULL) {
-            LV_LOG_WARN("No memory for compressed file");
-            return LV_RESULT_INVALID;
-
+        /*Read the compressed data in place if the file can be mapped*/
+        if(lv_fs_map(f, sizeof(lv_image_header_t) + len, compressed_len, &decoder_data->compressed_map) == LV_FS_RES_OK) {
+            compressed->data = decoder_data->compressed_map.data;
         }
+        else {
+            file_buf = lv_malloc(compressed_len);
+            if(file_buf == NULL) {
+                LV_LOG_WARN("No memory for compressed file");
+                return LV_RESULT_INVALID;
 
-        /*Continue to read the compressed data following compression header*/
-        fs_res = lv_fs_read(f, file_buf, compressed_len, &rn);
-        if(fs_res != LV_FS_RES_OK || rn != compressed_len) {
-            LV_LOG_WARN("Read compressed file failed: %d, with len: %" LV_PRIu32 ", expected: %" LV_PRIu32, fs_res, rn,
-                        compressed_len);
-            lv_free(file_buf);
-            return LV_RESULT_INVALID;
-        }
+            }
+
+            /*Continue to read the compressed data following compression header*/
+            fs_res = fs_read_file_at(f, sizeof(lv_image_header_t) + len, file_buf, compressed_len, &rn);
+            if(fs_res != LV_FS_RES_OK || rn != compressed_len) {
+                LV_LOG_WARN("Read compressed file failed: %d, with len: %" LV_PRIu32 ", expected: %" LV_PRIu32, fs_res, rn,
+                            compressed_len);
+                lv_free(file_buf);
+                return LV_RESULT_INVALID;
+            }
 
-        /*Decompress the image*/
-        compressed->data = file_buf;
+            decoder_data->compressed_buf = file_buf; /*Free on decoder close*/
+            compressed->data = file_buf;
+        }
     }
     else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
         lv_image_dsc_t * image = (lv_image_dsc_t *)dsc->src;
@@ -990,9 +1080,28 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
         return LV_RESULT_INVALID;
     }
 
+    if(compressed->block_rows && !check_blocks(dsc, compressed)) {
+        LV_LOG_WARN("Invalid index of the compressed blocks");
+        release_compressed_data(decoder_data);
+        return LV_RESULT_INVALID;
+    }
+
+#if LV_USE_IMAGE_DECODER_ROI
+    /*Decompress only the blocks of the drawn areas of large images in `lv_bin_decoder_get_area`.
+     *It's not kept opened: each descriptor has its own compressed data, so the draw units
+     *decompress their blocks in parallel without locking.*/
+    lv_color_format_t cf_blocks = dsc->header.cf;
+    if(compressed->block_rows && lv_image_decoder_use_roi(dsc) &&
+       (cf_blocks == LV_COLOR_FORMAT_ARGB8888 || cf_blocks == LV_COLOR_FORMAT_XRGB8888 ||
+        cf_blocks == LV_COLOR_FORMAT_RGB888 || cf_blocks == LV_COLOR_FORMAT_RGB565 ||
+        cf_blocks == LV_COLOR_FORMAT_RGB565_SWAPPED || cf_blocks == LV_COLOR_FORMAT_ARGB8565)) {
+        dsc->cache_tiles = true;
+        return LV_RESULT_OK;
+    }
+#endif
+
     res = decompress_image(dsc, compressed);
-    compressed->data = NULL; /*No need to store the data any more*/
-    lv_free(file_buf);
+    release_compressed_data(decoder_data); /*No need to store the data any more*/
     if(res != LV_RESULT_OK) {
         LV_LOG_WARN("Decompress failed");
         return LV_RESULT_INVALID;
@@ -1156,27 +1265,129 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
 
     img_data = decompressed->data;
 
+    if(compressed->block_rows == 0) {
+        len = decompress_block(compressed, dsc->header.cf, compressed->data, input_len, img_data, out_len);
+    }
+    else {
+        uint32_t block_len = compressed->block_rows * dsc->header.stride;
+        uint32_t block_cnt = get_block_cnt(dsc, compressed);
+        uint32_t i;
+        for(i = 0; i < block_cnt; i++) {
+            const uint8_t * input;
+            uint32_t block_input_len;
+            get_block(compressed, i, &input, &block_input_len);
+            uint32_t block_out_len = LV_MIN(block_len, out_len - len);
+            if(decompress_block(compressed, dsc->header.cf, input, block_input_len, img_data + len,
+                                block_out_len) != block_out_len) break;
+            len += block_out_len;
+        }
+    }
+
+    if(len != compressed->decompressed_size) {
+        LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
+        lv_draw_buf_destroy(decompressed);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->decompressed = decompressed; /*Free on decoder close*/
+    return LV_RESULT_OK;
+#else
+    LV_UNUSED(dsc);
+    LV_UNUSED(compressed);
+    LV_LOG_WARN("At least one compression method must be enabled");
+    return LV_RESULT_INVALID;
+#endif /* (LV_USE_LZ4 || LV_USE_RLE) */
+}
+
+/**
+ * Decompress the block of rows containing the first row of `full_area` which is not
+ * decompressed yet. The blocks are returned in full width.
+ * @param dsc           pointer to the decoder descriptor
+ * @param full_area     the area of the image to decompress
+ * @param decoded_area  the block returned at last, initially `LV_COORD_MIN`. Set to the next block.
+ * @return              LV_RESULT_OK: the next block is in `dsc->decoded`; LV_RESULT_INVALID: no more blocks
+ */
+static lv_result_t decompress_area(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                   lv_area_t * decoded_area)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+    if(compressed->data == NULL || compressed->block_rows == 0) return LV_RESULT_INVALID;
+
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? full_area->y1 : decoded_area->y2 + 1;
+    if(y > full_area->y2) return LV_RESULT_INVALID;
+
+    lv_color_format_t cf = dsc->header.cf;
+    uint32_t stride = dsc->header.stride;
+    uint32_t block = y / compressed->block_rows;
+    int32_t y1 = block * compressed->block_rows;
+    int32_t h = LV_MIN(compressed->block_rows, dsc->header.h - y1);
+
+    lv_draw_buf_t * decoded = lv_draw_buf_reshape(decoder_data->decoded_partial, cf, dsc->header.w, h, stride);
+    if(decoded == NULL) {
+        if(decoder_data->decoded_partial != NULL) {
+            lv_draw_buf_destroy(decoder_data->decoded_partial);
+            decoder_data->decoded_partial = NULL;
+        }
+        decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, compressed->block_rows, cf, stride);
+        if(decoded == NULL) return LV_RESULT_INVALID;
+        decoder_data->decoded_partial = decoded; /*Free on decoder close*/
+        decoded = lv_draw_buf_reshape(decoded, cf, dsc->header.w, h, stride);
+    }
+
+    const uint8_t * input;
+    uint32_t input_len;
+    get_block(compressed, block, &input, &input_len);
+    uint32_t block_len = compressed->block_rows * stride;
+    uint32_t out_len = LV_MIN(block_len, compressed->decompressed_size - block * block_len);
+    if(decompress_block(compressed, cf, input, input_len, decoded->data, out_len) != out_len) {
+        LV_LOG_WARN("Decompress block %" LV_PRIu32 " failed", block);
+        return LV_RESULT_INVALID;
+    }
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = dsc->header.w - 1;
+    decoded_area->y1 = y1;
+    decoded_area->y2 = y1 + h - 1;
+    dsc->decoded = decoded;
+    return LV_RESULT_OK;
+}
+
+/**
+ * Decompress a block of data
+ * @param compressed    the compression method
+ * @param cf            color format of the image
+ * @param input         the compressed block
+ * @param input_len     size of the compressed block
+ * @param output        buffer for the decompressed block
+ * @param output_len    size of the decompressed block
+ * @return              the number of decompressed bytes, 0 on error
+ */
+static uint32_t decompress_block(const lv_image_compressed_t * compressed, lv_color_format_t cf, const uint8_t * input,
+                                 uint32_t input_len, uint8_t * output, uint32_t output_len)
+{
+    uint32_t len = 0;
+    LV_UNUSED(cf);
+    LV_UNUSED(input);
+    LV_UNUSED(input_len);
+    LV_UNUSED(output);
+    LV_UNUSED(output_len);
+
     if(compressed->method == LV_IMAGE_COMPRESS_RLE) {
 #if LV_USE_RLE
         /*Compress always happen on byte*/
         uint32_t pixel_byte;
-        if(dsc->header.cf == LV_COLOR_FORMAT_RGB565A8)
+        if(cf == LV_COLOR_FORMAT_RGB565A8)
             pixel_byte = 2;
         else
-            pixel_byte = (lv_color_format_get_bpp(dsc->header.cf) + 7) >> 3;
+            pixel_byte = (lv_color_format_get_bpp(cf) + 7) >> 3;
 
-        const uint8_t * input = compressed->data;
-        uint8_t * output = img_data;
-
-        len = lv_rle_decompress(input, input_len, output, out_len, pixel_byte);
+        len = lv_rle_decompress(input, input_len, output, output_len, pixel_byte);
 #endif /* LV_USE_RLE */
     }
     else if(compressed->method == LV_IMAGE_COMPRESS_LZ4) {
 #if LV_USE_LZ4
-        const char * input = (const char *)compressed->data;
-        char * output = (char *)img_data;
-
-        int ret = LZ4_decompress_safe(input, output, (int)input_len, (int)out_len);
+        int ret = LZ4_decompress_safe((const char *)input, (char *)output, (int)input_len, (int)output_len);
         if(ret >= 0) {
             /* Cast is safe because of the above check */
             len = (uint32_t)ret;
@@ -1184,18 +1395,59 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
 #endif /* LV_USE_LZ4 */
     }
 
-    if(len != compressed->decompressed_size) {
-        LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
-        lv_draw_buf_destroy(decompressed);
-        return LV_RESULT_INVALID;
+    return len;
+}
+
+#if LV_BIN_DECODER_RAM_LOAD || LV_USE_LZ4 || LV_USE_RLE
+static uint32_t get_block_cnt(const lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed)
+{
+    uint32_t block_len = compressed->block_rows * dsc->header.stride;
+    return (compressed->decompressed_size + block_len - 1) / block_len;
+}
+#endif
+
+#if LV_BIN_DECODER_RAM_LOAD
+/**
+ * Check that the index of the blocks is within the compressed data
+ */
+static bool check_blocks(const lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed)
+{
+    if(dsc->header.stride == 0) return false;
+
+    uint32_t block_cnt = get_block_cnt(dsc, compressed);
+    if((uint64_t)(block_cnt + 1) * sizeof(uint32_t) > compressed->compressed_size) return false;
+
+    uint32_t prev_offset = (block_cnt + 1) * sizeof(uint32_t);
+    uint32_t i;
+    for(i = 0; i <= block_cnt; i++) {
+        uint32_t offset;
+        lv_memcpy(&offset, compressed->data + i * sizeof(uint32_t), sizeof(offset));
+        if(offset < prev_offset || offset > compressed->compressed_size) return false;
+        prev_offset = offset;
     }
 
-    decoder_data->decompressed = decompressed; /*Free on decoder close*/
-    return LV_RESULT_OK;
-#else
-    LV_UNUSED(dsc);
-    LV_UNUSED(compressed);
-    LV_LOG_WARN("At least one compression method must be enabled");
-    return LV_RESULT_INVALID;
-#endif /* (LV_USE_LZ4 || LV_USE_RLE) */
+    return true;
+}
+#endif /*LV_BIN_DECODER_RAM_LOAD*/
+
+static void get_block(const lv_image_compressed_t * compressed, uint32_t block, const uint8_t ** input,
+                      uint32_t * input_len)
+{
+    /*The index might be unaligned*/
+    uint32_t offsets[2];
+    lv_memcpy(offsets, compressed->data + block * sizeof(uint32_t), sizeof(offsets));
+    *input = compressed->data + offsets[0];
+    *input_len = offsets[1] - offsets[0];
+}
+
+static void release_compressed_data(decoder_data_t * decoder_data)
+{
+    if(decoder_data->compressed_map.data) {
+        lv_fs_unmap(&decoder_data->compressed_map);
+        lv_memzero(&decoder_data->compressed_map, sizeof(lv_fs_map_t));
+    }
+
+    lv_free(decoder_data->compressed_buf);
+    decoder_data->compressed_buf = NULL;
+    decoder_data->compressed.data = NULL;
 }
@@ -24,10 +24,8 @@
 
 #if LV_USE_OS != LV_OS_NONE
     #define img_decoder_info_lock_p &(LV_GLOBAL_DEFAULT()->img_decoder_info_lock)
-    #define img_decoder_open_lock_p &(LV_GLOBAL_DEFAULT()->img_decoder_open_lock)
 #else
     #define img_decoder_info_lock_p NULL
-    #define img_decoder_open_lock_p NULL
 #endif
 
 /**********************
@@ -74,7 +72,19 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
     lv_image_header_cache_init(image_header_count);
 
     lv_mutex_init(img_decoder_info_lock_p);
-    lv_mutex_init(img_decoder_open_lock_p);
+    lv_mutex_init(LV_IMAGE_DECODER_OPEN_LOCK_P);
+
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_image_decoder_opened_init();
+#endif
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+    lv_image_decoder_async_init();
+#endif
+
+#if LV_USE_IMAGE_DISK_CACHE
+    lv_image_decoder_disk_cache_init();
+#endif
 }
 
 /**
@@ -82,15 +92,33 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void)
 {
+#if LV_USE_IMAGE_DECODER_ASYNC
+    lv_image_decoder_async_deinit();
+#endif
+
+#if LV_USE_IMAGE_DISK_CACHE
+    lv_image_decoder_disk_cache_deinit();
+#endif
+
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_image_decoder_opened_deinit();
+#endif
+
     lv_cache_destroy(img_cache_p, NULL);
     lv_cache_destroy(img_header_cache_p, NULL);
 
     lv_mutex_delete(img_decoder_info_lock_p);
-    lv_mutex_delete(img_decoder_open_lock_p);
+    lv_mutex_delete(LV_IMAGE_DECODER_OPEN_LOCK_P);
 
     lv_ll_clear(img_decoder_ll_p);
 }
 
+void lv_image_decoder_args_init(lv_image_decoder_args_t * args)
+{
+    lv_memzero(args, sizeof(lv_image_decoder_args_t));
+    args->stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1;
+}
+
 lv_result_t lv_image_decoder_get_info(const void * src, lv_image_header_t * header)
 {
     LV_PROFILER_DECODER_BEGIN;
@@ -119,7 +147,7 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
     dsc->src = src;
     dsc->src_type = lv_image_src_get_type(src);
 
-    lv_mutex_lock(img_decoder_open_lock_p);
+    lv_mutex_lock(LV_IMAGE_DECODER_OPEN_LOCK_P);
 
     if(lv_image_cache_is_enabled()) {
         dsc->cache = img_cache_p;
@@ -129,39 +157,67 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
             * Check the cache first
             * If the image is found in the cache, just return it.*/
             if(try_cache(dsc) == LV_RESULT_OK) {
-                lv_mutex_unlock(img_decoder_open_lock_p);
+                lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
                 LV_PROFILER_DECODER_END;
                 return LV_RESULT_OK;
             }
         }
     }
 
+    /*Make a copy of args*/
+    if(args) dsc->args = *args;
+    else lv_image_decoder_args_init(&dsc->args);
+
+#if LV_USE_IMAGE_DISK_CACHE
+    /*Load the image decoded earlier, possibly before a restart*/
+    if(lv_image_decoder_disk_cache_load(dsc) == LV_RESULT_OK) {
+        if(dsc->args.flush_cache) lv_draw_buf_flush_cache(dsc->decoded, NULL);
+        lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
+        LV_PROFILER_DECODER_END;
+        return LV_RESULT_OK;
+    }
+#endif
+
+#if LV_USE_IMAGE_DECODER_ROI
+    /*Decode the missing tiles of an image kept opened*/
+    if(dsc->cache && !dsc->args.no_cache && lv_image_decoder_open_kept(dsc) == LV_RESULT_OK) {
+        lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
+        LV_PROFILER_DECODER_END;
+        return LV_RESULT_OK;
+    }
+#endif
+
     /*Find the decoder that can open the image source, and get the header info in the same time.*/
     dsc->decoder = image_decoder_get_info(dsc, &dsc->header);
     if(dsc->decoder == NULL) {
-        lv_mutex_unlock(img_decoder_open_lock_p);
+        lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
         LV_PROFILER_DECODER_END;
         return LV_RESULT_INVALID;
     }
 
-    /*Make a copy of args*/
-    dsc->args = args ? *args : (lv_image_decoder_args_t) {
-        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
-        .premultiply = false,
-        .no_cache = false,
-        .use_indexed = false,
-        .flush_cache = false,
-    };
-
     /*
      * We assume that if a decoder can get the info, it can open the image.
      * If decoder open failed, free the source and return error.
      * If decoder open succeed, add the image to cache if enabled.
      * */
     LV_PROFILER_DECODER_BEGIN_TAG(dsc->decoder->name);
+    uint32_t t_start = lv_tick_get();
     lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
     LV_PROFILER_DECODER_END_TAG(dsc->decoder->name);
 
+    if(dsc->time_to_open == 0) dsc->time_to_open = lv_tick_elaps(t_start);
+
+    /*Let the cost aware caches keep the images which are slow to decode*/
+    if(res == LV_RESULT_OK && dsc->cache_entry) {
+        lv_cache_entry_set_cost(dsc->cache_entry, dsc->time_to_open);
+    }
+
+#if LV_USE_IMAGE_DECODER_ROI
+    if(res == LV_RESULT_OK && dsc->keep_opened && dsc->cache_tiles && dsc->cache && !dsc->args.no_cache) {
+        lv_image_decoder_keep_opened(dsc);
+    }
+#endif
+
     if(res == LV_RESULT_OK && dsc->decoded != NULL) {
         LV_ASSERT_MSG(dsc->decoded->unaligned_data && dsc->decoded->handlers, "Invalid draw buffer");
 
@@ -178,7 +234,13 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
         }
     }
 
-    lv_mutex_unlock(img_decoder_open_lock_p);
+    lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
+
+#if LV_USE_IMAGE_DISK_CACHE
+    /*Write the image without blocking the other threads opening images*/
+    if(res == LV_RESULT_OK) lv_image_decoder_disk_cache_store(dsc);
+#endif
+
     LV_PROFILER_DECODER_END;
     return res;
 }
@@ -190,7 +252,17 @@ lv_result_t lv_image_decoder_get_area(lv_image_decoder_dsc_t * dsc, const lv_are
     lv_result_t res = LV_RESULT_INVALID;
     if(dsc->decoder->get_area_cb) {
         LV_PROFILER_DECODER_BEGIN_TAG(dsc->decoder->name);
+#if LV_USE_IMAGE_DECODER_ROI
+        /*Store the decoded areas in tiles in the image cache*/
+        if(dsc->cache_tiles && dsc->cache && !dsc->args.no_cache) {
+            res = lv_image_decoder_get_tile_area(dsc, full_area, decoded_area);
+        }
+        else {
+            res = dsc->decoder->get_area_cb(dsc->decoder, dsc, full_area, decoded_area);
+        }
+#else
         res = dsc->decoder->get_area_cb(dsc->decoder, dsc, full_area, decoded_area);
+#endif
         LV_PROFILER_DECODER_END_TAG(dsc->decoder->name);
     }
 
@@ -206,7 +278,12 @@ void lv_image_decoder_close(lv_image_decoder_dsc_t * dsc)
         return;
     }
 
-    lv_mutex_lock(img_decoder_open_lock_p);
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_image_decoder_release_tile(dsc);
+    lv_image_decoder_release_opened(dsc);
+#endif
+
+    lv_mutex_lock(LV_IMAGE_DECODER_OPEN_LOCK_P);
 
     if(dsc->decoder->close_cb) {
         LV_PROFILER_DECODER_BEGIN_TAG(dsc->decoder->name);
@@ -219,7 +296,7 @@ void lv_image_decoder_close(lv_image_decoder_dsc_t * dsc)
         lv_cache_release(dsc->cache, dsc->cache_entry, NULL);
     }
 
-    lv_mutex_unlock(img_decoder_open_lock_p);
+    lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
     LV_PROFILER_DECODER_END;
 }
 
@@ -241,6 +318,11 @@ lv_image_decoder_t * lv_image_decoder_create(void)
 
 void lv_image_decoder_delete(lv_image_decoder_t * decoder)
 {
+#if LV_USE_IMAGE_DECODER_ROI
+    /*The images kept opened might use this decoder*/
+    lv_image_decoder_drop_opened(NULL);
+#endif
+
     lv_ll_remove(img_decoder_ll_p, decoder);
     lv_free(decoder);
 }
@@ -479,6 +561,8 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
     lv_image_cache_data_t search_key;
     search_key.src_type = dsc->src_type;
     search_key.src = dsc->src;
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+    search_key.tile = 0;
 
     lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
 
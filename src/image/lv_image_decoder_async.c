@@ -0,0 +1,433 @@
+/**
+ * @file lv_image_decoder_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_image_decoder_private.h"
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+#include "../core/lv_global.h"
+#include "../core/lv_refr_private.h"
+#include "../display/lv_display_private.h"
+#include "../misc/cache/instance/lv_image_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define async_p (&(LV_GLOBAL_DEFAULT()->img_decoder_async))
+#define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+
+/*The sources which couldn't be cached are remembered to draw them synchronously.
+ *Only the last few are kept, the older ones are deferred again when they are drawn.*/
+#define UNCACHED_REQ_MAX    8
+
+#if LV_USE_OS
+    #define async_lock()    lv_mutex_lock(&async_p->lock)
+    #define async_unlock()  lv_mutex_unlock(&async_p->lock)
+#else
+    #define async_lock()
+    #define async_unlock()
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void timer_cb(lv_timer_t * timer);
+#if LV_USE_OS
+    static void worker_thread_cb(void * user_data);
+#endif
+static lv_image_decoder_async_state_t decode(const void * src);
+static bool needs_decoding(const void * src, const lv_image_header_t * header);
+static bool is_cached(const void * src);
+static lv_image_decoder_async_req_t * find_req(const void * src);
+static lv_image_decoder_async_req_t * add_req(const void * src);
+static void delete_req(lv_image_decoder_async_req_t * req);
+static void invalidate_objs(lv_image_decoder_async_req_t * req);
+static void obj_delete_event_cb(lv_event_t * e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_image_decoder_async_init(void)
+{
+    lv_image_decoder_async_t * async = async_p;
+    lv_ll_init(&async->req_ll, sizeof(lv_image_decoder_async_req_t));
+    async->enabled = false;
+    async->placeholder_color = lv_color_hex(0xC0C0C0);
+    async->placeholder_opa = LV_OPA_30;
+
+    async->timer = lv_timer_create(timer_cb, LV_DEF_REFR_PERIOD, NULL);
+    lv_timer_pause(async->timer);
+
+#if LV_USE_OS
+    async->exit = false;
+    lv_mutex_init(&async->lock);
+    lv_thread_sync_init(&async->sync);
+    lv_thread_init(&async->thread, "imgdec", LV_THREAD_PRIO_LOW, worker_thread_cb, LV_DRAW_THREAD_STACK_SIZE, async);
+#endif
+}
+
+void lv_image_decoder_async_deinit(void)
+{
+    lv_image_decoder_async_t * async = async_p;
+
+#if LV_USE_OS
+    async_lock();
+    async->exit = true;
+    async_unlock();
+    lv_thread_sync_signal(&async->sync);
+    lv_thread_delete(&async->thread);
+    lv_thread_sync_delete(&async->sync);
+    lv_mutex_delete(&async->lock);
+#endif
+
+    lv_timer_delete(async->timer);
+    async->timer = NULL;
+
+    lv_image_decoder_async_req_t * req = lv_ll_get_head(&async->req_ll);
+    while(req) {
+        lv_image_decoder_async_req_t * req_next = lv_ll_get_next(&async->req_ll, req);
+        delete_req(req);
+        req = req_next;
+    }
+}
+
+bool lv_image_decoder_async_defer(const void * src, const lv_image_header_t * header, lv_obj_t * obj)
+{
+    if(!async_p->enabled || obj == NULL) return false;
+
+    /*Snapshots and canvases need the image right now*/
+    lv_display_t * disp = lv_refr_get_disp_refreshing();
+    if(disp == NULL || !disp->rendering_in_progress) return false;
+
+    if(!needs_decoding(src, header)) return false;
+    if(is_cached(src)) return false;
+
+    async_lock();
+    lv_image_decoder_async_req_t * req = find_req(src);
+    if(req == NULL) req = add_req(src);
+
+    if(req == NULL || req->state == LV_IMAGE_DECODER_ASYNC_STATE_UNCACHED) {
+        async_unlock();
+        return false;
+    }
+
+    uint32_t i;
+    uint32_t obj_cnt = lv_array_size(&req->objs);
+    for(i = 0; i < obj_cnt; i++) {
+        if(*(lv_obj_t **)lv_array_at(&req->objs, i) == obj) break;
+    }
+    if(i == obj_cnt && lv_array_push_back(&req->objs, &obj) == LV_RESULT_OK) {
+        lv_obj_add_event_cb(obj, obj_delete_event_cb, LV_EVENT_DELETE, req);
+    }
+    async_unlock();
+
+    return true;
+}
+
+void lv_image_decoder_set_async(bool en)
+{
+    async_p->enabled = en;
+}
+
+bool lv_image_decoder_get_async(void)
+{
+    return async_p->enabled;
+}
+
+void lv_image_decoder_set_async_placeholder(lv_color_t color, lv_opa_t opa)
+{
+    async_p->placeholder_color = color;
+    async_p->placeholder_opa = opa;
+}
+
+lv_result_t lv_image_prefetch(const void * src)
+{
+    LV_ASSERT_NULL(src);
+
+    if(!lv_image_cache_is_enabled()) return LV_RESULT_INVALID;
+
+    lv_image_header_t header;
+    if(lv_image_decoder_get_info(src, &header) != LV_RESULT_OK) return LV_RESULT_INVALID;
+    if(is_cached(src)) return LV_RESULT_OK;
+
+    async_lock();
+    lv_image_decoder_async_req_t * req = find_req(src);
+    if(req == NULL) req = add_req(src);
+    async_unlock();
+
+    return req ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+bool lv_image_prefetch_is_pending(const void * src)
+{
+    LV_ASSERT_NULL(src);
+
+    async_lock();
+    lv_image_decoder_async_req_t * req = find_req(src);
+    bool pending = req && (req->state == LV_IMAGE_DECODER_ASYNC_STATE_PENDING ||
+                           req->state == LV_IMAGE_DECODER_ASYNC_STATE_DECODING);
+    async_unlock();
+
+    return pending;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Invalidate the widgets of the decoded images. Without an OS the images are decoded here too,
+ * one in each call, so the rendering is still not blocked by decoding all the images at once.
+ */
+static void timer_cb(lv_timer_t * timer)
+{
+    lv_image_decoder_async_t * async = async_p;
+
+#if LV_USE_OS == LV_OS_NONE
+    lv_image_decoder_async_req_t * req_pending;
+    LV_LL_READ(&async->req_ll, req_pending) {
+        if(req_pending->state == LV_IMAGE_DECODER_ASYNC_STATE_PENDING) {
+            req_pending->state = LV_IMAGE_DECODER_ASYNC_STATE_DECODING;
+            req_pending->state = decode(req_pending->src);
+            break;
+        }
+    }
+#endif
+
+    bool busy = false;
+    uint32_t uncached_cnt = 0;
+    async_lock();
+    lv_image_decoder_async_req_t * req = lv_ll_get_head(&async->req_ll);
+    while(req) {
+        lv_image_decoder_async_req_t * req_next = lv_ll_get_next(&async->req_ll, req);
+        switch(req->state) {
+            case LV_IMAGE_DECODER_ASYNC_STATE_READY:
+                invalidate_objs(req);
+                delete_req(req);
+                break;
+            case LV_IMAGE_DECODER_ASYNC_STATE_UNCACHED:
+                /*Keep it to not defer the image again*/
+                invalidate_objs(req);
+                uncached_cnt++;
+                break;
+            default:
+                busy = true;
+                break;
+        }
+        req = req_next;
+    }
+
+    /*Forget the oldest ones, they are at the head*/
+    req = lv_ll_get_head(&async->req_ll);
+    while(req && uncached_cnt > UNCACHED_REQ_MAX) {
+        lv_image_decoder_async_req_t * req_next = lv_ll_get_next(&async->req_ll, req);
+        if(req->state == LV_IMAGE_DECODER_ASYNC_STATE_UNCACHED) {
+            delete_req(req);
+            uncached_cnt--;
+        }
+        req = req_next;
+    }
+    async_unlock();
+
+    if(!busy) lv_timer_pause(timer);
+}
+
+#if LV_USE_OS
+static void worker_thread_cb(void * user_data)
+{
+    lv_image_decoder_async_t * async = user_data;
+
+    while(1) {
+        lv_image_decoder_async_req_t * req = NULL;
+
+        async_lock();
+        while(!async->exit) {
+            LV_LL_READ(&async->req_ll, req) {
+                if(req->state == LV_IMAGE_DECODER_ASYNC_STATE_PENDING) break;
+            }
+            if(req) break;
+
+            async_unlock();
+            lv_thread_sync_wait(&async->sync);
+            async_lock();
+        }
+
+        if(async->exit) {
+            async_unlock();
+            break;
+        }
+
+        /*The request is not deleted while it's decoding, and the source is constant*/
+        req->state = LV_IMAGE_DECODER_ASYNC_STATE_DECODING;
+        const void * src = req->src;
+        async_unlock();
+
+        lv_image_decoder_async_state_t state = decode(src);
+
+        async_lock();
+        req->state = state;
+        async_unlock();
+    }
+
+    LV_LOG_INFO("ready to exit image decoder thread");
+}
+#endif
+
+static lv_image_decoder_async_state_t decode(const void * src)
+{
+    LV_PROFILER_DECODER_BEGIN;
+
+    lv_image_decoder_dsc_t decoder_dsc;
+    lv_result_t res = lv_image_decoder_open(&decoder_dsc, src, NULL);
+    if(res != LV_RESULT_OK) {
+        LV_LOG_WARN("Failed to decode the image in the background");
+        LV_PROFILER_DECODER_END;
+        return LV_IMAGE_DECODER_ASYNC_STATE_UNCACHED;
+    }
+
+    bool cached = decoder_dsc.cache_entry != NULL;
+    lv_image_decoder_close(&decoder_dsc);
+
+    LV_PROFILER_DECODER_END;
+    return cached ? LV_IMAGE_DECODER_ASYNC_STATE_READY : LV_IMAGE_DECODER_ASYNC_STATE_UNCACHED;
+}
+
+static bool needs_decoding(const void * src, const lv_image_header_t * header)
+{
+    if(!lv_image_cache_is_enabled()) return false;
+
+    switch(lv_image_src_get_type(src)) {
+        case LV_IMAGE_SRC_FILE:
+            return true;
+        case LV_IMAGE_SRC_VARIABLE:
+            /*Plain images are used directly without decoding*/
+            return (header->flags & LV_IMAGE_FLAGS_COMPRESSED) ||
+                   header->cf == LV_COLOR_FORMAT_RAW || header->cf == LV_COLOR_FORMAT_RAW_ALPHA;
+        default:
+            return false;
+    }
+}
+
+static bool is_cached(const void * src)
+{
+    lv_image_cache_data_t search_key;
+    search_key.src_type = lv_image_src_get_type(src);
+    search_key.src = src;
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+    search_key.tile = 0;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    lv_cache_release(img_cache_p, entry, NULL);
+    return true;
+}
+
+static lv_image_decoder_async_req_t * find_req(const void * src)
+{
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    lv_image_decoder_async_req_t * req;
+    LV_LL_READ(&async_p->req_ll, req) {
+        if(req->src_type != src_type) continue;
+        if(src_type == LV_IMAGE_SRC_FILE ? lv_strcmp(req->src, src) == 0 : req->src == src) return req;
+    }
+
+    return NULL;
+}
+
+static lv_image_decoder_async_req_t * add_req(const void * src)
+{
+    lv_image_decoder_async_t * async = async_p;
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+
+    const void * src_copy = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+    if(src_copy == NULL) return NULL;
+
+    lv_image_decoder_async_req_t * req = lv_ll_ins_tail(&async->req_ll);
+    if(req == NULL) {
+        if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)src_copy);
+        return NULL;
+    }
+
+    req->src = src_copy;
+    req->src_type = src_type;
+    req->state = LV_IMAGE_DECODER_ASYNC_STATE_PENDING;
+    lv_array_init(&req->objs, 1, sizeof(lv_obj_t *));
+
+    lv_timer_resume(async->timer);
+#if LV_USE_OS
+    lv_thread_sync_signal(&async->sync);
+#endif
+
+    return req;
+}
+
+static void delete_req(lv_image_decoder_async_req_t * req)
+{
+    uint32_t i;
+    uint32_t obj_cnt = lv_array_size(&req->objs);
+    for(i = 0; i < obj_cnt; i++) {
+        lv_obj_t * obj = *(lv_obj_t **)lv_array_at(&req->objs, i);
+        lv_obj_remove_event_cb_with_user_data(obj, obj_delete_event_cb, req);
+    }
+
+    if(req->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)req->src);
+    lv_array_deinit(&req->objs);
+    lv_ll_remove(&async_p->req_ll, req);
+    lv_free(req);
+}
+
+static void invalidate_objs(lv_image_decoder_async_req_t * req)
+{
+    uint32_t i;
+    uint32_t obj_cnt = lv_array_size(&req->objs);
+    for(i = 0; i < obj_cnt; i++) {
+        lv_obj_t * obj = *(lv_obj_t **)lv_array_at(&req->objs, i);
+        lv_obj_remove_event_cb_with_user_data(obj, obj_delete_event_cb, req);
+        lv_obj_invalidate(obj);
+    }
+
+    lv_array_clear(&req->objs);
+}
+
+/**
+ * Forget a deleted widget waiting for an image
+ */
+static void obj_delete_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_current_target(e);
+    lv_image_decoder_async_req_t * req = lv_event_get_user_data(e);
+
+    async_lock();
+    uint32_t i;
+    uint32_t obj_cnt = lv_array_size(&req->objs);
+    for(i = 0; i < obj_cnt; i++) {
+        if(*(lv_obj_t **)lv_array_at(&req->objs, i) == obj) {
+            lv_array_remove(&req->objs, i);
+            break;
+        }
+    }
+    async_unlock();
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
@@ -0,0 +1,211 @@
+/**
+ * @file lv_image_decoder_convert.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_image_decoder_private.h"
+
+#if LV_USE_IMAGE_CACHE_CONVERT
+
+#include "../core/lv_global.h"
+#include "../misc/cache/instance/lv_image_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+#define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool can_convert(const lv_draw_buf_t * decoded, lv_color_format_t cf);
+static bool is_opaque(const lv_draw_buf_t * decoded);
+static lv_draw_buf_t * convert(const lv_draw_buf_t * decoded, lv_color_format_t cf);
+static void convert_to_rgb565(const lv_draw_buf_t * decoded, lv_draw_buf_t * converted);
+static void convert_to_rgb888(const lv_draw_buf_t * decoded, lv_draw_buf_t * converted);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+#if LV_IMAGE_CACHE_CONVERT_DITHER
+/*4x4 Bayer matrix*/
+static const uint8_t dither_matrix[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_cache_entry_t * lv_image_decoder_acquire_converted(const lv_image_decoder_dsc_t * dsc, lv_color_format_t cf)
+{
+    LV_ASSERT_NULL(dsc);
+
+    /*The images not in the cache (e.g. canvases, layers) might change any time*/
+    if(dsc->cache_entry == NULL || dsc->decoded == NULL) return NULL;
+    if(!can_convert(dsc->decoded, cf)) return NULL;
+
+    /*Not the whole image is decoded*/
+    const lv_draw_buf_t * decoded = dsc->decoded;
+    if(decoded->header.w != dsc->header.w || decoded->header.h != dsc->header.h) return NULL;
+
+    LV_PROFILER_DECODER_BEGIN;
+
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.target_cf = cf;
+    search_key.tile = 0;
+
+    /*Don't let two draw units convert and add the same image*/
+    lv_mutex_lock(LV_IMAGE_DECODER_OPEN_LOCK_P);
+
+    lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        lv_draw_buf_t * converted = convert(decoded, cf);
+        if(converted) {
+            search_key.slot.size = converted->data_size;
+            entry = lv_image_decoder_add_to_cache(dsc->decoder, &search_key, converted, NULL);
+            if(entry == NULL) lv_draw_buf_destroy(converted);
+        }
+    }
+
+    lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
+
+    LV_PROFILER_DECODER_END;
+    return entry;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool can_convert(const lv_draw_buf_t * decoded, lv_color_format_t cf)
+{
+    lv_color_format_t src_cf = decoded->header.cf;
+    if(lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_PREMULTIPLIED)) return false;
+
+    switch(cf) {
+        case LV_COLOR_FORMAT_RGB565:
+            return src_cf == LV_COLOR_FORMAT_ARGB8888 || src_cf == LV_COLOR_FORMAT_XRGB8888 ||
+                   src_cf == LV_COLOR_FORMAT_RGB888;
+        case LV_COLOR_FORMAT_RGB888:
+            return src_cf == LV_COLOR_FORMAT_XRGB8888;
+        case LV_COLOR_FORMAT_XRGB8888:
+            return src_cf == LV_COLOR_FORMAT_RGB888;
+        default:
+            return false;
+    }
+}
+
+static bool is_opaque(const lv_draw_buf_t * decoded)
+{
+    uint32_t y;
+    for(y = 0; y < decoded->header.h; y++) {
+        const lv_color32_t * row = (const lv_color32_t *)(decoded->data + y * decoded->header.stride);
+        uint32_t x;
+        for(x = 0; x < decoded->header.w; x++) {
+            if(row[x].alpha != LV_OPA_COVER) return false;
+        }
+    }
+
+    return true;
+}
+
+static lv_draw_buf_t * convert(const lv_draw_buf_t * decoded, lv_color_format_t cf)
+{
+    /*Keep the alpha channel in a separate plane*/
+    if(cf == LV_COLOR_FORMAT_RGB565 && decoded->header.cf == LV_COLOR_FORMAT_ARGB8888 && !is_opaque(decoded)) {
+        cf = LV_COLOR_FORMAT_RGB565A8;
+    }
+
+    lv_draw_buf_t * converted = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, decoded->header.w,
+                                                      decoded->header.h, cf, LV_STRIDE_AUTO);
+    if(converted == NULL) {
+        LV_LOG_WARN("No memory to convert the image");
+        return NULL;
+    }
+
+    if(cf == LV_COLOR_FORMAT_RGB565 || cf == LV_COLOR_FORMAT_RGB565A8) convert_to_rgb565(decoded, converted);
+    else convert_to_rgb888(decoded, converted);
+
+    return converted;
+}
+
+/**
+ * Convert to RGB565 the same way as blending does, so the result is the same unless dithering
+ * is enabled. For RGB565A8 the alpha channel is copied after the RGB565 plane with half stride.
+ */
+static void convert_to_rgb565(const lv_draw_buf_t * decoded, lv_draw_buf_t * converted)
+{
+    uint32_t w = decoded->header.w;
+    uint32_t h = decoded->header.h;
+    uint32_t src_px_size = lv_color_format_get_size(decoded->header.cf);
+    uint32_t dest_stride = converted->header.stride;
+    bool has_alpha = converted->header.cf == LV_COLOR_FORMAT_RGB565A8;
+    uint8_t * alpha_plane = converted->data + dest_stride * h;
+
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        const uint8_t * src = decoded->data + y * decoded->header.stride;
+        uint16_t * dest = (uint16_t *)(converted->data + y * dest_stride);
+        uint8_t * dest_alpha = alpha_plane + y * (dest_stride / 2);
+
+        uint32_t x;
+        for(x = 0; x < w; x++, src += src_px_size) {
+            uint32_t blue = src[0];
+            uint32_t green = src[1];
+            uint32_t red = src[2];
+#if LV_IMAGE_CACHE_CONVERT_DITHER
+            /*Add a threshold below the step of the 5 and 6 bit channels*/
+            uint32_t threshold = dither_matrix[y & 0x3][x & 0x3];
+            red = LV_MIN(red + (threshold >> 1), 255);
+            green = LV_MIN(green + (threshold >> 2), 255);
+            blue = LV_MIN(blue + (threshold >> 1), 255);
+#endif
+            dest[x] = (uint16_t)(((red & 0xF8) << 8) + ((green & 0xFC) << 3) + ((blue & 0xF8) >> 3));
+            if(has_alpha) dest_alpha[x] = src[3];
+        }
+    }
+}
+
+static void convert_to_rgb888(const lv_draw_buf_t * decoded, lv_draw_buf_t * converted)
+{
+    uint32_t src_px_size = lv_color_format_get_size(decoded->header.cf);
+    uint32_t dest_px_size = lv_color_format_get_size(converted->header.cf);
+
+    uint32_t y;
+    for(y = 0; y < decoded->header.h; y++) {
+        const uint8_t * src = decoded->data + y * decoded->header.stride;
+        uint8_t * dest = converted->data + y * converted->header.stride;
+
+        uint32_t x;
+        for(x = 0; x < decoded->header.w; x++, src += src_px_size, dest += dest_px_size) {
+            dest[0] = src[0];
+            dest[1] = src[1];
+            dest[2] = src[2];
+            if(dest_px_size == 4) dest[3] = 0xff;
+        }
+    }
+}
+
+#endif /*LV_USE_IMAGE_CACHE_CONVERT*/
@@ -0,0 +1,709 @@
+/**
+ * @file lv_image_decoder_disk_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_image_decoder_private.h"
+
+#if LV_USE_IMAGE_DISK_CACHE
+
+#include "../core/lv_global.h"
+#include "../draw/lv_draw_buf_private.h"
+#include "../misc/cache/instance/lv_image_cache.h"
+#include "../misc/cache/lv_cache_entry.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define disk_cache_p (&(LV_GLOBAL_DEFAULT()->img_disk_cache))
+#define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+
+#define DECODER_NAME        "DISK_CACHE"
+#define IMAGE_MAGIC         0x4344564CU     /*"LVDC"*/
+#define INDEX_MAGIC         0x4944564CU     /*"LVDI"*/
+#define INDEX_NAME          "index"
+
+/*Period of saving the index if it changed [ms]*/
+#define INDEX_SAVE_PERIOD   10000
+
+/*Images stored by other LVGL versions or color depths are not used*/
+#define FORMAT_VERSION      ((1U << 24) | (LVGL_VERSION_MAJOR << 16) | (LVGL_VERSION_MINOR << 8) | LV_COLOR_DEPTH)
+
+/*The source files are identified by their size and the hash of their first and last bytes*/
+#define FINGERPRINT_LEN     256
+
+/*Offset of the image data in the files, so the mapped data is aligned*/
+#define DATA_ALIGN          64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Header of the stored images, followed by the source path and the image data*/
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t src_size;                  /*Size of the source file*/
+    uint32_t src_hash;                  /*Hash of the first and last bytes of the source file*/
+    uint32_t time_to_open;              /*Time of decoding the source [ms]*/
+    uint32_t path_len;                  /*Length of the source path without the terminating 0*/
+    uint32_t data_offset;               /*Start of the image data in the file*/
+    uint32_t data_size;                 /*Size of the image data*/
+    lv_image_header_t header;           /*Header of the source image*/
+    lv_image_header_t decoded_header;   /*Header of the decoded draw buffer*/
+} image_file_header_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_cnt;
+} index_file_header_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_result_t load_image_locked(lv_image_decoder_dsc_t * dsc);
+static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lv_draw_buf_t * load_image(lv_fs_file_t * f, const image_file_header_t * file_header);
+static void mapped_draw_buf_free(void * buf);
+static bool write_image(const char * path, const image_file_header_t * file_header, const char * src,
+                        const lv_draw_buf_t * decoded);
+static lv_result_t get_fingerprint(const char * src, uint32_t * size, uint32_t * hash);
+static bool is_in_cache_dir(const char * src);
+static void get_image_path(uint32_t key, char * buf, uint32_t buf_size);
+static lv_image_disk_cache_entry_t * find_entry(uint32_t key, uint32_t * index);
+static void delete_entry(uint32_t index);
+static void delete_image_file(uint32_t key);
+static void load_index(void);
+static void save_index(void);
+static void save_timer_cb(lv_timer_t * timer);
+static uint32_t fnv_1a_hash(uint32_t hash, const void * data, uint32_t len);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const lv_draw_buf_handlers_t mapped_draw_buf_handlers = {
+    .buf_free_cb = mapped_draw_buf_free,
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_image_decoder_disk_cache_init(void)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+    lv_memzero(disk_cache, sizeof(lv_image_disk_cache_t));
+    lv_array_init(&disk_cache->entries, 0, sizeof(lv_image_disk_cache_entry_t));
+    lv_mutex_init(&disk_cache->lock);
+
+    /*Only closes the loaded images. Without `info_cb` and `open_cb` it's not used to open the images.*/
+    disk_cache->decoder = lv_image_decoder_create();
+    lv_image_decoder_set_close_cb(disk_cache->decoder, decoder_close);
+    disk_cache->decoder->name = DECODER_NAME;
+}
+
+void lv_image_decoder_disk_cache_deinit(void)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+    if(disk_cache->path && disk_cache->index_changed) save_index();
+
+    if(disk_cache->save_timer) lv_timer_delete(disk_cache->save_timer);
+    disk_cache->save_timer = NULL;
+    lv_free(disk_cache->path);
+    disk_cache->path = NULL;
+    lv_array_deinit(&disk_cache->entries);
+    lv_mutex_delete(&disk_cache->lock);
+}
+
+lv_result_t lv_image_decoder_set_disk_cache_path(const char * path)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+    lv_result_t res = LV_RESULT_OK;
+
+    lv_mutex_lock(&disk_cache->lock);
+
+    if(disk_cache->path && disk_cache->index_changed) save_index();
+    lv_free(disk_cache->path);
+    disk_cache->path = NULL;
+    disk_cache->path_cnt++;
+    lv_array_clear(&disk_cache->entries);
+    disk_cache->total_size = 0;
+    disk_cache->clock = 0;
+    disk_cache->index_changed = false;
+
+    if(path) {
+        disk_cache->path = lv_strdup(path);
+        if(disk_cache->path) load_index();
+        else res = LV_RESULT_INVALID;
+    }
+
+    if(disk_cache->path && disk_cache->save_timer == NULL) {
+        disk_cache->save_timer = lv_timer_create(save_timer_cb, INDEX_SAVE_PERIOD, NULL);
+    }
+    else if(disk_cache->path == NULL && disk_cache->save_timer) {
+        lv_timer_delete(disk_cache->save_timer);
+        disk_cache->save_timer = NULL;
+    }
+
+    lv_mutex_unlock(&disk_cache->lock);
+    return res;
+}
+
+void lv_image_decoder_disk_cache_drop(const char * src)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+
+    lv_mutex_lock(&disk_cache->lock);
+
+    if(disk_cache->path) {
+        if(src == NULL) {
+            while(!lv_array_is_empty(&disk_cache->entries)) delete_entry(lv_array_size(&disk_cache->entries) - 1);
+        }
+        else {
+            uint32_t index;
+            if(find_entry(fnv_1a_hash(0, src, lv_strlen(src)), &index)) delete_entry(index);
+        }
+
+        if(disk_cache->index_changed) save_index();
+    }
+
+    lv_mutex_unlock(&disk_cache->lock);
+}
+
+lv_result_t lv_image_decoder_disk_cache_load(lv_image_decoder_dsc_t * dsc)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+    if(dsc->src_type != LV_IMAGE_SRC_FILE) return LV_RESULT_INVALID;
+
+    lv_mutex_lock(&disk_cache->lock);
+    lv_result_t res = load_image_locked(dsc);
+    lv_mutex_unlock(&disk_cache->lock);
+
+    return res;
+}
+
+void lv_image_decoder_disk_cache_store(const lv_image_decoder_dsc_t * dsc)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+    if(dsc->src_type != LV_IMAGE_SRC_FILE) return;
+
+    /*Don't store the images loaded from the disk cache, the fast and the not decoded ones*/
+    const lv_draw_buf_t * decoded = dsc->decoded;
+    if(decoded == NULL || dsc->decoder == disk_cache->decoder || dsc->cache_tiles) return;
+    if(dsc->time_to_open < LV_IMAGE_DISK_CACHE_MIN_TIME) return;
+
+    const char * src = dsc->src;
+    uint32_t path_len = lv_strlen(src);
+    if(path_len >= LV_FS_MAX_PATH_LEN) return;
+
+    LV_PROFILER_DECODER_BEGIN_TAG(DECODER_NAME);
+
+    /*Forget the old image of the source, so it's not loaded while it's overwritten*/
+    uint32_t key = fnv_1a_hash(0, src, path_len);
+    char path[LV_FS_MAX_PATH_LEN];
+    lv_mutex_lock(&disk_cache->lock);
+    bool enabled = disk_cache->path && !is_in_cache_dir(src);
+    uint32_t path_cnt = disk_cache->path_cnt;
+    if(enabled) {
+        get_image_path(key, path, sizeof(path));
+        uint32_t index;
+        if(find_entry(key, &index)) delete_entry(index);
+    }
+    lv_mutex_unlock(&disk_cache->lock);
+
+    if(!enabled) {
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return;
+    }
+
+    image_file_header_t file_header;
+    lv_memzero(&file_header, sizeof(file_header));
+    if(get_fingerprint(src, &file_header.src_size, &file_header.src_hash) != LV_RESULT_OK) {
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return;
+    }
+
+    file_header.magic = IMAGE_MAGIC;
+    file_header.version = FORMAT_VERSION;
+    file_header.time_to_open = dsc->time_to_open;
+    file_header.path_len = path_len;
+    file_header.data_offset = LV_ALIGN_UP(sizeof(file_header) + path_len, DATA_ALIGN);
+    file_header.data_size = decoded->data_size;
+    file_header.header = dsc->header;
+    file_header.decoded_header = decoded->header;
+
+    uint32_t size = file_header.data_offset + file_header.data_size;
+    if(size > LV_IMAGE_DISK_CACHE_MAX_SIZE) {
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return;
+    }
+
+    /*Write the image without holding the lock*/
+    bool written = write_image(path, &file_header, src, decoded);
+
+    lv_mutex_lock(&disk_cache->lock);
+
+    /*The directory was changed or the same image was stored by an other thread meanwhile*/
+    uint32_t index;
+    if(path_cnt != disk_cache->path_cnt || find_entry(key, &index)) {
+        if(path_cnt != disk_cache->path_cnt) lv_fs_delete(path);
+        lv_mutex_unlock(&disk_cache->lock);
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return;
+    }
+
+    if(written) {
+        /*Delete the least recently used images from the beginning to make room*/
+        uint32_t evict_cnt = 0;
+        while(disk_cache->total_size + size > LV_IMAGE_DISK_CACHE_MAX_SIZE) {
+            lv_image_disk_cache_entry_t * lru = lv_array_at(&disk_cache->entries, evict_cnt);
+            delete_image_file(lru->key);
+            disk_cache->total_size -= lru->size;
+            evict_cnt++;
+        }
+        if(evict_cnt) lv_array_erase(&disk_cache->entries, 0, evict_cnt);
+
+        lv_image_disk_cache_entry_t entry;
+        entry.key = key;
+        entry.size = size;
+        entry.last_use = ++disk_cache->clock;
+        if(lv_array_push_back(&disk_cache->entries, &entry) == LV_RESULT_OK) {
+            disk_cache->total_size += size;
+        }
+        else {
+            lv_fs_delete(path);
+        }
+
+        /*Saved by the timer or on deinit*/
+        disk_cache->index_changed = true;
+    }
+    else {
+        LV_LOG_WARN("Couldn't store %s in %s", src, path);
+        lv_fs_delete(path);
+    }
+
+    lv_mutex_unlock(&disk_cache->lock);
+
+    LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Load a file image from the disk cache. The disk cache's lock needs to be held.
+ */
+static lv_result_t load_image_locked(lv_image_decoder_dsc_t * dsc)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+    if(disk_cache->path == NULL) return LV_RESULT_INVALID;
+
+    const char * src = dsc->src;
+    if(is_in_cache_dir(src)) return LV_RESULT_INVALID;
+
+    uint32_t key = fnv_1a_hash(0, src, lv_strlen(src));
+    uint32_t index;
+    lv_image_disk_cache_entry_t * entry = find_entry(key, &index);
+    if(entry == NULL) return LV_RESULT_INVALID;
+
+    LV_PROFILER_DECODER_BEGIN_TAG(DECODER_NAME);
+
+    uint32_t src_size;
+    uint32_t src_hash;
+    if(get_fingerprint(src, &src_size, &src_hash) != LV_RESULT_OK) {
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return LV_RESULT_INVALID;
+    }
+
+    char path[LV_FS_MAX_PATH_LEN];
+    get_image_path(key, path, sizeof(path));
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        delete_entry(index);
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return LV_RESULT_INVALID;
+    }
+
+    /*Check that the image was stored from the same source file*/
+    image_file_header_t file_header;
+    char src_stored[LV_FS_MAX_PATH_LEN];
+    uint32_t rn = 0;
+    bool valid = lv_fs_read(&f, &file_header, sizeof(file_header), &rn) == LV_FS_RES_OK && rn == sizeof(file_header) &&
+                 file_header.magic == IMAGE_MAGIC && file_header.version == FORMAT_VERSION &&
+                 file_header.src_size == src_size && file_header.src_hash == src_hash &&
+                 file_header.path_len == lv_strlen(src) && file_header.path_len < sizeof(src_stored) &&
+                 lv_fs_read(&f, src_stored, file_header.path_len, &rn) == LV_FS_RES_OK && rn == file_header.path_len &&
+                 lv_memcmp(src_stored, src, file_header.path_len) == 0;
+
+    lv_draw_buf_t * decoded = valid ? load_image(&f, &file_header) : NULL;
+    lv_fs_close(&f);
+
+    if(decoded == NULL) {
+        /*The source file changed or the stored image is broken*/
+        LV_LOG_INFO("Stored image of %s is outdated", src);
+        delete_entry(index);
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return LV_RESULT_INVALID;
+    }
+
+    /*Move it to the end as the most recently used*/
+    lv_image_disk_cache_entry_t used = *entry;
+    used.last_use = ++disk_cache->clock;
+    lv_array_remove(&disk_cache->entries, index);
+    lv_array_push_back(&disk_cache->entries, &used);
+    disk_cache->index_changed = true;
+
+    dsc->header = file_header.header;
+    dsc->decoder = disk_cache->decoder;
+    dsc->time_to_open = file_header.time_to_open;
+
+    lv_draw_buf_t * adjusted = lv_image_decoder_post_process(dsc, decoded);
+    if(adjusted == NULL) {
+        lv_draw_buf_destroy(decoded);
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return LV_RESULT_INVALID;
+    }
+
+    /*The adjusted draw buffer is newly allocated.*/
+    if(adjusted != decoded) {
+        lv_draw_buf_destroy(decoded);
+        decoded = adjusted;
+    }
+
+    dsc->decoded = decoded;
+
+    if(dsc->args.no_cache || !lv_image_cache_is_enabled()) {
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return LV_RESULT_OK;
+    }
+
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+    search_key.tile = 0;
+    search_key.slot.size = decoded->data_size;
+
+    lv_cache_entry_t * cache_entry = lv_image_decoder_add_to_cache(dsc->decoder, &search_key, decoded, NULL);
+    if(cache_entry == NULL) {
+        lv_draw_buf_destroy(decoded);
+        dsc->decoded = NULL;
+        LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+        return LV_RESULT_INVALID;
+    }
+
+    /*Keep the cost of decoding the source, as it would be decoded again if evicted and deleted from the disk*/
+    lv_cache_entry_set_cost(cache_entry, dsc->time_to_open);
+    dsc->cache_entry = cache_entry;
+
+    LV_PROFILER_DECODER_END_TAG(DECODER_NAME);
+    return LV_RESULT_OK;
+}
+
+static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    if(dsc->args.no_cache ||
+       !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+}
+
+/**
+ * Map or load the data of a stored image
+ * @param f             the opened file of the stored image
+ * @param file_header   the header read from the file
+ * @return              the draw buffer of the image or NULL on error
+ */
+static lv_draw_buf_t * load_image(lv_fs_file_t * f, const image_file_header_t * file_header)
+{
+    const lv_image_header_t * header = &file_header->decoded_header;
+    if(header->magic != LV_IMAGE_HEADER_MAGIC || header->w == 0 || header->h == 0 ||
+       (uint64_t)header->stride * header->h > file_header->data_size) return NULL;
+
+    uint32_t flags = header->flags & LV_IMAGE_FLAGS_PREMULTIPLIED;
+
+    /*Read the data in place if the file can be mapped*/
+    lv_fs_map_t map;
+    if(lv_fs_map(f, file_header->data_offset, file_header->data_size, &map) == LV_FS_RES_OK) {
+        lv_fs_map_t * map_p = NULL;
+        lv_draw_buf_t * decoded = NULL;
+
+        /*The draw units might need aligned data*/
+        if(lv_draw_buf_align((void *)map.data, header->cf) == map.data) {
+            map_p = lv_malloc(sizeof(lv_fs_map_t));
+            decoded = lv_malloc(sizeof(lv_draw_buf_t));
+        }
+
+        if(map_p && decoded) {
+            *map_p = map;
+            lv_draw_buf_init(decoded, header->w, header->h, header->cf, header->stride, (void *)map.data,
+                             file_header->data_size);
+            decoded->header.flags = LV_IMAGE_FLAGS_ALLOCATED | flags; /*Not modifiable*/
+            decoded->unaligned_data = map_p;
+            decoded->handlers = &mapped_draw_buf_handlers;
+            return decoded;
+        }
+
+        lv_free(map_p);
+        lv_free(decoded);
+        lv_fs_unmap(&map);
+    }
+
+    lv_draw_buf_t * decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, header->w, header->h, header->cf,
+                                                    header->stride);
+    if(decoded == NULL) return NULL;
+
+    uint32_t rn = 0;
+    if(decoded->data_size != file_header->data_size ||
+       lv_fs_seek(f, file_header->data_offset, LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+       lv_fs_read(f, decoded->data, file_header->data_size, &rn) != LV_FS_RES_OK || rn != file_header->data_size) {
+        lv_draw_buf_destroy(decoded);
+        return NULL;
+    }
+
+    decoded->header.flags |= flags;
+    return decoded;
+}
+
+static void mapped_draw_buf_free(void * buf)
+{
+    lv_fs_map_t * map = buf;
+    lv_fs_unmap(map);
+    lv_free(map);
+}
+
+/**
+ * Write an image to a file. The magic is written at last, so a partially written file is not used.
+ */
+static bool write_image(const char * path, const image_file_header_t * file_header, const char * src,
+                        const lv_draw_buf_t * decoded)
+{
+    /*Writing doesn't truncate the files with some drivers*/
+    lv_fs_delete(path);
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_WR) != LV_FS_RES_OK) return false;
+
+    image_file_header_t incomplete = *file_header;
+    incomplete.magic = 0;
+
+    static const uint8_t padding[DATA_ALIGN] = {0};
+    uint32_t padding_len = file_header->data_offset - sizeof(image_file_header_t) - file_header->path_len;
+    uint32_t magic = file_header->magic;
+    uint32_t bw = 0;
+
+    bool ok = lv_fs_write(&f, &incomplete, sizeof(incomplete), &bw) == LV_FS_RES_OK && bw == sizeof(incomplete) &&
+              lv_fs_write(&f, src, file_header->path_len, &bw) == LV_FS_RES_OK && bw == file_header->path_len &&
+              lv_fs_write(&f, padding, padding_len, &bw) == LV_FS_RES_OK && bw == padding_len &&
+              lv_fs_write(&f, decoded->data, file_header->data_size, &bw) == LV_FS_RES_OK && bw == file_header->data_size &&
+              lv_fs_seek(&f, 0, LV_FS_SEEK_SET) == LV_FS_RES_OK &&
+              lv_fs_write(&f, &magic, sizeof(magic), &bw) == LV_FS_RES_OK && bw == sizeof(magic);
+
+    return lv_fs_close(&f) == LV_FS_RES_OK && ok;
+}
+
+/**
+ * Identify the content of a file without reading all of it
+ */
+static lv_result_t get_fingerprint(const char * src, uint32_t * size, uint32_t * hash)
+{
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, src, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RESULT_INVALID;
+
+    uint8_t buf[FINGERPRINT_LEN];
+    uint32_t head_len = 0;
+    uint32_t tail_len = 0;
+    lv_fs_res_t res = lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    if(res == LV_FS_RES_OK) res = lv_fs_tell(&f, size);
+    if(res == LV_FS_RES_OK) res = lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) res = lv_fs_read(&f, buf, LV_MIN(*size, FINGERPRINT_LEN), &head_len);
+    *hash = fnv_1a_hash(0, buf, head_len);
+
+    if(res == LV_FS_RES_OK && *size > FINGERPRINT_LEN) {
+        uint32_t tail_start = LV_MAX(*size - FINGERPRINT_LEN, FINGERPRINT_LEN);
+        res = lv_fs_seek(&f, tail_start, LV_FS_SEEK_SET);
+        if(res == LV_FS_RES_OK) res = lv_fs_read(&f, buf, *size - tail_start, &tail_len);
+        *hash = fnv_1a_hash(*hash, buf, tail_len);
+    }
+
+    lv_fs_close(&f);
+    return res == LV_FS_RES_OK ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+static bool is_in_cache_dir(const char * src)
+{
+    const char * path = disk_cache_p->path;
+    size_t len = lv_strlen(path);
+    if(len == 0 || lv_strncmp(src, path, len) != 0) return false;
+
+    /*Not a file next to the directory with a similar name*/
+    char c = path[len - 1];
+    return c == '/' || c == '\\' || c == ':' || src[len] == '/' || src[len] == '\\';
+}
+
+static void get_image_path(uint32_t key, char * buf, uint32_t buf_size)
+{
+    char name[16];
+    lv_snprintf(name, sizeof(name), "%08" LV_PRIx32 ".img", key);
+    lv_fs_path_join(buf, buf_size, disk_cache_p->path, name);
+}
+
+static lv_image_disk_cache_entry_t * find_entry(uint32_t key, uint32_t * index)
+{
+    lv_array_t * entries = &disk_cache_p->entries;
+    uint32_t i;
+    for(i = 0; i < lv_array_size(entries); i++) {
+        lv_image_disk_cache_entry_t * entry = lv_array_at(entries, i);
+        if(entry->key == key) {
+            *index = i;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Delete an image from the disk and from the index
+ */
+static void delete_entry(uint32_t index)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+    lv_image_disk_cache_entry_t * entry = lv_array_at(&disk_cache->entries, index);
+
+    delete_image_file(entry->key);
+
+    /*Keep the order of use*/
+    disk_cache->total_size -= entry->size;
+    lv_array_remove(&disk_cache->entries, index);
+    disk_cache->index_changed = true;
+}
+
+static void delete_image_file(uint32_t key)
+{
+    char path[LV_FS_MAX_PATH_LEN];
+    get_image_path(key, path, sizeof(path));
+    lv_fs_res_t res = lv_fs_delete(path);
+    if(res != LV_FS_RES_OK && res != LV_FS_RES_NOT_EX) {
+        LV_LOG_WARN("Couldn't delete %s: %d", path, res);
+    }
+}
+
+static void load_index(void)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+
+    char path[LV_FS_MAX_PATH_LEN];
+    lv_fs_path_join(path, sizeof(path), disk_cache->path, INDEX_NAME);
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return;
+
+    index_file_header_t index_header;
+    uint32_t rn = 0;
+    if(lv_fs_read(&f, &index_header, sizeof(index_header), &rn) != LV_FS_RES_OK || rn != sizeof(index_header) ||
+       index_header.magic != INDEX_MAGIC || index_header.version != FORMAT_VERSION) {
+        lv_fs_close(&f);
+        LV_LOG_WARN("Invalid index: %s", path);
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < index_header.entry_cnt; i++) {
+        lv_image_disk_cache_entry_t entry;
+        if(lv_fs_read(&f, &entry, sizeof(entry), &rn) != LV_FS_RES_OK || rn != sizeof(entry)) break;
+        if(lv_array_push_back(&disk_cache->entries, &entry) != LV_RESULT_OK) break;
+
+        /*The entries are saved in the order of use, but keep them sorted anyway*/
+        uint32_t j = lv_array_size(&disk_cache->entries) - 1;
+        while(j > 0) {
+            lv_image_disk_cache_entry_t * prev = lv_array_at(&disk_cache->entries, j - 1);
+            if(prev->last_use <= entry.last_use) break;
+            lv_array_assign(&disk_cache->entries, j, prev);
+            j--;
+        }
+        lv_array_assign(&disk_cache->entries, j, &entry);
+
+        disk_cache->total_size += entry.size;
+        disk_cache->clock = LV_MAX(disk_cache->clock, entry.last_use);
+    }
+
+    lv_fs_close(&f);
+}
+
+static void save_index(void)
+{
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+
+    char path[LV_FS_MAX_PATH_LEN];
+    lv_fs_path_join(path, sizeof(path), disk_cache->path, INDEX_NAME);
+
+    /*Writing doesn't truncate the files with some drivers. The entry count tells where the index ends anyway.*/
+    lv_fs_delete(path);
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_WR) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't save the index: %s", path);
+        return;
+    }
+
+    index_file_header_t index_header;
+    index_header.magic = INDEX_MAGIC;
+    index_header.version = FORMAT_VERSION;
+    index_header.entry_cnt = lv_array_size(&disk_cache->entries);
+
+    uint32_t entries_size = index_header.entry_cnt * sizeof(lv_image_disk_cache_entry_t);
+    uint32_t bw = 0;
+    bool ok = lv_fs_write(&f, &index_header, sizeof(index_header), &bw) == LV_FS_RES_OK && bw == sizeof(index_header);
+    if(ok && entries_size) {
+        ok = lv_fs_write(&f, lv_array_front(&disk_cache->entries), entries_size, &bw) == LV_FS_RES_OK &&
+             bw == entries_size;
+    }
+
+    lv_fs_close(&f);
+
+    if(ok) disk_cache->index_changed = false;
+    else LV_LOG_WARN("Couldn't save the index: %s", path);
+}
+
+static void save_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_image_disk_cache_t * disk_cache = disk_cache_p;
+
+    lv_mutex_lock(&disk_cache->lock);
+    if(disk_cache->path && disk_cache->index_changed) save_index();
+    lv_mutex_unlock(&disk_cache->lock);
+}
+
+/**
+ * Continue an FNV-1a hash with more data
+ * @param hash      the hash of the previous data or 0 to start a new hash
+ */
+static uint32_t fnv_1a_hash(uint32_t hash, const void * data, uint32_t len)
+{
+    const uint8_t * bytes = data;
+    if(hash == 0) hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+#endif /*LV_USE_IMAGE_DISK_CACHE*/
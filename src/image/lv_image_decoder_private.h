@@ -15,11 +15,24 @@ extern "C" {
  *********************/
 
 #include "../misc/cache/lv_cache.h"
+#include "../misc/lv_array.h"
+#include "../osal/lv_os_private.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/** The lock held while opening an image or using the image cache. NULL without an OS.
+ *  `../core/lv_global.h` needs to be included to use it. */
+#if LV_USE_OS != LV_OS_NONE
+    #define LV_IMAGE_DECODER_OPEN_LOCK_P (&(LV_GLOBAL_DEFAULT()->img_decoder_open_lock))
+#else
+    #define LV_IMAGE_DECODER_OPEN_LOCK_P NULL
+#endif
+
+/** Number of tiles in a row or column of an image decoded in tiles. See `LV_USE_IMAGE_DECODER_ROI`*/
+#define LV_IMAGE_DECODER_ROI_TILE_CNT(size) (((size) + LV_IMAGE_DECODER_ROI_TILE_SIZE - 1) / LV_IMAGE_DECODER_ROI_TILE_SIZE)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -39,6 +52,7 @@ struct _lv_image_decoder_args_t {
     bool no_cache;          /**< When set, decoded image won't be put to cache, and decoder open will also ignore cache. */
     bool use_indexed;       /**< Decoded indexed image as is. Convert to ARGB8888 if false. */
     bool flush_cache;       /**< Whether to flush the data cache after decoding */
+    bool no_roi;            /**< Decode the whole image even if it's large enough for `LV_USE_IMAGE_DECODER_ROI` */
 };
 
 struct _lv_image_decoder_t {
@@ -60,6 +74,14 @@ struct _lv_image_cache_data_t {
     const void * src;
     lv_image_src_t src_type;
 
+    /** The color format the image was converted to for drawing, or `LV_COLOR_FORMAT_UNKNOWN`
+     *  for the decoded image. See `lv_image_decoder_acquire_converted()`*/
+    lv_color_format_t target_cf;
+
+    /** `0` for the whole image, else 1 + the index (row by row) of the tile of the image.
+     *  See `LV_USE_IMAGE_DECODER_ROI`*/
+    uint32_t tile;
+
     const lv_draw_buf_t * decoded;
     const lv_image_decoder_t * decoder;
     void * user_data;
@@ -112,10 +134,84 @@ struct _lv_image_decoder_dsc_t {
     /**Point to cache entry information*/
     lv_cache_entry_t * cache_entry;
 
+    /**Set in `open` to store the areas returned by `get_area_cb` in the image cache in tiles.
+     * `get_area_cb` should return the rows of the area from top to bottom then, in the full width
+     * of the area. See `LV_USE_IMAGE_DECODER_ROI`*/
+    bool cache_tiles;
+
+    /**The cache entry of the tile returned by the last `lv_image_decoder_get_area()`*/
+    lv_cache_entry_t * tile_entry;
+
+    /**Set in `open` with `cache_tiles` to keep `user_data` opened for decoding the missing tiles
+     * in the next draws too. `close` gets `user_data` NULL then, and the tiles of the image are
+     * decoded by one thread at a time. See `LV_IMAGE_DECODER_ROI_OPENED_CNT`*/
+    bool keep_opened;
+
+    /**The entry of the image kept opened. See `keep_opened`*/
+    lv_cache_entry_t * opened_entry;
+
     /**Store any custom data here is required*/
     void * user_data;
 };
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+typedef enum {
+    LV_IMAGE_DECODER_ASYNC_STATE_PENDING,   /**< Waiting for the worker */
+    LV_IMAGE_DECODER_ASYNC_STATE_DECODING,  /**< Being decoded by the worker */
+    LV_IMAGE_DECODER_ASYNC_STATE_READY,     /**< Decoded to the cache, the widgets are not invalidated yet */
+    LV_IMAGE_DECODER_ASYNC_STATE_UNCACHED,  /**< Couldn't be decoded to the cache, draw it synchronously */
+} lv_image_decoder_async_state_t;
+
+/**A source to decode in the background*/
+typedef struct {
+    const void * src;                       /**< Copy of the path for files */
+    lv_image_src_t src_type;
+    lv_array_t objs;                        /**< `lv_obj_t *` to invalidate when the image is decoded.
+                                             *   They are removed from here when they are deleted. */
+    lv_image_decoder_async_state_t state;
+} lv_image_decoder_async_req_t;
+
+typedef struct {
+    lv_ll_t req_ll;                         /**< `lv_image_decoder_async_req_t` */
+    lv_timer_t * timer;                     /**< Invalidates the widgets of the decoded images */
+    bool enabled;                           /**< Defer drawing the images which are not decoded yet */
+    lv_color_t placeholder_color;           /**< Drawn instead of the images which are not decoded yet */
+    lv_opa_t placeholder_opa;
+#if LV_USE_OS
+    lv_thread_t thread;
+    lv_thread_sync_t sync;
+    lv_mutex_t lock;                        /**< Protects `req_ll` */
+    bool exit;
+#endif
+} lv_image_decoder_async_t;
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
+#if LV_USE_IMAGE_DISK_CACHE
+
+/**An image stored in the disk cache*/
+typedef struct {
+    uint32_t key;                           /**< Hash of the source path, also the name of the file */
+    uint32_t size;                          /**< Size of the file in bytes */
+    uint32_t last_use;                      /**< `clock` when the image was stored or loaded the last time */
+} lv_image_disk_cache_entry_t;
+
+typedef struct {
+    char * path;                            /**< Directory of the stored images, NULL if disabled */
+    lv_array_t entries;                     /**< `lv_image_disk_cache_entry_t` from the least recently used,
+                                             *   saved in the index file */
+    uint32_t total_size;                    /**< Size of the stored images in bytes */
+    uint32_t clock;                         /**< Incremented on each use of an image */
+    uint32_t path_cnt;                      /**< Incremented when `path` is changed */
+    bool index_changed;                     /**< The index file needs to be saved */
+    lv_image_decoder_t * decoder;           /**< Closes the images loaded from the disk */
+    lv_timer_t * save_timer;                /**< Saves the index file periodically if it changed */
+    lv_mutex_t lock;                        /**< Protects the fields above, as the images are stored
+                                             *   without holding the decoder's open lock */
+} lv_image_disk_cache_t;
+
+#endif /*LV_USE_IMAGE_DISK_CACHE*/
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -133,10 +229,162 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void);
 
+/**
+ * Initialize the decoder arguments to the defaults used when `lv_image_decoder_open()` gets NULL
+ * @param args      pointer to the arguments to initialize
+ */
+void lv_image_decoder_args_init(lv_image_decoder_args_t * args);
+
 lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
                                                  lv_image_cache_data_t * search_key,
                                                  const lv_draw_buf_t * decoded, void * user_data);
 
+#if LV_USE_IMAGE_CACHE_CONVERT
+
+/**
+ * Get a copy of an opened image converted to the color format it's drawn to, so it can be
+ * copied as it is in each frame. The copy is created on the first call and stored in the
+ * image cache as a separate entry, so it's evicted independently of the decoded image.
+ * `lv_image_cache_drop()` drops both.
+ * Only the images stored in the image cache are converted, as the others might change any time.
+ * Images with alpha channel are converted to RGB565A8 for RGB565 and not converted for the
+ * other formats.
+ * @param dsc       an opened image
+ * @param cf        the color format of the layer, `LV_COLOR_FORMAT_RGB565`, `LV_COLOR_FORMAT_RGB888`
+ *                  or `LV_COLOR_FORMAT_XRGB8888`
+ * @return          the cache entry of the converted image (`lv_image_cache_data_t`) to release
+ *                  with `lv_cache_release()`, or NULL if the image can't be converted
+ */
+lv_cache_entry_t * lv_image_decoder_acquire_converted(const lv_image_decoder_dsc_t * dsc, lv_color_format_t cf);
+
+#endif /*LV_USE_IMAGE_CACHE_CONVERT*/
+
+#if LV_USE_IMAGE_DECODER_ROI
+
+/**
+ * Check if an image is large enough to decode only its drawn areas instead of the whole image.
+ * Decoders supporting it should set `cache_tiles` and leave `decoded` NULL in `open` then.
+ * Always false if the image is opened with the `no_roi` argument.
+ * @param dsc       the image being opened, with `header` set
+ * @return          true: decode the image in areas with `get_area_cb`
+ */
+bool lv_image_decoder_use_roi(const lv_image_decoder_dsc_t * dsc);
+
+/**
+ * Get the next tile of an area of an image opened with `cache_tiles`. The missing tiles are
+ * decoded with the decoder's `get_area_cb` and added to the image cache.
+ * @param dsc           an opened image
+ * @param full_area     the area of the image to get
+ * @param decoded_area  the area of the last tile, initially `LV_COORD_MIN`, set to the area of the next tile
+ * @return              LV_RESULT_OK: `dsc->decoded` is the next tile; LV_RESULT_INVALID: no more tiles
+ */
+lv_result_t lv_image_decoder_get_tile_area(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                           lv_area_t * decoded_area);
+
+/**
+ * Release the tile returned by the last `lv_image_decoder_get_tile_area()`
+ * @param dsc       an opened image
+ */
+void lv_image_decoder_release_tile(lv_image_decoder_dsc_t * dsc);
+
+/**
+ * Create the cache of the images kept opened to decode their tiles
+ */
+void lv_image_decoder_opened_init(void);
+
+/**
+ * Close all the images kept opened and delete their cache
+ */
+void lv_image_decoder_opened_deinit(void);
+
+/**
+ * Open an image kept opened by an earlier `lv_image_decoder_open()`. Sets `decoder`, `header`,
+ * `cache_tiles` and `opened_entry` without calling the decoder.
+ * @param dsc       the image being opened, with `src` and `args` set
+ * @return          LV_RESULT_OK: found; LV_RESULT_INVALID: open the image with its decoder
+ */
+lv_result_t lv_image_decoder_open_kept(lv_image_decoder_dsc_t * dsc);
+
+/**
+ * Keep the decoder's `user_data` of an image opened with `keep_opened` for the next draws.
+ * `user_data` is moved to `opened_entry` on success.
+ * @param dsc       an image just opened by its decoder
+ */
+void lv_image_decoder_keep_opened(lv_image_decoder_dsc_t * dsc);
+
+/**
+ * Release the image kept opened. Called by `lv_image_decoder_close()`.
+ * @param dsc       an opened image
+ */
+void lv_image_decoder_release_opened(lv_image_decoder_dsc_t * dsc);
+
+/**
+ * Close an image kept opened when it's not used anymore
+ * @param src       the source of the image, or NULL to close all of them
+ */
+void lv_image_decoder_drop_opened(const void * src);
+
+#endif /*LV_USE_IMAGE_DECODER_ROI*/
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+/**
+ * Start the worker of the asynchronous image decoding
+ */
+void lv_image_decoder_async_init(void);
+
+/**
+ * Stop the worker and free the pending requests
+ */
+void lv_image_decoder_async_deinit(void);
+
+/**
+ * Check if drawing an image should be skipped while it's decoded in the background.
+ * Only if it's enabled by `lv_image_decoder_set_async()`, and only the images drawn
+ * while refreshing a display are deferred, if
+ * they need real decoding (files, compressed or encoded variables) and they are not cached yet.
+ * @param src       the image source
+ * @param header    the header of the image
+ * @param obj       the widget drawing the image, invalidated when the image is decoded.
+ *                  If NULL the image is not deferred.
+ * @return          true: the image is being decoded, don't draw it now;
+ *                  false: draw the image as usual
+ */
+bool lv_image_decoder_async_defer(const void * src, const lv_image_header_t * header, lv_obj_t * obj);
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
+#if LV_USE_IMAGE_DISK_CACHE
+
+/**
+ * Create the decoder of the images loaded from the disk cache
+ */
+void lv_image_decoder_disk_cache_init(void);
+
+/**
+ * Save the index of the disk cache if it changed and free its memory
+ */
+void lv_image_decoder_disk_cache_deinit(void);
+
+/**
+ * Load a file image from the disk cache if it was stored from the same source file.
+ * The image is added to the image cache unless `args.no_cache` is set.
+ * @param dsc       the image being opened, with `src` and `args` set
+ * @return          LV_RESULT_OK: `dsc` is opened from the disk cache; LV_RESULT_INVALID: decode it
+ */
+lv_result_t lv_image_decoder_disk_cache_load(lv_image_decoder_dsc_t * dsc);
+
+/**
+ * Store a decoded file image in the disk cache if it was slow to decode, see `LV_IMAGE_DISK_CACHE_MIN_TIME`.
+ * The least recently used images are deleted if needed to stay below `LV_IMAGE_DISK_CACHE_MAX_SIZE`.
+ * Called without holding the decoder's open lock, as writing the image can take long.
+ * The index file is saved later by a timer or on deinit.
+ * @param dsc       an image just opened by a decoder, not closed yet
+ */
+void lv_image_decoder_disk_cache_store(const lv_image_decoder_dsc_t * dsc);
+
+#endif /*LV_USE_IMAGE_DISK_CACHE*/
+
 /**********************
  *      MACROS
  **********************/
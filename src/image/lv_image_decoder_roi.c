@@ -0,0 +1,494 @@
+/**
+ * @file lv_image_decoder_roi.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_image_decoder_private.h"
+#include "../misc/lv_area_private.h"
+
+#if LV_USE_IMAGE_DECODER_ROI
+
+#include "../core/lv_global.h"
+#include "../misc/cache/instance/lv_image_cache.h"
+#include "../misc/cache/lv_cache_entry.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TILE_SIZE LV_IMAGE_DECODER_ROI_TILE_SIZE
+
+#define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+#define img_opened_cache_p (LV_GLOBAL_DEFAULT()->img_opened_cache)
+#define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*An image kept opened to decode its missing tiles*/
+typedef struct {
+    const void * src;
+    lv_image_src_t src_type;
+    lv_image_decoder_t * decoder;
+    lv_image_header_t header;
+    void * user_data;   /*The decoder's `user_data` set in `open`*/
+    lv_mutex_t lock;    /*Held while decoding the tiles of the image*/
+} opened_data_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_cache_entry_t * decode_tiles(lv_image_decoder_dsc_t * dsc, int32_t tx, int32_t ty, lv_area_t * tile_range);
+static bool create_tiles(const lv_image_decoder_dsc_t * dsc, lv_draw_buf_t ** tiles, const lv_area_t * tile_range,
+                         int32_t ty, lv_color_format_t cf);
+static void copy_to_tiles(const lv_image_decoder_dsc_t * dsc, lv_draw_buf_t ** tiles, const lv_area_t * tile_range,
+                          int32_t ty, const lv_draw_buf_t * decoded, const lv_area_t * decoded_area);
+static lv_cache_entry_t * add_tiles(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t ** tiles, const lv_area_t * tile_range,
+                                    int32_t ty, int32_t tx_to_acquire, uint32_t cost);
+static void free_tiles(lv_draw_buf_t ** tiles, int32_t tile_cnt);
+static lv_cache_entry_t * acquire_tile(const lv_image_decoder_dsc_t * dsc, int32_t tx, int32_t ty);
+static bool is_row_cached(const lv_image_decoder_dsc_t * dsc, int32_t ty, const lv_area_t * tile_range);
+static void get_tile_area(const lv_image_decoder_dsc_t * dsc, int32_t tx, int32_t ty, lv_area_t * area);
+static lv_cache_compare_res_t opened_compare_cb(const opened_data_t * lhs, const opened_data_t * rhs);
+static void opened_free_cb(opened_data_t * opened, void * user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_image_decoder_use_roi(const lv_image_decoder_dsc_t * dsc)
+{
+    if(dsc->args.no_roi) return false;
+
+    uint64_t size = (uint64_t)lv_draw_buf_width_to_stride(dsc->header.w, dsc->header.cf) * dsc->header.h;
+    return size >= LV_IMAGE_DECODER_ROI_MIN_SIZE;
+}
+
+lv_result_t lv_image_decoder_get_tile_area(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                           lv_area_t * decoded_area)
+{
+    lv_image_decoder_release_tile(dsc);
+
+    lv_area_t image_area = {0, 0, dsc->header.w - 1, dsc->header.h - 1};
+    lv_area_t area;
+    if(!lv_area_intersect(&area, full_area, &image_area)) return LV_RESULT_INVALID;
+
+    /*The tiles covering the area*/
+    lv_area_t tile_range = {area.x1 / TILE_SIZE, area.y1 / TILE_SIZE, area.x2 / TILE_SIZE, area.y2 / TILE_SIZE};
+
+    /*Return the tiles row by row*/
+    int32_t tx;
+    int32_t ty;
+    if(decoded_area->y1 == LV_COORD_MIN) {
+        tx = tile_range.x1;
+        ty = tile_range.y1;
+    }
+    else {
+        tx = decoded_area->x1 / TILE_SIZE + 1;
+        ty = decoded_area->y1 / TILE_SIZE;
+        if(tx > tile_range.x2) {
+            tx = tile_range.x1;
+            ty++;
+        }
+    }
+
+    if(ty > tile_range.y2) return LV_RESULT_INVALID;
+
+    LV_PROFILER_DECODER_BEGIN;
+
+    lv_cache_entry_t * entry = acquire_tile(dsc, tx, ty);
+    if(entry == NULL) {
+        /*The rows above are returned already*/
+        tile_range.y1 = ty;
+
+        if(dsc->opened_entry) {
+            /*The image kept opened can be decoded by one thread at a time*/
+            opened_data_t * opened = lv_cache_entry_get_data(dsc->opened_entry);
+            lv_mutex_lock(&opened->lock);
+
+            /*The tile might have been decoded while waiting*/
+            entry = acquire_tile(dsc, tx, ty);
+            if(entry == NULL) {
+                dsc->user_data = opened->user_data;
+                entry = decode_tiles(dsc, tx, ty, &tile_range);
+                dsc->user_data = NULL;
+            }
+
+            lv_mutex_unlock(&opened->lock);
+        }
+        else {
+            entry = decode_tiles(dsc, tx, ty, &tile_range);
+        }
+    }
+
+    LV_PROFILER_DECODER_END;
+
+    if(entry == NULL) return LV_RESULT_INVALID;
+
+    lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    dsc->tile_entry = entry;
+    dsc->decoded = cached_data->decoded;
+    get_tile_area(dsc, tx, ty, decoded_area);
+
+    return LV_RESULT_OK;
+}
+
+void lv_image_decoder_release_tile(lv_image_decoder_dsc_t * dsc)
+{
+    if(dsc->tile_entry == NULL) return;
+
+    lv_cache_release(dsc->cache, dsc->tile_entry, NULL);
+    dsc->tile_entry = NULL;
+    dsc->decoded = NULL;
+}
+
+void lv_image_decoder_opened_init(void)
+{
+    img_opened_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(opened_data_t),
+    LV_IMAGE_DECODER_ROI_OPENED_CNT, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) opened_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) opened_free_cb
+    });
+
+    if(img_opened_cache_p) lv_cache_set_name(img_opened_cache_p, "IMAGE_OPENED");
+}
+
+void lv_image_decoder_opened_deinit(void)
+{
+    if(img_opened_cache_p == NULL) return;
+
+    lv_cache_destroy(img_opened_cache_p, NULL);
+    img_opened_cache_p = NULL;
+}
+
+lv_result_t lv_image_decoder_open_kept(lv_image_decoder_dsc_t * dsc)
+{
+    if(img_opened_cache_p == NULL || dsc->args.no_roi || dsc->args.use_indexed) return LV_RESULT_INVALID;
+
+    opened_data_t search_key;
+    search_key.src = dsc->src;
+    search_key.src_type = dsc->src_type;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(img_opened_cache_p, &search_key, NULL);
+    if(entry == NULL) return LV_RESULT_INVALID;
+
+    opened_data_t * opened = lv_cache_entry_get_data(entry);
+    dsc->decoder = opened->decoder;
+    dsc->header = opened->header;
+    dsc->cache_tiles = true;
+    dsc->keep_opened = true;
+    dsc->opened_entry = entry;
+
+    return LV_RESULT_OK;
+}
+
+void lv_image_decoder_keep_opened(lv_image_decoder_dsc_t * dsc)
+{
+    if(img_opened_cache_p == NULL || dsc->user_data == NULL) return;
+
+    opened_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.src = dsc->src;
+    search_key.src_type = dsc->src_type;
+    search_key.decoder = dsc->decoder;
+    search_key.header = dsc->header;
+    search_key.user_data = dsc->user_data;
+
+    /*Keep using the image's own `user_data` if it can't be added*/
+    lv_cache_entry_t * entry = lv_cache_add(img_opened_cache_p, &search_key, NULL);
+    if(entry == NULL) return;
+
+    opened_data_t * opened = lv_cache_entry_get_data(entry);
+    if(opened->src_type == LV_IMAGE_SRC_FILE) opened->src = lv_strdup(opened->src);
+    lv_mutex_init(&opened->lock);
+
+    dsc->user_data = NULL;
+    dsc->opened_entry = entry;
+}
+
+void lv_image_decoder_release_opened(lv_image_decoder_dsc_t * dsc)
+{
+    if(dsc->opened_entry == NULL) return;
+
+    lv_cache_release(img_opened_cache_p, dsc->opened_entry, NULL);
+    dsc->opened_entry = NULL;
+}
+
+void lv_image_decoder_drop_opened(const void * src)
+{
+    if(img_opened_cache_p == NULL) return;
+
+    if(src == NULL) {
+        lv_cache_drop_all(img_opened_cache_p, NULL);
+        return;
+    }
+
+    opened_data_t search_key;
+    search_key.src = src;
+    search_key.src_type = lv_image_src_get_type(src);
+    lv_cache_drop(img_opened_cache_p, &search_key, NULL);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Decode the rows of tiles from the row of a missing tile to the last row with a missing tile
+ * in one pass, as most decoders can't go back to the previous rows without starting over.
+ * @param dsc           an opened image
+ * @param tx            column of the missing tile
+ * @param ty            row of the missing tile
+ * @param tile_range    the columns and rows of the tiles to decode. The rows at the bottom which
+ *                      are cached already are removed.
+ * @return              the acquired cache entry of the missing tile or NULL on error
+ */
+static lv_cache_entry_t * decode_tiles(lv_image_decoder_dsc_t * dsc, int32_t tx, int32_t ty, lv_area_t * tile_range)
+{
+    while(tile_range->y2 > ty && is_row_cached(dsc, tile_range->y2, tile_range)) tile_range->y2--;
+
+    int32_t tile_cnt = lv_area_get_width(tile_range);
+    lv_draw_buf_t ** tiles = lv_malloc_zeroed(tile_cnt * sizeof(lv_draw_buf_t *));
+    LV_ASSERT_MALLOC(tiles);
+    if(tiles == NULL) return NULL;
+
+    lv_area_t first_tile_area;
+    lv_area_t last_tile_area;
+    get_tile_area(dsc, tile_range->x1, tile_range->y1, &first_tile_area);
+    get_tile_area(dsc, tile_range->x2, tile_range->y2, &last_tile_area);
+    lv_area_t area_to_decode = {first_tile_area.x1, first_tile_area.y1, last_tile_area.x2, last_tile_area.y2};
+
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    lv_cache_entry_t * entry = NULL;
+    int32_t row = LV_COORD_MIN; /*The row of the tiles being filled*/
+    bool error = false;
+    uint32_t t_start = lv_tick_get();
+
+    while(!error && dsc->decoder->get_area_cb(dsc->decoder, dsc, &area_to_decode, &decoded_area) == LV_RESULT_OK) {
+        const lv_draw_buf_t * decoded = dsc->decoded;
+        int32_t y_start = LV_MAX(decoded_area.y1, area_to_decode.y1) / TILE_SIZE;
+        int32_t y_end = LV_MIN(decoded_area.y2, area_to_decode.y2) / TILE_SIZE;
+        int32_t y;
+        for(y = y_start; y <= y_end; y++) {
+            if(y != row) {
+                /*The rows are decoded from top to bottom so the previous row was left incomplete*/
+                free_tiles(tiles, tile_cnt);
+                row = y;
+                if(!create_tiles(dsc, tiles, tile_range, row, decoded->header.cf)) {
+                    error = true;
+                    break;
+                }
+            }
+
+            copy_to_tiles(dsc, tiles, tile_range, row, decoded, &decoded_area);
+
+            /*The row of tiles is complete*/
+            lv_area_t tile_area;
+            get_tile_area(dsc, tile_range->x1, row, &tile_area);
+            if(decoded_area.y2 >= tile_area.y2) {
+                lv_cache_entry_t * acquired = add_tiles(dsc, tiles, tile_range, row, row == ty ? tx : -1,
+                                                        lv_tick_elaps(t_start));
+                if(acquired) entry = acquired;
+                row = LV_COORD_MIN;
+            }
+        }
+    }
+
+    free_tiles(tiles, tile_cnt);
+    lv_free(tiles);
+
+    /*The decoder's buffer is not valid after the next call*/
+    dsc->decoded = NULL;
+
+    if(entry == NULL) LV_LOG_WARN("Couldn't decode or cache the tiles of the image");
+
+    return entry;
+}
+
+static bool create_tiles(const lv_image_decoder_dsc_t * dsc, lv_draw_buf_t ** tiles, const lv_area_t * tile_range,
+                         int32_t ty, lv_color_format_t cf)
+{
+    int32_t i;
+    for(i = 0; i < lv_area_get_width(tile_range); i++) {
+        lv_area_t tile_area;
+        get_tile_area(dsc, tile_range->x1 + i, ty, &tile_area);
+        tiles[i] = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, lv_area_get_width(&tile_area),
+                                         lv_area_get_height(&tile_area), cf, LV_STRIDE_AUTO);
+        if(tiles[i] == NULL) {
+            LV_LOG_WARN("No memory for the tiles of the image");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void copy_to_tiles(const lv_image_decoder_dsc_t * dsc, lv_draw_buf_t ** tiles, const lv_area_t * tile_range,
+                          int32_t ty, const lv_draw_buf_t * decoded, const lv_area_t * decoded_area)
+{
+    int32_t i;
+    for(i = 0; i < lv_area_get_width(tile_range); i++) {
+        lv_area_t tile_area;
+        get_tile_area(dsc, tile_range->x1 + i, ty, &tile_area);
+
+        lv_area_t common_area;
+        if(!lv_area_intersect(&common_area, &tile_area, decoded_area)) continue;
+
+        lv_area_t dest_area = common_area;
+        lv_area_move(&dest_area, -tile_area.x1, -tile_area.y1);
+        lv_area_t src_area = common_area;
+        lv_area_move(&src_area, -decoded_area->x1, -decoded_area->y1);
+        lv_draw_buf_copy(tiles[i], &dest_area, decoded, &src_area);
+    }
+}
+
+/**
+ * Add a complete row of tiles to the image cache
+ * @param dsc               an opened image
+ * @param tiles             the tiles in the row. Added to the cache or destroyed.
+ * @param tile_range        the columns of the tiles
+ * @param ty                the row of the tiles
+ * @param tx_to_acquire     the column of the tile to keep acquired or -1
+ * @param cost              the time it took to decode the tiles
+ * @return                  the acquired cache entry of the tile at `tx_to_acquire` if any
+ */
+static lv_cache_entry_t * add_tiles(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t ** tiles, const lv_area_t * tile_range,
+                                    int32_t ty, int32_t tx_to_acquire, uint32_t cost)
+{
+    lv_cache_entry_t * acquired = NULL;
+    int32_t i;
+    for(i = 0; i < lv_area_get_width(tile_range); i++) {
+        int32_t tx = tile_range->x1 + i;
+        lv_draw_buf_t * tile = tiles[i];
+        tiles[i] = NULL;
+
+        /*The rows between the missing tiles might be cached already*/
+        lv_cache_entry_t * entry = acquire_tile(dsc, tx, ty);
+        if(entry == NULL) {
+            lv_color_format_t cf = tile->header.cf;
+            if(dsc->args.premultiply && lv_color_format_has_alpha(cf) && !LV_COLOR_FORMAT_IS_ALPHA_ONLY(cf)) {
+                lv_draw_buf_premultiply(tile);
+            }
+
+            if(dsc->args.flush_cache) lv_draw_buf_flush_cache(tile, NULL);
+
+            lv_image_cache_data_t search_key;
+            search_key.src_type = dsc->src_type;
+            search_key.src = dsc->src;
+            search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+            search_key.tile = ty * LV_IMAGE_DECODER_ROI_TILE_CNT(dsc->header.w) + tx + 1;
+            search_key.slot.size = tile->data_size;
+
+            /*Another thread might have added the same tile meanwhile*/
+            lv_mutex_lock(LV_IMAGE_DECODER_OPEN_LOCK_P);
+            entry = acquire_tile(dsc, tx, ty);
+            if(entry == NULL) {
+                entry = lv_image_decoder_add_to_cache(dsc->decoder, &search_key, tile, NULL);
+                if(entry) {
+                    lv_cache_entry_set_cost(entry, cost);
+                    tile = NULL;
+                }
+            }
+            lv_mutex_unlock(LV_IMAGE_DECODER_OPEN_LOCK_P);
+        }
+
+        if(tile) lv_draw_buf_destroy(tile);
+        if(entry == NULL) continue;
+
+        if(tx == tx_to_acquire) acquired = entry;
+        else lv_cache_release(img_cache_p, entry, NULL);
+    }
+
+    return acquired;
+}
+
+static void free_tiles(lv_draw_buf_t ** tiles, int32_t tile_cnt)
+{
+    int32_t i;
+    for(i = 0; i < tile_cnt; i++) {
+        if(tiles[i]) {
+            lv_draw_buf_destroy(tiles[i]);
+            tiles[i] = NULL;
+        }
+    }
+}
+
+static lv_cache_entry_t * acquire_tile(const lv_image_decoder_dsc_t * dsc, int32_t tx, int32_t ty)
+{
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+    search_key.tile = ty * LV_IMAGE_DECODER_ROI_TILE_CNT(dsc->header.w) + tx + 1;
+
+    return lv_cache_acquire(img_cache_p, &search_key, NULL);
+}
+
+static bool is_row_cached(const lv_image_decoder_dsc_t * dsc, int32_t ty, const lv_area_t * tile_range)
+{
+    int32_t tx;
+    for(tx = tile_range->x1; tx <= tile_range->x2; tx++) {
+        lv_cache_entry_t * entry = acquire_tile(dsc, tx, ty);
+        if(entry == NULL) return false;
+        lv_cache_release(img_cache_p, entry, NULL);
+    }
+
+    return true;
+}
+
+static void get_tile_area(const lv_image_decoder_dsc_t * dsc, int32_t tx, int32_t ty, lv_area_t * area)
+{
+    area->x1 = tx * TILE_SIZE;
+    area->y1 = ty * TILE_SIZE;
+    area->x2 = LV_MIN(area->x1 + TILE_SIZE, (int32_t)dsc->header.w) - 1;
+    area->y2 = LV_MIN(area->y1 + TILE_SIZE, (int32_t)dsc->header.h) - 1;
+}
+
+static lv_cache_compare_res_t opened_compare_cb(const opened_data_t * lhs, const opened_data_t * rhs)
+{
+    if(lhs->src_type != rhs->src_type) return lhs->src_type > rhs->src_type ? 1 : -1;
+
+    if(lhs->src_type == LV_IMAGE_SRC_FILE) {
+        int32_t cmp_res = lv_strcmp(lhs->src, rhs->src);
+        if(cmp_res != 0) return cmp_res > 0 ? 1 : -1;
+    }
+    else if(lhs->src != rhs->src) {
+        return lhs->src > rhs->src ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static void opened_free_cb(opened_data_t * opened, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*Let the decoder close its `user_data`*/
+    lv_image_decoder_dsc_t dsc;
+    lv_memzero(&dsc, sizeof(dsc));
+    dsc.decoder = opened->decoder;
+    dsc.src = opened->src;
+    dsc.src_type = opened->src_type;
+    dsc.header = opened->header;
+    dsc.user_data = opened->user_data;
+    if(opened->decoder->close_cb) opened->decoder->close_cb(opened->decoder, &dsc);
+
+    lv_mutex_delete(&opened->lock);
+    if(opened->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)opened->src);
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ROI*/
@@ -12,6 +12,7 @@
 #if LV_USE_LIBJPEG_TURBO
 
 #include "lv_image_decoder_private.h"
+#include "../misc/lv_area_private.h"
 #include <stdio.h>
 #include <jpeglib.h>
 #include <setjmp.h>
@@ -31,6 +32,8 @@
 #define ORIENTATION_TAG 0x112 /* Exif tag for orientation */
 #define APP1_MARKER JPEG_APP0 + 1  /* APP1 Marker code https://www.media.mit.edu/pia/Research/deepview/exif.html */
 #define MARKER_DATA_LIMIT 0xFFFF /* APP1 Marker limit */
+#define ROI_ROW_CNT 16 /* Rows to return at once from `decoder_get_area` */
+#define ROI_INPUT_BUF_SIZE 4096 /* Size of the parts of the file read at once while decoding an area */
 
 /**********************
  *      TYPEDEFS
@@ -67,6 +70,20 @@ typedef struct error_mgr_s {
     jmp_buf jb;
 } error_mgr_t;
 
+#if LV_USE_IMAGE_DECODER_ROI
+/* State of decoding a large image row by row */
+typedef struct {
+    struct jpeg_decompress_struct cinfo; /* Must be the first to get the state in the source callbacks */
+    error_mgr_t jerr;
+    struct jpeg_source_mgr src; /* Reads the file in parts */
+    lv_fs_file_t file;
+    uint8_t input_buf[ROI_INPUT_BUF_SIZE];
+    uint8_t * row_buf; /* A row in full width */
+    lv_draw_buf_t * decoded; /* The rows returned by `decoder_get_area` */
+    bool failed; /* Start over on the next call */
+} roi_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -83,6 +100,16 @@ static inline void process_buffer_orientation(image_orientation_t op, uint8_t *
 static image_orientation_t jpeg_markers_reader(struct jpeg_decompress_struct * cinfo);
 static void jpeg_cmyk_to_bgrx(uint8_t * cmyk_data, uint32_t pixel_count);
 static void error_exit(j_common_ptr cinfo);
+#if LV_USE_IMAGE_DECODER_ROI
+    static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                        const lv_area_t * full_area, lv_area_t * decoded_area);
+    static lv_result_t roi_open(lv_image_decoder_dsc_t * dsc);
+    static void roi_close(roi_data_t * roi);
+    static bool roi_start(roi_data_t * roi);
+    static void roi_source_noop(j_decompress_ptr cinfo);
+    static boolean roi_fill_input_buffer(j_decompress_ptr cinfo);
+    static void roi_skip_input_data(j_decompress_ptr cinfo, long num_bytes);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -112,6 +139,9 @@ void lv_libjpeg_turbo_init(void)
     lv_image_decoder_set_info_cb(dec, decoder_info);
     lv_image_decoder_set_open_cb(dec, decoder_open);
     lv_image_decoder_set_close_cb(dec, decoder_close);
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
+#endif
 
     dec->name = DECODER_NAME;
 }
@@ -194,6 +224,11 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
     /*If it's a JPEG file...*/
     if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+#if LV_USE_IMAGE_DECODER_ROI
+        /*Decode only the drawn areas of the large images in `decoder_get_area`*/
+        if(lv_image_decoder_use_roi(dsc) && roi_open(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
+#endif
+
         const char * fn = dsc->src;
         lv_draw_buf_t * decoded = decode_jpeg_file(fn);
         if(decoded == NULL) {
@@ -212,6 +247,8 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         lv_image_cache_data_t search_key;
         search_key.src_type = dsc->src_type;
         search_key.src = dsc->src;
+        search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+        search_key.tile = 0;
         search_key.slot.size = decoded->data_size;
 
         lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
@@ -234,6 +271,14 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder); /*Unused*/
 
+#if LV_USE_IMAGE_DECODER_ROI
+    if(dsc->user_data) {
+        roi_close(dsc->user_data);
+        dsc->user_data = NULL;
+        return;
+    }
+#endif
+
     if(dsc->args.no_cache ||
        !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
 }
@@ -647,4 +692,222 @@ static void error_exit(j_common_ptr cinfo)
     longjmp(myerr->jb, 1);
 }
 
+#if LV_USE_IMAGE_DECODER_ROI
+
+/**
+ * Decode an area of a large image. The rows are decoded from top to bottom so the decoding
+ * starts over only if the area is above the last decoded row. The rows above the area are
+ * skipped without decompressing them fully.
+ * @param decoder       pointer to the decoder
+ * @param dsc           pointer to the decoder descriptor
+ * @param full_area     the area of the image to decode
+ * @param decoded_area  the rows decoded at last, initially `LV_COORD_MIN`. Set to the next rows.
+ * @return              LV_RESULT_OK: the next rows are in `dsc->decoded`; LV_RESULT_INVALID: no more rows
+ */
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area)
+{
+    LV_UNUSED(decoder);
+    roi_data_t * roi = dsc->user_data;
+    LV_CHECK_ARG(roi, return LV_RESULT_INVALID, "decoder data unavailable");
+
+    lv_area_t image_area = {0, 0, dsc->header.w - 1, dsc->header.h - 1};
+    lv_area_t area;
+    if(!lv_area_intersect(&area, full_area, &image_area)) return LV_RESULT_INVALID;
+
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? area.y1 : decoded_area->y2 + 1;
+    if(y > area.y2) return LV_RESULT_INVALID;
+
+    if((roi->failed || roi->cinfo.output_scanline > (JDIMENSION)y) && !roi_start(roi)) return LV_RESULT_INVALID;
+
+    bool cmyk = roi->cinfo.out_color_space == JCS_CMYK;
+    lv_color_format_t cf = cmyk ? LV_COLOR_FORMAT_XRGB8888 : LV_COLOR_FORMAT_RGB888;
+    uint32_t px_size = lv_color_format_get_size(cf);
+    int32_t w = lv_area_get_width(&area);
+    int32_t row_cnt = LV_MIN(ROI_ROW_CNT, area.y2 - y + 1);
+    lv_draw_buf_t * decoded = lv_draw_buf_reshape(roi->decoded, cf, w, row_cnt, LV_STRIDE_AUTO);
+    if(decoded == NULL) {
+        if(roi->decoded) lv_draw_buf_destroy(roi->decoded);
+        roi->decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, w, ROI_ROW_CNT, cf, LV_STRIDE_AUTO);
+        if(roi->decoded == NULL) return LV_RESULT_INVALID;
+        decoded = lv_draw_buf_reshape(roi->decoded, cf, w, row_cnt, LV_STRIDE_AUTO);
+    }
+
+    /* Return here on error, and to the caller's setjmp after returning */
+    jmp_buf prev_jb;
+    lv_memcpy(prev_jb, roi->jerr.jb, sizeof(jmp_buf));
+    if(setjmp(roi->jerr.jb)) {
+        LV_LOG_WARN("decoding error");
+        roi->failed = true;
+        lv_memcpy(roi->jerr.jb, prev_jb, sizeof(jmp_buf));
+        return LV_RESULT_INVALID;
+    }
+
+    /* Skip the rows above */
+    if(roi->cinfo.output_scanline < (JDIMENSION)y) {
+        jpeg_skip_scanlines(&roi->cinfo, y - roi->cinfo.output_scanline);
+    }
+
+    JSAMPROW row = roi->row_buf;
+    int32_t i;
+    for(i = 0; i < row_cnt; i++) {
+        jpeg_read_scanlines(&roi->cinfo, &row, 1);
+        if(cmyk) jpeg_cmyk_to_bgrx(roi->row_buf, roi->cinfo.output_width);
+        lv_memcpy(decoded->data + i * decoded->header.stride, roi->row_buf + area.x1 * px_size, w * px_size);
+    }
+
+    decoded_area->x1 = area.x1;
+    decoded_area->x2 = area.x2;
+    decoded_area->y1 = y;
+    decoded_area->y2 = y + row_cnt - 1;
+    dsc->decoded = decoded;
+
+    lv_memcpy(roi->jerr.jb, prev_jb, sizeof(jmp_buf));
+    return LV_RESULT_OK;
+}
+
+/**
+ * Prepare decoding an image row by row. Rotated images can't be decoded row by row.
+ * @param dsc   pointer to the decoder descriptor
+ * @return      LV_RESULT_OK: `dsc->user_data` is set; LV_RESULT_INVALID: decode the whole image
+ */
+static lv_result_t roi_open(lv_image_decoder_dsc_t * dsc)
+{
+    roi_data_t * roi = lv_malloc_zeroed(sizeof(roi_data_t));
+    LV_ASSERT_MALLOC(roi);
+    if(roi == NULL) return LV_RESULT_INVALID;
+
+    if(lv_fs_open(&roi->file, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        lv_free(roi);
+        return LV_RESULT_INVALID;
+    }
+
+    roi->row_buf = lv_malloc(dsc->header.w * sizeof(lv_color32_t));
+    LV_ASSERT_MALLOC(roi->row_buf);
+    if(roi->row_buf == NULL) {
+        roi_close(roi);
+        return LV_RESULT_INVALID;
+    }
+
+    /* The functions called from here set their own return point and restore this one */
+    roi->cinfo.err = jpeg_std_error(&roi->jerr.pub);
+    roi->jerr.pub.error_exit = error_exit;
+    if(setjmp(roi->jerr.jb)) {
+        roi_close(roi);
+        return LV_RESULT_INVALID;
+    }
+
+    jpeg_create_decompress(&roi->cinfo);
+    roi->src.init_source = roi_source_noop;
+    roi->src.fill_input_buffer = roi_fill_input_buffer;
+    roi->src.skip_input_data = roi_skip_input_data;
+    roi->src.resync_to_restart = jpeg_resync_to_restart;
+    roi->src.term_source = roi_source_noop;
+    roi->cinfo.src = &roi->src;
+    jpeg_save_markers(&roi->cinfo, APP1_MARKER, MARKER_DATA_LIMIT);
+
+    if(!roi_start(roi)) {
+        roi_close(roi);
+        return LV_RESULT_INVALID;
+    }
+
+    image_orientation_t orientation = jpeg_markers_reader(&roi->cinfo);
+    if((orientation != IMAGE_CLOCKWISE_NONE && orientation != IMAGE_CLOCKWISE_0) ||
+       roi->cinfo.output_width != dsc->header.w || roi->cinfo.output_height != dsc->header.h) {
+        roi_close(roi);
+        return LV_RESULT_INVALID;
+    }
+
+    dsc->user_data = roi;
+    dsc->cache_tiles = true;
+    dsc->keep_opened = true;
+    return LV_RESULT_OK;
+}
+
+static void roi_close(roi_data_t * roi)
+{
+    jpeg_destroy_decompress(&roi->cinfo);
+    lv_fs_close(&roi->file);
+    if(roi->decoded) lv_draw_buf_destroy(roi->decoded);
+    lv_free(roi->row_buf);
+    lv_free(roi);
+}
+
+/**
+ * (Re)start decoding from the first row
+ * @param roi   the state of decoding
+ * @return      true: the rows can be read; false: error
+ */
+static bool roi_start(roi_data_t * roi)
+{
+    /* Return here on error, and to the caller's setjmp after returning */
+    jmp_buf prev_jb;
+    lv_memcpy(prev_jb, roi->jerr.jb, sizeof(jmp_buf));
+    if(setjmp(roi->jerr.jb)) {
+        LV_LOG_WARN("decoding error");
+        roi->failed = true;
+        lv_memcpy(roi->jerr.jb, prev_jb, sizeof(jmp_buf));
+        return false;
+    }
+
+    jpeg_abort_decompress(&roi->cinfo);
+    lv_fs_seek(&roi->file, 0, LV_FS_SEEK_SET);
+    roi->src.next_input_byte = NULL;
+    roi->src.bytes_in_buffer = 0;
+
+    jpeg_read_header(&roi->cinfo, TRUE);
+    if(roi->cinfo.jpeg_color_space == JCS_CMYK || roi->cinfo.jpeg_color_space == JCS_YCCK) {
+        roi->cinfo.out_color_space = JCS_CMYK;
+    }
+    else {
+        roi->cinfo.out_color_space = JCS_EXT_BGR;
+    }
+
+    jpeg_start_decompress(&roi->cinfo);
+
+    roi->failed = false;
+    lv_memcpy(roi->jerr.jb, prev_jb, sizeof(jmp_buf));
+    return true;
+}
+
+static void roi_source_noop(j_decompress_ptr cinfo)
+{
+    LV_UNUSED(cinfo);
+}
+
+static boolean roi_fill_input_buffer(j_decompress_ptr cinfo)
+{
+    roi_data_t * roi = (roi_data_t *)cinfo;
+    uint32_t rn = 0;
+    lv_fs_read(&roi->file, roi->input_buf, sizeof(roi->input_buf), &rn);
+
+    /* Insert a fake EOI marker at the end of the file as libjpeg does */
+    if(rn == 0) {
+        roi->input_buf[0] = 0xFF;
+        roi->input_buf[1] = JPEG_EOI;
+        rn = 2;
+    }
+
+    roi->src.next_input_byte = roi->input_buf;
+    roi->src.bytes_in_buffer = rn;
+    return TRUE;
+}
+
+static void roi_skip_input_data(j_decompress_ptr cinfo, long num_bytes)
+{
+    roi_data_t * roi = (roi_data_t *)cinfo;
+    if(num_bytes <= 0) return;
+
+    if((size_t)num_bytes > roi->src.bytes_in_buffer) {
+        lv_fs_seek(&roi->file, (uint32_t)(num_bytes - roi->src.bytes_in_buffer), LV_FS_SEEK_CUR);
+        roi->src.bytes_in_buffer = 0;
+    }
+    else {
+        roi->src.next_input_byte += num_bytes;
+        roi->src.bytes_in_buffer -= num_bytes;
+    }
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ROI*/
+
 #endif /*LV_USE_LIBJPEG_TURBO*/
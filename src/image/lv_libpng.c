@@ -12,6 +12,7 @@
 #if LV_USE_LIBPNG
 
 #include "lv_image_decoder_private.h"
+#include "../misc/lv_area_private.h"
 #include <png.h>
 #include <string.h>
 #include "../core/lv_global.h"
@@ -24,10 +25,27 @@
 
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
+#define ROI_ROW_CNT     16  /*Rows to return at once from `decoder_get_area`*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_IMAGE_DECODER_ROI
+/*State of decoding a large image row by row*/
+typedef struct {
+    lv_fs_file_t file;          /*Used for files*/
+    const uint8_t * data;       /*Used for variables*/
+    uint32_t data_size;
+    uint32_t data_pos;
+    png_structp png;
+    png_infop info;
+    uint8_t * row_buf;          /*A row in full width*/
+    lv_draw_buf_t * decoded;    /*The rows returned by `decoder_get_area`*/
+    int32_t next_row;           /*The row `png_read_row` reads next*/
+} roi_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -35,6 +53,14 @@ static lv_result_t decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_d
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_draw_buf_t * decode_png(lv_image_decoder_dsc_t * dsc);
+#if LV_USE_IMAGE_DECODER_ROI
+    static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                        const lv_area_t * full_area, lv_area_t * decoded_area);
+    static lv_result_t roi_open(lv_image_decoder_dsc_t * dsc);
+    static void roi_close(roi_data_t * roi);
+    static bool roi_start(roi_data_t * roi);
+    static void roi_read_cb(png_structp png, png_bytep buf, size_t len);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -57,6 +83,9 @@ void lv_libpng_init(void)
     lv_image_decoder_set_info_cb(dec, decoder_info);
     lv_image_decoder_set_open_cb(dec, decoder_open);
     lv_image_decoder_set_close_cb(dec, decoder_close);
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
+#endif
 
     dec->name = DECODER_NAME;
 }
@@ -140,6 +169,13 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 {
     LV_UNUSED(decoder); /*Unused*/
 
+#if LV_USE_IMAGE_DECODER_ROI
+    /*Decode only the drawn areas of the large images in `decoder_get_area`*/
+    if(!dsc->args.use_indexed && lv_image_decoder_use_roi(dsc) && roi_open(dsc) == LV_RESULT_OK) {
+        return LV_RESULT_OK;
+    }
+#endif
+
     lv_draw_buf_t * decoded;
     decoded = decode_png(dsc);
 
@@ -174,6 +210,8 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     lv_image_cache_data_t search_key;
     search_key.src_type = dsc->src_type;
     search_key.src = dsc->src;
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+    search_key.tile = 0;
     search_key.slot.size = decoded->data_size;
 
     lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
@@ -194,6 +232,14 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder); /*Unused*/
 
+#if LV_USE_IMAGE_DECODER_ROI
+    if(dsc->user_data) {
+        roi_close(dsc->user_data);
+        dsc->user_data = NULL;
+        return;
+    }
+#endif
+
     if(dsc->args.no_cache ||
        !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
 }
@@ -292,4 +338,182 @@ static lv_draw_buf_t * decode_png(lv_image_decoder_dsc_t * dsc)
     return decoded;
 }
 
+#if LV_USE_IMAGE_DECODER_ROI
+
+/**
+ * Decode an area of a large image. The rows are decoded from top to bottom so the decoding
+ * starts over only if the area is above the last decoded row.
+ * @param decoder       pointer to the decoder
+ * @param dsc           pointer to the decoder descriptor
+ * @param full_area     the area of the image to decode
+ * @param decoded_area  the rows decoded at last, initially `LV_COORD_MIN`. Set to the next rows.
+ * @return              LV_RESULT_OK: the next rows are in `dsc->decoded`; LV_RESULT_INVALID: no more rows
+ */
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area)
+{
+    LV_UNUSED(decoder);
+    roi_data_t * roi = dsc->user_data;
+    LV_CHECK_ARG(roi, return LV_RESULT_INVALID, "decoder data unavailable");
+
+    lv_area_t image_area = {0, 0, dsc->header.w - 1, dsc->header.h - 1};
+    lv_area_t area;
+    if(!lv_area_intersect(&area, full_area, &image_area)) return LV_RESULT_INVALID;
+
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? area.y1 : decoded_area->y2 + 1;
+    if(y > area.y2) return LV_RESULT_INVALID;
+
+    if(roi->next_row > y && !roi_start(roi)) return LV_RESULT_INVALID;
+
+    int32_t w = lv_area_get_width(&area);
+    int32_t row_cnt = LV_MIN(ROI_ROW_CNT, area.y2 - y + 1);
+    lv_draw_buf_t * decoded = lv_draw_buf_reshape(roi->decoded, LV_COLOR_FORMAT_ARGB8888, w, row_cnt, LV_STRIDE_AUTO);
+    if(decoded == NULL) {
+        if(roi->decoded) lv_draw_buf_destroy(roi->decoded);
+        roi->decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, w, ROI_ROW_CNT, LV_COLOR_FORMAT_ARGB8888,
+                                             LV_STRIDE_AUTO);
+        if(roi->decoded == NULL) return LV_RESULT_INVALID;
+        decoded = lv_draw_buf_reshape(roi->decoded, LV_COLOR_FORMAT_ARGB8888, w, row_cnt, LV_STRIDE_AUTO);
+    }
+
+    if(setjmp(png_jmpbuf(roi->png))) {
+        LV_LOG_WARN("png decode failed");
+        /*Start over next time*/
+        roi->next_row = INT32_MAX;
+        return LV_RESULT_INVALID;
+    }
+
+    /*Skip the rows above*/
+    while(roi->next_row < y) {
+        png_read_row(roi->png, roi->row_buf, NULL);
+        roi->next_row++;
+    }
+
+    int32_t i;
+    for(i = 0; i < row_cnt; i++) {
+        png_read_row(roi->png, roi->row_buf, NULL);
+        roi->next_row++;
+        lv_memcpy(decoded->data + i * decoded->header.stride, roi->row_buf + area.x1 * sizeof(lv_color32_t),
+                  w * sizeof(lv_color32_t));
+    }
+
+    decoded_area->x1 = area.x1;
+    decoded_area->x2 = area.x2;
+    decoded_area->y1 = y;
+    decoded_area->y2 = y + row_cnt - 1;
+    dsc->decoded = decoded;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Prepare decoding an image row by row. Interlaced images can't be decoded row by row.
+ * @param dsc   pointer to the decoder descriptor
+ * @return      LV_RESULT_OK: `dsc->user_data` is set; LV_RESULT_INVALID: decode the whole image
+ */
+static lv_result_t roi_open(lv_image_decoder_dsc_t * dsc)
+{
+    roi_data_t * roi = lv_malloc_zeroed(sizeof(roi_data_t));
+    LV_ASSERT_MALLOC(roi);
+    if(roi == NULL) return LV_RESULT_INVALID;
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        if(lv_fs_open(&roi->file, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            lv_free(roi);
+            return LV_RESULT_INVALID;
+        }
+    }
+    else {
+        const lv_image_dsc_t * img_dsc = dsc->src;
+        roi->data = img_dsc->data;
+        roi->data_size = img_dsc->data_size;
+    }
+
+    roi->row_buf = lv_malloc(dsc->header.w * sizeof(lv_color32_t));
+    LV_ASSERT_MALLOC(roi->row_buf);
+    if(roi->row_buf == NULL || !roi_start(roi)) {
+        roi_close(roi);
+        return LV_RESULT_INVALID;
+    }
+
+    dsc->user_data = roi;
+    dsc->cache_tiles = true;
+    dsc->keep_opened = true;
+    return LV_RESULT_OK;
+}
+
+static void roi_close(roi_data_t * roi)
+{
+    if(roi->png) png_destroy_read_struct(&roi->png, &roi->info, NULL);
+    if(roi->data == NULL) lv_fs_close(&roi->file);
+    if(roi->decoded) lv_draw_buf_destroy(roi->decoded);
+    lv_free(roi->row_buf);
+    lv_free(roi);
+}
+
+/**
+ * (Re)start decoding from the first row
+ * @param roi   the state of decoding
+ * @return      true: the rows can be read; false: error or interlaced image
+ */
+static bool roi_start(roi_data_t * roi)
+{
+    if(roi->png) png_destroy_read_struct(&roi->png, &roi->info, NULL);
+
+    if(roi->data) roi->data_pos = 0;
+    else lv_fs_seek(&roi->file, 0, LV_FS_SEEK_SET);
+
+    roi->png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if(roi->png == NULL) return false;
+
+    roi->info = png_create_info_struct(roi->png);
+    if(roi->info == NULL) {
+        png_destroy_read_struct(&roi->png, NULL, NULL);
+        return false;
+    }
+
+    if(setjmp(png_jmpbuf(roi->png))) {
+        LV_LOG_WARN("png read failed");
+        png_destroy_read_struct(&roi->png, &roi->info, NULL);
+        return false;
+    }
+
+    png_set_read_fn(roi->png, roi, roi_read_cb);
+    png_read_info(roi->png, roi->info);
+
+    if(png_get_interlace_type(roi->png, roi->info) != PNG_INTERLACE_NONE) {
+        png_destroy_read_struct(&roi->png, &roi->info, NULL);
+        return false;
+    }
+
+    /*Convert to 8 bit BGRA in sRGB as `png_image_finish_read` does*/
+    png_set_alpha_mode(roi->png, PNG_ALPHA_PNG, PNG_DEFAULT_sRGB);
+    png_set_expand(roi->png);
+    png_set_scale_16(roi->png);
+    png_set_gray_to_rgb(roi->png);
+    png_set_add_alpha(roi->png, 0xff, PNG_FILLER_AFTER);
+    png_set_bgr(roi->png);
+    png_read_update_info(roi->png, roi->info);
+
+    roi->next_row = 0;
+    return true;
+}
+
+static void roi_read_cb(png_structp png, png_bytep buf, size_t len)
+{
+    roi_data_t * roi = png_get_io_ptr(png);
+    if(roi->data) {
+        if(len > roi->data_size - roi->data_pos) png_error(png, "unexpected end of data");
+        lv_memcpy(buf, roi->data + roi->data_pos, len);
+        roi->data_pos += len;
+    }
+    else {
+        uint32_t rn;
+        lv_fs_res_t res = lv_fs_read(&roi->file, buf, len, &rn);
+        if(res != LV_FS_RES_OK || rn != len) png_error(png, "unexpected end of file");
+    }
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ROI*/
+
 #endif /*LV_USE_LIBPNG*/
@@ -12,6 +12,7 @@
 #if LV_USE_LIBWEBP
 
 #include "lv_image_decoder_private.h"
+#include "../misc/lv_area_private.h"
 #include <webp/decode.h>
 #include "../core/lv_global.h"
 
@@ -29,6 +30,17 @@
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_IMAGE_DECODER_ROI
+/* The compressed data of a large image kept to decode its areas */
+typedef struct {
+    lv_fs_map_t map; /* Set if the file could be mapped */
+    uint8_t * loaded; /* Set if the file was loaded to RAM */
+    const uint8_t * data;
+    uint32_t data_size;
+    lv_draw_buf_t * decoded; /* The area returned by `decoder_get_area` */
+} roi_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -37,6 +49,12 @@ static lv_result_t decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_d
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_draw_buf_t * decode_webp_file(lv_image_decoder_dsc_t * dsc, const char * filename);
+#if LV_USE_IMAGE_DECODER_ROI
+    static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                        const lv_area_t * full_area, lv_area_t * decoded_area);
+    static lv_result_t roi_open(lv_image_decoder_dsc_t * dsc);
+    static void roi_close(roi_data_t * roi);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -59,6 +77,9 @@ void lv_libwebp_init(void)
     lv_image_decoder_set_info_cb(dec, decoder_info);
     lv_image_decoder_set_open_cb(dec, decoder_open);
     lv_image_decoder_set_close_cb(dec, decoder_close);
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
+#endif
 
     dec->name = DECODER_NAME;
 }
@@ -133,6 +154,11 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
     /*If it's a webp file...*/
     if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+#if LV_USE_IMAGE_DECODER_ROI
+        /*Decode only the drawn areas of the large images in `decoder_get_area`*/
+        if(lv_image_decoder_use_roi(dsc) && roi_open(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
+#endif
+
         const char * fn = dsc->src;
         lv_draw_buf_t * decoded = decode_webp_file(dsc, fn);
         if(decoded == NULL) {
@@ -165,6 +191,8 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         lv_image_cache_data_t search_key;
         search_key.src_type = dsc->src_type;
         search_key.src = dsc->src;
+        search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+        search_key.tile = 0;
         search_key.slot.size = decoded->data_size;
 
         lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
@@ -188,6 +216,14 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder); /*Unused*/
 
+#if LV_USE_IMAGE_DECODER_ROI
+    if(dsc->user_data) {
+        roi_close(dsc->user_data);
+        dsc->user_data = NULL;
+        return;
+    }
+#endif
+
     if(dsc->args.no_cache ||
        !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
 }
@@ -238,4 +274,118 @@ static lv_draw_buf_t * decode_webp_file(lv_image_decoder_dsc_t * dsc, const char
     return decoded;
 }
 
+#if LV_USE_IMAGE_DECODER_ROI
+
+/**
+ * Decode an area of a large image using the cropping of libwebp.
+ * The whole area is decoded at once as the rows above it needs to be parsed anyway.
+ * @param decoder       pointer to the decoder
+ * @param dsc           pointer to the decoder descriptor
+ * @param full_area     the area of the image to decode
+ * @param decoded_area  `LV_COORD_MIN` initially. Set to the decoded area.
+ * @return              LV_RESULT_OK: the area is in `dsc->decoded`; LV_RESULT_INVALID: no more areas
+ */
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area)
+{
+    LV_UNUSED(decoder);
+    roi_data_t * roi = dsc->user_data;
+    LV_CHECK_ARG(roi, return LV_RESULT_INVALID, "decoder data unavailable");
+
+    /*The whole area is returned by the first call*/
+    if(decoded_area->y1 != LV_COORD_MIN) return LV_RESULT_INVALID;
+
+    lv_area_t image_area = {0, 0, dsc->header.w - 1, dsc->header.h - 1};
+    lv_area_t area;
+    if(!lv_area_intersect(&area, full_area, &image_area)) return LV_RESULT_INVALID;
+
+    /*Some versions of libwebp can crop only from even coordinates*/
+    area.x1 &= ~1;
+    area.y1 &= ~1;
+
+    int32_t w = lv_area_get_width(&area);
+    int32_t h = lv_area_get_height(&area);
+    if(roi->decoded) lv_draw_buf_destroy(roi->decoded);
+    roi->decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if(roi->decoded == NULL) return LV_RESULT_INVALID;
+
+    WebPDecoderConfig config;
+    WebPInitDecoderConfig(&config);
+
+    config.options.use_cropping = 1;
+    config.options.crop_left = area.x1;
+    config.options.crop_top = area.y1;
+    config.options.crop_width = w;
+    config.options.crop_height = h;
+
+    config.output.colorspace = MODE_BGRA;
+    config.output.u.RGBA.rgba = (uint8_t *) roi->decoded->data;
+    config.output.u.RGBA.stride = roi->decoded->header.stride;
+    config.output.u.RGBA.size = roi->decoded->data_size;
+    config.output.is_external_memory = 1;
+
+    LV_PROFILER_DECODER_BEGIN_TAG("WebPDecode");
+    int status = WebPDecode(roi->data, roi->data_size, &config);
+    LV_PROFILER_DECODER_END_TAG("WebPDecode");
+
+    if(status != VP8_STATUS_OK) {
+        LV_LOG_WARN("decode webp area failed, status: %d", status);
+        return LV_RESULT_INVALID;
+    }
+
+    *decoded_area = area;
+    dsc->decoded = roi->decoded;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Keep the compressed data of a large image to decode its areas later
+ * @param dsc   pointer to the decoder descriptor
+ * @return      LV_RESULT_OK: `dsc->user_data` is set; LV_RESULT_INVALID: decode the whole image
+ */
+static lv_result_t roi_open(lv_image_decoder_dsc_t * dsc)
+{
+    roi_data_t * roi = lv_malloc_zeroed(sizeof(roi_data_t));
+    LV_ASSERT_MALLOC(roi);
+    if(roi == NULL) return LV_RESULT_INVALID;
+
+    /*Prefer mapping the file to keeping it in RAM*/
+    lv_fs_file_t file;
+    if(lv_fs_open(&file, dsc->src, LV_FS_MODE_RD) == LV_FS_RES_OK) {
+        uint32_t size = 0;
+        if(lv_fs_seek(&file, 0, LV_FS_SEEK_END) == LV_FS_RES_OK && lv_fs_tell(&file, &size) == LV_FS_RES_OK &&
+           size > 0 && lv_fs_map(&file, 0, size, &roi->map) == LV_FS_RES_OK) {
+            roi->data = roi->map.data;
+            roi->data_size = roi->map.size;
+        }
+        lv_fs_close(&file);
+    }
+
+    if(roi->data == NULL) {
+        roi->loaded = lv_fs_load_with_alloc(dsc->src, &roi->data_size);
+        roi->data = roi->loaded;
+    }
+
+    if(roi->data == NULL) {
+        lv_free(roi);
+        return LV_RESULT_INVALID;
+    }
+
+    dsc->user_data = roi;
+    dsc->cache_tiles = true;
+    dsc->keep_opened = true;
+    return LV_RESULT_OK;
+}
+
+static void roi_close(roi_data_t * roi)
+{
+    if(roi->map.data) lv_fs_unmap(&roi->map);
+    lv_free(roi->loaded);
+    if(roi->decoded) lv_draw_buf_destroy(roi->decoded);
+    lv_free(roi);
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ROI*/
+
 #endif /*LV_USE_LIBWEBP*/
@@ -260,6 +260,8 @@ static lv_result_t svg_decoder_open(lv_image_decoder_t * decoder, lv_image_decod
         lv_image_cache_data_t search_key;
         search_key.src_type = dsc->src_type;
         search_key.src = dsc->src;
+        search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+        search_key.tile = 0;
         search_key.slot.size = dsc->decoded->data_size;
 
         lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, draw_buf, NULL);
@@ -22,6 +22,8 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static uint8_t * fill_run(uint8_t * output, const uint8_t * pixel, uint32_t blk_size, uint32_t cnt);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -79,24 +81,11 @@ uint32_t lv_rle_decompress(const uint8_t * input,
                     return 0; /* Error happened */
 
                 /* Skip the last pixel, which could overflow output buffer.*/
-                for(uint32_t i = 0; i < ctrl_byte - 1; i++) {
-                    lv_memcpy(output, input, blk_size);
-                    output += blk_size;
-                }
+                if(ctrl_byte > 1) fill_run(output, input, blk_size, ctrl_byte - 1);
                 return output_buff_len;
             }
 
-            if(blk_size == 1) {
-                /* optimize the most common case. */
-                lv_memset(output, input[0], ctrl_byte);
-                output += ctrl_byte;
-            }
-            else {
-                for(uint32_t i = 0; i < ctrl_byte; i++) {
-                    lv_memcpy(output, input, blk_size);
-                    output += blk_size;
-                }
-            }
+            if(ctrl_byte) output = fill_run(output, input, blk_size, ctrl_byte);
             input += blk_size;
         }
     }
@@ -108,4 +97,33 @@ uint32_t lv_rle_decompress(const uint8_t * input,
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Repeat a pixel `cnt` times
+ * @param output    write the pixels here
+ * @param pixel     the pixel to repeat
+ * @param blk_size  size of the pixel in bytes
+ * @param cnt       number of pixels to write, > 0
+ * @return          pointer after the last written pixel
+ */
+static uint8_t * fill_run(uint8_t * output, const uint8_t * pixel, uint32_t blk_size, uint32_t cnt)
+{
+    uint32_t len = blk_size * cnt;
+    if(blk_size == 1) {
+        /* optimize the most common case. */
+        lv_memset(output, pixel[0], len);
+        return output + len;
+    }
+
+    /* Copy the pixels already written doubling the copied size to use the wide copies of `lv_memcpy`*/
+    lv_memcpy(output, pixel, blk_size);
+    uint32_t done = blk_size;
+    while(done < len) {
+        uint32_t copy = LV_MIN(done, len - done);
+        lv_memcpy(output + done, output, copy);
+        done += copy;
+    }
+
+    return output + len;
+}
+
 #endif /*LV_USE_RLE*/
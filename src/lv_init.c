@@ -123,11 +123,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -199,6 +194,10 @@ void lv_init(void)
 
     lv_group_init();
 
+#if LV_USE_FONT_FMT_TXT_CACHE
+    lv_font_fmt_txt_cache_init();
+#endif
+
 #if LV_USE_FREETYPE
     /* Since the drawing unit needs to register the freetype event,
      * initialize the freetype module first
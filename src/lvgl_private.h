@@ -86,6 +86,17 @@
 #include "draw/sw/blend/riscv_v/lv_blend_riscv_v_private.h"
 #include "draw/sw/blend/riscv_v/lv_blend_riscv_vector_emulation.h"
 #include "draw/sw/blend/riscv_v/lv_draw_sw_blend_riscv_v_to_rgb888.h"
+#include "draw/sw/blend/simd/lv_blend_simd.h"
+#include "draw/sw/blend/simd/lv_draw_sw_blend_simd_to_a8.h"
+#include "draw/sw/blend/simd/lv_draw_sw_blend_simd_to_argb8888.h"
+#include "draw/sw/blend/simd/lv_draw_sw_blend_simd_to_l8.h"
+#include "draw/sw/blend/simd/lv_draw_sw_blend_simd_to_rgb565.h"
+#include "draw/sw/blend/simd/lv_draw_sw_blend_simd_to_rgb888.h"
+#include "draw/sw/blend/x86/lv_blend_x86.h"
+#include "draw/sw/blend/x86/lv_blend_x86_private.h"
+#include "draw/sw/blend/x86/lv_draw_sw_blend_x86_to_argb8888.h"
+#include "draw/sw/blend/x86/lv_draw_sw_blend_x86_to_rgb565.h"
+#include "draw/sw/blend/x86/lv_draw_sw_blend_x86_to_rgb888.h"
 #include "draw/sw/lv_draw_sw.h"
 #include "draw/sw/lv_draw_sw_grad.h"
 #include "draw/sw/lv_draw_sw_mask.h"
@@ -146,6 +157,7 @@
 #include "image/svg/lv_svg_parser.h"
 #include "image/svg/lv_svg_render.h"
 #include "image/svg/lv_svg_token.h"
+#include "misc/cache/class/lv_cache_2q.h"
 #include "misc/cache/class/lv_cache_class.h"
 #include "misc/cache/class/lv_cache_lru_ll.h"
 #include "misc/cache/class/lv_cache_lru_rb.h"
@@ -166,6 +178,7 @@
 #include "misc/lv_iter_private.h"
 #include "misc/lv_lru.h"
 #include "misc/lv_pending.h"
+#include "misc/lv_region_private.h"
 #include "misc/lv_rb_private.h"
 #include "misc/lv_text_ap.h"
 #include "misc/lv_text_private.h"
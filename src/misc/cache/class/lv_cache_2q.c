@@ -0,0 +1,610 @@
+/**
+* @file lv_cache_2q.c
+*
+*/
+
+/***************************************************************************\
+*                                                                           *
+*   new entry       ┌ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┐   evicted                 *
+*  ────────────────▶  A1in (FIFO, ~25% of size)    ─────────┐               *
+*                   └ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┘         │ key hash      *
+*                                                           ▼               *
+*                                              ┌ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┐      *
+*                                                A1out (hashes only)        *
+*                                              └ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┘      *
+*   added again while                                       │               *
+*   its hash is in A1out    ┌ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┐    │               *
+*  ◀───────────────────────   Am (LRU)                  ◀───┘               *
+*                           └ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┘                   *
+*                                                                           *
+\***************************************************************************/
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_cache_2q.h"
+#include "../lv_cache_entry.h"
+#include "../../../lvgl_public.h"
+#include "../../lv_rb_private.h"
+#include "../../lv_iter_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Share of A1in from the max size in percentage*/
+#define IN_QUEUE_PERCENT        25
+
+/*Number of unreferenced entries from the end of a queue to choose the cheapest victim from*/
+#define VICTIM_CANDIDATE_CNT    4
+
+/*Keep at least this many hashes in A1out, even if the cache has fewer entries*/
+#define GHOST_MIN_CNT           8
+
+/*An entry can be spared this many times at most, as its cost is halved each time*/
+#define SKIP_CNT_MAX            31
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint32_t (get_data_size_cb_t)(const void * data);
+
+typedef enum {
+    QUEUE_IN,
+    QUEUE_MAIN,
+} queue_t;
+
+/*Stored after the cache entry in the data of the RB tree nodes*/
+typedef struct {
+    lv_rb_node_t ** ll_node;        /**< The node in `in_ll` or `main_ll` */
+    uint8_t queue;                  /**< One of `queue_t` */
+    uint8_t skip_cnt;               /**< Number of times it wasn't evicted because it's more expensive */
+} node_info_t;
+
+typedef struct {
+    lv_rb_node_t ** ll_node;
+    bool in_queue;
+} iter_context_t;
+
+struct _lv_cache_2q_t {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t in_ll;                  /**< A1in: FIFO of the entries added recently */
+    lv_ll_t main_ll;                /**< Am: LRU of the entries added again after eviction from A1in */
+    lv_ll_t ghost_ll;               /**< A1out: hash of the keys evicted from A1in */
+
+    uint32_t in_size;
+    uint32_t entry_cnt;
+    uint32_t ghost_cnt;
+
+    get_data_size_cb_t * get_data_size_cb;
+};
+typedef struct _lv_cache_2q_t lv_cache_2q_t_;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cnt_cb(lv_cache_t * cache);
+static bool init_size_cb(lv_cache_t * cache);
+static void destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static bool init_common(lv_cache_2q_t_ * q, get_data_size_cb_t * get_data_size_cb);
+static node_info_t * get_node_info(lv_cache_2q_t_ * q, lv_rb_node_t * node);
+static bool insert_to_queue(lv_cache_2q_t_ * q, lv_rb_node_t * node, queue_t queue);
+static void remove_from_queue(lv_cache_2q_t_ * q, lv_rb_node_t * node);
+static lv_rb_node_t * get_cheapest_candidate(lv_cache_2q_t_ * q, lv_ll_t * ll);
+static bool is_cheaper(lv_cache_2q_t_ * q, lv_rb_node_t * a, lv_rb_node_t * b);
+static void add_ghost(lv_cache_2q_t_ * q, const void * data);
+static bool remove_ghost(lv_cache_2q_t_ * q, const void * key);
+
+static uint32_t cnt_get_data_size_cb(const void * data);
+static uint32_t size_get_data_size_cb(const void * data);
+
+static lv_iter_t * cache_iter_create_cb(lv_cache_t * cache);
+static lv_result_t cache_iter_next_cb(void * instance, void * context, void * elem);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_2q_count = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cnt_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .iter_create_cb = cache_iter_create_cb,
+};
+
+const lv_cache_class_t lv_cache_class_2q_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .iter_create_cb = cache_iter_create_cb,
+};
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_cache_2q_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_cache_2q_t_));
+    return res;
+}
+
+static bool init_cnt_cb(lv_cache_t * cache)
+{
+    return init_common((lv_cache_2q_t_ *)cache, cnt_get_data_size_cb);
+}
+
+static bool init_size_cb(lv_cache_t * cache)
+{
+    return init_common((lv_cache_2q_t_ *)cache, size_get_data_size_cb);
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+
+    if(cache == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(key);
+
+    if(q == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&q->rb, key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    node_info_t * info = get_node_info(q, node);
+    info->skip_cnt = 0;
+
+    /* The hits in A1in are usually correlated (e.g. the same image drawn in each frame while
+     * scrolling), so the entry stays there. Without hashes there is no A1out to detect the
+     * reuse of the entries evicted from A1in, so promote on the hit instead.*/
+    if(info->queue == QUEUE_MAIN) {
+        lv_ll_move_before(&q->main_ll, info->ll_node, lv_ll_get_head(&q->main_ll));
+    }
+    else if(cache->hash_cb == NULL) {
+        remove_from_queue(q, node);
+        insert_to_queue(q, node, QUEUE_MAIN);
+    }
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(key);
+
+    if(q == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&q->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    lv_memcpy(node->data, key, cache->node_size);
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+
+    /*Used again shortly after it was evicted from A1in*/
+    queue_t queue = remove_ghost(q, key) ? QUEUE_MAIN : QUEUE_IN;
+    if(!insert_to_queue(q, node, queue)) {
+        lv_rb_drop_node(&q->rb, node);
+        return NULL;
+    }
+
+    lv_cache_entry_init(entry, cache, cache->node_size);
+    cache->size += q->get_data_size_cb(key);
+    q->entry_cnt++;
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(entry);
+
+    if(q == NULL || entry == NULL) {
+        return;
+    }
+
+    void * data = lv_cache_entry_get_data(entry);
+    lv_rb_node_t * node = lv_rb_find(&q->rb, data);
+    if(node == NULL) {
+        return;
+    }
+
+    remove_from_queue(q, node);
+    lv_rb_remove_node(&q->rb, node);
+
+    cache->size -= q->get_data_size_cb(data);
+    q->entry_cnt--;
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(key);
+
+    if(q == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&q->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+
+    cache->ops.free_cb(data, user_data);
+    cache->size -= q->get_data_size_cb(data);
+    q->entry_cnt--;
+
+    remove_from_queue(q, node);
+    lv_rb_remove_node(&q->rb, node);
+    lv_cache_entry_delete(lv_cache_entry_get_entry(data, cache->node_size));
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+
+    if(q == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    lv_ll_t * lls[] = {&q->in_ll, &q->main_ll};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_rb_node_t ** node;
+        LV_LL_READ(lls[i], node) {
+            /*free user handled data and do other clean up*/
+            void * search_key = (*node)->data;
+            lv_cache_entry_t * entry = lv_cache_entry_get_entry(search_key, cache->node_size);
+            if(lv_cache_entry_get_ref(entry) == 0) {
+                cache->ops.free_cb(search_key, user_data);
+            }
+            else {
+                LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+                used_cnt++;
+            }
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&q->rb);
+    lv_ll_clear(&q->in_ll);
+    lv_ll_clear(&q->main_ll);
+    lv_ll_clear(&q->ghost_ll);
+
+    q->in_size = 0;
+    q->entry_cnt = 0;
+    q->ghost_cnt = 0;
+    cache->size = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+
+    /*Evict from A1in while it's over its share, so the new entries can't flush out Am.
+     *The share is of the current size, as a shard of a sharded cache may use only a part of max_size*/
+    bool in_full = q->in_size > (uint64_t)cache->size * IN_QUEUE_PERCENT / 100;
+
+    lv_rb_node_t * victim = in_full ? get_cheapest_candidate(q, &q->in_ll) : NULL;
+    if(victim == NULL) victim = get_cheapest_candidate(q, &q->main_ll);
+    if(victim == NULL && !in_full) victim = get_cheapest_candidate(q, &q->in_ll);
+    if(victim == NULL) {
+        return NULL;
+    }
+
+    /*The caller evicts the victim, remember it to detect if it's added again soon*/
+    if(get_node_info(q, victim)->queue == QUEUE_IN) {
+        add_ghost(q, victim->data);
+    }
+
+    return lv_cache_entry_get_entry(victim->data, cache->node_size);
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+
+    if(q == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? q->get_data_size_cb(key) : 0;
+    if(data_size > cache->max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, cache->max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > cache->max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static bool init_common(lv_cache_2q_t_ * q, get_data_size_cb_t * get_data_size_cb)
+{
+    LV_ASSERT_NULL(q->cache.ops.compare_cb);
+    LV_ASSERT_NULL(q->cache.ops.free_cb);
+    LV_ASSERT(q->cache.node_size > 0);
+
+    if(q->cache.node_size <= 0 || q->cache.ops.compare_cb == NULL || q->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*add the node info after the entry*/
+    if(!lv_rb_init(&q->rb, q->cache.ops.compare_cb, lv_cache_entry_get_size(q->cache.node_size) + sizeof(node_info_t))) {
+        return false;
+    }
+    lv_ll_init(&q->in_ll, sizeof(lv_rb_node_t *));
+    lv_ll_init(&q->main_ll, sizeof(lv_rb_node_t *));
+    lv_ll_init(&q->ghost_ll, sizeof(uint32_t));
+
+    q->get_data_size_cb = get_data_size_cb;
+
+    return true;
+}
+
+static node_info_t * get_node_info(lv_cache_2q_t_ * q, lv_rb_node_t * node)
+{
+    return (node_info_t *)((uint8_t *)node->data + lv_cache_entry_get_size(q->cache.node_size));
+}
+
+static bool insert_to_queue(lv_cache_2q_t_ * q, lv_rb_node_t * node, queue_t queue)
+{
+    lv_rb_node_t ** ll_node = lv_ll_ins_head(queue == QUEUE_IN ? &q->in_ll : &q->main_ll);
+    if(ll_node == NULL) {
+        return false;
+    }
+
+    *ll_node = node;
+
+    node_info_t * info = get_node_info(q, node);
+    info->ll_node = ll_node;
+    info->queue = queue;
+    info->skip_cnt = 0;
+
+    if(queue == QUEUE_IN) q->in_size += q->get_data_size_cb(node->data);
+
+    return true;
+}
+
+static void remove_from_queue(lv_cache_2q_t_ * q, lv_rb_node_t * node)
+{
+    node_info_t * info = get_node_info(q, node);
+    if(info->queue == QUEUE_IN) {
+        lv_ll_remove(&q->in_ll, info->ll_node);
+        q->in_size -= q->get_data_size_cb(node->data);
+    }
+    else {
+        lv_ll_remove(&q->main_ll, info->ll_node);
+    }
+
+    lv_free(info->ll_node);
+    info->ll_node = NULL;
+}
+
+/**
+ * Choose the victim from the oldest unreferenced entries of a queue. The more expensive
+ * candidates are spared, but their cost is halved each time so that they can't stay forever.
+ */
+static lv_rb_node_t * get_cheapest_candidate(lv_cache_2q_t_ * q, lv_ll_t * ll)
+{
+    lv_rb_node_t * candidates[VICTIM_CANDIDATE_CNT];
+    uint32_t candidate_cnt = 0;
+    lv_rb_node_t * victim = NULL;
+
+    lv_rb_node_t ** ll_node;
+    LV_LL_READ_BACK(ll, ll_node) {
+        lv_rb_node_t * node = *ll_node;
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, q->cache.node_size);
+        if(lv_cache_entry_get_ref(entry) != 0) continue;
+
+        candidates[candidate_cnt] = node;
+        candidate_cnt++;
+        if(victim == NULL || is_cheaper(q, node, victim)) victim = node;
+        if(candidate_cnt == VICTIM_CANDIDATE_CNT) break;
+    }
+
+    uint32_t i;
+    for(i = 0; i < candidate_cnt; i++) {
+        node_info_t * info = get_node_info(q, candidates[i]);
+        if(info->skip_cnt < SKIP_CNT_MAX && is_cheaper(q, victim, candidates[i])) info->skip_cnt++;
+    }
+
+    return victim;
+}
+
+/**
+ * Compare the cost per size of two entries. Entries without a cost are considered as
+ * cheap as possible, so the larger entries go first as they free more space.
+ */
+static bool is_cheaper(lv_cache_2q_t_ * q, lv_rb_node_t * a, lv_rb_node_t * b)
+{
+    uint32_t node_size = q->cache.node_size;
+    lv_cache_entry_t * entry_a = lv_cache_entry_get_entry(a->data, node_size);
+    lv_cache_entry_t * entry_b = lv_cache_entry_get_entry(b->data, node_size);
+
+    uint64_t cost_a = ((uint64_t)lv_cache_entry_get_cost(entry_a) + 1) >> get_node_info(q, a)->skip_cnt;
+    uint64_t cost_b = ((uint64_t)lv_cache_entry_get_cost(entry_b) + 1) >> get_node_info(q, b)->skip_cnt;
+
+    return cost_a * q->get_data_size_cb(b->data) < cost_b * q->get_data_size_cb(a->data);
+}
+
+static void add_ghost(lv_cache_2q_t_ * q, const void * data)
+{
+    if(q->cache.hash_cb == NULL) {
+        return;
+    }
+
+    uint32_t * hash = lv_ll_ins_head(&q->ghost_ll);
+    if(hash == NULL) {
+        return;
+    }
+
+    *hash = q->cache.hash_cb(data);
+    q->ghost_cnt++;
+
+    /*Remember about as many evicted entries as many are in the cache*/
+    uint32_t ghost_max = LV_MAX(q->entry_cnt, GHOST_MIN_CNT);
+    while(q->ghost_cnt > ghost_max) {
+        void * tail = lv_ll_get_tail(&q->ghost_ll);
+        lv_ll_remove(&q->ghost_ll, tail);
+        lv_free(tail);
+        q->ghost_cnt--;
+    }
+}
+
+static bool remove_ghost(lv_cache_2q_t_ * q, const void * key)
+{
+    if(q->cache.hash_cb == NULL || q->ghost_cnt == 0) {
+        return false;
+    }
+
+    uint32_t key_hash = q->cache.hash_cb(key);
+    uint32_t * hash;
+    LV_LL_READ(&q->ghost_ll, hash) {
+        if(*hash == key_hash) {
+            lv_ll_remove(&q->ghost_ll, hash);
+            lv_free(hash);
+            q->ghost_cnt--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint32_t cnt_get_data_size_cb(const void * data)
+{
+    LV_UNUSED(data);
+    return 1;
+}
+
+static uint32_t size_get_data_size_cb(const void * data)
+{
+    lv_cache_slot_size_t * slot = (lv_cache_slot_size_t *)data;
+    return slot->size;
+}
+
+static lv_iter_t * cache_iter_create_cb(lv_cache_t * cache)
+{
+    return lv_iter_create(cache, lv_cache_entry_get_size(cache->node_size), sizeof(iter_context_t), cache_iter_next_cb);
+}
+
+static lv_result_t cache_iter_next_cb(void * instance, void * context, void * elem)
+{
+    lv_cache_2q_t_ * q = (lv_cache_2q_t_ *)instance;
+    iter_context_t * ctx = context;
+
+    LV_ASSERT_NULL(ctx);
+
+    /*Am first, from the most recently used*/
+    lv_ll_t * ll = ctx->in_queue ? &q->in_ll : &q->main_ll;
+    if(ctx->ll_node == NULL) ctx->ll_node = lv_ll_get_head(ll);
+    else ctx->ll_node = lv_ll_get_next(ll, ctx->ll_node);
+
+    if(ctx->ll_node == NULL && !ctx->in_queue) {
+        ctx->in_queue = true;
+        ctx->ll_node = lv_ll_get_head(&q->in_ll);
+    }
+
+    if(ctx->ll_node == NULL) return LV_RESULT_INVALID;
+
+    lv_memcpy(elem, (*ctx->ll_node)->data, lv_cache_entry_get_size(q->cache.node_size));
+
+    return LV_RESULT_OK;
+}
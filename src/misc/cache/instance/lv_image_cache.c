@@ -21,6 +21,12 @@
 
 #define CACHE_NAME  "IMAGE"
 
+#if LV_USE_IMAGE_CACHE_2Q
+    #define IMAGE_CACHE_CLASS lv_cache_class_2q_size
+#else
+    #define IMAGE_CACHE_CLASS lv_cache_class_lru_rb_size
+#endif
+
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
@@ -34,6 +40,7 @@
 
 static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t * lhs,
                                                      const lv_image_cache_data_t * rhs);
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * key);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
 static void iter_inspect_cb(void * elem);
 
@@ -59,8 +66,9 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
-    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
-    sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
+    img_cache_p = lv_cache_create_sharded(&IMAGE_CACHE_CLASS,
+                                          sizeof(lv_image_cache_data_t), size, LV_IMAGE_CACHE_SHARD_CNT,
+    (lv_cache_hash_cb_t) image_cache_hash_cb, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
         .create_cb = NULL,
         .free_cb = (lv_cache_free_cb_t) image_cache_free_cb,
@@ -80,9 +88,19 @@ void lv_image_cache_resize(uint32_t new_size, bool evict_now)
 
 void lv_image_cache_drop(const void * src)
 {
+#if LV_USE_IMAGE_DECODER_ROI
+    /*Get the size of the image to find its tiles before its header is dropped*/
+    lv_image_header_t header;
+    bool has_header = src && lv_image_decoder_get_info(src, &header) == LV_RESULT_OK;
+#endif
+
     /*If user invalidate image, the header cache should be invalidated too.*/
     lv_image_header_cache_drop(src);
 
+#if LV_USE_IMAGE_DECODER_ROI
+    lv_image_decoder_drop_opened(src);
+#endif
+
     /*Notify draw units to invalidate any cached resources (e.g., GPU textures) for this image source.*/
     lv_draw_unit_send_event(NULL, LV_EVENT_INVALIDATE_AREA, (void *)src);
 
@@ -97,6 +115,29 @@ void lv_image_cache_drop(const void * src)
     };
 
     lv_cache_drop(img_cache_p, &search_key, NULL);
+
+#if LV_USE_IMAGE_CACHE_CONVERT
+    /*Drop the converted copies too*/
+    static const lv_color_format_t target_cfs[] = {
+        LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_XRGB8888
+    };
+    uint32_t i;
+    for(i = 0; i < sizeof(target_cfs) / sizeof(target_cfs[0]); i++) {
+        search_key.target_cf = target_cfs[i];
+        lv_cache_drop(img_cache_p, &search_key, NULL);
+    }
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+#endif
+
+#if LV_USE_IMAGE_DECODER_ROI
+    /*Drop the tiles too*/
+    if(has_header) {
+        uint32_t tile_cnt = LV_IMAGE_DECODER_ROI_TILE_CNT(header.w) * LV_IMAGE_DECODER_ROI_TILE_CNT(header.h);
+        for(search_key.tile = 1; search_key.tile <= tile_cnt; search_key.tile++) {
+            lv_cache_drop(img_cache_p, &search_key, NULL);
+        }
+    }
+#endif
 }
 
 bool lv_image_cache_is_enabled(void)
@@ -104,6 +145,25 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+uint32_t lv_image_cache_hash_src(const void * src, lv_image_src_t src_type)
+{
+    if(src_type != LV_IMAGE_SRC_FILE) {
+        /*Ignore the alignment bits of the pointers*/
+        uintptr_t p = (uintptr_t)src;
+        return (uint32_t)((p >> 4) ^ (p >> 16));
+    }
+
+    /*FNV-1a hash of the path*/
+    const uint8_t * c = src;
+    uint32_t hash = 2166136261u;
+    while(*c) {
+        hash = (hash ^ *c) * 16777619u;
+        c++;
+    }
+
+    return hash;
+}
+
 lv_iter_t * lv_image_cache_iter_create(void)
 {
     return lv_cache_iter_create(img_cache_p);
@@ -114,8 +174,14 @@ void lv_image_cache_dump(void)
     lv_iter_t * iter = lv_image_cache_iter_create();
     if(iter == NULL) return;
 
+    uint32_t hit_cnt = lv_cache_get_hit_cnt(img_cache_p);
+    uint32_t miss_cnt = lv_cache_get_miss_cnt(img_cache_p);
+    uint32_t lookup_cnt = hit_cnt + miss_cnt;
+
     LV_LOG_USER("Image cache dump:");
-    LV_LOG_USER("\tsize\tdata_size\tcf\trc\ttype\tdecoded\t\t\tsrc");
+    LV_LOG_USER("\thits: %" LV_PRIu32 ", misses: %" LV_PRIu32 ", hit rate: %" LV_PRIu32 "%%",
+                hit_cnt, miss_cnt, lookup_cnt ? (uint32_t)((uint64_t)hit_cnt * 100 / lookup_cnt) : 0);
+    LV_LOG_USER("\tsize\tdata_size\tcf\trc\tcost\ttype\tdecoded\t\t\tsrc");
     lv_iter_inspect(iter, iter_inspect_cb);
     lv_iter_destroy(iter);
 }
@@ -148,7 +214,17 @@ static lv_cache_compare_res_t image_cache_compare_cb(
     const lv_image_cache_data_t * lhs,
     const lv_image_cache_data_t * rhs)
 {
-    return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
+    lv_cache_compare_res_t res = image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
+    if(res != 0) return res;
+
+    if(lhs->target_cf != rhs->target_cf) return lhs->target_cf > rhs->target_cf ? 1 : -1;
+    if(lhs->tile != rhs->tile) return lhs->tile > rhs->tile ? 1 : -1;
+    return 0;
+}
+
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * key)
+{
+    return lv_image_cache_hash_src(key->src, key->src_type);
 }
 
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
@@ -176,20 +252,20 @@ static void iter_inspect_cb(void * elem)
     LV_UNUSED(header);
     LV_UNUSED(entry);
 
-    /*  size    data_size   cf  rc  type    decoded         src*/
-#define IMAGE_CACHE_DUMP_FORMAT "	%4dx%-4d	%9"LV_PRIu32"	%d	%"LV_PRId32"	"
+    /*  size    data_size   cf  rc  cost    type    decoded         src*/
+#define IMAGE_CACHE_DUMP_FORMAT "	%4dx%-4d	%9"LV_PRIu32"	%d	%"LV_PRId32"	%"LV_PRIu32"	"
     switch(data->src_type) {
         case LV_IMAGE_SRC_FILE:
             LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "file\t%-12p\t%s", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, (char *)data->src);
+                        lv_cache_entry_get_ref(entry), lv_cache_entry_get_cost(entry), (void *)data->decoded, (char *)data->src);
             break;
         case LV_IMAGE_SRC_VARIABLE:
             LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "var \t%-12p\t%p", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, data->src);
+                        lv_cache_entry_get_ref(entry), lv_cache_entry_get_cost(entry), (void *)data->decoded, data->src);
             break;
         default:
             LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "unkn\t%-12p\t%p", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, data->src);
+                        lv_cache_entry_get_ref(entry), lv_cache_entry_get_cost(entry), (void *)data->decoded, data->src);
             break;
     }
 }
@@ -57,6 +57,15 @@ void lv_image_cache_drop(const void * src);
  */
 bool lv_image_cache_is_enabled(void);
 
+/**
+ * Hash an image source. Used to pick the shard of an entry when
+ * the image caches are split into `LV_IMAGE_CACHE_SHARD_CNT` shards.
+ * @param src       the image source
+ * @param src_type  type of the image source
+ * @return          the hash of the image source
+ */
+uint32_t lv_image_cache_hash_src(const void * src, lv_image_src_t src_type);
+
 /**
  * Create an iterator to iterate over the image cache.
  * @return an iterator to iterate over the image cache.
@@ -32,6 +32,7 @@
 
 static lv_cache_compare_res_t image_header_cache_compare_cb(const lv_image_header_cache_data_t * lhs,
                                                             const lv_image_header_cache_data_t * rhs);
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * key);
 static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, void * user_data);
 static void iter_inspect_cb(void * elem);
 
@@ -57,8 +58,9 @@ lv_result_t lv_image_header_cache_init(uint32_t count)
         return LV_RESULT_OK;
     }
 
-    img_header_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count,
-    sizeof(lv_image_header_cache_data_t), count, (lv_cache_ops_t) {
+    img_header_cache_p = lv_cache_create_sharded(&lv_cache_class_lru_rb_count,
+                                                 sizeof(lv_image_header_cache_data_t), count, LV_IMAGE_CACHE_SHARD_CNT,
+    (lv_cache_hash_cb_t) image_header_cache_hash_cb, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_header_cache_compare_cb,
         .create_cb = NULL,
         .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb
@@ -143,6 +145,11 @@ static lv_cache_compare_res_t image_header_cache_compare_cb(
     return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
 }
 
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * key)
+{
+    return lv_image_cache_hash_src(key->src, key->src_type);
+}
+
 static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, void * user_data)
 {
     LV_UNUSED(user_data); /*Unused*/
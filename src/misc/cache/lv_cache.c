@@ -8,21 +8,37 @@
  *********************/
 #include "lv_cache.h"
 #include "lv_cache_entry_private.h"
+#include "../lv_iter_private.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/** Offset of the context of the current shard's iterator in `shards_iter_context_t` */
+#define SHARD_ITER_CONTEXT_OFS LV_ALIGN_UP(sizeof(shards_iter_context_t), sizeof(uint64_t))
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** Followed by the context of the current shard's iterator at `SHARD_ITER_CONTEXT_OFS` */
+typedef struct {
+    uint32_t shard_idx;
+    uint32_t shard_context_size;    /**< Size of the context of the shards' iterators */
+    lv_iter_next_cb shard_next_cb;  /**< `next_cb` of the shards' iterators */
+} shards_iter_context_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void cache_drop_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
 static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_data);
 static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_t * get_shard(lv_cache_t * cache, const void * key);
+static bool shards_reserve_no_lock(lv_cache_t * cache, lv_cache_t * shard, const void * key, size_t reserved_size,
+                                   void * user_data);
+static bool shards_evict_one(lv_cache_t * cache, void * user_data);
+static lv_result_t shards_iter_next_cb(void * instance, void * context, void * elem);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -52,6 +68,8 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -64,10 +82,69 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     return cache;
 }
 
+lv_cache_t * lv_cache_create_sharded(const lv_cache_class_t * cache_class,
+                                     size_t node_size, size_t max_size, uint32_t shard_cnt,
+                                     lv_cache_hash_cb_t hash_cb, lv_cache_ops_t ops)
+{
+    LV_ASSERT_NULL(hash_cb);
+
+    if(shard_cnt < 2) {
+        lv_cache_t * cache = lv_cache_create(cache_class, node_size, max_size, ops);
+        if(cache) cache->hash_cb = hash_cb;
+        return cache;
+    }
+
+    lv_cache_t * cache = lv_malloc_zeroed(sizeof(lv_cache_t));
+    LV_ASSERT_MALLOC(cache);
+    if(cache == NULL) return NULL;
+
+    cache->shards = lv_malloc_zeroed(shard_cnt * sizeof(lv_cache_t *));
+    LV_ASSERT_MALLOC(cache->shards);
+    if(cache->shards == NULL) {
+        lv_free(cache);
+        return NULL;
+    }
+
+    cache->clz = cache_class;
+    cache->node_size = node_size;
+    cache->max_size = max_size;
+    cache->ops = ops;
+    cache->shard_cnt = shard_cnt;
+    cache->hash_cb = hash_cb;
+
+    /*Protects only the adding to the shards, so they don't exceed `max_size` together*/
+    lv_mutex_init(&cache->lock);
+
+    /*Any shard can grow up to the whole `max_size`, making room by evicting from the others*/
+    uint32_t i;
+    for(i = 0; i < shard_cnt; i++) {
+        cache->shards[i] = lv_cache_create(cache_class, node_size, max_size, ops);
+        if(cache->shards[i] == NULL) {
+            cache->shard_cnt = i;
+            lv_cache_destroy(cache, NULL);
+            return NULL;
+        }
+        cache->shards[i]->hash_cb = hash_cb;
+    }
+
+    return cache;
+}
+
 void lv_cache_destroy(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shards) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            lv_cache_destroy(cache->shards[i], user_data);
+        }
+        lv_free(cache->shards);
+        lv_mutex_delete(&cache->lock);
+        lv_free(cache);
+        return;
+    }
+
     lv_mutex_lock(&cache->lock);
     cache->clz->destroy_cb(cache, user_data);
     lv_mutex_unlock(&cache->lock);
@@ -80,11 +157,14 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shards) return lv_cache_acquire(get_shard(cache, key), key, user_data);
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
 
     if(cache->size == 0) {
+        cache->miss_cnt++;
         lv_mutex_unlock(&cache->lock);
 
         LV_PROFILER_CACHE_END;
@@ -94,6 +174,10 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->hit_cnt++;
+    }
+    else {
+        cache->miss_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -104,6 +188,9 @@ void lv_cache_release(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_
 {
     LV_ASSERT_NULL(entry);
 
+    /*The entry belongs to a shard*/
+    if(cache->shards) cache = (lv_cache_t *)lv_cache_entry_get_cache(entry);
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -122,6 +209,19 @@ lv_cache_entry_t * lv_cache_add(lv_cache_t * cache, const void * key, void * use
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shards) {
+        lv_cache_t * shard = get_shard(cache, key);
+        lv_cache_entry_t * entry = NULL;
+
+        lv_mutex_lock(&cache->lock);
+        if(cache->max_size != 0 && shards_reserve_no_lock(cache, shard, key, 0, user_data)) {
+            entry = lv_cache_add(shard, key, user_data);
+        }
+        lv_mutex_unlock(&cache->lock);
+
+        return entry;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -146,6 +246,34 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shards) {
+        lv_cache_t * shard = get_shard(cache, key);
+
+        /*Look up without the lock of the whole cache, it's needed only to add*/
+        lv_mutex_lock(&shard->lock);
+        lv_cache_entry_t * entry = shard->size != 0 ? shard->clz->get_cb(shard, key, user_data) : NULL;
+        if(entry != NULL) {
+            lv_cache_entry_acquire_data(entry);
+            shard->hit_cnt++;
+        }
+        lv_mutex_unlock(&shard->lock);
+        if(entry != NULL) return entry;
+
+        lv_mutex_lock(&cache->lock);
+        if(cache->max_size != 0 && shards_reserve_no_lock(cache, shard, key, 0, user_data)) {
+            /*Looks up again in case an other thread has just added it, and counts the hit or the miss*/
+            entry = lv_cache_acquire_or_create(shard, key, user_data);
+        }
+        else {
+            lv_mutex_lock(&shard->lock);
+            shard->miss_cnt++;
+            lv_mutex_unlock(&shard->lock);
+        }
+        lv_mutex_unlock(&cache->lock);
+
+        return entry;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -155,12 +283,14 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            cache->hit_cnt++;
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_CACHE_END;
             return entry;
         }
     }
+    cache->miss_cnt++;
 
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
@@ -195,6 +325,13 @@ void lv_cache_reserve(lv_cache_t * cache, uint32_t reserved_size, void * user_da
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shards) {
+        lv_mutex_lock(&cache->lock);
+        shards_reserve_no_lock(cache, cache->shards[0], NULL, reserved_size, user_data);
+        lv_mutex_unlock(&cache->lock);
+        return;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     for(lv_cache_reserve_cond_res_t reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data);
@@ -209,6 +346,11 @@ void lv_cache_drop(lv_cache_t * cache, const void * key, void * user_data)
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shards) {
+        lv_cache_drop(get_shard(cache, key), key, user_data);
+        return;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -221,6 +363,8 @@ bool lv_cache_evict_one(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shards) return shards_evict_one(cache, user_data);
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -234,6 +378,14 @@ void lv_cache_drop_all(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shards) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            lv_cache_drop_all(cache->shards[i], user_data);
+        }
+        return;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -245,8 +397,12 @@ void lv_cache_drop_all(lv_cache_t * cache, void * user_data)
 
 void lv_cache_set_max_size(lv_cache_t * cache, size_t max_size, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->max_size = max_size;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_set_max_size(cache->shards[i], max_size, user_data);
+    }
 }
 size_t lv_cache_get_max_size(lv_cache_t * cache, void * user_data)
 {
@@ -255,13 +411,20 @@ size_t lv_cache_get_max_size(lv_cache_t * cache, void * user_data)
 }
 size_t lv_cache_get_size(lv_cache_t * cache, void * user_data)
 {
-    LV_UNUSED(user_data);
+    if(cache->shards) {
+        size_t size = 0;
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            size += lv_cache_get_size(cache->shards[i], user_data);
+        }
+        return size;
+    }
+
     return cache->size;
 }
 size_t lv_cache_get_free_size(lv_cache_t * cache, void * user_data)
 {
-    LV_UNUSED(user_data);
-    return cache->max_size - cache->size;
+    return cache->max_size - lv_cache_get_size(cache, user_data);
 }
 bool lv_cache_is_enabled(lv_cache_t * cache)
 {
@@ -269,33 +432,100 @@ bool lv_cache_is_enabled(lv_cache_t * cache)
 }
 void lv_cache_set_compare_cb(lv_cache_t * cache, lv_cache_compare_cb_t compare_cb, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->ops.compare_cb = compare_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_set_compare_cb(cache->shards[i], compare_cb, user_data);
+    }
 }
 void lv_cache_set_create_cb(lv_cache_t * cache, lv_cache_create_cb_t alloc_cb, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->ops.create_cb = alloc_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_set_create_cb(cache->shards[i], alloc_cb, user_data);
+    }
 }
 void lv_cache_set_free_cb(lv_cache_t * cache, lv_cache_free_cb_t free_cb, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->ops.free_cb = free_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_set_free_cb(cache->shards[i], free_cb, user_data);
+    }
 }
 void lv_cache_set_name(lv_cache_t * cache, const char * name)
 {
     if(cache == NULL) return;
     cache->name = name;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_set_name(cache->shards[i], name);
+    }
 }
 const char * lv_cache_get_name(lv_cache_t * cache)
 {
     return cache->name;
 }
 
+uint32_t lv_cache_get_hit_cnt(lv_cache_t * cache)
+{
+    uint32_t hit_cnt = cache->hit_cnt;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        hit_cnt += lv_cache_get_hit_cnt(cache->shards[i]);
+    }
+    return hit_cnt;
+}
+uint32_t lv_cache_get_miss_cnt(lv_cache_t * cache)
+{
+    uint32_t miss_cnt = cache->miss_cnt;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        miss_cnt += lv_cache_get_miss_cnt(cache->shards[i]);
+    }
+    return miss_cnt;
+}
+void lv_cache_reset_stats(lv_cache_t * cache)
+{
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_reset_stats(cache->shards[i]);
+    }
+}
+
 lv_iter_t * lv_cache_iter_create(lv_cache_t * cache)
 {
     LV_ASSERT_NULL(cache);
     if(cache == NULL || cache->clz->iter_create_cb == NULL) return NULL;
+
+    if(cache->shards) {
+        /*Only the callback and the context size of the shards' iterators are needed*/
+        lv_iter_t * shard_iter = lv_cache_iter_create(cache->shards[0]);
+        if(shard_iter == NULL) return NULL;
+        lv_iter_next_cb shard_next_cb = lv_iter_get_next_cb(shard_iter);
+        uint32_t shard_context_size = lv_iter_get_context_size(shard_iter);
+        lv_iter_destroy(shard_iter);
+
+        lv_iter_t * iter = lv_iter_create(cache, lv_cache_entry_get_size(cache->node_size),
+                                          SHARD_ITER_CONTEXT_OFS + shard_context_size, shards_iter_next_cb);
+        if(iter == NULL) return NULL;
+
+        shards_iter_context_t * ctx = lv_iter_get_context(iter);
+        ctx->shard_context_size = shard_context_size;
+        ctx->shard_next_cb = shard_next_cb;
+        return iter;
+    }
+
     return cache->clz->iter_create_cb(cache);
 }
 
@@ -353,3 +583,90 @@ static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const v
 
     return entry;
 }
+
+static lv_cache_t * get_shard(lv_cache_t * cache, const void * key)
+{
+    return cache->shards[cache->hash_cb(key) % cache->shard_cnt];
+}
+
+/**
+ * Evict from the shards of `cache` until `key` and `reserved_size` fit into `shard`
+ * without exceeding the `max_size` of the whole cache. `cache->lock` must be locked.
+ */
+static bool shards_reserve_no_lock(lv_cache_t * cache, lv_cache_t * shard, const void * key, size_t reserved_size,
+                                   void * user_data)
+{
+    while(1) {
+        size_t others_size = 0;
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            if(cache->shards[i] == shard) continue;
+            lv_mutex_lock(&cache->shards[i]->lock);
+            others_size += cache->shards[i]->size;
+            lv_mutex_unlock(&cache->shards[i]->lock);
+        }
+
+        /*The shard's max size is the whole cache's, so reserving the others' size checks the total*/
+        lv_mutex_lock(&shard->lock);
+        lv_cache_reserve_cond_res_t reserve_cond_res = shard->clz->reserve_cond_cb(shard, key,
+                                                                                    others_size + reserved_size,
+                                                                                    user_data);
+        lv_mutex_unlock(&shard->lock);
+
+        if(reserve_cond_res == LV_CACHE_RESERVE_COND_OK) return true;
+        if(reserve_cond_res != LV_CACHE_RESERVE_COND_NEED_VICTIM) return false;
+        if(shards_evict_one(cache, user_data) == false) return false;
+    }
+}
+
+/**
+ * Evict from the fullest shard, or from any other one if all the entries of the fullest are in use
+ */
+static bool shards_evict_one(lv_cache_t * cache, void * user_data)
+{
+    lv_cache_t * victim_shard = NULL;
+    size_t victim_size = 0;
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_t * shard = cache->shards[i];
+        lv_mutex_lock(&shard->lock);
+        size_t size = shard->size;
+        lv_mutex_unlock(&shard->lock);
+        if(size > victim_size) {
+            victim_shard = shard;
+            victim_size = size;
+        }
+    }
+
+    if(victim_shard == NULL) return false;
+    if(lv_cache_evict_one(victim_shard, user_data)) return true;
+
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_t * shard = cache->shards[i];
+        if(shard != victim_shard && lv_cache_get_size(shard, user_data) != 0 &&
+           lv_cache_evict_one(shard, user_data)) return true;
+    }
+
+    return false;
+}
+
+static lv_result_t shards_iter_next_cb(void * instance, void * context, void * elem)
+{
+    lv_cache_t * cache = instance;
+    shards_iter_context_t * ctx = context;
+
+    /*Nothing could free the iterator of a shard if the iteration is stopped early,
+     *so keep the state of the current shard's iteration in this context instead*/
+    void * shard_context = ctx->shard_context_size > 0 ? (uint8_t *)ctx + SHARD_ITER_CONTEXT_OFS : NULL;
+    while(ctx->shard_idx < cache->shard_cnt) {
+        if(ctx->shard_next_cb(cache->shards[ctx->shard_idx], shard_context, elem) == LV_RESULT_OK) {
+            return LV_RESULT_OK;
+        }
+
+        /*A zeroed context starts the iteration of the next shard, as in `lv_iter_create`*/
+        ctx->shard_idx++;
+        if(shard_context) lv_memzero(shard_context, ctx->shard_context_size);
+    }
+
+    return LV_RESULT_INVALID;
+}
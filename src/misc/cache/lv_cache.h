@@ -48,6 +48,12 @@ typedef bool (*lv_cache_create_cb_t)(void * node, void * user_data);
 typedef void (*lv_cache_free_cb_t)(void * node, void * user_data);
 typedef lv_cache_compare_res_t (*lv_cache_compare_cb_t)(const void * a, const void * b);
 
+/**
+ * Hash a key to pick the shard of a sharded cache. The keys which are equal according to
+ * `lv_cache_ops_t::compare_cb` must have the same hash.
+ */
+typedef uint32_t (*lv_cache_hash_cb_t)(const void * key);
+
 /**
  * The cache instance allocation function, used by the cache class to allocate memory for cache instances.
  * @return It should return a pointer to the allocated instance.
@@ -139,6 +145,15 @@ struct _lv_cache_t {
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< Name of the cache */
+
+    lv_cache_t ** shards;             /**< Independent caches with their own locks, the entries are
+                                       * spread among them by `hash_cb`. NULL if not sharded. */
+    uint32_t shard_cnt;               /**< Number of shards */
+    lv_cache_hash_cb_t hash_cb;       /**< Picks the shard of a key, and lets the 2Q classes remember
+                                       * the evicted keys. Can be NULL if not sharded. */
+
+    uint32_t hit_cnt;                 /**< Number of lookups which found the entry */
+    uint32_t miss_cnt;                /**< Number of lookups which didn't find the entry */
 };
 
 /**
@@ -188,9 +203,11 @@ struct _lv_cache_slot_size_t {
 
 /**
  * Create a cache object with the given parameters.
- * @param cache_class   The class of the cache. Currently only support one two builtin classes:
+ * @param cache_class   The class of the cache. E.g. one of these builtin classes:
  *                        - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  *                        - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ *                        - lv_cache_class_2q_count and lv_cache_class_2q_size for scan resistant
+ *                          and cost aware variants of the above. See lv_cache_entry_set_cost().
  * @param node_size     The node size is the size of the data stored in the cache..
  * @param max_size      The max size is the maximum amount of memory or count that the cache can hold.
  *                        - lv_cache_class_lru_rb_count: max_size is the maximum count of nodes in the cache.
@@ -202,6 +219,25 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
                              size_t node_size, size_t max_size,
                              lv_cache_ops_t ops);
 
+/**
+ * Create a cache split into independent shards, each with its own lock, to reduce lock
+ * contention when the cache is used by multiple threads (e.g. draw units).
+ * The entries are assigned to the shards by the hash of their keys. Looking up locks only
+ * the entry's shard, while adding also makes room by evicting from the fullest shards,
+ * so any shard can grow up to `max_size` and an entry of any size up to that can be cached.
+ * @param cache_class   The class of the shards. See lv_cache_create().
+ * @param node_size     The node size is the size of the data stored in the cache.
+ * @param max_size      The max size of all the shards together. See lv_cache_create().
+ * @param shard_cnt     Number of shards. If less than 2 a normal cache is created.
+ * @param hash_cb       Function to hash the keys. Also used by the 2Q classes, so it's worth
+ *                      passing even if `shard_cnt` is less than 2.
+ * @param ops           A set of operations that can be performed on the cache. See lv_cache_ops_t for details.
+ * @return              Returns a pointer to the created cache object on success, `NULL` on error.
+ */
+lv_cache_t * lv_cache_create_sharded(const lv_cache_class_t * cache_class,
+                                     size_t node_size, size_t max_size, uint32_t shard_cnt,
+                                     lv_cache_hash_cb_t hash_cb, lv_cache_ops_t ops);
+
 /**
  * Destroy a cache object.
  * @param cache         The cache object pointer to destroy.
@@ -368,6 +404,28 @@ void lv_cache_set_name(lv_cache_t * cache, const char * name);
  */
 const char * lv_cache_get_name(lv_cache_t * cache);
 
+/**
+ * Get the number of `lv_cache_acquire()` and `lv_cache_acquire_or_create()` calls which
+ * found the entry in the cache.
+ * @param cache         The cache object pointer.
+ * @return              The number of hits since the creation or the last lv_cache_reset_stats().
+ */
+uint32_t lv_cache_get_hit_cnt(lv_cache_t * cache);
+
+/**
+ * Get the number of `lv_cache_acquire()` and `lv_cache_acquire_or_create()` calls which
+ * didn't find the entry in the cache.
+ * @param cache         The cache object pointer.
+ * @return              The number of misses since the creation or the last lv_cache_reset_stats().
+ */
+uint32_t lv_cache_get_miss_cnt(lv_cache_t * cache);
+
+/**
+ * Reset the hit and miss counters of the cache.
+ * @param cache         The cache object pointer.
+ */
+void lv_cache_reset_stats(lv_cache_t * cache);
+
 /**
  * Create an iterator for the cache object. The iterator is used to iterate over all cache entries.
  * @param cache         The cache object pointer to create the iterator.
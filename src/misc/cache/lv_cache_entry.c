@@ -78,6 +78,18 @@ void lv_cache_entry_set_node_size(lv_cache_entry_t * entry, uint32_t node_size)
     entry->node_size = node_size;
 }
 
+void lv_cache_entry_set_cost(lv_cache_entry_t * entry, uint32_t cost)
+{
+    LV_ASSERT_NULL(entry);
+    entry->cost = cost;
+}
+
+uint32_t lv_cache_entry_get_cost(lv_cache_entry_t * entry)
+{
+    LV_ASSERT_NULL(entry);
+    return entry->cost;
+}
+
 bool lv_cache_entry_is_invalid(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
@@ -157,6 +169,7 @@ void lv_cache_entry_init(lv_cache_entry_t * entry, const lv_cache_t * cache, uin
     entry->cache = cache;
     entry->node_size = node_size;
     entry->ref_cnt = 0;
+    entry->cost = 0;
     entry->flags = 0;
 }
 
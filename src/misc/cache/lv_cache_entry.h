@@ -50,6 +50,22 @@ int32_t  lv_cache_entry_get_ref(lv_cache_entry_t * entry);
  */
 uint32_t lv_cache_entry_get_node_size(lv_cache_entry_t * entry);
 
+/**
+ * Set the cost of recreating the data of a cache entry, e.g. the time of decoding an image.
+ * The cost aware cache classes (`lv_cache_class_2q_count` and `lv_cache_class_2q_size`)
+ * evict the cheaper entries first.
+ * @param entry        The cache entry to set the cost of.
+ * @param cost         The cost in any unit, but the same for all the entries of a cache.
+ */
+void     lv_cache_entry_set_cost(lv_cache_entry_t * entry, uint32_t cost);
+
+/**
+ * Get the cost of recreating the data of a cache entry.
+ * @param entry        The cache entry to get the cost of.
+ * @return             The cost set by lv_cache_entry_set_cost(), or 0 if not set.
+ */
+uint32_t lv_cache_entry_get_cost(lv_cache_entry_t * entry);
+
 /**
  * Check if a cache entry is invalid.
  * @param entry        The cache entry to check.
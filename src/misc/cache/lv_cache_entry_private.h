@@ -28,6 +28,7 @@ struct _lv_cache_entry_t {
     const lv_cache_t * cache;
     int32_t ref_cnt;
     uint32_t node_size;
+    uint32_t cost;      /**< The cost of recreating the data, e.g. the time of decoding an image */
 #define LV_CACHE_ENTRY_FLAG_INVALID (1 << 0) /** Flag indicating if the entry is invalid and can be released */
 #define LV_CACHE_ENTRY_FLAG_DISABLE_DELETE (1 << 1) /** This flag should be set if the cache class is managing the memory of the entry itself*/
 #define LV_CACHE_ENTRY_FLAG_CLASS_CUSTOM (1 << 7) /**A custom flag that can be used by the different cache classes*/
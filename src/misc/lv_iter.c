@@ -86,6 +86,20 @@ void * lv_iter_get_context(const lv_iter_t * iter)
     return iter ? iter->context : NULL;
 }
 
+uint32_t lv_iter_get_context_size(const lv_iter_t * iter)
+{
+    LV_ASSERT_NULL(iter);
+
+    return iter ? iter->context_size : 0;
+}
+
+lv_iter_next_cb lv_iter_get_next_cb(const lv_iter_t * iter)
+{
+    LV_ASSERT_NULL(iter);
+
+    return iter ? iter->next_cb : NULL;
+}
+
 void lv_iter_destroy(lv_iter_t * iter)
 {
     LV_ASSERT_NULL(iter);
@@ -51,6 +51,21 @@ lv_iter_t * lv_iter_create(void * instance, uint32_t elem_size, uint32_t context
  */
 void * lv_iter_get_context(const lv_iter_t * iter);
 
+/**
+ * Get the size of the context of the iterator.
+ * @param iter           `lv_iter_t` object create before
+ * @return the size of the context in bytes
+ */
+uint32_t lv_iter_get_context_size(const lv_iter_t * iter);
+
+/**
+ * Get the callback which returns the next element of the iterator.
+ * Calling it with the iterator's instance and a copy of its context continues the iteration from the copy.
+ * @param iter           `lv_iter_t` object create before
+ * @return the next_cb passed to `lv_iter_create`
+ */
+lv_iter_next_cb lv_iter_get_next_cb(const lv_iter_t * iter);
+
 /**
  * Destroy the iterator object, and release the context. Other resources allocated by the user are not released.
  * The user needs to release it by itself.
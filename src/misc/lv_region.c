@@ -0,0 +1,269 @@
+/**
+ * @file lv_region.c
+ * A set of pixels stored as a list of not overlapping areas.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_region_private.h"
+#include "lv_area_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Number of following areas to try to join even if they are not touching*/
+#define MERGE_LOOKAHEAD 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void sort_by_y1(lv_area_t * areas, uint32_t cnt);
+static bool try_merge(lv_area_t * areas, uint32_t cnt, uint32_t i, uint32_t j, lv_region_cost_cb_t cost_cb,
+                      void * user_data);
+static void mark_removed(lv_area_t * area);
+static bool is_removed(const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_region_init(lv_region_t * region)
+{
+    lv_array_init(&region->areas, LV_ARRAY_DEFAULT_CAPACITY, sizeof(lv_area_t));
+}
+
+void lv_region_deinit(lv_region_t * region)
+{
+    lv_array_deinit(&region->areas);
+}
+
+void lv_region_clear(lv_region_t * region)
+{
+    lv_array_clear(&region->areas);
+}
+
+uint32_t lv_region_get_area_count(const lv_region_t * region)
+{
+    return lv_array_size(&region->areas);
+}
+
+lv_area_t * lv_region_get_area(const lv_region_t * region, uint32_t idx)
+{
+    return lv_array_at(&region->areas, idx);
+}
+
+lv_result_t lv_region_add(lv_region_t * region, const lv_area_t * area)
+{
+    if(lv_region_is_in(region, area)) return LV_RESULT_OK;
+
+    /*Keep the new area in one piece and cut the existing ones*/
+    lv_result_t res = lv_region_subtract(region, area);
+    if(res != LV_RESULT_OK) return res;
+
+    res = lv_array_push_back(&region->areas, area);
+    if(res != LV_RESULT_OK) return res;
+
+    /*Don't let adding and subtracting get slower and slower with too many areas*/
+    uint32_t cnt = lv_array_size(&region->areas);
+    if(cnt > LV_REGION_AREA_CNT_MAX) {
+        lv_area_t bbox = *area;
+        uint32_t i;
+        for(i = 0; i < cnt; i++) {
+            lv_area_join(&bbox, &bbox, lv_array_at(&region->areas, i));
+        }
+        lv_array_clear(&region->areas);
+        res = lv_array_push_back(&region->areas, &bbox);
+    }
+
+    return res;
+}
+
+lv_result_t lv_region_subtract(lv_region_t * region, const lv_area_t * area)
+{
+    /*The new pieces are added to the end and they don't overlap `area`, so don't check them*/
+    uint32_t cnt = lv_array_size(&region->areas);
+    uint32_t i = 0;
+    while(i < cnt) {
+        lv_area_t * a = lv_array_at(&region->areas, i);
+        lv_area_t pieces[4];
+        int8_t piece_cnt = lv_area_diff(pieces, a, area);
+
+        /*Not overlapping*/
+        if(piece_cnt < 0) {
+            i++;
+            continue;
+        }
+
+        /*Fully covered*/
+        if(piece_cnt == 0) {
+            lv_array_remove(&region->areas, i);
+            cnt--;
+            continue;
+        }
+
+        /*`a` might be invalid after adding a new piece, so replace it first*/
+        *a = pieces[0];
+        int8_t p;
+        for(p = 1; p < piece_cnt; p++) {
+            lv_result_t res = lv_array_push_back(&region->areas, &pieces[p]);
+            if(res != LV_RESULT_OK) return res;
+        }
+        i++;
+    }
+
+    return LV_RESULT_OK;
+}
+
+bool lv_region_is_in(const lv_region_t * region, const lv_area_t * area)
+{
+    uint32_t cnt = lv_array_size(&region->areas);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        if(lv_area_is_in(area, lv_array_at(&region->areas, i), 0)) return true;
+    }
+
+    return false;
+}
+
+void lv_region_merge(lv_region_t * region, lv_region_cost_cb_t cost_cb, void * user_data)
+{
+    uint32_t cnt = lv_array_size(&region->areas);
+    if(cnt < 2) return;
+
+    LV_PROFILER_REFR_BEGIN;
+
+    /*No areas are added while merging so the array won't be reallocated*/
+    lv_area_t * areas = lv_array_front(&region->areas);
+    sort_by_y1(areas, cnt);
+
+    /*Single sweep: `areas[i]` can grow while it's compared with the next areas,
+     *but the areas skipped before are not checked again*/
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < cnt; i++) {
+        if(is_removed(&areas[i])) continue;
+
+        for(j = i + 1; j < cnt; j++) {
+            /*The areas are sorted by y1 so the next ones can't touch `areas[i]` either.
+             *Still check a few of them as joining can be cheaper even with a gap in between.*/
+            if(areas[j].y1 > areas[i].y2 + 1 && j > i + MERGE_LOOKAHEAD) break;
+
+            if(!is_removed(&areas[j])) try_merge(areas, cnt, i, j, cost_cb, user_data);
+        }
+    }
+
+    /*Remove the merged areas*/
+    uint32_t new_cnt = 0;
+    for(i = 0; i < cnt; i++) {
+        if(is_removed(&areas[i])) continue;
+        areas[new_cnt] = areas[i];
+        new_cnt++;
+    }
+    lv_array_erase(&region->areas, new_cnt, cnt);
+
+    LV_PROFILER_REFR_END;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Sort the areas by their y1 coordinate.
+ * Insertion sort is used as the areas are usually invalidated from top to bottom.
+ * @param areas     array of areas
+ * @param cnt       number of areas
+ */
+static void sort_by_y1(lv_area_t * areas, uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 1; i < cnt; i++) {
+        lv_area_t tmp = areas[i];
+        uint32_t j = i;
+        while(j > 0 && areas[j - 1].y1 > tmp.y1) {
+            areas[j] = areas[j - 1];
+            j--;
+        }
+        areas[j] = tmp;
+    }
+}
+
+/**
+ * Replace two areas with their bounding box if it's cheaper.
+ * The other areas on the bounding box are merged too to keep the areas disjoint.
+ * If an area is only partially on the bounding box, the areas are not merged.
+ * @param areas     array of areas sorted by y1
+ * @param cnt       number of areas
+ * @param i         index of the area to merge into
+ * @param j         index of the area to merge, `j > i`
+ * @param cost_cb   function to get the cost of refreshing an area
+ * @param user_data custom data passed to `cost_cb`
+ * @return          true: the areas were merged into `areas[i]`
+ */
+static bool try_merge(lv_area_t * areas, uint32_t cnt, uint32_t i, uint32_t j, lv_region_cost_cb_t cost_cb,
+                      void * user_data)
+{
+    lv_area_t joined;
+    lv_area_join(&joined, &areas[i], &areas[j]);
+
+    /*Quick check: joining the two areas alone should be cheaper*/
+    uint64_t joined_cost = cost_cb(&joined, user_data);
+    if(joined_cost >= cost_cb(&areas[i], user_data) + cost_cb(&areas[j], user_data)) return false;
+
+    /*The areas starting below the bounding box can't be on it*/
+    uint32_t end = j + 1;
+    while(end < cnt && areas[end].y1 <= joined.y2) end++;
+
+    uint64_t separate_cost = 0;
+    uint32_t k;
+    for(k = 0; k < end; k++) {
+        if(is_removed(&areas[k]) || !lv_area_is_on(&joined, &areas[k])) continue;
+        if(!lv_area_is_in(&areas[k], &joined, 0)) return false;
+        separate_cost += cost_cb(&areas[k], user_data);
+    }
+
+    if(joined_cost >= separate_cost) return false;
+
+    for(k = 0; k < end; k++) {
+        if(k == i || is_removed(&areas[k])) continue;
+        if(lv_area_is_on(&joined, &areas[k])) mark_removed(&areas[k]);
+    }
+
+    /*`joined.y1` is `areas[i].y1`, so the areas remain sorted*/
+    areas[i] = joined;
+
+    return true;
+}
+
+/**
+ * Mark an area to be removed after merging. Such an area is not on any other area.
+ * @param area  pointer to an area
+ */
+static void mark_removed(lv_area_t * area)
+{
+    area->x1 = LV_COORD_MAX;
+    area->x2 = LV_COORD_MIN;
+}
+
+/**
+ * Check if an area was marked to be removed
+ * @param area  pointer to an area
+ * @return      true: the area is removed
+ */
+static bool is_removed(const lv_area_t * area)
+{
+    return area->x1 > area->x2;
+}
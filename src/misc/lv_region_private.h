@@ -0,0 +1,137 @@
+/**
+ * @file lv_region_private.h
+ *
+ */
+
+#ifndef LV_REGION_PRIVATE_H
+#define LV_REGION_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lvgl_public.h"
+#include "lv_array.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** If a region has more areas than this, they are replaced by their bounding box.
+ *  `LV_INV_BUF_SIZE`, which limited the invalidated areas of the displays, sets it too.*/
+#ifdef LV_INV_BUF_SIZE
+#define LV_REGION_AREA_CNT_MAX  LV_INV_BUF_SIZE
+#else
+#define LV_REGION_AREA_CNT_MAX  128
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A set of pixels described by a growable list of areas which don't overlap each other
+ */
+typedef struct {
+    lv_array_t areas;   /**< `lv_area_t` elements */
+} lv_region_t;
+
+/**
+ * Get the cost of refreshing an area. Used to decide if joining areas is worth it.
+ * @param area          pointer to an area
+ * @param user_data     the `user_data` passed to `lv_region_merge`
+ * @return              the cost in any unit, but the same for all the areas
+ */
+typedef uint64_t (*lv_region_cost_cb_t)(const lv_area_t * area, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty region
+ * @param region    pointer to a region
+ */
+void lv_region_init(lv_region_t * region);
+
+/**
+ * Free the memory used by a region
+ * @param region    pointer to a region
+ */
+void lv_region_deinit(lv_region_t * region);
+
+/**
+ * Remove all the areas from a region. The allocated memory is kept.
+ * @param region    pointer to a region
+ */
+void lv_region_clear(lv_region_t * region);
+
+/**
+ * Get the number of areas of a region
+ * @param region    pointer to a region
+ * @return          number of areas
+ */
+uint32_t lv_region_get_area_count(const lv_region_t * region);
+
+/**
+ * Get an area of a region
+ * @param region    pointer to a region
+ * @param idx       index of the area, `0 .. lv_region_get_area_count() - 1`
+ * @return          pointer to the area. Valid until the region is modified.
+ */
+lv_area_t * lv_region_get_area(const lv_region_t * region, uint32_t idx);
+
+/**
+ * Add an area to a region (union). The parts of the existing areas covered by
+ * the new area are removed, so the areas still won't overlap.
+ * If the region would have more than `LV_REGION_AREA_CNT_MAX` areas, all the areas
+ * are replaced by their bounding box, so the region can be larger than the union.
+ * @param region    pointer to a region
+ * @param area      the area to add
+ * @return          LV_RESULT_OK: the area was added or it was already covered by an area;
+ *                  LV_RESULT_INVALID: out of memory, the region is not complete
+ */
+lv_result_t lv_region_add(lv_region_t * region, const lv_area_t * area);
+
+/**
+ * Remove an area from a region. The partially covered areas of the region are
+ * split into at most 4 areas.
+ * @param region    pointer to a region
+ * @param area      the area to remove
+ * @return          LV_RESULT_OK: the area was removed;
+ *                  LV_RESULT_INVALID: out of memory, the region is not complete
+ */
+lv_result_t lv_region_subtract(lv_region_t * region, const lv_area_t * area);
+
+/**
+ * Check if an area is fully covered by one of the areas of a region
+ * @param region    pointer to a region
+ * @param area      the area to check
+ * @return          true: `area` is in an area of the region
+ */
+bool lv_region_is_in(const lv_region_t * region, const lv_area_t * area);
+
+/**
+ * Replace neighboring areas with their bounding box if it's cheaper to refresh
+ * than the original areas. The areas are sorted by their y1 coordinate and in a
+ * single sweep each area is compared with the following touching areas and the next few areas.
+ * The areas still won't overlap after merging.
+ * @param region    pointer to a region
+ * @param cost_cb   function to get the cost of refreshing an area
+ * @param user_data custom data passed to `cost_cb`
+ */
+void lv_region_merge(lv_region_t * region, lv_region_cost_cb_t cost_cb, void * user_data);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_REGION_PRIVATE_H*/
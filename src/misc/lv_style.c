@@ -24,6 +24,10 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_STYLE_SORTED_PROPS
+    static uint32_t find_sorted_prop(const lv_style_prop_t * props, uint32_t prop_cnt, lv_style_prop_t prop);
+    static void insert_sorted_prop(lv_style_t * style, uint32_t pos, lv_style_prop_t prop, lv_style_value_t value);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -336,6 +340,13 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
 
             lv_free(old_values);
+
+#if LV_STYLE_SORTED_PROPS
+            /*The last bit is shared by the custom properties with large IDs so keep it*/
+            if(prop < LV_STYLE_PROP_BITMAP_SIZE * 32 - 1) {
+                style->has_prop[prop >> 5] &= ~((uint32_t)1 << (prop & 0x1F));
+            }
+#endif
             LV_PROFILER_STYLE_END;
             return true;
         }
@@ -357,8 +368,23 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     LV_CHECK_ARG(prop != LV_STYLE_PROP_INV, return);
     LV_PROFILER_STYLE_BEGIN;
     lv_style_prop_t * props;
-    int32_t i;
 
+#if LV_STYLE_SORTED_PROPS
+    uint32_t pos = 0;
+    if(style->values_and_props) {
+        props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+        pos = find_sorted_prop(props, style->prop_cnt, prop);
+        if(pos < style->prop_cnt && props[pos] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            values[pos] = value;
+            LV_PROFILER_STYLE_END;
+            return;
+        }
+    }
+
+    insert_sorted_prop(style, pos, prop, value);
+#else
+    int32_t i;
     if(style->values_and_props) {
         props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         for(i = style->prop_cnt - 1; i >= 0; i--) {
@@ -397,6 +423,7 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 
     uint32_t group = lv_style_get_prop_group(prop);
     style->has_group |= (uint32_t)1 << group;
+#endif /*LV_STYLE_SORTED_PROPS*/
     LV_PROFILER_STYLE_END;
 }
 
@@ -526,3 +553,63 @@ uint8_t lv_style_prop_lookup_flags(lv_style_prop_t prop)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_STYLE_SORTED_PROPS
+
+/**
+ * Find the position of a property in a sorted property list
+ * @param props     pointer to the sorted properties
+ * @param prop_cnt  number of properties
+ * @param prop      the property to find
+ * @return          index of `prop` if it's in the list, else the index where it should be inserted
+ */
+static uint32_t find_sorted_prop(const lv_style_prop_t * props, uint32_t prop_cnt, lv_style_prop_t prop)
+{
+    uint32_t min = 0;
+    uint32_t max = prop_cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) >> 1;
+        if(props[mid] < prop) min = mid + 1;
+        else max = mid;
+    }
+    return min;
+}
+
+/**
+ * Add a new property to a style keeping the properties sorted
+ * @param style     pointer to a style
+ * @param pos       index where the property should be inserted
+ * @param prop      the new property
+ * @param value     value of the new property
+ */
+static void insert_sorted_prop(lv_style_t * style, uint32_t pos, lv_style_prop_t prop, lv_style_value_t value)
+{
+    uint32_t cnt = style->prop_cnt;
+    size_t size = (cnt + 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+    uint8_t * values_and_props = lv_realloc(style->values_and_props, size);
+    if(values_and_props == NULL) return;
+
+    style->values_and_props = values_and_props;
+
+    /*Move the props after the new value and make place for the new prop.
+     *Move the props after `pos` first as the props before it will overwrite their old place.*/
+    lv_style_prop_t * old_props = values_and_props + cnt * sizeof(lv_style_value_t);
+    lv_style_prop_t * new_props = values_and_props + (cnt + 1) * sizeof(lv_style_value_t);
+    lv_memmove(new_props + pos + 1, old_props + pos, (cnt - pos) * sizeof(lv_style_prop_t));
+    lv_memmove(new_props, old_props, pos * sizeof(lv_style_prop_t));
+
+    lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+    lv_memmove(values + pos + 1, values + pos, (cnt - pos) * sizeof(lv_style_value_t));
+
+    new_props[pos] = prop;
+    values[pos] = value;
+    style->prop_cnt++;
+
+    uint32_t group = lv_style_get_prop_group(prop);
+    style->has_group |= (uint32_t)1 << group;
+
+    uint32_t bit = prop < LV_STYLE_PROP_BITMAP_SIZE * 32 ? prop : LV_STYLE_PROP_BITMAP_SIZE * 32 - 1;
+    style->has_prop[bit >> 5] |= (uint32_t)1 << (bit & 0x1F);
+}
+
+#endif /*LV_STYLE_SORTED_PROPS*/
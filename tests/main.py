@@ -89,12 +89,27 @@ test_options = {
         "description": "RISC-V Vector emulation with full config, 32 bit color depth",
         "defconfigs": ["full", "depth_32", HOST, "sys_heap", "run_tests", "riscv_v"],
     },
+    "OPTIONS_TEST_SIMD": {
+        "description": "Portable SIMD blending with full config, 32 bit color depth",
+        "defconfigs": ["full", "depth_32", HOST, "sys_heap", "run_tests", "simd"],
+    },
+    "OPTIONS_TEST_OS_NONE": {
+        "description": "Test config without an OS, 32 bit color depth",
+        "defconfigs": ["full", "depth_32", HOST, "sys_heap", "run_tests", "os_none"],
+    },
     "OPTIONS_TEST_NANOVG": {
         "description": "NanoVG headless rendering with EGL, 32 bit color depth",
         "defconfigs": ["full", "depth_32", HOST, "sys_heap", "run_tests", "nanovg"],
     },
 }
 
+# The SSE4.1/AVX2 kernels can be compiled and run only on an x86 host
+if platform.machine().lower() in ("x86", "x86_64", "amd64", "i386", "i686"):
+    test_options["OPTIONS_TEST_X86"] = {
+        "description": "x86 SSE4.1/AVX2 blending with full config, 32 bit color depth",
+        "defconfigs": ["full", "depth_32", HOST, "sys_heap", "run_tests", "x86"],
+    }
+
 
 def get_build_config(options_name):
     if options_name in build_only_options:
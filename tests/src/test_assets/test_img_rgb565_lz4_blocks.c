@@ -0,0 +1,160 @@
+
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+#include "lvgl.h"
+#elif defined(LV_LVGL_H_INCLUDE_SYSTEM)
+#include <lvgl.h>
+#elif defined(LV_BUILD_TEST)
+#include "../lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+#ifndef LV_ATTRIBUTE_MEM_ALIGN
+#define LV_ATTRIBUTE_MEM_ALIGN
+#endif
+
+#ifndef LV_ATTRIBUTE_TEST_IMG_RGB565_LZ4_BLOCKS
+#define LV_ATTRIBUTE_TEST_IMG_RGB565_LZ4_BLOCKS
+#endif
+
+static const
+LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_TEST_IMG_RGB565_LZ4_BLOCKS
+uint8_t test_img_rgb565_lz4_blocks_map[] = {
+
+    0x02,0x01,0x00,0x00,0x61,0x07,0x00,0x00,0x48,0x21,0x00,0x00,0x14,0x00,0x00,0x00,
+    0x95,0x01,0x00,0x00,0xa9,0x03,0x00,0x00,0x71,0x06,0x00,0x00,0x61,0x07,0x00,0x00,
+    0x2f,0xe0,0x07,0x02,0x00,0x7b,0x1f,0xff,0x01,0x00,0x76,0x00,0x1a,0x01,0x0f,0x8d,
+    0x00,0x76,0x05,0x8e,0x00,0x1b,0x00,0x01,0x00,0x0f,0xa2,0x00,0x3d,0x2f,0x00,0xf8,
+    0x02,0x00,0x0d,0x0f,0x8e,0x00,0x28,0xff,0x00,0xbd,0x5f,0x6b,0x5f,0x29,0x3f,0x00,
+    0x3f,0x00,0x5f,0x29,0x5f,0x6b,0xff,0xbd,0xbc,0x00,0x0f,0x02,0x6e,0x00,0x0f,0x02,
+    0x00,0x07,0x02,0x20,0x00,0x0f,0x1c,0x01,0x1f,0x6a,0x3f,0xe7,0x5f,0x6b,0x1f,0x00,
+    0x02,0x00,0x48,0x5f,0x6b,0x3f,0xe7,0x6a,0x00,0x86,0xbf,0x94,0xff,0x18,0xff,0x18,
+    0xbf,0x94,0x14,0x00,0x2f,0x00,0xf8,0x20,0x01,0x09,0x02,0x20,0x00,0x0f,0xaa,0x01,
+    0x1f,0x4a,0x3f,0xe7,0xbf,0x52,0x8a,0x00,0x02,0x02,0x00,0x29,0xbf,0x52,0x90,0x00,
+    0x7c,0x18,0x1f,0x00,0x1f,0x00,0xff,0x18,0x8e,0x00,0x06,0x10,0x00,0x08,0x02,0x00,
+    0x0f,0x8e,0x00,0x27,0x0e,0x18,0x01,0x04,0x02,0x00,0x27,0x5f,0x6b,0x62,0x00,0x0f,
+    0x8e,0x00,0x06,0x0e,0x3e,0x02,0x0f,0x8e,0x00,0x28,0x14,0xbd,0x7c,0x00,0x0f,0x02,
+    0x00,0x01,0x06,0x40,0x02,0x0f,0xaa,0x01,0x05,0x02,0x7a,0x00,0x08,0x02,0x00,0x04,
+    0x14,0x00,0x02,0x38,0x01,0x0f,0x38,0x02,0x1b,0x0f,0x1a,0x01,0x07,0x0d,0x1e,0x01,
+    0x0b,0x02,0x00,0x08,0x76,0x00,0x06,0x20,0x01,0x0a,0x18,0x00,0x0f,0x8e,0x00,0x1e,
+    0x12,0x29,0x78,0x00,0x0f,0x02,0x00,0x03,0x2b,0x5f,0x29,0x83,0x00,0x07,0x02,0x00,
+    0x0e,0x7a,0x00,0x0f,0x14,0x00,0x01,0x04,0x1c,0x01,0x0c,0x02,0x00,0x0b,0x7f,0x04,
+    0x12,0x00,0x20,0x00,0x1b,0x3f,0x4c,0x03,0x0a,0x02,0x00,0x13,0x3f,0x26,0x00,0xa6,
+    0xff,0xbd,0x9f,0x52,0x7f,0x08,0x7f,0x08,0x9f,0x52,0xbc,0x01,0x0c,0x8e,0x00,0x0f,
+    0x10,0x00,0x01,0x0f,0x8e,0x00,0x42,0x16,0xbd,0x42,0x01,0x24,0x5f,0x29,0x90,0x00,
+    0x0c,0x7e,0x00,0x0f,0x1c,0x01,0x31,0x06,0x68,0x00,0x0f,0x02,0x00,0x01,0x02,0xaa,
+    0x01,0x19,0x9f,0x02,0x04,0x2f,0x9f,0x52,0x7a,0x00,0x01,0x04,0x02,0x00,0x0a,0xa6,
+    0x00,0x0f,0x1c,0x01,0x1d,0x0f,0xc6,0x02,0x11,0x28,0x7f,0x08,0xaa,0x00,0x2e,0x7f,
+    0x08,0x8e,0x00,0x08,0x02,0x00,0x08,0x92,0x00,0x0f,0x8e,0x00,0x1d,0x0f,0xe2,0x03,
+    0x11,0x0f,0x8e,0x00,0x0d,0x0c,0x02,0x00,0x05,0x92,0x00,0x50,0xff,0xff,0xff,0xe0,
+    0x07,0x3f,0xe0,0x07,0xff,0x01,0x00,0x00,0x1b,0x00,0x01,0x00,0x04,0x23,0x00,0x4f,
+    0x5f,0x6b,0x1f,0x00,0x02,0x00,0x03,0x22,0x5f,0x6b,0x24,0x00,0x28,0x9f,0x52,0x20,
+    0x00,0x22,0x9f,0x52,0x16,0x00,0x22,0x00,0xf8,0x04,0x00,0x0f,0x02,0x00,0x01,0x06,
+    0x1c,0x00,0x2f,0xe0,0x07,0x8e,0x00,0x1b,0x39,0x3f,0xe7,0xbf,0x6e,0x00,0x04,0x02,
+    0x00,0x43,0xbf,0x52,0x3f,0xe7,0x6a,0x00,0x34,0xbd,0x5f,0x29,0x16,0x00,0x42,0x5f,
+    0x29,0xff,0xbd,0x16,0x00,0x02,0x72,0x00,0x0f,0x02,0x00,0x05,0x02,0x20,0x00,0x0f,
+    0x8e,0x00,0x1f,0x4e,0xff,0xff,0x3f,0xe7,0x20,0x01,0x25,0x5f,0x6b,0x8c,0x00,0xd4,
+    0xff,0xff,0xff,0xff,0xbd,0x9f,0x52,0x7f,0x08,0x7f,0x08,0x9f,0x52,0x8c,0x00,0x04,
+    0x6e,0x00,0x0f,0x02,0x00,0x07,0x0f,0x8e,0x00,0x0b,0x0f,0x02,0x00,0x0c,0xd6,0xbd,
+    0x5f,0x6b,0x5f,0x29,0x3f,0x00,0x3f,0x00,0x5f,0x29,0x5f,0x6b,0x74,0x00,0x0f,0x02,
+    0x00,0x07,0x0f,0x16,0x01,0x05,0x06,0x02,0x00,0x0f,0x8e,0x00,0x28,0x0f,0x02,0x00,
+    0x44,0x0f,0x38,0x02,0x05,0x0f,0x02,0x00,0x63,0x0e,0x8e,0x00,0xac,0x7d,0xef,0xba,
+    0xd6,0x59,0xce,0xdb,0xde,0xbe,0xf7,0x92,0x00,0x0b,0x67,0x03,0x0f,0x02,0x00,0x3c,
+    0x0c,0xaa,0x01,0x64,0x59,0xce,0x4d,0x6b,0x04,0x21,0x65,0x00,0x6c,0x20,0x00,0xc7,
+    0x39,0x14,0xa5,0x92,0x00,0x0f,0x02,0x00,0x4b,0x06,0x1c,0x01,0x24,0x69,0x4a,0x88,
+    0x00,0x08,0x02,0x00,0x3d,0x08,0x42,0x9e,0x24,0x01,0x0f,0x02,0x00,0x47,0x06,0x8e,
+    0x00,0x26,0xa2,0x10,0x86,0x00,0x16,0x20,0x0b,0x00,0x23,0x00,0xaa,0xc0,0x04,0x0f,
+    0x02,0x00,0x51,0x06,0x8e,0x00,0xf6,0x01,0xc3,0x18,0x00,0x00,0x00,0x00,0xc3,0x18,
+    0xb6,0xb5,0xbe,0xf7,0xdf,0xff,0x18,0xc6,0xb4,0x01,0x2f,0x9a,0xd6,0x8a,0x00,0x51,
+    0x0a,0x38,0x02,0x11,0xe3,0x8e,0x00,0x22,0xcb,0x5a,0x18,0x00,0x44,0xff,0xff,0xd7,
+    0xbd,0x21,0x01,0x24,0x71,0x8c,0x14,0x00,0x04,0x02,0x00,0xf4,0x01,0x5d,0xef,0x51,
+    0x8c,0x08,0x42,0x04,0x21,0xc3,0x18,0x45,0x29,0x0c,0x63,0x38,0xc6,0x18,0x00,0x0f,
+    0x02,0x00,0x2d,0x06,0x1c,0x01,0x84,0x08,0x42,0x04,0x21,0x04,0x21,0x92,0x94,0x52,
+    0x00,0x24,0xbe,0xf7,0x8e,0x00,0x24,0xae,0x73,0x14,0x00,0x02,0x02,0x00,0x28,0x55,
+    0xad,0xca,0x01,0x62,0x00,0x00,0x00,0x00,0x10,0x84,0x1a,0x00,0x0f,0x02,0x00,0x2d,
+    0x06,0x8e,0x00,0x08,0x02,0x00,0x62,0x9e,0xf7,0x5d,0xef,0x5d,0xef,0x6a,0x00,0x33,
+    0x00,0x00,0x6d,0x10,0x07,0x04,0x02,0x00,0xd3,0x92,0x94,0x00,0x00,0x00,0x00,0xe3,
+    0x18,0x8e,0x73,0xcf,0x7b,0x24,0x84,0x03,0x0f,0x20,0x01,0x33,0x0a,0x8e,0x00,0x6c,
+    0x75,0xad,0xcb,0x5a,0xe3,0x18,0xfa,0x00,0x0c,0x8e,0x00,0x11,0xb2,0x8e,0x00,0x11,
+    0xf7,0x10,0x07,0x9b,0x5d,0xef,0x61,0x08,0x00,0x00,0x00,0x00,0x8e,0x40,0x01,0x0f,
+    0x02,0x00,0x09,0x22,0x00,0x00,0x04,0x00,0x04,0x06,0x00,0x06,0x08,0x00,0x06,0x8e,
+    0x00,0x44,0x1c,0xe7,0xa6,0x31,0x0e,0x01,0x0a,0x02,0x00,0x0c,0x8e,0x00,0x82,0xf7,
+    0xbd,0xcb,0x5a,0xcb,0x5a,0x7d,0xef,0x72,0x00,0x2f,0xc7,0x39,0x7a,0x03,0x34,0x50,
+    0xff,0xff,0xff,0xe0,0x07,0xb3,0xe0,0x07,0xff,0xff,0xff,0xff,0x9e,0xf7,0x04,0x21,
+    0x00,0x01,0x00,0x83,0xa2,0x10,0xe7,0x39,0x28,0x42,0x28,0x42,0x0f,0x00,0x4d,0x00,
+    0x6d,0x6b,0xff,0x01,0x00,0xfc,0x03,0x7d,0xef,0x55,0xad,0x30,0x84,0x8e,0x73,0x6d,
+    0x6b,0xc3,0x18,0x00,0x00,0x00,0x00,0x8a,0x52,0x23,0x00,0xac,0x5d,0xef,0x14,0xa5,
+    0x10,0x84,0x92,0x94,0x1c,0xe7,0x1a,0x00,0x0f,0x02,0x00,0x07,0x22,0xe0,0x07,0x8e,
+    0x00,0x24,0x30,0x84,0x7c,0x00,0x33,0x30,0x84,0xdf,0x2f,0x00,0x04,0x12,0x00,0x0e,
+    0x8e,0x00,0x34,0xef,0x7b,0x20,0x1d,0x00,0x03,0x02,0x00,0x0c,0x8e,0x00,0xe3,0x7d,
+    0xef,0x20,0x00,0x00,0x00,0xe3,0x18,0x00,0x00,0x20,0x00,0xf7,0xbd,0x51,0x00,0x0f,
+    0x02,0x00,0x0e,0x04,0x8e,0x00,0x13,0x08,0x0a,0x01,0x26,0x45,0x29,0x33,0x00,0x03,
+    0x69,0x00,0x0d,0x1c,0x01,0x22,0xef,0x7b,0x1a,0x00,0x7f,0x08,0x42,0x8e,0x73,0xae,
+    0x73,0xe3,0x1c,0x01,0x02,0xe6,0x5d,0xef,0x00,0x00,0x10,0x84,0xff,0xff,0x14,0xa5,
+    0x00,0x00,0x49,0x4a,0x54,0x00,0x62,0xff,0xff,0xff,0xff,0x00,0x00,0x04,0x00,0x04,
+    0x06,0x00,0x06,0x08,0x00,0x04,0x8e,0x00,0x22,0x65,0x29,0x62,0x00,0x22,0xa6,0x31,
+    0x32,0x00,0x42,0xff,0xff,0xba,0xd6,0x12,0x00,0x0c,0x1c,0x01,0xa2,0xdf,0xff,0x41,
+    0x08,0x00,0x00,0x00,0x00,0x8e,0x73,0x2a,0x00,0x2f,0xe7,0x39,0xaa,0x01,0x03,0xb7,
+    0xfb,0xde,0xb6,0xb5,0xf3,0x9c,0xcf,0x7b,0x00,0x00,0x65,0xe2,0x00,0x0f,0x02,0x00,
+    0x0b,0x04,0x8e,0x00,0x24,0x49,0x4a,0x7c,0x00,0xa4,0x71,0x8c,0x3c,0xe7,0xfb,0xde,
+    0x92,0x94,0x82,0x10,0x12,0x00,0x19,0x4d,0x38,0x02,0x22,0x3c,0xe7,0x18,0x00,0x91,
+    0x55,0xad,0xff,0xff,0xff,0xff,0xdf,0xff,0x45,0xc8,0x00,0x0e,0xaa,0x01,0x8f,0x86,
+    0x31,0x00,0x00,0x04,0x21,0x24,0x21,0x8e,0x00,0x21,0x22,0xd3,0x9c,0x64,0x00,0x0f,
+    0x02,0x00,0x03,0x44,0x04,0x21,0x96,0xb5,0xd6,0x00,0x22,0xbe,0xf7,0x34,0x02,0x71,
+    0x45,0x29,0x34,0xa5,0xf3,0x9c,0xc7,0x1a,0x01,0x64,0x00,0x00,0xe7,0x39,0xfb,0xde,
+    0x22,0x00,0xee,0xff,0xff,0xff,0xff,0x92,0x94,0x00,0x00,0xcb,0x5a,0xff,0xff,0x79,
+    0xce,0x8e,0x00,0x0f,0xaa,0x01,0x0f,0x13,0xdf,0x72,0x01,0x06,0x02,0x00,0x24,0x49,
+    0x4a,0x6a,0x00,0x62,0x00,0x00,0x00,0x00,0xd3,0x9c,0x66,0x00,0x62,0xff,0xff,0xff,
+    0xff,0x4d,0x6b,0x14,0x00,0x02,0x02,0x00,0x02,0x38,0x02,0x62,0x00,0x00,0x00,0x00,
+    0x9e,0xf7,0x20,0x00,0x04,0xde,0x00,0xb9,0x45,0x29,0xd3,0x9c,0x08,0x42,0x00,0x00,
+    0xe3,0x18,0xdb,0xaa,0x00,0x0f,0x02,0x00,0x07,0x04,0xaa,0x01,0x62,0xff,0xff,0xbe,
+    0xf7,0x6d,0x6b,0x12,0x02,0xa2,0x00,0x00,0x41,0x08,0xcf,0x7b,0xdf,0xff,0x71,0x8c,
+    0x66,0x00,0x0c,0x8e,0x00,0x42,0xbe,0xf7,0x2c,0x63,0x20,0x01,0x55,0x82,0x10,0x14,
+    0xa5,0xf3,0x56,0x01,0x08,0x8e,0x00,0x22,0xbe,0xf7,0x18,0x03,0x11,0xcf,0x7e,0x03,
+    0x28,0x0c,0x63,0x82,0x00,0x0f,0x1c,0x01,0x0f,0x02,0x02,0x00,0x88,0xbe,0xf7,0x18,
+    0xc6,0x96,0xb5,0x18,0xc6,0x58,0x00,0x0f,0x02,0x00,0x03,0x64,0x9e,0xf7,0x38,0xc6,
+    0x79,0xce,0x0c,0x04,0x0f,0x02,0x00,0x03,0x4f,0x5d,0xef,0x7d,0xef,0x1a,0x00,0x03,
+    0x0f,0x02,0x00,0x05,0x06,0x1c,0x01,0x0f,0x02,0x00,0x71,0x04,0x8e,0x00,0xf4,0x2d,
+    0xfe,0x07,0xfc,0x07,0xfa,0x07,0xf8,0x07,0xf6,0x07,0xf3,0x07,0xf1,0x07,0xef,0x07,
+    0xed,0x07,0xeb,0x07,0xe9,0x07,0xe7,0x07,0xe5,0x07,0xe2,0x07,0xe0,0x07,0xe0,0x0f,
+    0xe0,0x1f,0xe0,0x37,0xe0,0x47,0xe0,0x57,0xe0,0x67,0xe0,0x77,0xe0,0x87,0xe0,0x97,
+    0xe0,0xaf,0xe0,0xbf,0xe0,0xcf,0xe0,0xdf,0xe0,0xef,0xe0,0xff,0x02,0x00,0xf7,0x28,
+    0xe1,0xff,0xe2,0xff,0xe3,0xff,0xe4,0xff,0xe5,0xff,0xe6,0xff,0xe7,0xff,0xe9,0xff,
+    0xea,0xff,0xeb,0xff,0xec,0xff,0xed,0xff,0xee,0xff,0xef,0xff,0xf0,0xff,0xf1,0xff,
+    0xf2,0xff,0xf3,0xff,0xf4,0xff,0xf5,0xff,0xf6,0xff,0xf8,0xff,0xf9,0xff,0xfa,0xff,
+    0xfb,0xff,0xfc,0xff,0xfd,0xff,0xfe,0x07,0x01,0x0f,0x8e,0x00,0x45,0x1f,0xe8,0x8e,
+    0x00,0x34,0x1f,0xf4,0x1c,0x01,0x32,0x0f,0x8e,0x00,0xc3,0x0f,0x38,0x02,0x7b,0x0a,
+    0xaa,0x01,0x1f,0xe4,0xc6,0x02,0x57,0x50,0xff,0xff,0xff,0xe0,0x07,0xf4,0x33,0xe0,
+    0x07,0xff,0xff,0xff,0xff,0xfe,0x07,0xfc,0x07,0xfa,0x07,0xf8,0x07,0xf6,0x07,0xf4,
+    0x07,0xf1,0x07,0xef,0x07,0xed,0x07,0xeb,0x07,0xe9,0x07,0xe7,0x07,0xe5,0x07,0xe2,
+    0x07,0xe0,0x07,0xe0,0x0f,0xe0,0x1f,0xe0,0x37,0xe0,0x47,0xe0,0x57,0xe0,0x67,0xe0,
+    0x77,0xe0,0x87,0xe0,0x97,0xe0,0xaf,0xe0,0xbf,0xe0,0xcf,0xe0,0xdf,0xe0,0xef,0xe0,
+    0xff,0x02,0x00,0xf6,0x29,0xe1,0xff,0xe2,0xff,0xe3,0xff,0xe4,0xff,0xe5,0xff,0xe6,
+    0xff,0xe7,0xff,0xe9,0xff,0xea,0xff,0xeb,0xff,0xec,0xff,0xed,0xff,0xee,0xff,0xef,
+    0xff,0xf0,0xff,0xf1,0xff,0xf2,0xff,0xf3,0xff,0xf4,0xff,0xf5,0xff,0xf6,0xff,0xf8,
+    0xff,0xf9,0xff,0xfa,0xff,0xfb,0xff,0xfc,0xff,0xfd,0xff,0xfe,0xff,0x01,0x00,0x2f,
+    0xe0,0x07,0x8e,0x00,0x0b,0x1f,0xe4,0x8e,0x00,0x24,0x1f,0xe8,0x8e,0x00,0x4b,0x1f,
+    0x27,0x1c,0x01,0x63,0x19,0xf3,0xaa,0x01,0x05,0x1c,0x01,0x0f,0x8e,0x00,0x38,0x1f,
+    0xf7,0xaa,0x01,0x18,0x08,0x8e,0x00,0x16,0xe6,0x8e,0x00,0x0f,0x38,0x02,0x38,0x3f,
+    0xf7,0xff,0xf7,0x38,0x02,0x16,0x0f,0x8e,0x00,0x51,0x0f,0xc6,0x02,0x23,0x0f,0x1c,
+    0x01,0x43,0x0f,0x54,0x03,0x23,0x1f,0xe8,0x8e,0x00,0x07,0x1f,0x9f,0xe2,0x03,0x2b,
+    0x0f,0xaa,0x01,0x0d,0x0f,0x02,0x00,0x73,0x04,0x70,0x04,0x0f,0x02,0x00,0x73,0x0f,
+    0x8e,0x00,0x7f,0x0f,0x02,0x00,0x74,0x50,0x07,0xe0,0x07,0xe0,0x07,
+
+};
+
+const lv_image_dsc_t test_img_rgb565_lz4_blocks = {
+  .header = {
+    .magic = LV_IMAGE_HEADER_MAGIC,
+    .cf = LV_COLOR_FORMAT_RGB565,
+    .flags = 0 | LV_IMAGE_FLAGS_COMPRESSED,
+    .w = 71,
+    .h = 60,
+    .stride = 142,
+    .reserved_2 = 0,
+  },
+  .data_size = sizeof(test_img_rgb565_lz4_blocks_map),
+  .data = test_img_rgb565_lz4_blocks_map,
+  .reserved = NULL,
+};
+
@@ -224,6 +224,22 @@ static void cache_eviction_test(lv_cache_t * cache, test_data_t * expected_data,
     TEST_ASSERT_EQUAL(9, original_entries_found_cnt);
 }
 
+static uint32_t hash_cb(const test_data_t * key)
+{
+    return (uint32_t)key->key1;
+}
+
+static lv_cache_t * create_sharded_cache(const lv_cache_class_t * cache_class, size_t max_size, uint32_t shard_cnt)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+    };
+    return lv_cache_create_sharded(cache_class, sizeof(test_data_t), max_size, shard_cnt,
+                                   (lv_cache_hash_cb_t)hash_cb, ops);
+}
+
 void test_cache_lru_rb_count_add_acquire(void)
 {
     lv_cache_t * cache = create_cache(&lv_cache_class_lru_rb_count, CACHE_EXPECTED_DATA_CNT);
@@ -361,4 +377,233 @@ void test_cache_entry_alloc_unaligned_node_size(void)
         lv_cache_destroy(cache, NULL);
     }
 }
+
+void test_cache_sharded_add_acquire(void)
+{
+    /*Each shard can hold all the entries hashed to it*/
+    lv_cache_t * cache = create_sharded_cache(&lv_cache_class_lru_rb_count, 4 * CACHE_EXPECTED_DATA_CNT, 4);
+    TEST_ASSERT_NOT_NULL(cache);
+    TEST_ASSERT_EQUAL(4, cache->shard_cnt);
+
+    test_data_t expected_data[CACHE_EXPECTED_DATA_CNT];
+    cache_add_acquire_test(cache, expected_data, CACHE_EXPECTED_DATA_CNT);
+    TEST_ASSERT_EQUAL(CACHE_EXPECTED_DATA_CNT, lv_cache_get_size(cache, NULL));
+    TEST_ASSERT_EQUAL(3 * CACHE_EXPECTED_DATA_CNT, lv_cache_get_free_size(cache, NULL));
+
+    /*The entries are in the shard picked by the hash*/
+    for(size_t i = 0; i < CACHE_EXPECTED_DATA_CNT; ++i) {
+        lv_cache_entry_t * entry = lv_cache_acquire(cache, &expected_data[i], NULL);
+        TEST_ASSERT_EQUAL_PTR(cache->shards[i % 4], lv_cache_entry_get_cache(entry));
+        lv_cache_release(cache, entry, NULL);
+    }
+
+    uint32_t iter_cnt = 0;
+    void * elem = lv_malloc(lv_cache_entry_get_size(sizeof(test_data_t)));
+    lv_iter_t * iter = lv_cache_iter_create(cache);
+    TEST_ASSERT_NOT_NULL(iter);
+    while(lv_iter_next(iter, elem) == LV_RESULT_OK) iter_cnt++;
+    lv_iter_destroy(iter);
+    lv_free(elem);
+    TEST_ASSERT_EQUAL(CACHE_EXPECTED_DATA_CNT, iter_cnt);
+
+    lv_cache_drop(cache, &expected_data[0], NULL);
+    TEST_ASSERT_NULL(lv_cache_acquire(cache, &expected_data[0], NULL));
+    TEST_ASSERT_TRUE(lv_cache_evict_one(cache, NULL));
+    TEST_ASSERT_EQUAL(CACHE_EXPECTED_DATA_CNT - 2, lv_cache_get_size(cache, NULL));
+
+    lv_cache_drop_all(cache, NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+    TEST_ASSERT_FALSE(lv_cache_evict_one(cache, NULL));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_sharded_max_size(void)
+{
+    lv_cache_t * cache = create_sharded_cache(&lv_cache_class_lru_rb_count, 10, 4);
+    TEST_ASSERT_NOT_NULL(cache);
+
+    /*Any shard can grow up to the max size, but together they don't exceed it*/
+    TEST_ASSERT_EQUAL(10, lv_cache_get_max_size(cache->shards[0], NULL));
+    TEST_ASSERT_EQUAL(10, lv_cache_get_max_size(cache->shards[3], NULL));
+    int32_t i;
+    for(i = 0; i < 20; i++) {
+        test_data_t key = { .key1 = i, .key2 = i + 1 };
+        lv_cache_entry_t * entry = lv_cache_add(cache, &key, NULL);
+        TEST_ASSERT_NOT_NULL(entry);
+        lv_cache_release(cache, entry, NULL);
+    }
+    TEST_ASSERT_EQUAL(10, lv_cache_get_size(cache, NULL));
+    lv_cache_reserve(cache, 4, NULL);
+    TEST_ASSERT_EQUAL(6, lv_cache_get_size(cache, NULL));
+
+    lv_cache_set_max_size(cache, 0, NULL);
+    TEST_ASSERT_FALSE(lv_cache_is_enabled(cache));
+    test_data_t key = { .key1 = 1, .key2 = 2 };
+    TEST_ASSERT_NULL(lv_cache_add(cache, &key, NULL));
+
+    lv_cache_destroy(cache, NULL);
+
+    /*Less than 2 shards is a normal cache*/
+    cache = create_sharded_cache(&lv_cache_class_lru_rb_count, 10, 1);
+    TEST_ASSERT_NOT_NULL(cache);
+    TEST_ASSERT_NULL(cache->shards);
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_2q_count_add_acquire(void)
+{
+    lv_cache_t * cache = create_cache(&lv_cache_class_2q_count, CACHE_EXPECTED_DATA_CNT);
+    test_data_t expected_data[CACHE_EXPECTED_DATA_CNT];
+    cache_add_acquire_test(cache, expected_data, CACHE_EXPECTED_DATA_CNT);
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_2q_count_eviction(void)
+{
+    lv_cache_t * cache = create_cache(&lv_cache_class_2q_count, CACHE_EXPECTED_DATA_CNT);
+    test_data_t expected_data[CACHE_EXPECTED_DATA_CNT];
+    cache_eviction_test(cache, expected_data, CACHE_EXPECTED_DATA_CNT);
+    lv_cache_destroy(cache, NULL);
+}
+
+/*Look up an entry and add it on miss, the way the image decoders use the cache*/
+static void use_entry(lv_cache_t * cache, int32_t key, size_t size, uint32_t cost)
+{
+    test_data_t search_key = { .slot.size = size, .key1 = key, .key2 = key + 1 };
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+    if(entry == NULL) {
+        entry = lv_cache_add(cache, &search_key, NULL);
+        TEST_ASSERT_NOT_NULL(entry);
+        lv_cache_entry_set_cost(entry, cost);
+    }
+    lv_cache_release(cache, entry, NULL);
+}
+
+static bool has_entry(lv_cache_t * cache, int32_t key)
+{
+    test_data_t search_key = { .key1 = key, .key2 = key + 1 };
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    lv_cache_release(cache, entry, NULL);
+    return true;
+}
+
+void test_cache_2q_scan_resistance(void)
+{
+    /*The hash lets the cache remember the entries evicted from the new entries' queue*/
+    lv_cache_t * cache = create_sharded_cache(&lv_cache_class_2q_count, 8, 1);
+    TEST_ASSERT_NOT_NULL(cache);
+    int32_t i;
+
+    /*The hot entries are evicted once, but they are added again soon after*/
+    for(i = 0; i < 4; i++) use_entry(cache, i, 1, 0);
+    for(i = 100; i < 108; i++) use_entry(cache, i, 1, 0);
+    for(i = 0; i < 4; i++) TEST_ASSERT_FALSE(has_entry(cache, i));
+    for(i = 0; i < 4; i++) use_entry(cache, i, 1, 0);
+
+    /*Scanning through many entries doesn't evict them*/
+    for(i = 200; i < 300; i++) use_entry(cache, i, 1, 0);
+    for(i = 0; i < 4; i++) TEST_ASSERT_TRUE(has_entry(cache, i));
+    TEST_ASSERT_FALSE(has_entry(cache, 200));
+    TEST_ASSERT_EQUAL(8, lv_cache_get_size(cache, NULL));
+
+    /*The iterator returns all the entries*/
+    uint32_t iter_cnt = 0;
+    void * elem = lv_malloc(lv_cache_entry_get_size(sizeof(test_data_t)));
+    lv_iter_t * iter = lv_cache_iter_create(cache);
+    TEST_ASSERT_NOT_NULL(iter);
+    while(lv_iter_next(iter, elem) == LV_RESULT_OK) iter_cnt++;
+    lv_iter_destroy(iter);
+    lv_free(elem);
+    TEST_ASSERT_EQUAL(8, iter_cnt);
+
+    lv_cache_destroy(cache, NULL);
+
+    /*Without hash the entries used again while cached are protected*/
+    cache = create_cache(&lv_cache_class_2q_count, 8);
+    TEST_ASSERT_NOT_NULL(cache);
+    for(i = 0; i < 4; i++) use_entry(cache, i, 1, 0);
+    for(i = 0; i < 4; i++) use_entry(cache, i, 1, 0);
+    for(i = 200; i < 300; i++) use_entry(cache, i, 1, 0);
+    for(i = 0; i < 4; i++) TEST_ASSERT_TRUE(has_entry(cache, i));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_2q_cost(void)
+{
+    lv_cache_t * cache = create_sharded_cache(&lv_cache_class_2q_size, 100, 1);
+    TEST_ASSERT_NOT_NULL(cache);
+
+    /*The oldest entry is expensive to recreate, so the cheaper ones are evicted instead*/
+    use_entry(cache, 0, 25, 100);
+    use_entry(cache, 1, 25, 0);
+    use_entry(cache, 2, 25, 0);
+    use_entry(cache, 3, 25, 0);
+    use_entry(cache, 4, 25, 0);
+    TEST_ASSERT_TRUE(has_entry(cache, 0));
+    TEST_ASSERT_FALSE(has_entry(cache, 1));
+
+    use_entry(cache, 5, 25, 0);
+    use_entry(cache, 6, 25, 0);
+    TEST_ASSERT_TRUE(has_entry(cache, 0));
+    TEST_ASSERT_FALSE(has_entry(cache, 2));
+    TEST_ASSERT_FALSE(has_entry(cache, 3));
+
+    /*But not forever*/
+    int32_t i;
+    for(i = 10; i < 30; i++) use_entry(cache, i, 25, 0);
+    TEST_ASSERT_FALSE(has_entry(cache, 0));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_hit_rate(void)
+{
+    lv_cache_t * cache = create_sharded_cache(&lv_cache_class_lru_rb_count, CACHE_EXPECTED_DATA_CNT, 4);
+    TEST_ASSERT_NOT_NULL(cache);
+
+    int32_t i;
+    for(i = 0; i < 4; i++) use_entry(cache, i, 1, 0);
+    for(i = 0; i < 4; i++) use_entry(cache, i, 1, 0);
+    TEST_ASSERT_FALSE(has_entry(cache, 100));
+
+    /*Summed up from the shards*/
+    TEST_ASSERT_EQUAL(4, lv_cache_get_hit_cnt(cache));
+    TEST_ASSERT_EQUAL(5, lv_cache_get_miss_cnt(cache));
+
+    lv_cache_reset_stats(cache);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_hit_cnt(cache));
+    TEST_ASSERT_EQUAL(0, lv_cache_get_miss_cnt(cache));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_sharded_large_entry(void)
+{
+    lv_cache_t * cache = create_sharded_cache(&lv_cache_class_lru_rb_size, 100, 4);
+    TEST_ASSERT_NOT_NULL(cache);
+
+    /*Larger than max_size / shard_cnt, the other shards make room for it*/
+    int32_t i;
+    for(i = 0; i < 4; i++) use_entry(cache, i, 20, 0);
+    use_entry(cache, 4, 70, 0);
+    TEST_ASSERT_TRUE(has_entry(cache, 4));
+    TEST_ASSERT_TRUE(has_entry(cache, 3));
+    TEST_ASSERT_FALSE(has_entry(cache, 0));
+    TEST_ASSERT_FALSE(has_entry(cache, 1));
+    TEST_ASSERT_EQUAL(90, lv_cache_get_size(cache, NULL));
+
+    /*Even if it fills the whole cache*/
+    use_entry(cache, 5, 100, 0);
+    TEST_ASSERT_TRUE(has_entry(cache, 5));
+    TEST_ASSERT_EQUAL(100, lv_cache_get_size(cache, NULL));
+
+    test_data_t key = { .slot.size = 101, .key1 = 6, .key2 = 7 };
+    TEST_ASSERT_NULL(lv_cache_add(cache, &key, NULL));
+
+    lv_cache_destroy(cache, NULL);
+}
 #endif
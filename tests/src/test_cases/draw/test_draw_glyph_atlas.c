@@ -0,0 +1,156 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_GLYPH_ATLAS && LV_FONT_MONTSERRAT_28_COMPRESSED && LV_FONT_MONTSERRAT_48 && LV_FONT_MONTSERRAT_46 && \
+    LV_FONT_MONTSERRAT_44 && LV_FONT_MONTSERRAT_42 && LV_FONT_MONTSERRAT_40 && LV_FONT_MONTSERRAT_38 && \
+    LV_FONT_MONTSERRAT_36
+
+void setUp(void)
+{
+    lv_draw_glyph_atlas_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_buf_t * create_glyph_buf(const lv_font_glyph_dsc_t * g)
+{
+    lv_draw_buf_t * buf = lv_draw_buf_create(g->box_w, g->box_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(buf);
+    return buf;
+}
+
+/*Check that the glyph in the atlas is the same as the glyph rendered by the font*/
+static void check_glyph(const lv_font_t * font, uint32_t letter, lv_draw_glyph_atlas_glyph_t * glyph)
+{
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, letter, 0));
+
+    lv_draw_buf_t * buf = create_glyph_buf(&g);
+    TEST_ASSERT_TRUE(lv_draw_glyph_atlas_acquire(&g, buf, glyph));
+
+    lv_draw_buf_t * ref = create_glyph_buf(&g);
+    TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(&g, ref));
+    int32_t y;
+    for(y = 0; y < g.box_h; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(ref->data + y * lv_draw_buf_width_to_stride(g.box_w, LV_COLOR_FORMAT_A8),
+                                 glyph->data + y * glyph->stride, g.box_w);
+    }
+
+    lv_font_glyph_release_draw_data(&g);
+    lv_draw_buf_destroy(buf);
+    lv_draw_buf_destroy(ref);
+}
+
+static bool is_stored(const lv_font_t * font, uint32_t letter)
+{
+    lv_draw_glyph_atlas_t * atlas = &LV_GLOBAL_DEFAULT()->glyph_atlas;
+    uint32_t miss_cnt = atlas->miss_cnt;
+
+    lv_draw_glyph_atlas_glyph_t glyph;
+    check_glyph(font, letter, &glyph);
+    lv_draw_glyph_atlas_release(&glyph);
+
+    return atlas->miss_cnt == miss_cnt;
+}
+
+void test_draw_glyph_atlas_glyphs(void)
+{
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_28_compressed};
+    uint32_t i;
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        TEST_ASSERT_FALSE(is_stored(fonts[i], 'A'));
+        TEST_ASSERT_FALSE(is_stored(fonts[i], 'g'));
+        TEST_ASSERT_TRUE(is_stored(fonts[i], 'A'));
+        TEST_ASSERT_TRUE(is_stored(fonts[i], 'g'));
+    }
+
+    /*Only the glyphs of the given font are dropped*/
+    lv_draw_glyph_atlas_drop(&lv_font_montserrat_14);
+    TEST_ASSERT_FALSE(is_stored(&lv_font_montserrat_14, 'A'));
+    TEST_ASSERT_TRUE(is_stored(&lv_font_montserrat_28_compressed, 'A'));
+}
+
+void test_draw_glyph_atlas_evict(void)
+{
+    /*More glyphs than the default pages can hold*/
+    const lv_font_t * fonts[] = {&lv_font_montserrat_48, &lv_font_montserrat_46, &lv_font_montserrat_44,
+                                 &lv_font_montserrat_42, &lv_font_montserrat_40, &lv_font_montserrat_38,
+                                 &lv_font_montserrat_36
+                                };
+
+    uint32_t i;
+    uint32_t letter;
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        for(letter = '!'; letter <= '~'; letter++) is_stored(fonts[i], letter);
+    }
+
+    /*The least recently used pages were cleared*/
+    TEST_ASSERT_TRUE(is_stored(&lv_font_montserrat_36, '~'));
+    uint32_t stored_cnt = 0;
+    for(letter = '!'; letter <= '~'; letter++) {
+        if(is_stored(&lv_font_montserrat_48, letter)) stored_cnt++;
+    }
+    TEST_ASSERT_LESS_THAN('~' - '!' + 1, stored_cnt);
+
+    /*An acquired glyph is not evicted*/
+    lv_draw_glyph_atlas_glyph_t kept;
+    check_glyph(&lv_font_montserrat_48, 'W', &kept);
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        for(letter = '!'; letter <= '~'; letter++) is_stored(fonts[i], letter);
+    }
+
+    TEST_ASSERT_TRUE(is_stored(&lv_font_montserrat_48, 'W'));
+    lv_draw_glyph_atlas_release(&kept);
+}
+
+void test_draw_glyph_atlas_redraw(void)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_label_set_text(label, "The quick brown fox\njumps over the lazy dog");
+    lv_obj_center(label);
+
+    lv_draw_glyph_atlas_t * atlas = &LV_GLOBAL_DEFAULT()->glyph_atlas;
+    lv_refr_now(NULL);
+    uint32_t miss_cnt = atlas->miss_cnt;
+    uint32_t hit_cnt = atlas->hit_cnt;
+    TEST_ASSERT_NOT_EQUAL(0, miss_cnt);
+
+    /*The glyphs are not rendered again*/
+    lv_obj_invalidate(label);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/glyph_atlas.png");
+    TEST_ASSERT_EQUAL(miss_cnt, atlas->miss_cnt);
+    TEST_ASSERT_GREATER_THAN(hit_cnt, atlas->hit_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_glyph_atlas_glyphs(void)
+{
+}
+
+void test_draw_glyph_atlas_evict(void)
+{
+}
+
+void test_draw_glyph_atlas_redraw(void)
+{
+}
+
+#endif /*LV_USE_DRAW_GLYPH_ATLAS and the fonts*/
+
+#endif
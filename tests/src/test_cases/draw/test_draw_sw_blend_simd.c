@@ -0,0 +1,300 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW_SIMD
+
+/*Not a multiple of the pixels processed at once to test the end of the rows too*/
+#define W           37
+#define H           5
+#define STRIDE      (W * 4 + 12)
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+typedef enum {
+    TARGET_ARGB8888,
+    TARGET_XRGB8888,
+    TARGET_RGB565,
+    TARGET_L8,
+    TARGET_A8,
+} target_t;
+
+typedef enum {
+    SRC_COLOR,
+    SRC_ARGB8888,
+    SRC_RGB565,
+} src_t;
+
+static uint8_t dest_ori[H * STRIDE];
+static uint8_t dest_ref[H * STRIDE];
+static uint8_t dest_simd[H * STRIDE];
+static uint8_t src[H * W * 4];
+static lv_opa_t mask[H * W];
+
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+/*Mostly the opacity values where the C implementation has special cases*/
+static lv_opa_t rnd_opa(void)
+{
+    static const lv_opa_t opas[] = {0, 1, 2, 3, 127, 128, 252, 253, 254, 255};
+    uint32_t r = rnd() % 16;
+    return r < sizeof(opas) ? opas[r] : (lv_opa_t)rnd();
+}
+
+static void init_buffers(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(dest_ori); i++) dest_ori[i] = (i % 4 == 3) ? rnd_opa() : (uint8_t)rnd();
+    for(i = 0; i < sizeof(src); i++) src[i] = (i % 4 == 3) ? rnd_opa() : (uint8_t)rnd();
+    for(i = 0; i < sizeof(mask); i++) mask[i] = rnd_opa();
+}
+
+/*The reference: the mixing functions of the C implementation in lv_draw_sw_blend_to_*.c*/
+
+static lv_color32_t mix_argb8888(lv_color32_t fg, lv_color32_t bg)
+{
+    if(fg.alpha >= LV_OPA_MAX || bg.alpha <= LV_OPA_MIN) return fg;
+    if(fg.alpha <= LV_OPA_MIN) return bg;
+
+    uint32_t res_opa = 255 - LV_OPA_MIX2(255 - fg.alpha, 255 - bg.alpha);
+    uint32_t ratio = (uint32_t)fg.alpha * 255 / res_opa;
+    lv_color32_t res;
+    if(ratio >= LV_OPA_MAX) res = fg;
+    else if(ratio <= LV_OPA_MIN) res = bg;
+    else {
+        res.red = LV_UDIV255(fg.red * ratio + bg.red * (255 - ratio));
+        res.green = LV_UDIV255(fg.green * ratio + bg.green * (255 - ratio));
+        res.blue = LV_UDIV255(fg.blue * ratio + bg.blue * (255 - ratio));
+    }
+    res.alpha = res_opa;
+    return res;
+}
+
+static void mix_xrgb8888(lv_color32_t fg, lv_color32_t * bg, lv_opa_t mix)
+{
+    if(mix == 0) return;
+    if(mix >= LV_OPA_MAX) {
+        bg->red = fg.red;
+        bg->green = fg.green;
+        bg->blue = fg.blue;
+    }
+    else {
+        bg->red = (fg.red * mix + bg->red * (255 - mix)) >> 8;
+        bg->green = (fg.green * mix + bg->green * (255 - mix)) >> 8;
+        bg->blue = (fg.blue * mix + bg->blue * (255 - mix)) >> 8;
+    }
+}
+
+static uint16_t mix_argb8888_to_rgb565(lv_color32_t fg, uint16_t bg, lv_opa_t mix)
+{
+    if(mix == 0) return bg;
+    if(mix == 255) return ((fg.red & 0xF8) << 8) + ((fg.green & 0xFC) << 3) + ((fg.blue & 0xF8) >> 3);
+
+    uint32_t mix_inv = 255 - mix;
+    return ((((fg.red >> 3) * mix + ((bg >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+           ((((fg.green >> 2) * mix + ((bg >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+           (((fg.blue >> 3) * mix + (bg & 0x1F) * mix_inv) >> 8);
+}
+
+static void blend_ref(target_t target, src_t src_type, lv_color_t color, lv_opa_t opa, bool masked)
+{
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < H; y++) {
+        for(x = 0; x < W; x++) {
+            lv_opa_t px_opa = opa;
+            if(masked) px_opa = opa >= LV_OPA_MAX ? mask[y * W + x] : LV_OPA_MIX2(mask[y * W + x], opa);
+
+            lv_color32_t fg = lv_color_to_32(color, 0xFF);
+            uint16_t fg16 = lv_color_to_u16(color);
+            if(src_type == SRC_ARGB8888) {
+                lv_memcpy(&fg, &src[(y * W + x) * 4], 4);
+                px_opa = masked ? LV_OPA_MIX3(fg.alpha, mask[y * W + x], opa) : LV_OPA_MIX2(fg.alpha, opa);
+                if(opa >= LV_OPA_MAX) px_opa = masked ? LV_OPA_MIX2(fg.alpha, mask[y * W + x]) : fg.alpha;
+            }
+            else if(src_type == SRC_RGB565) {
+                lv_memcpy(&fg16, &src[(y * W + x) * 2], 2);
+            }
+
+            uint8_t * dest = &dest_ref[y * STRIDE];
+            if(target == TARGET_L8) {
+                if(px_opa >= LV_OPA_MAX) dest[x] = lv_color_luminance(color);
+                else if(px_opa > 0) dest[x] = (lv_color_luminance(color) * px_opa + dest[x] * (255 - px_opa)) >> 8;
+            }
+            else if(target == TARGET_A8) {
+                if(dest[x] < px_opa) dest[x] = px_opa;
+            }
+            else if(target == TARGET_ARGB8888) {
+                lv_color32_t bg;
+                lv_memcpy(&bg, &dest[x * 4], 4);
+                fg.alpha = px_opa;
+                bg = mix_argb8888(fg, bg);
+                lv_memcpy(&dest[x * 4], &bg, 4);
+            }
+            else if(target == TARGET_XRGB8888) {
+                lv_color32_t bg;
+                lv_memcpy(&bg, &dest[x * 4], 4);
+                mix_xrgb8888(fg, &bg, px_opa);
+                lv_memcpy(&dest[x * 4], &bg, 4);
+            }
+            else {
+                uint16_t bg;
+                lv_memcpy(&bg, &dest[x * 2], 2);
+                if(src_type == SRC_ARGB8888) bg = mix_argb8888_to_rgb565(fg, bg, px_opa);
+                else bg = lv_color_16_16_mix(fg16, bg, px_opa);
+                lv_memcpy(&dest[x * 2], &bg, 2);
+            }
+        }
+    }
+}
+
+static void blend_simd(target_t target, src_t src_type, lv_color_t color, lv_opa_t opa, bool masked)
+{
+    lv_draw_sw_blend_fill_dsc_t fill_dsc;
+    lv_memzero(&fill_dsc, sizeof(fill_dsc));
+    fill_dsc.dest_buf = dest_simd;
+    fill_dsc.dest_w = W;
+    fill_dsc.dest_h = H;
+    fill_dsc.dest_stride = STRIDE;
+    fill_dsc.mask_buf = masked ? mask : NULL;
+    fill_dsc.mask_stride = W;
+    fill_dsc.color = color;
+    fill_dsc.opa = opa;
+
+    lv_draw_sw_blend_image_dsc_t image_dsc;
+    lv_memzero(&image_dsc, sizeof(image_dsc));
+    image_dsc.dest_buf = dest_simd;
+    image_dsc.dest_w = W;
+    image_dsc.dest_h = H;
+    image_dsc.dest_stride = STRIDE;
+    image_dsc.mask_buf = masked ? mask : NULL;
+    image_dsc.mask_stride = W;
+    image_dsc.src_buf = src;
+    image_dsc.src_stride = W * (src_type == SRC_RGB565 ? 2 : 4);
+    image_dsc.src_color_format = src_type == SRC_RGB565 ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_ARGB8888;
+    image_dsc.opa = opa;
+    image_dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+    lv_result_t res = LV_RESULT_INVALID;
+    switch(target) {
+        case TARGET_ARGB8888:
+            if(src_type == SRC_COLOR) res = lv_draw_sw_blend_simd_color_to_argb8888(&fill_dsc);
+            else res = lv_draw_sw_blend_simd_argb8888_to_argb8888(&image_dsc);
+            break;
+        case TARGET_XRGB8888:
+            if(src_type == SRC_COLOR) res = lv_draw_sw_blend_simd_color_to_rgb888(&fill_dsc, 4);
+            else res = lv_draw_sw_blend_simd_argb8888_to_rgb888(&image_dsc, 4);
+            break;
+        case TARGET_RGB565:
+            if(src_type == SRC_COLOR) res = lv_draw_sw_blend_simd_color_to_rgb565(&fill_dsc);
+            else if(src_type == SRC_RGB565) res = lv_draw_sw_blend_simd_rgb565_to_rgb565(&image_dsc);
+            else res = lv_draw_sw_blend_simd_argb8888_to_rgb565(&image_dsc);
+            break;
+        case TARGET_L8:
+            res = lv_draw_sw_blend_simd_color_to_l8(&fill_dsc);
+            break;
+        case TARGET_A8:
+            res = lv_draw_sw_blend_simd_color_to_a8(&fill_dsc);
+            break;
+    }
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, res);
+}
+
+static void check_all(target_t target, src_t src_type)
+{
+    static const lv_opa_t opas[] = {255, 254, 253, 200, 128, 3, 0};
+    uint32_t i;
+    uint32_t masked;
+    for(i = 0; i < sizeof(opas); i++) {
+        for(masked = 0; masked < 2; masked++) {
+            /*A plain fill is left to the C implementation*/
+            if(src_type == SRC_COLOR && opas[i] >= LV_OPA_MAX && !masked) continue;
+
+            init_buffers();
+            lv_color_t color = lv_color_make((uint8_t)rnd(), (uint8_t)rnd(), (uint8_t)rnd());
+            lv_memcpy(dest_ref, dest_ori, sizeof(dest_ori));
+            lv_memcpy(dest_simd, dest_ori, sizeof(dest_ori));
+            blend_ref(target, src_type, color, opas[i], masked);
+            blend_simd(target, src_type, color, opas[i], masked);
+            TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_simd, sizeof(dest_ref));
+        }
+    }
+}
+
+void test_draw_sw_blend_simd_to_argb8888(void)
+{
+    check_all(TARGET_ARGB8888, SRC_COLOR);
+    check_all(TARGET_ARGB8888, SRC_ARGB8888);
+}
+
+void test_draw_sw_blend_simd_to_xrgb8888(void)
+{
+    check_all(TARGET_XRGB8888, SRC_COLOR);
+    check_all(TARGET_XRGB8888, SRC_ARGB8888);
+}
+
+void test_draw_sw_blend_simd_to_rgb565(void)
+{
+    check_all(TARGET_RGB565, SRC_COLOR);
+    check_all(TARGET_RGB565, SRC_ARGB8888);
+    check_all(TARGET_RGB565, SRC_RGB565);
+}
+
+void test_draw_sw_blend_simd_to_l8(void)
+{
+    check_all(TARGET_L8, SRC_COLOR);
+}
+
+void test_draw_sw_blend_simd_to_a8(void)
+{
+    check_all(TARGET_A8, SRC_COLOR);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_blend_simd_to_argb8888(void)
+{
+}
+
+void test_draw_sw_blend_simd_to_xrgb8888(void)
+{
+}
+
+void test_draw_sw_blend_simd_to_rgb565(void)
+{
+}
+
+void test_draw_sw_blend_simd_to_l8(void)
+{
+}
+
+void test_draw_sw_blend_simd_to_a8(void)
+{
+}
+
+#endif /*LV_USE_DRAW_SW_SIMD*/
+
+#endif
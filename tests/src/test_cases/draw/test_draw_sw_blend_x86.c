@@ -0,0 +1,219 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+
+/*Not a multiple of the pixels processed at once to test the end of the rows too*/
+#define W           37
+#define H           5
+#define STRIDE      (W * 4 + 12)
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_blend_x86_init();
+}
+
+typedef enum {
+    TARGET_ARGB8888,
+    TARGET_XRGB8888,
+    TARGET_RGB565,
+} target_t;
+
+static uint8_t dest_ori[H * STRIDE];
+static uint8_t dest_ref[H * STRIDE];
+static uint8_t dest_x86[H * STRIDE];
+static lv_color32_t src[H * W];
+static lv_opa_t mask[H * W];
+
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+/*Mostly the opacity values where the C implementation has special cases*/
+static lv_opa_t rnd_opa(void)
+{
+    static const lv_opa_t opas[] = {0, 1, 2, 3, 127, 128, 252, 253, 254, 255};
+    uint32_t r = rnd() % 16;
+    return r < sizeof(opas) ? opas[r] : (lv_opa_t)rnd();
+}
+
+static void init_buffers(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(dest_ori); i++) dest_ori[i] = (i % 4 == 3) ? rnd_opa() : (uint8_t)rnd();
+    for(i = 0; i < W * H; i++) {
+        src[i].blue = (uint8_t)rnd();
+        src[i].green = (uint8_t)rnd();
+        src[i].red = (uint8_t)rnd();
+        src[i].alpha = rnd_opa();
+        mask[i] = rnd_opa();
+    }
+}
+
+static void blend_color(target_t target, lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    switch(target) {
+        case TARGET_ARGB8888:
+            lv_draw_sw_blend_color_to_argb8888(dsc);
+            break;
+        case TARGET_XRGB8888:
+            lv_draw_sw_blend_color_to_rgb888(dsc, 4);
+            break;
+        case TARGET_RGB565:
+            lv_draw_sw_blend_color_to_rgb565(dsc);
+            break;
+    }
+}
+
+static void blend_image(target_t target, lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    switch(target) {
+        case TARGET_ARGB8888:
+            lv_draw_sw_blend_image_to_argb8888(dsc);
+            break;
+        case TARGET_XRGB8888:
+            lv_draw_sw_blend_image_to_rgb888(dsc, 4);
+            break;
+        case TARGET_RGB565:
+            lv_draw_sw_blend_image_to_rgb565(dsc);
+            break;
+    }
+}
+
+/*Blend with the C implementation and with the supported instruction sets and compare the results*/
+static void check(target_t target, bool image, lv_opa_t opa, bool masked)
+{
+    lv_draw_sw_blend_fill_dsc_t fill_dsc;
+    lv_memzero(&fill_dsc, sizeof(fill_dsc));
+    fill_dsc.dest_w = W;
+    fill_dsc.dest_h = H;
+    fill_dsc.dest_stride = STRIDE;
+    fill_dsc.mask_buf = masked ? mask : NULL;
+    fill_dsc.mask_stride = W;
+    fill_dsc.color = lv_color_make((uint8_t)rnd(), (uint8_t)rnd(), (uint8_t)rnd());
+    fill_dsc.opa = opa;
+
+    lv_draw_sw_blend_image_dsc_t image_dsc;
+    lv_memzero(&image_dsc, sizeof(image_dsc));
+    image_dsc.dest_w = W;
+    image_dsc.dest_h = H;
+    image_dsc.dest_stride = STRIDE;
+    image_dsc.mask_buf = masked ? mask : NULL;
+    image_dsc.mask_stride = W;
+    image_dsc.src_buf = src;
+    image_dsc.src_stride = W * sizeof(lv_color32_t);
+    image_dsc.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+    image_dsc.opa = opa;
+    image_dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+    lv_memcpy(dest_ref, dest_ori, sizeof(dest_ori));
+    fill_dsc.dest_buf = dest_ref;
+    image_dsc.dest_buf = dest_ref;
+    TEST_ASSERT_EQUAL(LV_DRAW_SW_BLEND_X86_NONE, lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_BLEND_X86_NONE));
+    if(image) blend_image(target, &image_dsc);
+    else blend_color(target, &fill_dsc);
+
+    lv_draw_sw_blend_x86_level_t level;
+    for(level = LV_DRAW_SW_BLEND_X86_SSE41; level <= LV_DRAW_SW_BLEND_X86_AVX2; level++) {
+        if(lv_draw_sw_blend_x86_set_level(level) != level) continue;
+
+        lv_memcpy(dest_x86, dest_ori, sizeof(dest_ori));
+        fill_dsc.dest_buf = dest_x86;
+        image_dsc.dest_buf = dest_x86;
+        if(image) blend_image(target, &image_dsc);
+        else blend_color(target, &fill_dsc);
+
+        TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_x86, sizeof(dest_ref));
+    }
+}
+
+static void check_all(target_t target, bool image)
+{
+    static const lv_opa_t opas[] = {255, 254, 253, 200, 128, 3, 0};
+    uint32_t i;
+    for(i = 0; i < sizeof(opas); i++) {
+        init_buffers();
+        check(target, image, opas[i], false);
+        init_buffers();
+        check(target, image, opas[i], true);
+    }
+}
+
+void test_draw_sw_blend_x86_color_to_argb8888(void)
+{
+    check_all(TARGET_ARGB8888, false);
+}
+
+void test_draw_sw_blend_x86_image_to_argb8888(void)
+{
+    check_all(TARGET_ARGB8888, true);
+}
+
+void test_draw_sw_blend_x86_color_to_xrgb8888(void)
+{
+    check_all(TARGET_XRGB8888, false);
+}
+
+void test_draw_sw_blend_x86_image_to_xrgb8888(void)
+{
+    check_all(TARGET_XRGB8888, true);
+}
+
+void test_draw_sw_blend_x86_color_to_rgb565(void)
+{
+    check_all(TARGET_RGB565, false);
+}
+
+void test_draw_sw_blend_x86_image_to_rgb565(void)
+{
+    check_all(TARGET_RGB565, true);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_blend_x86_color_to_argb8888(void)
+{
+}
+
+void test_draw_sw_blend_x86_image_to_argb8888(void)
+{
+}
+
+void test_draw_sw_blend_x86_color_to_xrgb8888(void)
+{
+}
+
+void test_draw_sw_blend_x86_image_to_xrgb8888(void)
+{
+}
+
+void test_draw_sw_blend_x86_color_to_rgb565(void)
+{
+}
+
+void test_draw_sw_blend_x86_image_to_rgb565(void)
+{
+}
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86*/
+
+#endif
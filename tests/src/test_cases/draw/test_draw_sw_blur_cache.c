@@ -0,0 +1,111 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_SW_BLUR_CACHE_SIZE > 0
+
+#define CANVAS_WIDTH    200
+#define CANVAS_HEIGHT   150
+
+static lv_draw_buf_t * draw_buf;
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    draw_buf = lv_draw_buf_create(CANVAS_WIDTH, CANVAS_HEIGHT, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_draw_buf_destroy(draw_buf);
+}
+
+/**
+ * Draw a text on the canvas and blur the middle of it
+ * @param text          the text to blur
+ * @param blur_coords   the area to blur
+ * @return              the number of blurs restored from the cache while rendering
+ */
+static uint32_t canvas_render(const char * text, const lv_area_t * blur_coords)
+{
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->sw_blur_cache;
+    uint32_t hit_cnt = lv_cache_get_hit_cnt(cache);
+
+    lv_canvas_fill_bg(canvas, lv_color_hex3(0xccc), LV_OPA_COVER);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.color = lv_palette_main(LV_PALETTE_RED);
+    label_dsc.font = &lv_font_montserrat_14;
+    label_dsc.text = text;
+    lv_area_t label_coords = {10, 10, CANVAS_WIDTH - 10, CANVAS_HEIGHT - 10};
+    lv_draw_label(&layer, &label_dsc, &label_coords);
+
+    lv_draw_blur_dsc_t blur_dsc;
+    lv_draw_blur_dsc_init(&blur_dsc);
+    blur_dsc.blur_radius = 16;
+    blur_dsc.corner_radius = 10;
+    lv_draw_blur(&layer, &blur_dsc, blur_coords);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    return lv_cache_get_hit_cnt(cache) - hit_cnt;
+}
+
+void test_draw_sw_blur_cache(void)
+{
+    static const char * text = "Lorem ipsum dolor sit amet, consectetur adipiscing elit. "
+                               "Curabitur sed velit sed neque tristique sagittis vel et sapien.";
+    lv_area_t blur_coords = {20, 20, CANVAS_WIDTH - 20, CANVAS_HEIGHT - 20};
+
+    /*Blur a text the first time*/
+    TEST_ASSERT_EQUAL_UINT32(0, canvas_render(text, &blur_coords));
+    uint8_t * blurred = lv_malloc(draw_buf->data_size);
+    TEST_ASSERT_NOT_NULL(blurred);
+    lv_memcpy(blurred, draw_buf->data, draw_buf->data_size);
+
+    /*The same pixels are restored from the cache*/
+    TEST_ASSERT_EQUAL_UINT32(1, canvas_render(text, &blur_coords));
+    TEST_ASSERT_EQUAL_MEMORY(blurred, draw_buf->data, draw_buf->data_size);
+
+    /*Different pixels are blurred again*/
+    TEST_ASSERT_EQUAL_UINT32(0, canvas_render("Curabitur sed velit sed neque", &blur_coords));
+
+    /*The same pixels are blurred again on a different area*/
+    blur_coords.x1++;
+    TEST_ASSERT_EQUAL_UINT32(0, canvas_render(text, &blur_coords));
+    blur_coords.x1--;
+
+    /*The first blur is still in the cache*/
+    TEST_ASSERT_EQUAL_UINT32(1, canvas_render(text, &blur_coords));
+    TEST_ASSERT_EQUAL_MEMORY(blurred, draw_buf->data, draw_buf->data_size);
+
+    lv_free(blurred);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_blur_cache(void)
+{
+}
+
+#endif /*LV_DRAW_SW_BLUR_CACHE_SIZE > 0*/
+
+#endif
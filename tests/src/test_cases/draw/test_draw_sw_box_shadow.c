@@ -0,0 +1,53 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_obj_t * card_create(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, int32_t shadow_width,
+                              int32_t spread)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_shadow_width(obj, shadow_width, 0);
+    lv_obj_set_style_shadow_spread(obj, spread, 0);
+    lv_obj_set_style_shadow_offset_x(obj, shadow_width / 4, 0);
+    lv_obj_set_style_shadow_offset_y(obj, shadow_width / 3, 0);
+    lv_obj_set_style_shadow_color(obj, lv_palette_darken(LV_PALETTE_BLUE, 3), 0);
+    return obj;
+}
+
+void test_draw_sw_box_shadow(void)
+{
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_palette_lighten(LV_PALETTE_GREY, 3), 0);
+
+    /*Rectangles without radius, rounded rectangles, and shapes smaller than their shadows*/
+    static const int32_t radii[] = {0, 0, 8, 30};
+    static const int32_t shadow_widths[] = {1, 2, 7, 16, 31, 50};
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        for(j = 0; j < sizeof(shadow_widths) / sizeof(shadow_widths[0]); j++) {
+            int32_t size = i == 1 ? 12 : 60;
+            card_create(40 + j * 125, 40 + i * 115, size + j * 4, size, radii[i], shadow_widths[j], i == 1 ? 0 : 3);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_box_shadow.png");
+}
+
+#endif
@@ -0,0 +1,63 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE >= 7
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void card_create(int32_t x, int32_t y)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, 50, 60);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_radius(obj, 3, 0);
+    lv_obj_set_style_shadow_width(obj, 4, 0);
+    lv_obj_set_style_shadow_offset_x(obj, 1, 0);
+    lv_obj_set_style_shadow_offset_y(obj, 1, 0);
+}
+
+void test_draw_sw_box_shadow_cache(void)
+{
+    /*A grid of the same cards*/
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        card_create(20 + (i % 10) * 75, 40 + (i / 10) * 100);
+    }
+
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->sw_shadow_cache;
+    uint32_t miss_cnt = lv_cache_get_miss_cnt(cache);
+    lv_refr_now(NULL);
+
+    /*The corner of the shadow is calculated only once*/
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, lv_cache_get_miss_cnt(cache));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_box_shadow_cache(void)
+{
+}
+
+#endif /*LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE >= 7*/
+
+#endif
@@ -0,0 +1,94 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define SRC_SIZE    24
+
+static const lv_color_format_t color_formats[] = {
+    LV_COLOR_FORMAT_ARGB8888,
+    LV_COLOR_FORMAT_XRGB8888,
+    LV_COLOR_FORMAT_RGB888,
+    LV_COLOR_FORMAT_RGB565,
+    LV_COLOR_FORMAT_RGB565_SWAPPED,
+    LV_COLOR_FORMAT_RGB565A8,
+    LV_COLOR_FORMAT_A8,
+    LV_COLOR_FORMAT_L8,
+    LV_COLOR_FORMAT_AL88,
+};
+
+#define CF_CNT      (sizeof(color_formats) / sizeof(color_formats[0]))
+
+static lv_draw_buf_t * srcs[CF_CNT];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+
+    uint32_t i;
+    for(i = 0; i < CF_CNT; i++) {
+        if(srcs[i]) lv_draw_buf_destroy(srcs[i]);
+        srcs[i] = NULL;
+    }
+}
+
+static lv_draw_buf_t * src_create(lv_color_format_t cf)
+{
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(SRC_SIZE, SRC_SIZE, cf, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+
+    /*Blocks of random bytes to mix both equal and different neighbors.
+     *The bytes have only a few values to have fully transparent and opaque pixels too.*/
+    static const uint8_t values[] = {0x00, 0x30, 0x90, 0xE0, 0xFF};
+    uint32_t stride = draw_buf->header.stride;
+    uint32_t i;
+    for(i = 0; i < draw_buf->data_size; i++) {
+        uint32_t block = (i / stride / 3) * 97 + (i % stride) / 9;
+        uint32_t hash = (block * 7 + i % 3) * 2654435761u;
+        draw_buf->data[i] = values[(hash >> 24) % sizeof(values)];
+    }
+
+    return draw_buf;
+}
+
+/**
+ * Create an image from each color format in a row
+ * @param y             the Y coordinate of the row
+ * @param rotation      rotation of the images
+ * @param scale         scale of the images
+ * @param antialias     true: mix the neighbor pixels
+ */
+static void row_create(int32_t y, int32_t rotation, int32_t scale, bool antialias)
+{
+    uint32_t i;
+    for(i = 0; i < CF_CNT; i++) {
+        if(srcs[i] == NULL) srcs[i] = src_create(color_formats[i]);
+
+        lv_obj_t * img = lv_image_create(lv_screen_active());
+        lv_image_set_src(img, srcs[i]);
+        lv_obj_set_pos(img, 24 + i * 86, y);
+        lv_image_set_rotation(img, rotation);
+        lv_image_set_scale(img, scale);
+        lv_image_set_antialias(img, antialias);
+        lv_obj_set_style_image_recolor(img, lv_palette_main(LV_PALETTE_RED), 0);   /*For A8*/
+    }
+}
+
+void test_draw_sw_transform(void)
+{
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_palette_lighten(LV_PALETTE_LIGHT_BLUE, 2), 0);
+
+    row_create(30, 300, LV_SCALE_NONE, true);
+    row_create(130, 300, LV_SCALE_NONE, false);
+    row_create(230, 1234, 150, true);
+    row_create(340, 450, 360, true);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform.png");
+}
+
+#endif
@@ -0,0 +1,181 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(200, 200, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+    lv_draw_buf_clear(draw_buf, NULL);
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    lv_canvas_init_layer(canvas, &layer);
+}
+
+void tearDown(void)
+{
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.task_index);
+
+    lv_draw_buf_destroy(lv_canvas_get_draw_buf(canvas));
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_task_t * add_fill(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+    dsc.color = lv_color_hex(0xff0000);
+
+    lv_area_t area = {x1, y1, x2, y2};
+    lv_draw_fill(&layer, &dsc, &area);
+
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t->next) t = t->next;
+    return t;
+}
+
+static bool is_available(lv_draw_task_t * t_check)
+{
+    lv_draw_task_t * t = NULL;
+    while((t = lv_draw_get_next_available_task(&layer, t, t_check->preferred_draw_unit_id)) != NULL) {
+        if(t == t_check) return true;
+    }
+
+    return false;
+}
+
+void test_draw_task_dependency_overlap(void)
+{
+    lv_draw_task_t * t1 = add_fill(0, 0, 49, 49);
+    lv_draw_task_t * t2 = add_fill(100, 100, 149, 149);
+    lv_draw_task_t * t3 = add_fill(40, 40, 59, 59);
+    lv_draw_task_t * t4 = add_fill(60, 60, 99, 99);
+
+    TEST_ASSERT_NOT_NULL(layer.task_index);
+    TEST_ASSERT_TRUE(is_available(t1));
+    TEST_ASSERT_TRUE(is_available(t2));
+    TEST_ASSERT_FALSE(is_available(t3));
+    TEST_ASSERT_TRUE(is_available(t4));
+
+    /*Finished tasks don't block the others*/
+    t1->state = LV_DRAW_TASK_STATE_FINISHED;
+    TEST_ASSERT_TRUE(is_available(t3));
+}
+
+void test_draw_task_dependency_same_bin(void)
+{
+    /*Small tasks in the same bin are checked by their real area*/
+    lv_draw_task_t * t1 = add_fill(0, 0, 1, 1);
+    lv_draw_task_t * t2 = add_fill(4, 4, 5, 5);
+    lv_draw_task_t * t3 = add_fill(1, 1, 2, 2);
+
+    TEST_ASSERT_TRUE(is_available(t1));
+    TEST_ASSERT_TRUE(is_available(t2));
+    TEST_ASSERT_FALSE(is_available(t3));
+}
+
+static uint32_t get_bin_task_cnt(const lv_draw_task_bin_t * bin)
+{
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = bin->start; i < bin->cnt; i++) {
+        if(bin->tasks[i]) cnt++;
+    }
+
+    return cnt;
+}
+
+void test_draw_task_dependency_index_update(void)
+{
+    /*The bins are 25 x 25 pixels*/
+    lv_draw_task_t * t1 = add_fill(0, 0, 49, 24);
+    lv_draw_task_t * t2 = add_fill(100, 100, 149, 149);
+    lv_draw_task_t * t3 = add_fill(30, 0, 34, 4);
+
+    lv_draw_task_index_t * index = layer.task_index;
+    TEST_ASSERT_EQUAL_PTR(t1, index->bins[0].tasks[index->bins[0].start]);
+    TEST_ASSERT_EQUAL_PTR(t1, index->bins[1].tasks[index->bins[1].start]);
+    TEST_ASSERT_EQUAL_UINT32(2, get_bin_task_cnt(&index->bins[1]));
+    TEST_ASSERT_EQUAL_UINT32(4, get_bin_task_cnt(&index->bins[4 * LV_DRAW_TASK_INDEX_BINS + 4]) +
+                             get_bin_task_cnt(&index->bins[4 * LV_DRAW_TASK_INDEX_BINS + 5]) +
+                             get_bin_task_cnt(&index->bins[5 * LV_DRAW_TASK_INDEX_BINS + 4]) +
+                             get_bin_task_cnt(&index->bins[5 * LV_DRAW_TASK_INDEX_BINS + 5]));
+
+    /*Only the bins of the removed task are updated: the second one keeps the next task
+     *touching it and the first one becomes empty*/
+    layer.draw_task_head = t2;
+    lv_draw_cleanup_task(t1, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, get_bin_task_cnt(&index->bins[0]));
+    TEST_ASSERT_EQUAL_UINT32(1, get_bin_task_cnt(&index->bins[1]));
+    TEST_ASSERT_EQUAL_PTR(t3, index->bins[1].tasks[index->bins[1].start]);
+    TEST_ASSERT_EQUAL_PTR(t2, index->bins[4 * LV_DRAW_TASK_INDEX_BINS + 4].tasks[0]);
+    TEST_ASSERT_TRUE(is_available(t3));
+}
+
+void test_draw_task_dependency_many_tasks_in_a_bin(void)
+{
+    /*More tasks than the initial capacity of the bins, removed from the middle too*/
+    lv_draw_task_t * tasks[20];
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        tasks[i] = add_fill(i * 2, 0, i * 2, 0);
+    }
+
+    lv_draw_task_t * t_over = add_fill(0, 0, 39, 0);
+    for(i = 0; i < 20; i++) {
+        TEST_ASSERT_TRUE(is_available(tasks[i]));
+    }
+    TEST_ASSERT_FALSE(is_available(t_over));
+
+    lv_draw_task_index_t * index = layer.task_index;
+    for(i = 0; i < 20; i++) {
+        tasks[i]->state = LV_DRAW_TASK_STATE_FINISHED;
+        if(i % 2) {
+            tasks[i - 1]->next = tasks[i]->next;
+            lv_draw_cleanup_task(tasks[i], NULL);
+        }
+    }
+
+    /*`t_over` is in both bins*/
+    TEST_ASSERT_EQUAL_UINT32(10 + 2, get_bin_task_cnt(&index->bins[0]) + get_bin_task_cnt(&index->bins[1]));
+    TEST_ASSERT_TRUE(is_available(t_over));
+}
+
+void test_draw_task_dependency_outside_of_layer(void)
+{
+    /*Areas outside of the layer are mapped to the edge bins*/
+    lv_draw_task_t * t1 = add_fill(-100, -100, 10, 10);
+    lv_draw_task_t * t2 = add_fill(150, 150, 400, 400);
+    lv_draw_task_t * t3 = add_fill(-20, -20, -10, -10);
+
+    TEST_ASSERT_TRUE(is_available(t1));
+    TEST_ASSERT_TRUE(is_available(t2));
+    TEST_ASSERT_FALSE(is_available(t3));
+}
+
+void test_draw_task_dependency_after_cleanup(void)
+{
+    lv_draw_task_t * t1 = add_fill(0, 0, 49, 49);
+    lv_draw_task_t * t2 = add_fill(0, 0, 49, 49);
+    lv_draw_task_t * t3 = add_fill(0, 0, 49, 49);
+
+    TEST_ASSERT_TRUE(is_available(t1));
+    TEST_ASSERT_FALSE(is_available(t2));
+
+    /*Remove the oldest task as the dispatcher does it*/
+    layer.draw_task_head = t2;
+    lv_draw_cleanup_task(t1, NULL);
+
+    TEST_ASSERT_NOT_NULL(layer.task_index);
+    TEST_ASSERT_TRUE(is_available(t2));
+    TEST_ASSERT_FALSE(is_available(t3));
+}
+
+#endif
@@ -0,0 +1,125 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    lv_draw_task_pool_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_draw_task_pool_reuse_tasks_while_refreshing(void)
+{
+    lv_obj_t * objs[30];
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        lv_obj_set_size(obj, 100, 40);
+        lv_obj_set_pos(obj, (i % 6) * 120, (i / 6) * 60);
+        lv_obj_t * label = lv_label_create(obj);
+        lv_label_set_text_fmt(label, "Label %" LV_PRIu32, i);
+        objs[i] = obj;
+    }
+
+    /*Fill the caches first*/
+    lv_refr_now(NULL);
+    lv_draw_task_pool_reset_stats();
+
+    /*The areas are drawn one after the other, so the tasks of the first area are surely
+     *finished and can be reused in the second*/
+    lv_obj_invalidate(objs[0]);
+    lv_obj_invalidate(objs[29]);
+    lv_refr_now(NULL);
+
+    lv_draw_task_pool_stats_t stats;
+    lv_draw_task_pool_get_stats(&stats);
+#if LV_USE_DRAW_TASK_POOL
+    TEST_ASSERT_GREATER_THAN(0, stats.reuse_cnt);
+
+    /*The pool is kept for the next refreshes*/
+    TEST_ASSERT_GREATER_THAN(0, stats.cached_cnt);
+#else
+    TEST_ASSERT_EQUAL(0, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL(0, stats.reuse_cnt);
+    TEST_ASSERT_EQUAL(0, stats.cached_cnt);
+#endif
+
+    lv_draw_task_pool_reset_stats();
+    lv_draw_task_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL(0, stats.reuse_cnt);
+}
+
+void test_draw_task_pool_reuse_tasks_across_refreshes(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * label = lv_label_create(lv_screen_active());
+        lv_label_set_text_fmt(label, "Label %" LV_PRIu32, i);
+        lv_obj_set_pos(label, 10, i * 30);
+    }
+
+    lv_refr_now(NULL);
+    lv_draw_task_pool_reset_stats();
+
+    /*The tasks of the previous refresh are reused, no new ones are allocated*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_task_pool_stats_t stats;
+    lv_draw_task_pool_get_stats(&stats);
+#if LV_USE_DRAW_TASK_POOL
+    TEST_ASSERT_EQUAL(0, stats.alloc_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.reuse_cnt);
+
+    /*Flushing frees the pool*/
+    TEST_ASSERT_GREATER_THAN(0, stats.cached_cnt);
+    lv_draw_task_pool_flush();
+    lv_draw_task_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.cached_cnt);
+#else
+    TEST_ASSERT_EQUAL(0, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL(0, stats.reuse_cnt);
+#endif
+}
+
+void test_draw_task_pool_is_kept_after_drawing_on_canvas(void)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(100, 100, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+    dsc.color = lv_color_hex(0xff0000);
+
+    int32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_area_t area = {i * 10, i * 10, i * 10 + 9, i * 10 + 9};
+        lv_draw_fill(&layer, &dsc, &area);
+    }
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    lv_draw_task_pool_stats_t stats;
+    lv_draw_task_pool_get_stats(&stats);
+#if LV_USE_DRAW_TASK_POOL
+    TEST_ASSERT_GREATER_THAN(0, stats.cached_cnt);
+#else
+    TEST_ASSERT_EQUAL(0, stats.cached_cnt);
+#endif
+
+    lv_draw_buf_destroy(draw_buf);
+}
+
+#endif
@@ -0,0 +1,148 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IMAGE_CACHE_CONVERT
+
+#define OPAQUE_SRC "A:src/test_assets/test_arc_bg.png"
+#define ALPHA_SRC "A:src/test_assets/test_img_lvgl_logo.png"
+
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    lv_image_cache_drop(NULL);
+    canvas = lv_canvas_create(lv_screen_active());
+}
+
+void tearDown(void)
+{
+    lv_draw_buf_t * draw_buf = lv_canvas_get_draw_buf(canvas);
+    lv_obj_delete(canvas);
+    if(draw_buf) lv_draw_buf_destroy(draw_buf);
+    lv_image_cache_drop(NULL);
+}
+
+/*Draw `src` on a new RGB565 buffer*/
+static lv_draw_buf_t * draw_to_rgb565(const char * src)
+{
+    lv_image_header_t header;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info(src, &header));
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(header.w, header.h, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+    lv_draw_buf_clear(draw_buf, NULL);
+
+    lv_draw_buf_t * old_buf = lv_canvas_get_draw_buf(canvas);
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    if(old_buf) lv_draw_buf_destroy(old_buf);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = src;
+    lv_area_t coords = {0, 0, header.w - 1, header.h - 1};
+    lv_draw_image(&layer, &dsc, &coords);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    return lv_draw_buf_dup(draw_buf);
+}
+
+static lv_color_format_t get_converted_cf(const char * src)
+{
+    lv_image_cache_data_t search_key;
+    search_key.src_type = LV_IMAGE_SRC_FILE;
+    search_key.src = src;
+    search_key.target_cf = LV_COLOR_FORMAT_RGB565;
+    search_key.tile = 0;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(LV_GLOBAL_DEFAULT()->img_cache, &search_key, NULL);
+    if(entry == NULL) return LV_COLOR_FORMAT_UNKNOWN;
+
+    lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    lv_color_format_t cf = cached_data->decoded->header.cf;
+    lv_cache_release(LV_GLOBAL_DEFAULT()->img_cache, entry, NULL);
+    return cf;
+}
+
+/*Draw without the image cache, that is without conversion*/
+static lv_draw_buf_t * draw_reference(const char * src)
+{
+    uint32_t cache_size = LV_GLOBAL_DEFAULT()->img_cache->max_size;
+    lv_image_cache_resize(0, true);
+    lv_draw_buf_t * ref = draw_to_rgb565(src);
+    lv_image_cache_resize(cache_size, true);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_UNKNOWN, get_converted_cf(src));
+    return ref;
+}
+
+void test_image_cache_convert_opaque(void)
+{
+    lv_draw_buf_t * ref = draw_reference(OPAQUE_SRC);
+
+    /*Converted on the first draw and reused on the second*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_draw_buf_t * converted = draw_to_rgb565(OPAQUE_SRC);
+        TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565, get_converted_cf(OPAQUE_SRC));
+#if LV_IMAGE_CACHE_CONVERT_DITHER == 0
+        TEST_ASSERT_EQUAL_MEMORY(ref->data, converted->data, ref->data_size);
+#endif
+        lv_draw_buf_destroy(converted);
+    }
+
+    lv_image_cache_drop(OPAQUE_SRC);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_UNKNOWN, get_converted_cf(OPAQUE_SRC));
+
+    lv_draw_buf_destroy(ref);
+}
+
+void test_image_cache_convert_alpha(void)
+{
+    lv_draw_buf_t * ref = draw_reference(ALPHA_SRC);
+    lv_draw_buf_t * converted = draw_to_rgb565(ALPHA_SRC);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565A8, get_converted_cf(ALPHA_SRC));
+
+    /*Mixing in RGB565 rounds a little differently*/
+    uint32_t y;
+    for(y = 0; y < ref->header.h; y++) {
+        const uint16_t * ref_row = (const uint16_t *)(ref->data + y * ref->header.stride);
+        const uint16_t * row = (const uint16_t *)(converted->data + y * converted->header.stride);
+        uint32_t x;
+        for(x = 0; x < ref->header.w; x++) {
+            TEST_ASSERT_INT_WITHIN(2, ref_row[x] >> 11, row[x] >> 11);
+            TEST_ASSERT_INT_WITHIN(2, (ref_row[x] >> 5) & 0x3F, (row[x] >> 5) & 0x3F);
+            TEST_ASSERT_INT_WITHIN(2, ref_row[x] & 0x1F, row[x] & 0x1F);
+        }
+    }
+
+    lv_draw_buf_destroy(converted);
+    lv_draw_buf_destroy(ref);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_cache_convert_opaque(void)
+{
+}
+
+void test_image_cache_convert_alpha(void)
+{
+}
+
+#endif /*LV_USE_IMAGE_CACHE_CONVERT*/
+
+#endif
@@ -0,0 +1,296 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IMAGE_DECODER_ROI && LV_USE_LIBPNG && LV_USE_LODEPNG && LV_USE_LIBJPEG_TURBO
+
+/*Large enough to be decoded by areas with the default `LV_IMAGE_DECODER_ROI_MIN_SIZE`*/
+#define PNG_SRC "A:src/test_assets/test_img_gradient_640x560.png"
+#define JPEG_SRC "A:src/test_assets/test_img_gradient_640x560.jpg"
+
+void setUp(void)
+{
+    lv_image_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_image_cache_drop(NULL);
+}
+
+/*Compare the decoded pieces of `area` with the same area of `ref` and check that they cover it*/
+static void check_area(lv_image_decoder_dsc_t * dsc, const lv_area_t * area, const lv_draw_buf_t * ref)
+{
+    uint32_t px_size = lv_color_format_get_size(ref->header.cf);
+    uint32_t covered = 0;
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    while(lv_image_decoder_get_area(dsc, area, &decoded_area) == LV_RESULT_OK) {
+        const lv_draw_buf_t * decoded = dsc->decoded;
+        TEST_ASSERT_NOT_NULL(decoded);
+        TEST_ASSERT_EQUAL(ref->header.cf, decoded->header.cf);
+        TEST_ASSERT_EQUAL(lv_area_get_width(&decoded_area), decoded->header.w);
+        TEST_ASSERT_EQUAL(lv_area_get_height(&decoded_area), decoded->header.h);
+
+        lv_area_t common;
+        if(!lv_area_intersect(&common, &decoded_area, area)) continue;
+        covered += lv_area_get_size(&common);
+
+        int32_t y;
+        for(y = common.y1; y <= common.y2; y++) {
+            const uint8_t * ref_px = ref->data + y * ref->header.stride + common.x1 * px_size;
+            const uint8_t * px = decoded->data + (y - decoded_area.y1) * decoded->header.stride +
+                                 (common.x1 - decoded_area.x1) * px_size;
+            TEST_ASSERT_EQUAL_MEMORY(ref_px, px, lv_area_get_width(&common) * px_size);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(lv_area_get_size(area), covered);
+}
+
+static uint32_t get_tile_cnt(const void * src, const lv_image_header_t * header)
+{
+    uint32_t cnt = 0;
+    lv_image_cache_data_t search_key;
+    search_key.src_type = LV_IMAGE_SRC_FILE;
+    search_key.src = src;
+    search_key.target_cf = LV_COLOR_FORMAT_UNKNOWN;
+    uint32_t tile_cnt = LV_IMAGE_DECODER_ROI_TILE_CNT(header->w) * LV_IMAGE_DECODER_ROI_TILE_CNT(header->h);
+    for(search_key.tile = 1; search_key.tile <= tile_cnt; search_key.tile++) {
+        lv_cache_entry_t * entry = lv_cache_acquire(LV_GLOBAL_DEFAULT()->img_cache, &search_key, NULL);
+        if(entry) {
+            cnt++;
+            lv_cache_release(LV_GLOBAL_DEFAULT()->img_cache, entry, NULL);
+        }
+    }
+
+    return cnt;
+}
+
+/*Check a part of the image decoded directly and through the cached tiles*/
+static void check_roi(const char * src, const lv_draw_buf_t * ref)
+{
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+
+    /*Not decoded when opened*/
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_NULL(dsc.decoded);
+    TEST_ASSERT_TRUE(dsc.cache_tiles);
+
+    /*Going back starts over*/
+    lv_area_t area = {100, 300, 419, 339};
+    check_area(&dsc, &area, ref);
+    lv_area_set(&area, 3, 5, 250, 130);
+    check_area(&dsc, &area, ref);
+    lv_image_decoder_close(&dsc);
+    TEST_ASSERT_EQUAL(0, get_tile_cnt(src, &dsc.header));
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    TEST_ASSERT_NULL(dsc.decoded);
+
+    /*Only the tiles covering the area are decoded, and reused the second time*/
+    lv_area_set(&area, 70, 100, 199, 140);
+    check_area(&dsc, &area, ref);
+    TEST_ASSERT_EQUAL(3 * 2, get_tile_cnt(src, &dsc.header));
+    check_area(&dsc, &area, ref);
+    TEST_ASSERT_EQUAL(3 * 2, get_tile_cnt(src, &dsc.header));
+
+    /*The tiles at the edges are smaller*/
+    lv_area_set(&area, 500, 520, 639, 559);
+    check_area(&dsc, &area, ref);
+    TEST_ASSERT_EQUAL(3 * 2 + 3, get_tile_cnt(src, &dsc.header));
+    lv_image_decoder_close(&dsc);
+
+    lv_image_cache_drop(src);
+    TEST_ASSERT_EQUAL(0, get_tile_cnt(src, &dsc.header));
+}
+
+void test_image_decoder_roi_png(void)
+{
+    /*lodepng decodes the whole image*/
+    lv_libpng_deinit();
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, PNG_SRC, NULL));
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+    lv_draw_buf_t * ref = lv_draw_buf_dup(dsc.decoded);
+    lv_image_decoder_close(&dsc);
+    lv_image_cache_drop(NULL);
+
+    lv_libpng_init();
+    lv_lodepng_deinit();
+
+    check_roi(PNG_SRC, ref);
+
+    lv_lodepng_init();
+    lv_draw_buf_destroy(ref);
+}
+
+void test_image_decoder_roi_jpeg(void)
+{
+    /*Decode the whole image by areas as a reference*/
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, JPEG_SRC, &args));
+    TEST_ASSERT_NULL(dsc.decoded);
+
+    lv_draw_buf_t * ref = NULL;
+    lv_area_t full_area = {0, 0, dsc.header.w - 1, dsc.header.h - 1};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    while(lv_image_decoder_get_area(&dsc, &full_area, &decoded_area) == LV_RESULT_OK) {
+        if(ref == NULL) ref = lv_draw_buf_create(dsc.header.w, dsc.header.h, dsc.decoded->header.cf, LV_STRIDE_AUTO);
+        TEST_ASSERT_NOT_NULL(ref);
+        lv_draw_buf_copy(ref, &decoded_area, dsc.decoded, NULL);
+    }
+    lv_image_decoder_close(&dsc);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    check_roi(JPEG_SRC, ref);
+
+    lv_draw_buf_destroy(ref);
+}
+
+void test_image_decoder_roi_draw(void)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(200, 150, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = PNG_SRC;
+    lv_area_t coords = {-300, -250, 339, 309};
+
+    /*Drawn from the whole image decoded by lodepng*/
+    lv_libpng_deinit();
+    lv_layer_t layer;
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_TRANSP);
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_image(&layer, &dsc, &coords);
+    lv_canvas_finish_layer(canvas, &layer);
+    lv_draw_buf_t * ref = lv_draw_buf_dup(draw_buf);
+    TEST_ASSERT_NOT_EQUAL(0, ((lv_color32_t *)ref->data)[0].alpha);
+    lv_image_cache_drop(NULL);
+
+    /*Drawn from the tiles decoded by libpng*/
+    lv_libpng_init();
+    lv_lodepng_deinit();
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_TRANSP);
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_image(&layer, &dsc, &coords);
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_EQUAL_MEMORY(ref->data, draw_buf->data, ref->data_size);
+
+    /*Only the visible part was decoded*/
+    lv_image_header_t header;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info(PNG_SRC, &header));
+    TEST_ASSERT_EQUAL(4 * 4, get_tile_cnt(PNG_SRC, &header));
+
+    lv_lodepng_init();
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(draw_buf);
+    lv_draw_buf_destroy(ref);
+}
+
+void test_image_decoder_roi_kept_opened(void)
+{
+    /*The decoder's state is kept for the next draws*/
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, JPEG_SRC, NULL));
+    TEST_ASSERT_NOT_NULL(dsc.opened_entry);
+    TEST_ASSERT_NULL(dsc.user_data);
+    lv_cache_entry_t * opened_entry = dsc.opened_entry;
+
+    lv_area_t area = {10, 400, 90, 460};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_area(&dsc, &area, &decoded_area));
+    lv_image_decoder_close(&dsc);
+    TEST_ASSERT_NULL(dsc.opened_entry);
+
+    /*Opened again without the decoder, and the missing tiles are decoded with the kept state*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, JPEG_SRC, NULL));
+    TEST_ASSERT_EQUAL_PTR(opened_entry, dsc.opened_entry);
+    TEST_ASSERT_TRUE(dsc.cache_tiles);
+    lv_area_set(&area, 10, 10, 90, 60);
+    decoded_area.y1 = LV_COORD_MIN;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_area(&dsc, &area, &decoded_area));
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+    TEST_ASSERT_EQUAL(2 * 2 + 2, get_tile_cnt(JPEG_SRC, &dsc.header));
+    lv_image_decoder_close(&dsc);
+
+    /*Not kept without caching*/
+    lv_image_decoder_args_t args;
+    lv_image_decoder_args_init(&args);
+    args.no_cache = true;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, JPEG_SRC, &args));
+    TEST_ASSERT_NULL(dsc.opened_entry);
+    TEST_ASSERT_NOT_NULL(dsc.user_data);
+    lv_image_decoder_close(&dsc);
+
+    /*Closed when dropped*/
+    lv_image_cache_drop(JPEG_SRC);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, JPEG_SRC, NULL));
+    TEST_ASSERT_NOT_NULL(dsc.opened_entry);
+    TEST_ASSERT_EQUAL(0, get_tile_cnt(JPEG_SRC, &dsc.header));
+    lv_image_decoder_close(&dsc);
+}
+
+void test_image_decoder_roi_transformed(void)
+{
+    /*Rotated and scaled images are decoded fully*/
+    lv_lodepng_deinit();
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, PNG_SRC);
+    lv_image_set_rotation(img, 300);
+    lv_image_set_scale(img, 128);
+    lv_obj_center(img);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_decoder_roi_transformed.png");
+
+    lv_image_header_t header;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info(PNG_SRC, &header));
+    TEST_ASSERT_EQUAL(0, get_tile_cnt(PNG_SRC, &header));
+
+    lv_lodepng_init();
+    lv_obj_delete(img);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_decoder_roi_png(void)
+{
+}
+
+void test_image_decoder_roi_jpeg(void)
+{
+}
+
+void test_image_decoder_roi_draw(void)
+{
+}
+
+void test_image_decoder_roi_kept_opened(void)
+{
+}
+
+void test_image_decoder_roi_transformed(void)
+{
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ROI && LV_USE_LIBPNG && LV_USE_LODEPNG && LV_USE_LIBJPEG_TURBO*/
+
+#endif
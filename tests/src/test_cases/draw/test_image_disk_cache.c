@@ -0,0 +1,234 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include <sys/stat.h>
+
+#if LV_USE_IMAGE_DISK_CACHE && LV_USE_LODEPNG
+
+#define CACHE_DIR       "src/test_files/image_disk_cache"
+#define LOGO_SRC        "A:src/test_assets/test_img_lvgl_logo.png"
+#define EMOJI_SRC       "A:src/test_assets/test_img_emoji_F600.png"
+#define GRADIENT_SRC    "A:src/test_assets/test_img_gradient_640x560.png"
+#define COPY_SRC        "A:src/test_files/image_disk_cache_copy.png"
+
+static uint32_t tick;
+
+/*Every image takes some time to decode*/
+static uint32_t test_tick_cb(void)
+{
+    tick += 5;
+    return tick;
+}
+
+void setUp(void)
+{
+    lv_tick_set_cb(test_tick_cb);
+    lv_image_cache_drop(NULL);
+    mkdir(CACHE_DIR, 0777);
+    lv_image_decoder_set_disk_cache_path("A:" CACHE_DIR);
+    lv_image_decoder_disk_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_image_decoder_disk_cache_drop(NULL);
+    lv_image_decoder_set_disk_cache_path(NULL);
+    lv_image_cache_drop(NULL);
+    lv_tick_set_cb(NULL);
+}
+
+/*Open an image without the image cache, and return its decoder's name*/
+static const char * open_image(const char * src, lv_draw_buf_t ** ref)
+{
+    lv_image_cache_drop(NULL);
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+
+    if(*ref == NULL) {
+        *ref = lv_draw_buf_dup(dsc.decoded);
+    }
+    else {
+        TEST_ASSERT_EQUAL((*ref)->header.w, dsc.decoded->header.w);
+        TEST_ASSERT_EQUAL((*ref)->header.h, dsc.decoded->header.h);
+        TEST_ASSERT_EQUAL((*ref)->header.cf, dsc.decoded->header.cf);
+        TEST_ASSERT_EQUAL_MEMORY((*ref)->data, dsc.decoded->data, (*ref)->data_size);
+    }
+
+    const char * name = dsc.decoder->name;
+    lv_image_decoder_close(&dsc);
+    return name;
+}
+
+static void copy_file(const char * src, const char * dest)
+{
+    lv_fs_delete(dest);
+
+    uint32_t size;
+    uint8_t * data = lv_fs_load_with_alloc(src, &size);
+    TEST_ASSERT_NOT_NULL(data);
+
+    lv_fs_file_t f;
+    uint32_t bw;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, dest, LV_FS_MODE_WR));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, data, size, &bw));
+    TEST_ASSERT_EQUAL(size, bw);
+    lv_fs_close(&f);
+    lv_free(data);
+}
+
+void test_image_disk_cache_load(void)
+{
+    lv_draw_buf_t * ref = NULL;
+    TEST_ASSERT_NOT_EQUAL(0, lv_strcmp("DISK_CACHE", open_image(LOGO_SRC, &ref)));
+    TEST_ASSERT_EQUAL_STRING("DISK_CACHE", open_image(LOGO_SRC, &ref));
+
+    /*Still found after a restart*/
+    lv_image_decoder_set_disk_cache_path(NULL);
+    lv_image_decoder_set_disk_cache_path("A:" CACHE_DIR);
+    TEST_ASSERT_EQUAL_STRING("DISK_CACHE", open_image(LOGO_SRC, &ref));
+
+    /*Also without the image cache*/
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, LOGO_SRC, &args));
+    TEST_ASSERT_EQUAL_STRING("DISK_CACHE", dsc.decoder->name);
+    TEST_ASSERT_EQUAL_MEMORY(ref->data, dsc.decoded->data, ref->data_size);
+    lv_image_decoder_close(&dsc);
+
+    /*Drawn the same way*/
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, LOGO_SRC);
+    lv_obj_center(img);
+    lv_image_cache_drop(NULL);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_disk_cache.png");
+    lv_obj_delete(img);
+
+    lv_draw_buf_destroy(ref);
+}
+
+void test_image_disk_cache_changed_source(void)
+{
+    lv_draw_buf_t * logo = NULL;
+    copy_file(LOGO_SRC, COPY_SRC);
+    open_image(COPY_SRC, &logo);
+    TEST_ASSERT_EQUAL_STRING("DISK_CACHE", open_image(COPY_SRC, &logo));
+
+    /*The stored image of the old file is not used*/
+    lv_draw_buf_t * emoji = NULL;
+    copy_file(EMOJI_SRC, COPY_SRC);
+    TEST_ASSERT_NOT_EQUAL(0, lv_strcmp("DISK_CACHE", open_image(COPY_SRC, &emoji)));
+    TEST_ASSERT_EQUAL_STRING("DISK_CACHE", open_image(COPY_SRC, &emoji));
+
+    lv_fs_delete(COPY_SRC);
+    lv_draw_buf_destroy(logo);
+    lv_draw_buf_destroy(emoji);
+}
+
+void test_image_disk_cache_fast_image(void)
+{
+    /*Decoded in no time, so not stored*/
+    lv_tick_set_cb(NULL);
+    lv_draw_buf_t * ref = NULL;
+    open_image(LOGO_SRC, &ref);
+    TEST_ASSERT_NOT_EQUAL(0, lv_strcmp("DISK_CACHE", open_image(LOGO_SRC, &ref)));
+    TEST_ASSERT_EQUAL(0, lv_array_size(&LV_GLOBAL_DEFAULT()->img_disk_cache.entries));
+    lv_draw_buf_destroy(ref);
+}
+
+void test_image_disk_cache_drop(void)
+{
+    lv_draw_buf_t * logo = NULL;
+    lv_draw_buf_t * emoji = NULL;
+    open_image(LOGO_SRC, &logo);
+    open_image(EMOJI_SRC, &emoji);
+
+    lv_image_decoder_disk_cache_drop(LOGO_SRC);
+    TEST_ASSERT_NOT_EQUAL(0, lv_strcmp("DISK_CACHE", open_image(LOGO_SRC, &logo)));
+    TEST_ASSERT_EQUAL_STRING("DISK_CACHE", open_image(EMOJI_SRC, &emoji));
+
+    lv_image_decoder_disk_cache_drop(NULL);
+    TEST_ASSERT_NOT_EQUAL(0, lv_strcmp("DISK_CACHE", open_image(EMOJI_SRC, &emoji)));
+
+    lv_draw_buf_destroy(logo);
+    lv_draw_buf_destroy(emoji);
+}
+
+void test_image_disk_cache_prune(void)
+{
+    /*The same large image through different paths, stored as different images*/
+    static const char * srcs[] = {
+        GRADIENT_SRC,
+        "A:./src/test_assets/test_img_gradient_640x560.png",
+        "A:src/./test_assets/test_img_gradient_640x560.png",
+        "A:src/test_assets/./test_img_gradient_640x560.png",
+        "A:./src/./test_assets/test_img_gradient_640x560.png",
+        "A:./src/test_assets/./test_img_gradient_640x560.png",
+        "A:src/./test_assets/./test_img_gradient_640x560.png",
+    };
+
+#if LV_USE_LIBPNG
+    /*libpng might decode it by areas, which are not stored*/
+    lv_libpng_deinit();
+#endif
+
+    lv_draw_buf_t * ref = NULL;
+    lv_image_disk_cache_t * disk_cache = &LV_GLOBAL_DEFAULT()->img_disk_cache;
+    uint32_t i;
+    for(i = 0; i < sizeof(srcs) / sizeof(srcs[0]); i++) {
+        open_image(srcs[i], &ref);
+        TEST_ASSERT_LESS_OR_EQUAL(LV_IMAGE_DISK_CACHE_MAX_SIZE, disk_cache->total_size);
+
+        /*Keep using the first image*/
+        TEST_ASSERT_EQUAL_STRING("DISK_CACHE", open_image(srcs[0], &ref));
+    }
+
+    /*The least recently used images were deleted*/
+    TEST_ASSERT_LESS_THAN(sizeof(srcs) / sizeof(srcs[0]), lv_array_size(&disk_cache->entries));
+    TEST_ASSERT_NOT_EQUAL(0, lv_strcmp("DISK_CACHE", open_image(srcs[1], &ref)));
+    TEST_ASSERT_EQUAL_STRING("DISK_CACHE", open_image(srcs[i - 1], &ref));
+
+#if LV_USE_LIBPNG
+    lv_libpng_init();
+#endif
+    lv_draw_buf_destroy(ref);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_disk_cache_load(void)
+{
+}
+
+void test_image_disk_cache_changed_source(void)
+{
+}
+
+void test_image_disk_cache_fast_image(void)
+{
+}
+
+void test_image_disk_cache_drop(void)
+{
+}
+
+void test_image_disk_cache_prune(void)
+{
+}
+
+#endif /*LV_USE_IMAGE_DISK_CACHE && LV_USE_LODEPNG*/
+
+#endif
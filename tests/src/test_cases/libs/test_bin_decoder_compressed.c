@@ -0,0 +1,143 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_BIN_DECODER_RAM_LOAD && LV_USE_RLE && LV_USE_LZ4
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+#if LV_USE_IMAGE_DECODER_ROI
+static void create_image(const void * src)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_obj_center(img);
+}
+#endif
+
+/*Compare the pixels of two decoded images with possibly different strides*/
+static void check_same_pixels(const lv_draw_buf_t * ref, const lv_draw_buf_t * decoded)
+{
+    TEST_ASSERT_EQUAL(ref->header.cf, decoded->header.cf);
+    TEST_ASSERT_EQUAL(ref->header.w, decoded->header.w);
+    TEST_ASSERT_EQUAL(ref->header.h, decoded->header.h);
+
+    uint32_t line_len = ref->header.w * lv_color_format_get_size(ref->header.cf);
+    for(uint32_t y = 0; y < ref->header.h; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(ref->data + y * ref->header.stride, decoded->data + y * decoded->header.stride, line_len);
+    }
+}
+
+static void check_compressed_blocks(const void * ref_src, const void * src)
+{
+    const lv_image_decoder_args_t args = { .no_cache = true };
+    lv_image_decoder_dsc_t ref_dsc;
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&ref_dsc, ref_src, &args));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+
+    check_same_pixels(ref_dsc.decoded, dsc.decoded);
+
+    lv_image_decoder_close(&ref_dsc);
+    lv_image_decoder_close(&dsc);
+}
+
+/*Decompressed fully when opened, also without LV_USE_IMAGE_DECODER_ROI*/
+void test_bin_decoder_compressed_blocks(void)
+{
+    /*Compressed by 16 rows*/
+    LV_IMAGE_DECLARE(test_img_rgb565_lz4_blocks);
+    LV_IMAGE_DECLARE(test_RGB565_NONE_align1);
+    LV_IMAGE_DECLARE(test_ARGB8888_NONE_align1);
+    check_compressed_blocks(&test_RGB565_NONE_align1, &test_img_rgb565_lz4_blocks);
+    check_compressed_blocks(&test_ARGB8888_NONE_align1, "A:src/test_files/binimages/test.ARGB8888.RLE.bin");
+}
+
+#if LV_USE_IMAGE_DECODER_ROI
+
+void test_bin_decoder_compressed_blocks_area(void)
+{
+    /*Large enough to decompress only the drawn areas. The color of each 16x16 pixel square
+     *is known from its position.*/
+    const char * src = "A:src/test_files/binimages/blocks_640x480.ARGB8888.LZ4.bin";
+    lv_image_cache_drop(src);
+
+    const lv_image_decoder_args_t args = { .no_cache = true };
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_NULL(dsc.decoded);
+    TEST_ASSERT_TRUE(dsc.cache_tiles);
+
+    const lv_area_t area = {100, 37, 300, 70};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    int32_t next_y = area.y1;
+    while(lv_image_decoder_get_area(&dsc, &area, &decoded_area) == LV_RESULT_OK) {
+        /*Whole blocks of rows*/
+        TEST_ASSERT_EQUAL(0, decoded_area.x1);
+        TEST_ASSERT_EQUAL(dsc.header.w - 1, decoded_area.x2);
+        TEST_ASSERT_EQUAL(0, decoded_area.y1 % 16);
+        TEST_ASSERT_TRUE(decoded_area.y1 <= next_y && decoded_area.y2 >= next_y);
+        next_y = decoded_area.y2 + 1;
+
+        for(int32_t y = decoded_area.y1; y <= decoded_area.y2; y++) {
+            for(int32_t x = area.x1; x <= area.x2; x++) {
+                const lv_color32_t * px = lv_draw_buf_goto_xy(dsc.decoded, x, y - decoded_area.y1);
+                TEST_ASSERT_EQUAL_HEX8((x >> 4) * 6, px->blue);
+                TEST_ASSERT_EQUAL_HEX8((y >> 4) * 7, px->green);
+                TEST_ASSERT_EQUAL_HEX8(((x >> 4) + (y >> 4)) * 3, px->red);
+                TEST_ASSERT_EQUAL_HEX8(0xff, px->alpha);
+            }
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(area.y2, next_y);
+    lv_image_decoder_close(&dsc);
+
+    /*Drawn through the cached tiles*/
+    size_t mem_before = lv_test_get_free_mem();
+    create_image(src);
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/bin_decoder_compressed_blocks.png");
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(src);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+#else
+
+void test_bin_decoder_compressed_blocks_area(void)
+{
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ROI*/
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_bin_decoder_compressed_blocks(void)
+{
+}
+
+void test_bin_decoder_compressed_blocks_area(void)
+{
+}
+
+#endif /*LV_BIN_DECODER_RAM_LOAD && LV_USE_RLE && LV_USE_LZ4*/
+
+#endif
@@ -295,6 +295,142 @@ void test_display_deleted_during_event(void)
     lv_draw_buf_destroy(buf1);
 }
 
+static void flush_cnt_event_cb(lv_event_t * e)
+{
+    uint32_t * flush_cnt = lv_event_get_user_data(e);
+    (*flush_cnt)++;
+}
+
+void test_display_refr_cost(void)
+{
+    lv_display_t * disp = lv_display_create(480, 320);
+    lv_display_set_flush_cb(disp, dummy_flush_cb);
+    lv_draw_buf_t * buf1 = lv_draw_buf_create(480, 320, LV_COLOR_FORMAT_NATIVE, 0);
+    lv_display_set_draw_buffers(disp, buf1, NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    uint32_t flush_cnt = 0;
+    lv_display_add_event_cb(disp, flush_cnt_event_cb, LV_EVENT_FLUSH_START, &flush_cnt);
+
+    lv_obj_t * obj1 = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_remove_style_all(obj1);
+    lv_obj_set_pos(obj1, 10, 10);
+    lv_obj_set_size(obj1, 100, 20);
+
+    lv_obj_t * obj2 = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_remove_style_all(obj2);
+    lv_obj_set_pos(obj2, 10, 40);
+    lv_obj_set_size(obj2, 100, 20);
+    lv_refr_now(disp);
+
+    /*With only pixel costs the areas with a gap between them are not joined*/
+    lv_display_set_refr_cost(disp, 0, 1, 0);
+    lv_obj_invalidate(obj1);
+    lv_obj_invalidate(obj2);
+    flush_cnt = 0;
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(2, flush_cnt);
+    TEST_ASSERT_EQUAL_UINT64(2 * 100 * 20, lv_display_get_refr_cost_predicted(disp));
+
+    /*If a flush is expensive it's better to redraw the gap too*/
+    lv_display_set_refr_cost(disp, 10000, 1, 0);
+    lv_obj_invalidate(obj1);
+    lv_obj_invalidate(obj2);
+    flush_cnt = 0;
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+    TEST_ASSERT_EQUAL_UINT64(10000 + 100 * 50, lv_display_get_refr_cost_predicted(disp));
+
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf1);
+}
+
+/*Pretend that flushing a pixel takes 1 us*/
+static void slow_flush_event_cb(lv_event_t * e)
+{
+    const lv_area_t * area = lv_event_get_param(e);
+    lv_tick_inc(lv_area_get_size(area) / 1000);
+}
+
+void test_display_frame_pacing(void)
+{
+    lv_display_t * disp = lv_display_create(480, 320);
+    lv_display_set_flush_cb(disp, dummy_flush_cb);
+    lv_draw_buf_t * buf1 = lv_draw_buf_create(480, 320, LV_COLOR_FORMAT_NATIVE, 0);
+    lv_display_set_draw_buffers(disp, buf1, NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_timer_set_period(lv_display_get_refr_timer(disp), 30);
+
+    uint32_t flush_cnt = 0;
+    lv_display_add_event_cb(disp, flush_cnt_event_cb, LV_EVENT_FLUSH_START, &flush_cnt);
+    lv_display_add_event_cb(disp, slow_flush_event_cb, LV_EVENT_FLUSH_START, NULL);
+
+    lv_obj_t * obj1 = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_remove_style_all(obj1);
+    lv_obj_set_pos(obj1, 0, 10);
+    lv_obj_set_size(obj1, 400, 50);
+
+    lv_obj_t * obj2 = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_remove_style_all(obj2);
+    lv_obj_set_pos(obj2, 0, 200);
+    lv_obj_set_size(obj2, 400, 50);
+
+    lv_display_set_frame_pacing(disp, true);
+    TEST_ASSERT_TRUE(lv_display_get_frame_pacing(disp));
+
+    /*The first frame is just measured*/
+    lv_refr_now(disp);
+    lv_display_frame_pacing_stats_t stats;
+    lv_display_get_frame_pacing_stats(disp, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.frame_cnt);
+
+    /*The full screen took ~150 ms so skip the next refresh*/
+    lv_obj_invalidate(obj1);
+    lv_obj_invalidate(obj2);
+    flush_cnt = 0;
+    lv_refr_now(disp);
+    lv_display_get_frame_pacing_stats(disp, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.skip_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, flush_cnt);
+
+    /*The 2 areas take ~40 ms, so only the first is drawn now*/
+    lv_refr_now(disp);
+    lv_display_get_frame_pacing_stats(disp, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.split_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+
+    /*And the second in the next frame*/
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(2, flush_cnt);
+    lv_display_get_frame_pacing_stats(disp, &stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.skip_cnt);
+
+    /*An area can't be split, so refresh less frequently*/
+    lv_obj_set_size(obj1, 400, 100);
+    lv_refr_now(disp);
+    lv_display_get_frame_pacing_stats(disp, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.coalesce_cnt);
+    TEST_ASSERT_EQUAL_UINT32(60, lv_display_get_refr_timer(disp)->period);
+
+    /*Small changes are drawn with the target period again*/
+    lv_obj_t * obj3 = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_remove_style_all(obj3);
+    lv_obj_set_pos(obj3, 0, 300);
+    lv_obj_set_size(obj3, 10, 10);
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(30, lv_display_get_refr_timer(disp)->period);
+
+    lv_display_set_frame_pacing(disp, false);
+    TEST_ASSERT_FALSE(lv_display_get_frame_pacing(disp));
+    lv_display_reset_frame_pacing_stats(disp);
+    lv_display_get_frame_pacing_stats(disp, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.frame_cnt);
+
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf1);
+}
+
 static void test_display_resolution_full_rotation(
     lv_display_t * disp,
     int32_t ori_hor_res, int32_t ori_ver_res,
@@ -0,0 +1,164 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_FONT_FMT_TXT_CACHE
+
+/*A font without bitmaps with a sparse character map and kerning pairs*/
+static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+    {.adv_w = 0},
+    {.adv_w = 10 * 16, .box_w = 10, .box_h = 10},
+    {.adv_w = 11 * 16, .box_w = 11, .box_h = 10},
+    {.adv_w = 12 * 16, .box_w = 12, .box_h = 10},
+    {.adv_w = 13 * 16, .box_w = 13, .box_h = 10},
+};
+
+static const uint16_t unicode_list[] = {0, 5, 100, 1000};
+
+static const lv_font_fmt_txt_cmap_t cmaps[] = {
+    {
+        .range_start = 0x4E00, .range_length = 1001, .glyph_id_start = 1,
+        .unicode_list = unicode_list, .glyph_id_ofs_list = NULL, .list_length = 4, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+    }
+};
+
+static const uint8_t kern_pair_glyph_ids[] = {
+    1, 2,
+    2, 3,
+    3, 4,
+};
+
+static const int8_t kern_pair_values[] = {-16, 16, 32};
+
+static const lv_font_fmt_txt_kern_pair_t kern_pairs = {
+    .glyph_ids = kern_pair_glyph_ids,
+    .values = kern_pair_values,
+    .pair_cnt = 3,
+    .glyph_ids_size = 0
+};
+
+static const lv_font_fmt_txt_dsc_t font_dsc = {
+    .glyph_dsc = glyph_dsc,
+    .cmaps = cmaps,
+    .kern_dsc = &kern_pairs,
+    .kern_scale = 16,
+    .cmap_num = 1,
+    .bpp = 8,
+    .kern_classes = 0,
+};
+
+static const lv_font_t font = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,
+    .line_height = 10,
+    .dsc = &font_dsc,
+};
+
+void setUp(void)
+{
+    lv_font_fmt_txt_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+}
+
+/*Get the glyph ID and advance width of a letter, and check them*/
+static void check_glyph(const lv_font_t * f, uint32_t letter, uint32_t letter_next, uint32_t gid, uint32_t adv_w)
+{
+    lv_font_glyph_dsc_t g;
+    lv_memzero(&g, sizeof(g));
+    bool found = lv_font_get_glyph_dsc_fmt_txt(f, &g, letter, letter_next);
+    TEST_ASSERT_EQUAL(gid != 0, found);
+    if(found) {
+        TEST_ASSERT_EQUAL_UINT32(gid, g.gid.index);
+        TEST_ASSERT_EQUAL_UINT32(adv_w, g.adv_w);
+    }
+}
+
+static void check_glyphs(const lv_font_t * f)
+{
+    check_glyph(f, 0x4E00, 0, 1, 10);
+    check_glyph(f, 0x4E05, 0, 2, 11);
+    check_glyph(f, 0x4E64, 0, 3, 12);
+    check_glyph(f, 0x51E8, 0, 4, 13);
+
+    /*In the range of the character map but missing*/
+    check_glyph(f, 0x4E01, 0, 0, 0);
+    check_glyph(f, 0x51E7, 0, 0, 0);
+
+    /*Kerning pairs*/
+    check_glyph(f, 0x4E00, 0x4E05, 1, 9);
+    check_glyph(f, 0x4E05, 0x4E64, 2, 12);
+    check_glyph(f, 0x4E64, 0x51E8, 3, 14);
+    check_glyph(f, 0x4E05, 0x4E00, 2, 11);
+}
+
+void test_font_fmt_txt_cache_lookup(void)
+{
+    lv_font_fmt_txt_cache_t * cache = &LV_GLOBAL_DEFAULT()->font_fmt_txt_cache;
+
+    check_glyphs(&font);
+    uint32_t miss_cnt = cache->miss_cnt;
+    uint32_t hit_cnt = cache->hit_cnt;
+
+    /*The same results from the cache*/
+    check_glyphs(&font);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, cache->miss_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(hit_cnt, cache->hit_cnt);
+}
+
+void test_font_fmt_txt_cache_fonts(void)
+{
+    /*A font created at runtime with the same letters but different glyphs*/
+    lv_font_fmt_txt_dsc_t * dsc = lv_malloc(sizeof(lv_font_fmt_txt_dsc_t));
+    lv_memcpy(dsc, &font_dsc, sizeof(font_dsc));
+    lv_font_fmt_txt_cmap_t cmap = cmaps[0];
+    cmap.glyph_id_start = 0;
+    dsc->cmaps = &cmap;
+    dsc->kern_dsc = NULL;
+
+    lv_font_t runtime_font = font;
+    runtime_font.dsc = dsc;
+
+    check_glyphs(&font);
+    check_glyph(&runtime_font, 0x4E05, 0, 1, 10);
+    check_glyph(&runtime_font, 0x4E64, 0x51E8, 2, 11);
+    check_glyphs(&font);
+
+    /*Only the entries of the dropped font are removed*/
+    lv_font_fmt_txt_cache_t * cache = &LV_GLOBAL_DEFAULT()->font_fmt_txt_cache;
+    lv_font_fmt_txt_cache_drop(&runtime_font);
+    uint32_t miss_cnt = cache->miss_cnt;
+    check_glyph(&font, 0x4E05, 0, 2, 11);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, cache->miss_cnt);
+    check_glyph(&runtime_font, 0x4E05, 0, 1, 10);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, cache->miss_cnt);
+
+    lv_font_fmt_txt_cache_drop(&runtime_font);
+    lv_free(dsc);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_font_fmt_txt_cache_lookup(void)
+{
+}
+
+void test_font_fmt_txt_cache_fonts(void)
+{
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_CACHE*/
+
+#endif
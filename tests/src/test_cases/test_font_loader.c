@@ -178,6 +178,29 @@ void test_font_loader_reload(void)
     lv_binfont_destroy(font);
 }
 
+void test_font_loader_mapped(void)
+{
+    /*The same as test_font_2.fnt but the glyph bitmaps start on byte boundary,
+     *so they can be used in place from the mapped file*/
+    const char * paths[] = {"A:src/test_assets/test_font_2_aligned.fnt", "B:src/test_assets/test_font_2_aligned.fnt"};
+
+    for(uint32_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        lv_font_t * font = lv_binfont_create(paths[i]);
+        TEST_ASSERT_NOT_NULL(font);
+        compare_fonts(&test_font_2, font);
+
+        lv_obj_t * label = lv_label_create(lv_screen_active());
+        lv_obj_center(label);
+        lv_label_set_text(label, "The quick brown fox jumped over the lazy dog");
+        lv_obj_set_style_text_font(label, font, 0);
+
+        TEST_ASSERT_EQUAL_SCREENSHOT("font_loader_2.png");
+
+        lv_obj_delete(label);
+        lv_binfont_destroy(font);
+    }
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
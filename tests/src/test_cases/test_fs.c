@@ -450,6 +450,41 @@ void test_fs_load_to_buf(void)
     lv_test_fs_set_ready(true);
 }
 
+void test_fs_map(void)
+{
+    const char * paths[] = {"A:src/test_files/readtest.txt", "B:src/test_files/readtest.txt"};
+    const uint32_t file_size = 745; /* Size of readtest.txt */
+
+    for(uint32_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        lv_fs_file_t f;
+        lv_fs_map_t map;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, paths[i], LV_FS_MODE_RD));
+
+        /* Not page aligned offset */
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_map(&f, 100, 300, &map));
+        TEST_ASSERT_EQUAL_UINT32(300, map.size);
+
+        /* Out of the file */
+        lv_fs_map_t map_out;
+        TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_map(&f, 100, file_size, &map_out));
+        TEST_ASSERT_NULL(map_out.data);
+
+        /* The mapping remains valid after closing the file */
+        lv_fs_close(&f);
+        TEST_ASSERT_EQUAL_MEMORY(read_exp + 100, map.data, 300);
+
+        lv_fs_unmap(&map);
+        TEST_ASSERT_NULL(map.data);
+    }
+
+    /* Drive 'T' can't map files */
+    lv_fs_file_t ft;
+    lv_fs_map_t map;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&ft, "T:src/test_files/readtest.txt", LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, lv_fs_map(&ft, 0, 10, &map));
+    lv_fs_close(&ft);
+}
+
 void test_fs_dir_open(void)
 {
     lv_fs_res_t res;
@@ -0,0 +1,171 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+#define IMAGE_SRC "A:src/test_assets/test_img_lvgl_logo.png"
+
+static uint32_t image_task_cnt;
+static uint32_t fill_task_cnt;
+
+void setUp(void)
+{
+    image_task_cnt = 0;
+    fill_task_cnt = 0;
+    lv_image_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_image_decoder_set_async(false);
+    lv_image_decoder_set_async_placeholder(lv_color_hex(0xC0C0C0), LV_OPA_30);
+    lv_obj_clean(lv_screen_active());
+}
+
+static void draw_task_added_cb(lv_event_t * e)
+{
+    lv_draw_task_t * t = lv_event_get_draw_task(e);
+    if(lv_draw_task_get_type(t) == LV_DRAW_TASK_TYPE_IMAGE) image_task_cnt++;
+    if(lv_draw_task_get_type(t) == LV_DRAW_TASK_TYPE_FILL) fill_task_cnt++;
+}
+
+static lv_obj_t * create_image(void)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, IMAGE_SRC);
+    lv_obj_set_send_draw_task_events(img, true);
+    lv_obj_add_event_cb(img, draw_task_added_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    return img;
+}
+
+/*Let the worker decode the image and the timer invalidate the widgets*/
+static void wait_for_decoding(void)
+{
+    uint32_t i;
+    for(i = 0; i < 1000 && lv_image_prefetch_is_pending(IMAGE_SRC); i++) {
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        lv_timer_handler();
+#if LV_USE_OS
+        /*Without an OS the timer decodes the image, and sleeping would wait for ticks forever*/
+        lv_sleep_ms(1);
+#endif
+    }
+
+    TEST_ASSERT_FALSE(lv_image_prefetch_is_pending(IMAGE_SRC));
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    lv_timer_handler();
+}
+
+void test_image_decoder_async_draws_the_image_when_decoded(void)
+{
+    lv_image_decoder_set_async(true);
+    TEST_ASSERT_TRUE(lv_image_decoder_get_async());
+    create_image();
+
+    /*Snapshots are drawn synchronously*/
+    lv_draw_buf_t * ref = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(ref);
+    lv_image_cache_drop(NULL);
+    image_task_cnt = 0;
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, image_task_cnt);
+
+    wait_for_decoding();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, image_task_cnt);
+
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    TEST_ASSERT_EQUAL_MEMORY(ref->data, snapshot->data, ref->data_size);
+    lv_draw_buf_destroy(snapshot);
+    lv_draw_buf_destroy(ref);
+}
+
+void test_image_decoder_async_prefetch(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_prefetch(IMAGE_SRC));
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_prefetch("A:src/test_assets/not_exists.png"));
+    wait_for_decoding();
+
+    /*Drawn in the first refresh*/
+    create_image();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, image_task_cnt);
+}
+
+void test_image_decoder_async_widget_deleted_while_decoding(void)
+{
+    lv_image_decoder_set_async(true);
+    lv_obj_t * img = create_image();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, image_task_cnt);
+
+    lv_obj_delete(img);
+    wait_for_decoding();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, image_task_cnt);
+}
+
+void test_image_decoder_async_draws_a_placeholder_while_decoding(void)
+{
+    lv_image_decoder_set_async(true);
+    create_image();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, image_task_cnt);
+    TEST_ASSERT_EQUAL(1, fill_task_cnt);
+
+    wait_for_decoding();
+    fill_task_cnt = 0;
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, image_task_cnt);
+    TEST_ASSERT_EQUAL(0, fill_task_cnt);
+}
+
+void test_image_decoder_async_no_placeholder_if_transparent(void)
+{
+    lv_image_decoder_set_async(true);
+    lv_image_decoder_set_async_placeholder(lv_color_black(), LV_OPA_TRANSP);
+    create_image();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, image_task_cnt);
+    TEST_ASSERT_EQUAL(0, fill_task_cnt);
+    wait_for_decoding();
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_decoder_async_draws_the_image_when_decoded(void)
+{
+}
+
+void test_image_decoder_async_prefetch(void)
+{
+}
+
+void test_image_decoder_async_widget_deleted_while_decoding(void)
+{
+}
+
+void test_image_decoder_async_draws_a_placeholder_while_decoding(void)
+{
+}
+
+void test_image_decoder_async_no_placeholder_if_transparent(void)
+{
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
+#endif
@@ -0,0 +1,177 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_OBJ_RETAINED_DRAW
+
+static uint32_t draw_main_cnt;
+
+void setUp(void)
+{
+    draw_main_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void draw_main_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_main_cnt++;
+}
+
+static lv_obj_t * create_widget(lv_obj_t * parent)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_set_size(obj, 200, 100);
+    lv_obj_set_pos(obj, 20, 30);
+    lv_obj_set_style_radius(obj, 20, 0);
+    lv_obj_set_style_shadow_width(obj, 15, 0);
+    lv_obj_set_style_border_width(obj, 3, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), LV_STATE_CHECKED);
+    lv_obj_add_event_cb(obj, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Retained");
+    lv_obj_center(label);
+
+    return obj;
+}
+
+/*Render `obj` to a buffer and check if it's the same as the reference*/
+static void snapshot_compare(lv_obj_t * obj, const lv_draw_buf_t * ref)
+{
+    lv_draw_buf_t * snapshot = lv_snapshot_take(obj, LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    TEST_ASSERT_EQUAL(ref->data_size, snapshot->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(ref->data, snapshot->data, ref->data_size);
+    lv_draw_buf_destroy(snapshot);
+}
+
+void test_obj_retained_draw_replays_the_same_draw_tasks(void)
+{
+    lv_obj_t * obj = create_widget(lv_screen_active());
+    lv_draw_buf_t * ref = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    lv_obj_set_draw_retained(obj, true);
+    TEST_ASSERT_TRUE(lv_obj_get_draw_retained(obj));
+
+    draw_main_cnt = 0;
+    snapshot_compare(lv_screen_active(), ref);
+    TEST_ASSERT_EQUAL(1, draw_main_cnt);
+
+    /*Use the recorded draw tasks*/
+    snapshot_compare(lv_screen_active(), ref);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_main_cnt);
+
+    lv_obj_set_draw_retained(obj, false);
+    TEST_ASSERT_FALSE(lv_obj_get_draw_retained(obj));
+    snapshot_compare(lv_screen_active(), ref);
+    TEST_ASSERT_EQUAL(2, draw_main_cnt);
+
+    lv_draw_buf_destroy(ref);
+}
+
+void test_obj_retained_draw_is_dropped_on_changes(void)
+{
+    lv_obj_t * obj = create_widget(lv_screen_active());
+    lv_obj_set_draw_retained(obj, true);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_main_cnt);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, draw_main_cnt);
+
+    /*Inherited by the children, so changing the parent's style should redraw too*/
+    lv_obj_set_style_text_color(lv_screen_active(), lv_color_hex(0x0000ff), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(3, draw_main_cnt);
+
+    /*The new state has different styles*/
+    lv_obj_add_state(obj, LV_STATE_CHECKED);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(4, draw_main_cnt);
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(4, draw_main_cnt);
+}
+
+void test_obj_retained_draw_is_moved_on_scroll(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 300, 200);
+    lv_obj_t * obj = create_widget(cont);
+    lv_obj_set_y(obj, 150);
+    lv_obj_t * filler = lv_obj_create(cont);
+    lv_obj_set_pos(filler, 0, 600);
+
+    lv_obj_scroll_to_y(cont, 100, LV_ANIM_OFF);
+    lv_draw_buf_t * ref = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(ref);
+    lv_obj_scroll_to_y(cont, 120, LV_ANIM_OFF);
+
+    /*Record the widget in one piece*/
+    lv_obj_set_draw_retained(obj, true);
+    lv_obj_invalidate(cont);
+    lv_refr_now(NULL);
+    draw_main_cnt = 0;
+
+    lv_obj_scroll_to_y(cont, 100, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    snapshot_compare(lv_screen_active(), ref);
+    TEST_ASSERT_EQUAL(0, draw_main_cnt);
+
+    lv_draw_buf_destroy(ref);
+}
+
+void test_obj_retained_draw_is_freed_with_the_widget(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+
+    lv_obj_t * obj = create_widget(lv_screen_active());
+    lv_obj_set_draw_retained(obj, true);
+    lv_refr_now(NULL);
+    lv_obj_delete(obj);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_obj_retained_draw_replays_the_same_draw_tasks(void)
+{
+}
+
+void test_obj_retained_draw_is_dropped_on_changes(void)
+{
+}
+
+void test_obj_retained_draw_is_moved_on_scroll(void)
+{
+}
+
+void test_obj_retained_draw_is_freed_with_the_widget(void)
+{
+}
+
+#endif /*LV_USE_OBJ_RETAINED_DRAW*/
+
+#endif
@@ -0,0 +1,201 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_region_t region;
+
+static uint64_t size_cost_cb(const lv_area_t * area, void * user_data)
+{
+    uint64_t fix_cost = *(uint64_t *)user_data;
+    return lv_area_get_size(area) + fix_cost;
+}
+
+static uint64_t get_region_size(void)
+{
+    uint64_t size = 0;
+    uint32_t i;
+    for(i = 0; i < lv_region_get_area_count(&region); i++) {
+        size += lv_area_get_size(lv_region_get_area(&region, i));
+    }
+    return size;
+}
+
+static void assert_disjoint(void)
+{
+    uint32_t cnt = lv_region_get_area_count(&region);
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < cnt; i++) {
+        for(j = i + 1; j < cnt; j++) {
+            TEST_ASSERT_FALSE(lv_area_is_on(lv_region_get_area(&region, i), lv_region_get_area(&region, j)));
+        }
+    }
+}
+
+void setUp(void)
+{
+    lv_region_init(&region);
+}
+
+void tearDown(void)
+{
+    lv_region_deinit(&region);
+}
+
+void test_region_add_many(void)
+{
+    /*More areas than the old fixed invalidation buffer could hold*/
+    int32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_area_t a = {0, i * 10, 49, i * 10 + 4};
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_region_add(&region, &a));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(100, lv_region_get_area_count(&region));
+    TEST_ASSERT_EQUAL_UINT64(100 * 50 * 5, get_region_size());
+}
+
+void test_region_add_too_many(void)
+{
+    int32_t i;
+    for(i = 0; i < LV_REGION_AREA_CNT_MAX; i++) {
+        lv_area_t a = {0, i * 10, 49, i * 10 + 4};
+        lv_region_add(&region, &a);
+    }
+    TEST_ASSERT_EQUAL_UINT32(LV_REGION_AREA_CNT_MAX, lv_region_get_area_count(&region));
+
+    /*One more area replaces all of them with their bounding box*/
+    lv_area_t a = {100, 0, 109, 4};
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_region_add(&region, &a));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_region_get_area_count(&region));
+    lv_area_t * bbox = lv_region_get_area(&region, 0);
+    TEST_ASSERT_EQUAL_INT32(0, bbox->x1);
+    TEST_ASSERT_EQUAL_INT32(0, bbox->y1);
+    TEST_ASSERT_EQUAL_INT32(109, bbox->x2);
+    TEST_ASSERT_EQUAL_INT32((LV_REGION_AREA_CNT_MAX - 1) * 10 + 4, bbox->y2);
+}
+
+void test_region_add_covered(void)
+{
+    lv_area_t a1 = {0, 0, 99, 99};
+    lv_area_t a2 = {10, 10, 20, 20};
+    lv_region_add(&region, &a1);
+    lv_region_add(&region, &a2);
+
+    TEST_ASSERT_TRUE(lv_region_is_in(&region, &a2));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_region_get_area_count(&region));
+
+    /*Covering the existing area replaces it*/
+    lv_area_t a3 = {-10, -10, 109, 109};
+    lv_region_add(&region, &a3);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_region_get_area_count(&region));
+    TEST_ASSERT_EQUAL_UINT64(120 * 120, get_region_size());
+}
+
+void test_region_add_overlapping(void)
+{
+    lv_area_t a1 = {0, 0, 99, 99};
+    lv_area_t a2 = {50, 50, 149, 149};
+    lv_area_t a3 = {20, 120, 60, 200};
+    lv_region_add(&region, &a1);
+    lv_region_add(&region, &a2);
+    lv_region_add(&region, &a3);
+
+    assert_disjoint();
+    TEST_ASSERT_EQUAL_UINT64(100 * 100 * 2 - 50 * 50 + 41 * 81 - 11 * 30, get_region_size());
+}
+
+void test_region_subtract(void)
+{
+    lv_area_t a1 = {0, 0, 99, 99};
+    lv_area_t a2 = {40, 40, 59, 59};
+    lv_region_add(&region, &a1);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_region_subtract(&region, &a2));
+
+    /*A hole in the middle splits the area into 4*/
+    TEST_ASSERT_EQUAL_UINT32(4, lv_region_get_area_count(&region));
+    assert_disjoint();
+    TEST_ASSERT_EQUAL_UINT64(100 * 100 - 20 * 20, get_region_size());
+
+    lv_region_subtract(&region, &a1);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_region_get_area_count(&region));
+}
+
+void test_region_merge_by_cost(void)
+{
+    /*Two areas with a 10 px gap between them*/
+    lv_area_t a1 = {0, 0, 99, 9};
+    lv_area_t a2 = {0, 20, 99, 29};
+    lv_area_t a3 = {0, 10, 9, 19};
+    lv_region_add(&region, &a1);
+    lv_region_add(&region, &a2);
+    lv_region_add(&region, &a3);
+
+    /*Without fix cost the bounding box has more pixels than the areas*/
+    uint64_t fix_cost = 0;
+    lv_region_merge(&region, size_cost_cb, &fix_cost);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_region_get_area_count(&region));
+
+    /*With a large enough fix cost per area one area is cheaper*/
+    fix_cost = 1000;
+    lv_region_merge(&region, size_cost_cb, &fix_cost);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_region_get_area_count(&region));
+    lv_area_t * a = lv_region_get_area(&region, 0);
+    TEST_ASSERT_EQUAL_INT32(0, a->x1);
+    TEST_ASSERT_EQUAL_INT32(0, a->y1);
+    TEST_ASSERT_EQUAL_INT32(99, a->x2);
+    TEST_ASSERT_EQUAL_INT32(29, a->y2);
+}
+
+void test_region_merge_keeps_disjoint(void)
+{
+    int32_t i;
+    for(i = 0; i < 50; i++) {
+        lv_area_t a = {(i * 37) % 200, (i * 53) % 300, (i * 37) % 200 + 30, (i * 53) % 300 + 20};
+        lv_region_add(&region, &a);
+    }
+    assert_disjoint();
+
+    uint64_t fix_cost = 0;
+    lv_region_merge(&region, size_cost_cb, &fix_cost);
+    assert_disjoint();
+
+    fix_cost = 200;
+    lv_region_merge(&region, size_cost_cb, &fix_cost);
+    assert_disjoint();
+}
+
+void test_region_invalidate_many_areas(void)
+{
+    lv_obj_t * scr = lv_screen_active();
+    lv_display_t * disp = lv_display_get_default();
+    lv_refr_now(disp);
+
+    int32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_obj_t * obj = lv_obj_create(scr);
+        lv_obj_set_pos(obj, (i % 8) * 100, (i / 8) * 100);
+        lv_obj_set_size(obj, 50, 50);
+    }
+    lv_refr_now(disp);
+
+    for(i = 0; i < 40; i++) {
+        lv_obj_invalidate(lv_obj_get_child(scr, i));
+    }
+
+    /*Having more than 32 areas doesn't invalidate the whole screen*/
+    TEST_ASSERT_EQUAL_UINT32(40, lv_region_get_area_count(&disp->inv_region));
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                lv_display_get_vertical_resolution(disp) - 1);
+    TEST_ASSERT_FALSE(lv_region_is_in(&disp->inv_region, &scr_area));
+
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_region_get_area_count(&disp->inv_region));
+
+    lv_obj_clean(scr);
+}
+
+#endif
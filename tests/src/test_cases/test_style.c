@@ -226,6 +226,47 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+void test_style_set_get_remove_many_props(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+
+    /*Set the properties in a mixed order*/
+    uint32_t i;
+    for(i = 0; i < LV_STYLE_NUM_BUILT_IN_PROPS; i++) {
+        lv_style_prop_t prop = (lv_style_prop_t)((i * 37) % LV_STYLE_NUM_BUILT_IN_PROPS);
+        if(prop == LV_STYLE_PROP_INV) continue;
+        lv_style_value_t v = {.num = prop * 10};
+        lv_style_set_prop(&style, prop, v);
+    }
+
+    /*Overwrite a few values*/
+    for(i = 1; i < LV_STYLE_NUM_BUILT_IN_PROPS; i += 10) {
+        lv_style_value_t v = {.num = i * 20};
+        lv_style_set_prop(&style, (lv_style_prop_t)i, v);
+    }
+
+    /*Remove every third property*/
+    for(i = 1; i < LV_STYLE_NUM_BUILT_IN_PROPS; i += 3) {
+        TEST_ASSERT_TRUE(lv_style_remove_prop(&style, (lv_style_prop_t)i));
+    }
+
+    for(i = 1; i < LV_STYLE_NUM_BUILT_IN_PROPS; i++) {
+        lv_style_value_t v;
+        lv_style_res_t res = lv_style_get_prop(&style, (lv_style_prop_t)i, &v);
+        if((i - 1) % 3 == 0) {
+            TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, res);
+        }
+        else {
+            TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, res);
+            TEST_ASSERT_TRUE(lv_style_may_have_prop(&style, (lv_style_prop_t)i));
+            TEST_ASSERT_EQUAL_INT32((i - 1) % 10 == 0 ? i * 20 : i * 10, v.num);
+        }
+    }
+
+    lv_style_reset(&style);
+}
+
 void test_style_remove_theme(void)
 {
     lv_obj_t * sw = lv_switch_create(lv_screen_active());
@@ -249,4 +290,117 @@ void test_style_remove_theme(void)
     TEST_ASSERT_EQUAL(0, lv_obj_get_style_bg_opa(sw, LV_PART_KNOB));
 }
 
+
+void test_style_get_prop_many_props_follow_changes(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_radius(&style, 1);
+    lv_style_set_bg_opa(&style, 2);
+    lv_style_set_border_width(&style, 3);
+    lv_style_set_pad_top(&style, 4);
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT32(4, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_outline_width(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(1, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL(2, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    }
+
+    /*Change a property in the middle*/
+    lv_obj_set_style_border_width(obj, 30, LV_PART_MAIN);
+    lv_obj_set_style_outline_width(obj, 50, LV_PART_MAIN);
+    for(i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT32(1, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL(2, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(30, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(50, lv_obj_get_style_outline_width(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(4, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+    }
+
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BORDER_WIDTH, LV_PART_MAIN);
+    for(i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT32(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(50, lv_obj_get_style_outline_width(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(1, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL_INT32(4, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+    }
+
+    lv_obj_delete(obj);
+    lv_style_reset(&style);
+}
+
+void test_style_get_prop_follows_changes(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_radius(&style, 10);
+
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(parent);
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT32(10, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Changed shared style*/
+    lv_style_set_radius(&style, 20);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Local style property*/
+    lv_obj_set_style_radius(obj, 30, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT32(30, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_RADIUS, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Property of an other state*/
+    lv_obj_set_style_radius(obj, 40, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    lv_obj_remove_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Disabled and removed style*/
+    lv_obj_style_set_disabled(obj, &style, LV_PART_MAIN, true);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    lv_obj_style_set_disabled(obj, &style, LV_PART_MAIN, false);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    lv_obj_remove_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Inherited property set on the parent*/
+    lv_obj_set_style_text_letter_space(parent, 3, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT32(3, lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN));
+    lv_obj_set_style_text_letter_space(parent, 5, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT32(5, lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN));
+
+    /*Transition*/
+    static const lv_style_prop_t props[] = {LV_STYLE_BG_OPA, LV_STYLE_PROP_INV};
+    static lv_style_transition_dsc_t trans;
+    lv_style_transition_dsc_init(&trans, props, lv_anim_path_linear, 100, 0, NULL);
+    lv_obj_set_style_transition(obj, &trans, LV_STATE_PRESSED);
+    lv_obj_set_size(parent, 100, 100);
+    lv_obj_set_size(obj, 50, 50);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_refr_now(NULL);  /*Transitions are skipped until the widget is rendered*/
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    lv_test_fast_forward(50);
+    lv_opa_t opa = lv_obj_get_style_bg_opa(obj, LV_PART_MAIN);
+    TEST_ASSERT_TRUE(opa > LV_OPA_TRANSP && opa < LV_OPA_COVER);
+    lv_test_fast_forward(100);
+    TEST_ASSERT_EQUAL(LV_OPA_COVER, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_delete(parent);
+    lv_style_reset(&style);
+}
+
 #endif
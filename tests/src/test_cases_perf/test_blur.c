@@ -0,0 +1,55 @@
+/* Performance test of blurring the backdrop of a widget */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "unity/unity.h"
+
+static lv_obj_t * label;
+static lv_obj_t * panel;
+
+void setUp(void)
+{
+    label = lv_label_create(lv_screen_active());
+    lv_obj_set_width(label, lv_pct(100));
+    lv_label_set_text(label, "Lorem ipsum dolor sit amet, consectetur adipiscing elit. "
+                      "Curabitur sed velit sed neque tristique sagittis vel et sapien. "
+                      "Lorem ipsum dolor sit amet, consectetur adipiscing elit.");
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+
+    panel = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(panel, 400, 300);
+    lv_obj_center(panel);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_30, 0);
+    lv_obj_set_style_radius(panel, 20, 0);
+    lv_obj_set_style_blur_backdrop(panel, true, 0);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void render_blurred(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        /*Move the backdrop to blur different pixels in each frame*/
+        lv_obj_set_y(label, i * 7);
+        lv_refr_now(NULL);
+    }
+}
+
+void test_blur_precise(void)
+{
+    lv_obj_set_style_blur_radius(panel, 20, 0);
+    lv_obj_set_style_blur_quality(panel, LV_BLUR_QUALITY_PRECISION, 0);
+    TEST_ASSERT_MAX_TIME(render_blurred, 600, 10);
+}
+
+void test_blur_auto(void)
+{
+    lv_obj_set_style_blur_radius(panel, 40, 0);
+    TEST_ASSERT_MAX_TIME(render_blurred, 300, 10);
+}
+
+#endif
@@ -0,0 +1,52 @@
+/* Performance test of drawing a grid of cards with shadows */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "unity/unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void cards_create(int32_t radius)
+{
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_pos(obj, 20 + (i % 6) * 130, 20 + (i / 6) * 95);
+        lv_obj_set_size(obj, 100, 60);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_style_radius(obj, radius, 0);
+        lv_obj_set_style_shadow_width(obj, 30, 0);
+        lv_obj_set_style_shadow_offset_y(obj, 5, 0);
+    }
+}
+
+static void render_cards(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+}
+
+void test_box_shadow_rect(void)
+{
+    cards_create(0);
+    TEST_ASSERT_MAX_TIME(render_cards, 300, 10);
+}
+
+void test_box_shadow_rounded(void)
+{
+    cards_create(12);
+    TEST_ASSERT_MAX_TIME(render_cards, 400, 10);
+}
+
+#endif
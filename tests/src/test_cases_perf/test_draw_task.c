@@ -0,0 +1,79 @@
+/* Performance test for the dependency check of the draw tasks */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "unity/unity.h"
+
+#define CELL_CNT    40      /*40 x 40 = 1600 draw tasks*/
+#define CELL_SIZE   10
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+static uint32_t available_cnt;
+
+void setUp(void)
+{
+    int32_t size = CELL_CNT * CELL_SIZE;
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(size, size, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+}
+
+void tearDown(void)
+{
+    lv_draw_buf_destroy(lv_canvas_get_draw_buf(canvas));
+    lv_obj_delete(canvas);
+}
+
+static void add_grid(int32_t cell_size)
+{
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+
+    int32_t x, y;
+    for(y = 0; y < CELL_CNT; y++) {
+        for(x = 0; x < CELL_CNT; x++) {
+            lv_area_t area = {x * CELL_SIZE, y * CELL_SIZE, x * CELL_SIZE + cell_size - 1, y * CELL_SIZE + cell_size - 1};
+            dsc.color = lv_color_make(x * 6, y * 6, 0);
+            lv_draw_fill(&layer, &dsc, &area);
+        }
+    }
+}
+
+static void get_available_tasks(lv_layer_t * l)
+{
+    available_cnt = 0;
+    uint8_t unit_id = l->draw_task_head->preferred_draw_unit_id;
+    lv_draw_task_t * t = NULL;
+    while((t = lv_draw_get_next_available_task(l, t, unit_id)) != NULL) {
+        available_cnt++;
+    }
+}
+
+void test_draw_task_independent(void)
+{
+    lv_canvas_init_layer(canvas, &layer);
+    add_grid(CELL_SIZE);
+
+    /*Every task is independent*/
+    TEST_ASSERT_MAX_TIME(get_available_tasks, 10, &layer);
+    TEST_ASSERT_EQUAL_UINT32(CELL_CNT * CELL_CNT, available_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_draw_task_overlapping(void)
+{
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*Every task overlaps with its right and bottom neighbors*/
+    add_grid(CELL_SIZE + 1);
+
+    TEST_ASSERT_MAX_TIME(get_available_tasks, 10, &layer);
+    TEST_ASSERT_EQUAL_UINT32(1, available_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+#endif
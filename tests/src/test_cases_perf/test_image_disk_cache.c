@@ -0,0 +1,86 @@
+/* Performance test of opening images after a restart with and without the disk cache */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "unity/unity.h"
+#include <sys/stat.h>
+#include <time.h>
+
+#if LV_USE_IMAGE_DISK_CACHE && LV_USE_LODEPNG && LV_USE_FS_STDIO
+
+#define CACHE_DIR   "src/test_files/image_disk_cache"
+
+static const char * srcs[] = {
+    "A:src/test_assets/test_img_lvgl_logo.png",
+    "A:src/test_assets/test_img_emoji_F600.png",
+    "A:src/test_assets/test_arc_bg.png",
+    "A:src/test_assets/test_img_gradient_640x560.png",
+};
+
+/*Measure the time of decoding*/
+static uint32_t test_tick_cb(void)
+{
+    return (uint32_t)((uint64_t)clock() * 1000 / CLOCKS_PER_SEC);
+}
+
+void setUp(void)
+{
+    lv_tick_set_cb(test_tick_cb);
+    lv_image_cache_drop(NULL);
+    mkdir(CACHE_DIR, 0777);
+    lv_image_decoder_set_disk_cache_path("A:" CACHE_DIR);
+    lv_image_decoder_disk_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_image_decoder_disk_cache_drop(NULL);
+    lv_image_decoder_set_disk_cache_path(NULL);
+    lv_image_cache_drop(NULL);
+    lv_tick_set_cb(NULL);
+}
+
+static void open_images(void)
+{
+    /*As after a restart*/
+    lv_image_cache_drop(NULL);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(srcs) / sizeof(srcs[0]); i++) {
+        lv_image_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, srcs[i], NULL));
+        lv_image_decoder_close(&dsc);
+    }
+}
+
+void test_image_disk_cache_cold_start(void)
+{
+    clock_t start = clock();
+    open_images();
+    clock_t decode_time = clock() - start;
+
+    start = clock();
+    open_images();
+    clock_t load_time = clock() - start;
+
+    TEST_ASSERT_LESS_THAN(decode_time, load_time);
+    TEST_ASSERT_MAX_TIME(open_images, 20);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_disk_cache_cold_start(void)
+{
+}
+
+#endif /*LV_USE_IMAGE_DISK_CACHE && LV_USE_LODEPNG && LV_USE_FS_STDIO*/
+
+#endif
@@ -0,0 +1,66 @@
+/* Performance test of drawing rotated and scaled images */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "unity/unity.h"
+
+#define SRC_SIZE    480
+
+static lv_draw_buf_t * draw_buf;
+static lv_obj_t * img;
+
+void setUp(void)
+{
+    draw_buf = lv_draw_buf_create(SRC_SIZE, SRC_SIZE, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+
+    /*A photo-like image with smooth gradients and semi-transparent pixels*/
+    int32_t x, y;
+    for(y = 0; y < SRC_SIZE; y++) {
+        lv_color32_t * row = (lv_color32_t *)(draw_buf->data + y * draw_buf->header.stride);
+        for(x = 0; x < SRC_SIZE; x++) {
+            row[x].red = (uint8_t)(x / 2);
+            row[x].green = (uint8_t)(y / 2);
+            row[x].blue = (uint8_t)((x + y) / 4);
+            row[x].alpha = (uint8_t)(255 - ((x * y) & 0x3F));
+        }
+    }
+
+    img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, draw_buf);
+    lv_obj_center(img);
+}
+
+void tearDown(void)
+{
+    lv_obj_delete(img);
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static void render_rotated(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_image_set_rotation(img, 150 + i * 100);
+        lv_refr_now(NULL);
+    }
+}
+
+void test_image_transform_rotate(void)
+{
+    TEST_ASSERT_MAX_TIME(render_rotated, 1000, 10);
+}
+
+void test_image_transform_rotate_no_antialias(void)
+{
+    lv_image_set_antialias(img, false);
+    TEST_ASSERT_MAX_TIME(render_rotated, 300, 10);
+}
+
+void test_image_transform_rotate_and_scale(void)
+{
+    lv_image_set_scale(img, 300);
+    TEST_ASSERT_MAX_TIME(render_rotated, 1200, 10);
+}
+
+#endif
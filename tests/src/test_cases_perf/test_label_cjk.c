@@ -0,0 +1,73 @@
+/* Performance test of the labels and the glyph lookup of a large CJK font */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "unity/unity.h"
+
+#if LV_FONT_SOURCE_HAN_SANS_SC_16_CJK
+
+static lv_obj_t * label = NULL;
+
+void setUp(void)
+{
+    label = lv_label_create(lv_screen_active());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void get_cjk_glyph_dscs(void)
+{
+    static const uint32_t letters[] = {0x76D7, 0x63D0, 0x967D, 0x5E2F, 0x9F3B, 0x753B, 0x8F15, 0x518A, 0x5199, 0x7236};
+    uint32_t letter_cnt = sizeof(letters) / sizeof(letters[0]);
+    lv_font_glyph_dsc_t g;
+    uint32_t i;
+    for(i = 0; i < 100000; i++) {
+        lv_font_get_glyph_dsc(&lv_font_source_han_sans_sc_16_cjk, &g, letters[i % letter_cnt],
+                              letters[(i + 1) % letter_cnt]);
+    }
+}
+
+void test_label_cjk(void)
+{
+    /*The letters are in a sparse character map of more than 1000 letters*/
+    static const char * text =
+        "盗提陽帯鼻画輕冊写父結想正四夫源庭場天續鳥講猿苦階給了製守祝己妳薄泣塩帰吃変輪那着仍嗯爭熱創味保字宿捨準查達肯"
+        "薬得査障該降察網加昼料等図邪秋態品屬久原殊候路願楽確針上被怕悲風份重歡附既黨價娘朝凍僅際洋止右航专角應酸師個比"
+        "則響健昇豐筆歷適修據細忙跟管長令家期般花越域泳通些油乏營返調農叫樹刊愛間包知把貧橋拡普聞前建当繰送習渇用補覺體";
+
+    lv_obj_set_width(label, 300);
+    lv_obj_set_style_text_font(label, &lv_font_source_han_sans_sc_16_cjk, 0);
+    lv_label_set_text(label, text);
+
+    /*Measured again when the layout is refreshed*/
+    TEST_ASSERT_MAX_TIME_ITER(lv_label_set_text, 40, 10, label, text);
+}
+
+void test_label_cjk_glyph_dsc(void)
+{
+    TEST_ASSERT_MAX_TIME(get_cjk_glyph_dscs, 60);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_label_cjk(void)
+{
+}
+
+void test_label_cjk_glyph_dsc(void)
+{
+}
+
+#endif /*LV_FONT_SOURCE_HAN_SANS_SC_16_CJK*/
+
+#endif